@@ -164,6 +164,7 @@ public:
   unsigned getBankNum() const {return m_bankNum;}
 	void setBankNum(unsigned x_bankNum){m_bankNum=x_bankNum;}
   void acceptStatistics(c_BankStatistics *x_bankStats);
+  bool isIdle() const {return (nullptr == m_cmd);}
 
 private:
 	c_Bank(); // for serialization only
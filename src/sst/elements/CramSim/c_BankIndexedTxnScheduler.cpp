@@ -0,0 +1,321 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+
+// std includes
+#include <iostream>
+#include <assert.h>
+
+// local includes
+#include "c_BankIndexedTxnScheduler.hpp"
+
+using namespace SST;
+using namespace SST::CramSim;
+using namespace std;
+
+
+c_BankIndexedTxnScheduler::c_BankIndexedTxnScheduler(SST::ComponentId_t id, SST::Params& x_params, Output* out, unsigned channels, c_TxnConverter* converter, c_CmdScheduler* scheduler) :
+    c_TxnScheduler(id, x_params, out, channels, converter, scheduler) {
+
+    m_numBanksPerChannel = m_cmdScheduler->getNumBanksPerChannel();
+    assert(m_numBanksPerChannel>0);
+
+    if(!k_isReadFirstScheduling) {
+        m_indexedTxnQ.resize(m_numChannels);
+        for(auto &l_queue: m_indexedTxnQ)
+            initQueue(l_queue);
+    } else {
+        m_indexedReadQ.resize(m_numChannels);
+        m_indexedWriteQ.resize(m_numChannels);
+        for(unsigned l_ch=0; l_ch<m_numChannels; l_ch++) {
+            initQueue(m_indexedReadQ[l_ch]);
+            initQueue(m_indexedWriteQ[l_ch]);
+        }
+    }
+}
+
+c_BankIndexedTxnScheduler::~c_BankIndexedTxnScheduler() {
+    for(auto l_queues: {&m_indexedTxnQ, &m_indexedReadQ, &m_indexedWriteQ}) {
+        for(auto &l_queue: *l_queues) {
+            for(auto l_entry: l_queue.fifo)
+                delete l_entry;
+        }
+    }
+}
+
+void c_BankIndexedTxnScheduler::initQueue(c_IndexedTxnQueue& x_queue) {
+    x_queue.banks.resize(m_numBanksPerChannel);
+    x_queue.pendingBanks.assign((m_numBanksPerChannel+63)/64, 0);
+    x_queue.nextOrder=0;
+}
+
+
+void c_BankIndexedTxnScheduler::run(SimTime_t simCycle){
+
+    for(int l_channelID=0; l_channelID<m_numChannels; l_channelID++) {
+
+        //0. select queue
+        c_IndexedTxnQueue* l_queue= nullptr;
+        if(!k_isReadFirstScheduling) {
+            l_queue = &(m_indexedTxnQ[l_channelID]);
+        } else {
+            if (m_indexedWriteQ[l_channelID].fifo.size() >= m_maxNumPendingWrite || m_indexedReadQ[l_channelID].fifo.size()==0)
+                m_flushWriteQueue = true;
+            else if (m_indexedWriteQ[l_channelID].fifo.size() < m_minNumPendingWrite && m_indexedReadQ[l_channelID].fifo.size()!=0)
+                m_flushWriteQueue = false;
+
+            if(m_flushWriteQueue)
+                l_queue = &(m_indexedWriteQ[l_channelID]);
+            else
+                l_queue = &(m_indexedReadQ[l_channelID]);
+        }
+
+        assert(l_queue!=nullptr);
+
+        //1. select a transaction from the transaction queue
+        c_IndexedTxn* l_nextTxn=nullptr;
+        if(l_queue->fifo.size())
+            l_nextTxn=selectTxn(*l_queue, l_channelID);
+          //1.1. With read-first scheduling, we change the queue if there are no issuable transactions in the selected queue
+        if(k_isReadFirstScheduling && l_nextTxn== nullptr)
+        {
+            if(m_flushWriteQueue ==true)
+                l_queue = &m_indexedReadQ[l_channelID];
+            else
+                l_queue = &m_indexedWriteQ[l_channelID];
+            if(l_queue->fifo.size())
+                l_nextTxn=selectTxn(*l_queue, l_channelID);
+        }
+
+        //2. send the selected transaction to transaction converter
+        if(l_nextTxn!=nullptr) {
+            c_Transaction* l_txn = l_nextTxn->txn;
+
+            if(m_cmdScheduler->getToken(l_txn->getHashedAddress())>=3) {
+
+                // send the selected transaction
+                m_txnConverter->push(l_txn);
+
+                #ifdef __SST_DEBUG_OUTPUT__
+                l_txn->print(output, "[c_BankIndexedTxnScheduler]",simCycle);
+                #endif
+
+                // pop it from inputQ
+                removeTxn(*l_queue, l_nextTxn);
+            }
+        }
+    }
+}
+
+
+// FCFS takes the oldest transaction. FRFCFS takes the oldest issuable
+// transaction to an open row and otherwise, like c_TxnScheduler, the
+// youngest issuable transaction.
+c_BankIndexedTxnScheduler::c_IndexedTxn* c_BankIndexedTxnScheduler::selectTxn(c_IndexedTxnQueue& x_queue, int x_ch)
+{
+    assert(x_queue.fifo.size()!=0);
+
+    c_IndexedTxn* l_nxtTxn = nullptr;
+
+    //FCFS
+    if(k_txnSchedulingPolicy == e_txnSchedulingPolicy::FCFS) {
+        c_IndexedTxn* l_front = x_queue.fifo.front();
+        if(m_cmdScheduler->getToken(l_front->txn->getHashedAddress())>=3) {
+            if(hasHazard(x_queue, l_front, x_ch)==false)
+                l_nxtTxn = l_front;
+        }
+    }//FRFCFS
+    else if(k_txnSchedulingPolicy == e_txnSchedulingPolicy::FRFCFS) {
+        c_IndexedTxn* l_rowHit = nullptr;
+        c_IndexedTxn* l_youngest = nullptr;
+
+        for(unsigned l_word=0; l_word<x_queue.pendingBanks.size(); l_word++) {
+            uint64_t l_banks = x_queue.pendingBanks[l_word];
+
+            while(l_banks) {
+                c_BankTxns& l_bank = x_queue.banks[l_word*64 + __builtin_ctzll(l_banks)];
+                l_banks &= l_banks-1;
+
+                const c_HashedAddress& l_addr = l_bank.txns.front()->txn->getHashedAddress();
+                if(m_cmdScheduler->getToken(l_addr) < 3)
+                    continue;
+
+                c_BankInfo *l_bankInfo = m_txnConverter->getBankInfo(l_addr.getBankId());
+
+                if(l_bankInfo->isRowOpen()) {
+                    auto l_row = l_bank.rows.find(l_bankInfo->getOpenRowNum());
+
+                    if(l_row != l_bank.rows.end()) {
+                        for(auto l_entry: l_row->second) {
+                            if(hasHazard(x_queue, l_entry, x_ch)==false) {
+                                if(l_rowHit==nullptr || l_entry->order < l_rowHit->order)
+                                    l_rowHit = l_entry;
+                                break;
+                            }
+                        }
+                    }
+                }
+
+                // only needed when no bank has a row hit
+                if(l_rowHit==nullptr) {
+                    for(auto l_itr = l_bank.txns.rbegin(); l_itr != l_bank.txns.rend(); ++l_itr) {
+                        if(hasHazard(x_queue, *l_itr, x_ch)==false) {
+                            if(l_youngest==nullptr || (*l_itr)->order > l_youngest->order)
+                                l_youngest = *l_itr;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        l_nxtTxn = (l_rowHit!=nullptr) ? l_rowHit : l_youngest;
+    }
+    else
+    {
+        printf("unsupported transaction scheduling policy.. exit(1)");
+        exit(1);
+    }
+
+    return l_nxtTxn;
+}
+
+
+void c_BankIndexedTxnScheduler::pushTxn(c_IndexedTxnQueue& x_queue, c_Transaction* x_txn)
+{
+    const c_HashedAddress& l_addr = x_txn->getHashedAddress();
+
+    c_IndexedTxn* l_entry = new c_IndexedTxn;
+    l_entry->txn = x_txn;
+    l_entry->order = x_queue.nextOrder++;
+    l_entry->bank = l_addr.getBankId() % m_numBanksPerChannel;
+    l_entry->row = l_addr.getRow();
+
+    c_BankTxns& l_bank = x_queue.banks[l_entry->bank];
+    c_IndexedTxnList& l_rowTxns = l_bank.rows[l_entry->row];
+    c_AddrChain& l_chain = x_queue.hazards[x_txn->getAddress()];
+
+    l_entry->fifoItr = x_queue.fifo.insert(x_queue.fifo.end(), l_entry);
+    l_entry->bankItr = l_bank.txns.insert(l_bank.txns.end(), l_entry);
+    l_entry->rowItr = l_rowTxns.insert(l_rowTxns.end(), l_entry);
+
+    if(l_chain.txns.empty())
+        l_chain.numWrites=0;
+    l_entry->addrItr = l_chain.txns.insert(l_chain.txns.end(), l_entry);
+    if(x_txn->isWrite())
+        l_chain.numWrites++;
+
+    x_queue.pendingBanks[l_entry->bank/64] |= ((uint64_t)1) << (l_entry->bank%64);
+}
+
+void c_BankIndexedTxnScheduler::removeTxn(c_IndexedTxnQueue& x_queue, c_IndexedTxn* x_entry)
+{
+    c_BankTxns& l_bank = x_queue.banks[x_entry->bank];
+
+    auto l_row = l_bank.rows.find(x_entry->row);
+    assert(l_row != l_bank.rows.end());
+    l_row->second.erase(x_entry->rowItr);
+    if(l_row->second.empty())
+        l_bank.rows.erase(l_row);
+
+    auto l_chain = x_queue.hazards.find(x_entry->txn->getAddress());
+    assert(l_chain != x_queue.hazards.end());
+    l_chain->second.txns.erase(x_entry->addrItr);
+    if(x_entry->txn->isWrite())
+        l_chain->second.numWrites--;
+    if(l_chain->second.txns.empty())
+        x_queue.hazards.erase(l_chain);
+
+    l_bank.txns.erase(x_entry->bankItr);
+    if(l_bank.txns.empty())
+        x_queue.pendingBanks[x_entry->bank/64] &= ~(((uint64_t)1) << (x_entry->bank%64));
+
+    x_queue.fifo.erase(x_entry->fifoItr);
+    delete x_entry;
+}
+
+bool c_BankIndexedTxnScheduler::push(c_Transaction* newTxn)
+{
+    int l_channelId=newTxn->getHashedAddress().getChannel();
+    c_IndexedTxnQueue* l_queue=nullptr;
+
+    if(!k_isReadFirstScheduling)
+        l_queue = &m_indexedTxnQ.at(l_channelId);
+    else if(newTxn->isRead())
+        l_queue = &m_indexedReadQ.at(l_channelId);
+    else
+        l_queue = &m_indexedWriteQ.at(l_channelId);
+
+    if(l_queue->fifo.size() >= k_numTxnQEntries)
+        return false;
+
+    pushTxn(*l_queue, newTxn);
+    return true;
+}
+
+
+bool c_BankIndexedTxnScheduler::isEmpty()
+{
+    for(auto l_queues: {&m_indexedTxnQ, &m_indexedReadQ, &m_indexedWriteQ}) {
+        for(auto &l_queue: *l_queues) {
+            if(!l_queue.fifo.empty())
+                return false;
+        }
+    }
+    return true;
+}
+
+
+//Check if read transactions get data from the transaction queue
+bool c_BankIndexedTxnScheduler::isHit(c_Transaction* x_txn)
+{
+    if(!x_txn->isRead())
+        return false;
+
+    int l_channelId=x_txn->getHashedAddress().getChannel();
+    c_IndexedTxnQueue* l_queue=nullptr;
+
+    if(!k_isReadFirstScheduling)
+        l_queue = &m_indexedTxnQ.at(l_channelId);
+    else
+        l_queue = &m_indexedWriteQ.at(l_channelId);
+
+    auto l_chain = l_queue->hazards.find(x_txn->getAddress());
+    return l_chain != l_queue->hazards.end() && l_chain->second.numWrites > 0;
+}
+
+// A transaction waits for any older transaction to the same address, in its own
+// queue or, with read-first scheduling, in the queue of the other type
+bool c_BankIndexedTxnScheduler::hasHazard(c_IndexedTxnQueue& x_queue, c_IndexedTxn* x_entry, int x_ch)
+{
+    c_IndexedTxnQueue* l_queue= nullptr;
+
+    if(!k_isReadFirstScheduling)
+        l_queue=&x_queue;
+    else
+    {
+        if(x_entry->txn->isRead())
+            l_queue = &m_indexedWriteQ[x_ch];
+        else
+            l_queue = &m_indexedReadQ[x_ch];
+    }
+
+    auto l_chain = l_queue->hazards.find(x_entry->txn->getAddress());
+    if(l_chain == l_queue->hazards.end())
+        return false;
+
+    return l_chain->second.txns.front()->txn->getSeqNum() < x_entry->txn->getSeqNum();
+}
@@ -0,0 +1,114 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef C_BANKINDEXEDTXNSCHEDULER_HPP
+#define C_BANKINDEXEDTXNSCHEDULER_HPP
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "c_TxnScheduler.hpp"
+
+namespace SST {
+    namespace CramSim {
+
+        // Transaction scheduler making the same choices as c_TxnScheduler, found
+        // through indexes instead of scans of the transaction queue:
+        //  - pending transactions are kept per bank, and per open-able row of each bank
+        //  - a bitmask marks the banks with pending transactions
+        //  - a hazard table keyed by address finds older transactions to the same address
+        // A scheduling decision costs time in the number of banks with work, not the
+        // number of queued transactions, which matters for deep (HBM) queues.
+        class c_BankIndexedTxnScheduler : public c_TxnScheduler {
+        public:
+
+            SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+                c_BankIndexedTxnScheduler,
+                "CramSim",
+                "c_BankIndexedTxnScheduler",
+                SST_ELI_ELEMENT_VERSION(1,0,0),
+                "Transaction Scheduler indexed by bank and row",
+                SST::CramSim::c_TxnScheduler
+            )
+
+            SST_ELI_DOCUMENT_PARAMS(
+                {"txnSchedulingPolicy", "Transaction scheduling policy", "FCFS"},
+                {"numTxnQEntries", "The number of transaction queue entries", "32"},
+                {"boolReadFirstTxnScheduling", "", "0"},
+                {"maxPendingWriteThreshold", "", "1.0"},
+                {"minPendingWriteThreshold", "", "0.2"},
+            )
+
+            c_BankIndexedTxnScheduler(SST::ComponentId_t id, SST::Params &x_params, Output* out, unsigned channels, c_TxnConverter* converter, c_CmdScheduler* scheduler);
+            ~c_BankIndexedTxnScheduler();
+
+            void run(SimTime_t simCycle) override;
+            bool push(c_Transaction* newTxn) override;
+            bool isHit(c_Transaction* newTxn) override;
+            bool isEmpty() override;
+
+        private:
+            struct c_IndexedTxn;
+            typedef std::list<c_IndexedTxn*> c_IndexedTxnList;
+
+            struct c_IndexedTxn {
+                c_Transaction* txn;
+                uint64_t order;     // arrival order in its queue
+                unsigned bank;      // bank within the channel
+                unsigned row;
+                c_IndexedTxnList::iterator fifoItr;
+                c_IndexedTxnList::iterator bankItr;
+                c_IndexedTxnList::iterator rowItr;
+                c_IndexedTxnList::iterator addrItr;
+            };
+
+            // pending transactions to one address, oldest first
+            struct c_AddrChain {
+                c_IndexedTxnList txns;
+                unsigned numWrites;
+            };
+
+            // pending transactions to one bank, oldest first, and the same split by row
+            struct c_BankTxns {
+                c_IndexedTxnList txns;
+                std::unordered_map<unsigned, c_IndexedTxnList> rows;
+            };
+
+            struct c_IndexedTxnQueue {
+                c_IndexedTxnList fifo;
+                std::vector<c_BankTxns> banks;
+                std::vector<uint64_t> pendingBanks;
+                std::unordered_map<ulong, c_AddrChain> hazards;
+                uint64_t nextOrder;
+            };
+
+            void initQueue(c_IndexedTxnQueue& x_queue);
+            void pushTxn(c_IndexedTxnQueue& x_queue, c_Transaction* x_txn);
+            void removeTxn(c_IndexedTxnQueue& x_queue, c_IndexedTxn* x_entry);
+            c_IndexedTxn* selectTxn(c_IndexedTxnQueue& x_queue, int x_ch);
+            bool hasHazard(c_IndexedTxnQueue& x_queue, c_IndexedTxn* x_entry, int x_ch);
+
+            //**per-channel indexed transaction queues, unified or split for read-first scheduling
+            std::vector<c_IndexedTxnQueue> m_indexedTxnQ;
+            std::vector<c_IndexedTxnQueue> m_indexedReadQ;
+            std::vector<c_IndexedTxnQueue> m_indexedWriteQ;
+
+            unsigned m_numBanksPerChannel;
+        };
+    }
+}
+
+#endif //C_BANKINDEXEDTXNSCHEDULER_HPP
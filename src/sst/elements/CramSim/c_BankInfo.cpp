@@ -27,6 +27,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #include <memory>
+#include <new>
 #include <assert.h>
 
 #include "sst_config.h"
@@ -35,32 +36,55 @@
 #include "c_BankInfo.hpp"
 #include "c_BankState.hpp"
 #include "c_BankStateIdle.hpp"
+#include "c_BankStateActivating.hpp"
+#include "c_BankStateActive.hpp"
+#include "c_BankStateRead.hpp"
+#include "c_BankStateReadA.hpp"
+#include "c_BankStateWrite.hpp"
+#include "c_BankStateWriteA.hpp"
+#include "c_BankStatePrecharge.hpp"
+#include "c_BankStateRefresh.hpp"
 #include "c_BankCommand.hpp"
 #include "c_BankGroup.hpp"
 
 using namespace SST;
 using namespace SST::CramSim;
 
+// Reconstructs a pooled state in place, or allocates it the first time its
+// slot is used. A slot only ever holds states of one type.
+template<class T>
+static c_BankState* recycleState(c_BankState* x_state,
+		std::map<std::string, unsigned>* x_bankParams) {
+	if (nullptr == x_state)
+		return (new T(x_bankParams));
+
+	x_state->~c_BankState();
+	return (new (x_state) T(x_bankParams));
+}
+
 c_BankInfo::c_BankInfo() :
-		m_bankState(new c_BankStateIdle(nullptr)) {
+		m_bankState(nullptr), m_bankParams(nullptr) {
 
 	reset();
+	m_bankState = acquireState(e_BankState::IDLE);
 	m_bankState->enter(this, nullptr, nullptr,0);
 }
 
 c_BankInfo::c_BankInfo(std::map<std::string, unsigned>* x_bankParams,
 		unsigned x_bankId) :
-		m_bankParams(x_bankParams), m_bankId(x_bankId), m_bankState(
-				new c_BankStateIdle(x_bankParams)),
+		m_bankParams(x_bankParams), m_bankId(x_bankId), m_bankState(nullptr),
                 m_autoPrechargeTimer(0) {
 
 	reset();
+	m_bankState = acquireState(e_BankState::IDLE);
 	m_bankState->enter(this, nullptr, nullptr,0);
 
 }
 c_BankInfo::~c_BankInfo() {
-	// if (nullptr != m_bankState)
-	// 	delete m_bankState;
+	for (unsigned l_i = 0; l_i < c_numBankStates; ++l_i) {
+		delete m_statePool[l_i][0];
+		delete m_statePool[l_i][1];
+	}
 }
 
 void c_BankInfo::print() {
@@ -98,28 +122,19 @@ void c_BankInfo::print() {
 	    break;
 	}
 	std::cout << "m_nextCommandCycleMap: " << std::endl;
-	for (auto l_mapEntry : m_nextCommandCycleMap) {
-		std::cout << m_cmdToString[l_mapEntry.first] << ":" << std::dec
-				<< l_mapEntry.second << std::endl;
+	for (unsigned l_i = 0; l_i < c_numBankCommandTypes; ++l_i) {
+		e_BankCommandType l_cmd = static_cast<e_BankCommandType>(l_i);
+		if (isTimedCommand(l_cmd))
+			std::cout << m_cmdToString[l_cmd] << ":" << std::dec
+					<< m_nextCommandCycle[l_i] << std::endl;
 	}
 }
 
 void c_BankInfo::reset() {
-	m_lastCommandCycleMap = { {e_BankCommandType::ACT,0},
-		{	e_BankCommandType::READ,0},
-		{	e_BankCommandType::READA,0},
-		{	e_BankCommandType::WRITE,0},
-		{	e_BankCommandType::WRITEA,0},
-		{	e_BankCommandType::PRE,0},
-		{	e_BankCommandType::REF,0}};
-
-	m_nextCommandCycleMap = { {e_BankCommandType::ACT,0},
-		{	e_BankCommandType::READ,0},
-		{	e_BankCommandType::READA,0},
-		{	e_BankCommandType::WRITE,0},
-		{	e_BankCommandType::WRITEA,0},
-		{	e_BankCommandType::PRE,0},
-		{	e_BankCommandType::REF, 0}};
+	for (unsigned l_i = 0; l_i < c_numBankCommandTypes; ++l_i) {
+		m_lastCommandCycle[l_i] = 0;
+		m_nextCommandCycle[l_i] = 0;
+	}
 
 	m_cmdToString[e_BankCommandType::ERR] = "ERR";
 	m_cmdToString[e_BankCommandType::ACT] = "ACT";
@@ -134,10 +149,9 @@ void c_BankInfo::reset() {
 
 void c_BankInfo::handleCommand(c_BankCommand* x_bankCommandPtr,
                                SimTime_t x_simCycle) {
+	assert(isTimedCommand(x_bankCommandPtr->getCommandMnemonic()));
 	assert(
-			m_nextCommandCycleMap.end() != m_nextCommandCycleMap.find(x_bankCommandPtr->getCommandMnemonic()));
-	assert(
-			x_simCycle >= m_nextCommandCycleMap[x_bankCommandPtr->getCommandMnemonic()]);
+			x_simCycle >= m_nextCommandCycle[static_cast<unsigned>(x_bankCommandPtr->getCommandMnemonic())]);
 
 
 	m_bankState->handleCommand(this, x_bankCommandPtr,x_simCycle);
@@ -152,6 +166,15 @@ void c_BankInfo::clockTic(SimTime_t x_cycle) {
 
 }
 
+void c_BankInfo::skipCycles(SimTime_t x_cycles) {
+	assert(isQuiescent());
+
+	if (x_cycles < m_autoPrechargeTimer)
+		m_autoPrechargeTimer -= x_cycles;
+	else
+		m_autoPrechargeTimer = 0;
+}
+
 std::list<e_BankCommandType> c_BankInfo::getAllowedCommands() {
 	return m_bankState->getAllowedCommands();
 }
@@ -162,8 +185,8 @@ bool c_BankInfo::isCommandAllowed(c_BankCommand* x_cmdPtr,
 	assert(nullptr != m_bankState);
 
 	if (m_bankState->isCommandAllowed(x_cmdPtr, this)) {
-		assert(m_nextCommandCycleMap.find(x_cmdPtr->getCommandMnemonic()) != m_nextCommandCycleMap.end());
-		if (m_nextCommandCycleMap.find(x_cmdPtr->getCommandMnemonic())->second <= x_simCycle)
+		assert(isTimedCommand(x_cmdPtr->getCommandMnemonic()));
+		if (m_nextCommandCycle[static_cast<unsigned>(x_cmdPtr->getCommandMnemonic())] <= x_simCycle)
 			l_canAccept = true;
 
 
@@ -177,26 +200,94 @@ void c_BankInfo::changeState(c_BankState* x_newState) {
 		m_bankState = x_newState;
 }
 
+c_BankState* c_BankInfo::acquireState(e_BankState x_state) {
+	unsigned l_type = static_cast<unsigned>(x_state);
+	assert(l_type < c_numBankStates);
+
+	// take the slot holding neither the current state nor a prepared next state
+	unsigned l_slot = 0;
+	if ((m_statePool[l_type][0] == m_bankState)
+			|| (m_statePool[l_type][0] == m_lastAcquiredState))
+		l_slot = 1;
+	c_BankState* l_state = m_statePool[l_type][l_slot];
+	assert((nullptr == l_state)
+			|| ((l_state != m_bankState) && (l_state != m_lastAcquiredState)));
+
+	switch (x_state) {
+	case e_BankState::IDLE:
+		l_state = recycleState<c_BankStateIdle>(l_state, m_bankParams);
+		break;
+	case e_BankState::ACTNG:
+		l_state = recycleState<c_BankStateActivating>(l_state, m_bankParams);
+		break;
+	case e_BankState::ACTIVE:
+		l_state = recycleState<c_BankStateActive>(l_state, m_bankParams);
+		break;
+	case e_BankState::READ:
+		l_state = recycleState<c_BankStateRead>(l_state, m_bankParams);
+		break;
+	case e_BankState::READA:
+		l_state = recycleState<c_BankStateReadA>(l_state, m_bankParams);
+		break;
+	case e_BankState::WRITE:
+		l_state = recycleState<c_BankStateWrite>(l_state, m_bankParams);
+		break;
+	case e_BankState::WRITEA:
+		l_state = recycleState<c_BankStateWriteA>(l_state, m_bankParams);
+		break;
+	case e_BankState::PRE:
+		l_state = recycleState<c_BankStatePrecharge>(l_state, m_bankParams);
+		break;
+	case e_BankState::REF:
+		l_state = recycleState<c_BankStateRefresh>(l_state, m_bankParams);
+		break;
+	default:
+		std::cout << __PRETTY_FUNCTION__ << ": Unrecognized state"
+				<< std::endl;
+		exit(-1);
+		break;
+	}
+
+	m_statePool[l_type][l_slot] = l_state;
+	m_lastAcquiredState = l_state;
+	return (l_state);
+}
+
+bool c_BankInfo::isTimedCommand(e_BankCommandType x_cmd) {
+	switch (x_cmd) {
+	case e_BankCommandType::ACT:
+	case e_BankCommandType::READ:
+	case e_BankCommandType::READA:
+	case e_BankCommandType::WRITE:
+	case e_BankCommandType::WRITEA:
+	case e_BankCommandType::PRE:
+	case e_BankCommandType::REF:
+		return true;
+	default:
+		return false;
+	}
+}
+
 void c_BankInfo::setNextCommandCycle(const e_BankCommandType x_cmd,
 		const SimTime_t x_cycle) {
-	assert(m_nextCommandCycleMap.end() != m_nextCommandCycleMap.find(x_cmd));
-	m_nextCommandCycleMap[x_cmd] = x_cycle;
+	assert(isTimedCommand(x_cmd));
+	m_nextCommandCycle[static_cast<unsigned>(x_cmd)] = x_cycle;
 }
 
 SimTime_t c_BankInfo::getNextCommandCycle(e_BankCommandType x_cmd) {
-	assert(m_nextCommandCycleMap.end() != m_nextCommandCycleMap.find(x_cmd));
-	return (m_nextCommandCycleMap[x_cmd]);
+	assert(isTimedCommand(x_cmd));
+	return (m_nextCommandCycle[static_cast<unsigned>(x_cmd)]);
 }
 
 void c_BankInfo::setLastCommandCycle(e_BankCommandType x_cmd,
                                      SimTime_t x_lastCycle) {
-	assert(m_lastCommandCycleMap.end() != m_lastCommandCycleMap.find(x_cmd));
-	m_lastCommandCycleMap[x_cmd] = x_lastCycle;
+	assert(isTimedCommand(x_cmd));
+	m_lastCommandCycle[static_cast<unsigned>(x_cmd)] = x_lastCycle;
 }
 
 SimTime_t c_BankInfo::getLastCommandCycle(e_BankCommandType x_cmd) {
-	assert(m_lastCommandCycleMap.end() != m_lastCommandCycleMap.find(x_cmd));
-	return m_lastCommandCycleMap[x_cmd];
+	assert(isTimedCommand(x_cmd));
+	return m_lastCommandCycle[static_cast<unsigned>(x_cmd)];
 }
 
 void c_BankInfo::acceptBankGroup(c_BankGroup* x_bankGroupPtr) {
@@ -36,13 +36,12 @@
 
 // CramSim includes
 #include "c_BankState.hpp"
+#include "c_BankCommand.hpp"
 
 namespace SST {
 namespace CramSim {
 
 class c_BankGroup;
-class c_BankCommand;
-enum class e_BankCommandType;
 
 class c_BankInfo {
 public:
@@ -57,6 +56,13 @@ public:
 
 	void clockTic(SimTime_t x_cycle);
 
+	// used by skip-ahead clocking: a quiescent bank only counts down its
+	// auto-precharge timer until it receives a command
+	bool isQuiescent() {
+		return (m_bankState->isQuiescent());
+	}
+	void skipCycles(SimTime_t x_cycles);
+
 	std::list<e_BankCommandType> getAllowedCommands();
 
 	bool isCommandAllowed(c_BankCommand* x_cmdPtr, SimTime_t x_simCycle);
@@ -67,6 +73,11 @@ public:
 
 	void changeState(c_BankState* x_newState);
 
+	// Returns a freshly constructed state of type x_state for the bank to
+	// move to. States are recycled from a per-bank pool instead of being
+	// allocated on every transition.
+	c_BankState* acquireState(e_BankState x_state);
+
 	void setNextCommandCycle(const e_BankCommandType x_cmd,
 			const SimTime_t x_cycle);
 	SimTime_t getNextCommandCycle(e_BankCommandType x_cmd);
@@ -120,9 +131,21 @@ private:
 	c_BankState* m_bankState;
 	c_BankGroup* m_bankGroupPtr;
 
+	static bool isTimedCommand(e_BankCommandType x_cmd);
+
+	// At most two states of a bank are live at a time: the current state and
+	// the next state it has prepared. Two slots per state type are enough.
+	static const unsigned c_numBankStates = static_cast<unsigned>(e_BankState::REF) + 1;
+	c_BankState* m_statePool[c_numBankStates][2] = {};
+	c_BankState* m_lastAcquiredState = nullptr;
+
 	std::map<std::string, unsigned>* m_bankParams;
-	std::map<e_BankCommandType, SimTime_t> m_lastCommandCycleMap;
-	std::map<e_BankCommandType, SimTime_t> m_nextCommandCycleMap;
+
+	// indexed by e_BankCommandType, only ACT, READ, READA, WRITE, WRITEA, PRE
+	// and REF are tracked
+	static const unsigned c_numBankCommandTypes = static_cast<unsigned>(e_BankCommandType::PDE) + 1;
+	SimTime_t m_lastCommandCycle[c_numBankCommandTypes];
+	SimTime_t m_nextCommandCycle[c_numBankCommandTypes];
 
 	//TESTING -- DELETE
 	std::map<e_BankCommandType, std::string> m_cmdToString;
@@ -33,6 +33,8 @@
 #include <memory>
 #include <list>
 #include <map>
+#include <stdint.h>
+#include <assert.h>
 
 #include <sst/core/simulation.h>
 
@@ -53,6 +55,46 @@ enum class e_BankState {
 };
 // NONE state is for the startup situation when IDLE state is entered.
 
+// Set of bank command types, one bit per type. Used for the commands a
+// state allows, which every state rebuilds on entry, so a transition does
+// not allocate list nodes.
+class c_BankCommandSet {
+public:
+	c_BankCommandSet() :
+			m_bits(0) {
+	}
+
+	void clear() {
+		m_bits = 0;
+	}
+
+	void push_back(e_BankCommandType x_cmd) {
+		m_bits |= bit(x_cmd);
+	}
+
+	bool contains(e_BankCommandType x_cmd) const {
+		return (0 != (m_bits & bit(x_cmd)));
+	}
+
+	// members in enum order
+	std::list<e_BankCommandType> toList() const {
+		std::list<e_BankCommandType> l_list;
+		for (unsigned l_i = 0; l_i < 32; ++l_i) {
+			if (0 != (m_bits & (1u << l_i)))
+				l_list.push_back(static_cast<e_BankCommandType>(l_i));
+		}
+		return (l_list);
+	}
+
+private:
+	static uint32_t bit(e_BankCommandType x_cmd) {
+		assert(static_cast<unsigned>(x_cmd) < 32);
+		return (1u << static_cast<unsigned>(x_cmd));
+	}
+
+	uint32_t m_bits;
+};
+
 
 
 class c_BankState {
@@ -72,6 +114,11 @@ public:
 	virtual bool isCommandAllowed(c_BankCommand* x_cmdPtr,
 			c_BankInfo* x_bankPtr) = 0;
 
+	// true if clockTic() cannot change anything until the bank receives a command
+	virtual bool isQuiescent() {
+		return false;
+	}
+
 	e_BankState getCurrentState() {
 		return m_currentState;
 	}
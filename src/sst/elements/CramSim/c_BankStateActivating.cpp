@@ -70,7 +70,7 @@ void c_BankStateActivating::clockTic(c_BankInfo* x_bank, SimTime_t x_cycle) {
 		--m_timer;
 
 	} else {
-		auto l_p = new c_BankStateActive(m_bankParams); // create pointer to the next state
+		auto l_p = x_bank->acquireState(e_BankState::ACTIVE); // create pointer to the next state
 		assert(e_BankCommandType::ACT == m_prevCommandPtr->getCommandMnemonic()); // only cmd allowed to flow through to BankStateActive is ACT
 		l_p->enter(x_bank, this, m_prevCommandPtr, x_cycle);
 	}
@@ -95,12 +95,10 @@ void c_BankStateActivating::enter(c_BankInfo* x_bank,
 	// this is a transitory state
 
 	x_bank->changeState(this);
-	if (nullptr != x_prevState)
-		delete x_prevState;
 }
 
 std::list<e_BankCommandType> c_BankStateActivating::getAllowedCommands() {
-	return (m_allowedCommands);
+	return (m_allowedCommands.toList());
 }
 
 
@@ -108,13 +106,7 @@ bool c_BankStateActivating::isCommandAllowed(c_BankCommand* x_cmdPtr,
 		c_BankInfo* x_bankPtr) {
 
 	// Cmd must be of an allowed type and BankState cannot already be processing another cmd
-	for (std::list<e_BankCommandType>::iterator l_iter =
-			m_allowedCommands.begin(); l_iter != m_allowedCommands.end(); ++l_iter) {
-
-		if (x_cmdPtr->getCommandMnemonic() == *l_iter && m_receivedCommandPtr
-				== nullptr)
-			return true;
-	}
-	return false;
+	return (m_allowedCommands.contains(x_cmdPtr->getCommandMnemonic())
+			&& m_receivedCommandPtr == nullptr);
 
 }
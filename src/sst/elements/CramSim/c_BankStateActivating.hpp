@@ -68,7 +68,7 @@ private:
 
 	c_BankCommand* m_prevCommandPtr;
 	c_BankCommand* m_receivedCommandPtr;
-	std::list<e_BankCommandType> m_allowedCommands;
+	c_BankCommandSet m_allowedCommands;
 
 };
 }
@@ -77,23 +77,23 @@ void c_BankStateActive::handleCommand(c_BankInfo* x_bank,
 		m_nextStatePtr = nullptr;
 		switch (m_receivedCommandPtr->getCommandMnemonic()) {
 		case e_BankCommandType::READ:
-			m_nextStatePtr = new c_BankStateRead(m_bankParams);
+			m_nextStatePtr = x_bank->acquireState(e_BankState::READ);
 			x_bank->setLastCommandCycle(e_BankCommandType::READ, l_time);
 			break;
 		case e_BankCommandType::READA:
-			m_nextStatePtr = new c_BankStateReadA(m_bankParams);
+			m_nextStatePtr = x_bank->acquireState(e_BankState::READA);
 			x_bank->setLastCommandCycle(e_BankCommandType::READA, l_time);
 			break;
 		case e_BankCommandType::WRITE:
-			m_nextStatePtr = new c_BankStateWrite(m_bankParams);
+			m_nextStatePtr = x_bank->acquireState(e_BankState::WRITE);
 			x_bank->setLastCommandCycle(e_BankCommandType::WRITE, l_time);
 			break;
 		case e_BankCommandType::WRITEA:
-			m_nextStatePtr = new c_BankStateWriteA(m_bankParams);
+			m_nextStatePtr = x_bank->acquireState(e_BankState::WRITEA);
 			x_bank->setLastCommandCycle(e_BankCommandType::WRITEA, l_time);
 			break;
 		case e_BankCommandType::PRE:
-			m_nextStatePtr = new c_BankStatePrecharge(m_bankParams);
+			m_nextStatePtr = x_bank->acquireState(e_BankState::PRE);
 			x_bank->setLastCommandCycle(e_BankCommandType::PRE, l_time);
 			break;
 		default:
@@ -179,26 +179,17 @@ void c_BankStateActive::enter(c_BankInfo* x_bank, c_BankState* x_prevState,
 								+ m_bankParams->at("nRTP"))))));
 
 	x_bank->changeState(this);
-	if (nullptr != x_prevState)
-		delete x_prevState;
 }
 
 std::list<e_BankCommandType> c_BankStateActive::getAllowedCommands() {
-	return (m_allowedCommands);
+	return (m_allowedCommands.toList());
 }
 
 bool c_BankStateActive::isCommandAllowed(c_BankCommand* x_cmdPtr,
 		c_BankInfo* x_bankPtr) {
 
 // Cmd must be of an allowed type and BankState cannot already be processing another cmd
-	for (std::list<e_BankCommandType>::iterator l_iter =
-			m_allowedCommands.begin(); l_iter != m_allowedCommands.end();
-			++l_iter) {
-
-		if (x_cmdPtr->getCommandMnemonic() == *l_iter
-				&& m_receivedCommandPtr == nullptr)
-			return true;
-	}
-	return false;
+	return (m_allowedCommands.contains(x_cmdPtr->getCommandMnemonic())
+			&& m_receivedCommandPtr == nullptr);
 
 }
@@ -61,9 +61,13 @@ public:
 	virtual bool isCommandAllowed(c_BankCommand* x_cmdPtr,
 			c_BankInfo* x_bankPtr);
 
+	virtual bool isQuiescent() {
+		return ((nullptr == m_receivedCommandPtr) && (0 == m_timer));
+	}
+
 private:
 
-	std::list<e_BankCommandType> m_allowedCommands;
+	c_BankCommandSet m_allowedCommands;
 	c_BankCommand* m_receivedCommandPtr; //<! pointer to command received after entering this state
 	c_BankCommand* m_prevCommandPtr;
 	c_BankState* m_nextStatePtr;
@@ -83,7 +83,7 @@ void c_BankStateIdle::handleCommand(c_BankInfo* x_bank, c_BankCommand* x_bankCom
 
 // returns the list of allowed commands in this state
 std::list<e_BankCommandType> c_BankStateIdle::getAllowedCommands() {
-	return (m_allowedCommands);
+	return (m_allowedCommands.toList());
 }
 
 // call this function every clock cycle
@@ -105,13 +105,13 @@ void c_BankStateIdle::clockTic(c_BankInfo* x_bank, SimTime_t x_cycle) {
 				c_BankState* l_p = nullptr;
 				switch (m_receivedCommandPtr->getCommandMnemonic()) {
 				case e_BankCommandType::ACT:
-					l_p = new c_BankStateActivating(m_bankParams);
+					l_p = x_bank->acquireState(e_BankState::ACTNG);
 					break;
 				case e_BankCommandType::REF:
-					l_p = new c_BankStateRefresh(m_bankParams);
+					l_p = x_bank->acquireState(e_BankState::REF);
 					break;
 					case e_BankCommandType::PRE:
-						l_p = new c_BankStatePrecharge(m_bankParams);
+						l_p = x_bank->acquireState(e_BankState::PRE);
 						break;
 				default:
 				break;
@@ -155,23 +155,13 @@ void c_BankStateIdle::enter(c_BankInfo* x_bank, c_BankState* x_prevState,
 										 l_time));
 
 	x_bank->changeState(this);
-
-	if (nullptr != x_prevState)
-		delete x_prevState;
 }
 
 bool c_BankStateIdle::isCommandAllowed(c_BankCommand* x_cmdPtr,
 		c_BankInfo* x_bankPtr) {
 
 // Cmd must be of an allowed type and BankState cannot already be processing another cmd
-	for (std::list<e_BankCommandType>::iterator l_iter =
-			m_allowedCommands.begin(); l_iter != m_allowedCommands.end();
-			++l_iter) {
-
-		if (x_cmdPtr->getCommandMnemonic() == *l_iter
-				&& m_receivedCommandPtr == nullptr)
-			return true;
-	}
-	return false;
+	return (m_allowedCommands.contains(x_cmdPtr->getCommandMnemonic())
+			&& m_receivedCommandPtr == nullptr);
 
 }
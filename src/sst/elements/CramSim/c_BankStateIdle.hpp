@@ -60,10 +60,14 @@ public:
 	virtual bool isCommandAllowed(c_BankCommand* x_cmdPtr,
 			c_BankInfo* x_bankPtr);
 
+	virtual bool isQuiescent() {
+		return (nullptr == m_receivedCommandPtr);
+	}
+
 private:
 
 
-	std::list<e_BankCommandType> m_allowedCommands;
+	c_BankCommandSet m_allowedCommands;
 	c_BankCommand* m_prevCommandPtr;
 	c_BankCommand* m_receivedCommandPtr;
 	SimTime_t m_timer;
@@ -74,7 +74,7 @@ void c_BankStatePrecharge::clockTic(c_BankInfo* x_bank, SimTime_t x_cycle) {
 		if (m_prevCommandPtr) {
 			m_prevCommandPtr->setResponseReady();
 		}
-		auto l_p = new c_BankStateIdle(m_bankParams);
+		auto l_p = x_bank->acquireState(e_BankState::IDLE);
 		l_p->enter(x_bank, this, nullptr, x_cycle);
 	}
 }
@@ -94,27 +94,18 @@ void c_BankStatePrecharge::enter(c_BankInfo* x_bank, c_BankState* x_prevState,
 // this is a transitory state
 
 	x_bank->changeState(this);
-	if (nullptr != x_prevState)
-		delete x_prevState;
 
 }
 
 std::list<e_BankCommandType> c_BankStatePrecharge::getAllowedCommands() {
-	return (m_allowedCommands);
+	return (m_allowedCommands.toList());
 }
 
 bool c_BankStatePrecharge::isCommandAllowed(c_BankCommand* x_cmdPtr,
 		c_BankInfo* x_bankPtr) {
 
 // Cmd must be of an allowed type and BankState cannot already be processing another cmd
-	for (std::list<e_BankCommandType>::iterator l_iter =
-			m_allowedCommands.begin(); l_iter != m_allowedCommands.end();
-			++l_iter) {
-
-		if (x_cmdPtr->getCommandMnemonic() == *l_iter
-				&& m_receivedCommandPtr == nullptr)
-			return true;
-	}
-	return false;
+	return (m_allowedCommands.contains(x_cmdPtr->getCommandMnemonic())
+			&& m_receivedCommandPtr == nullptr);
 
 }
@@ -66,7 +66,7 @@ private:
 	SimTime_t m_timer; //<! counts down to 0. when 0, changes state to IDLE automatically. is reset to ?? at state entry.
 	c_BankCommand* m_receivedCommandPtr; //<! pointer to a received command
 	c_BankCommand* m_prevCommandPtr;
-	std::list<e_BankCommandType> m_allowedCommands;
+	c_BankCommandSet m_allowedCommands;
 
 };
 
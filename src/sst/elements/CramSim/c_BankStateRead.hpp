@@ -64,7 +64,7 @@ private:
 	SimTime_t m_timerExit; // counts down to 0 during state exit
 
 private:
-	std::list<e_BankCommandType> m_allowedCommands;
+	c_BankCommandSet m_allowedCommands;
 	c_BankCommand* m_receivedCommandPtr;
 	c_BankCommand* m_prevCommandPtr;
 	c_BankState* m_nextStatePtr;
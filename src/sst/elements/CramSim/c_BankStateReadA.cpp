@@ -72,7 +72,7 @@ void c_BankStateReadA::clockTic(c_BankInfo* x_bank, SimTime_t x_cycle) {
 	} else {
 		if (0 == m_timerExit) {
 			SimTime_t l_time = x_cycle;
-			m_nextStatePtr = new c_BankStatePrecharge(m_bankParams);
+			m_nextStatePtr = x_bank->acquireState(e_BankState::PRE);
 			x_bank->setLastCommandCycle(e_BankCommandType::PRE, l_time);
 			SimTime_t l_nextCycle = std::max(
 					x_bank->getNextCommandCycle(e_BankCommandType::PRE),
@@ -166,13 +166,11 @@ void c_BankStateReadA::enter(c_BankInfo* x_bank, c_BankState* x_prevState,
 											+ m_bankParams->at("nRTP"))))) - 1);
 
 	x_bank->changeState(this);
-	if (nullptr != x_prevState)
-		delete x_prevState;
 
 }
 
 std::list<e_BankCommandType> c_BankStateReadA::getAllowedCommands() {
-	return (m_allowedCommands);
+	return (m_allowedCommands.toList());
 }
 
 bool c_BankStateReadA::isCommandAllowed(c_BankCommand* x_cmdPtr,
@@ -67,7 +67,7 @@ void c_BankStateRefresh::handleCommand(c_BankInfo* x_bank,
 
 // returns the list of allowed commands in this state
 std::list<e_BankCommandType> c_BankStateRefresh::getAllowedCommands() {
-	return (m_allowedCommands);
+	return (m_allowedCommands.toList());
 }
 
 // call this function every clock cycle
@@ -77,7 +77,7 @@ void c_BankStateRefresh::clockTic(c_BankInfo* x_bank, SimTime_t x_cycle) {
 
 	} else {
 
-		auto l_p = new c_BankStateIdle(m_bankParams); // create pointer to the next state
+		auto l_p = x_bank->acquireState(e_BankState::IDLE); // create pointer to the next state
 		assert(
 				e_BankCommandType::REF == m_prevCommandPtr->getCommandMnemonic());
 		// only cmd allowed to flow through to BankStateActive is ACT
@@ -109,8 +109,6 @@ void c_BankStateRefresh::enter(c_BankInfo* x_bank, c_BankState* x_prevState,
 					l_time + m_bankParams->at("nREFI"))-1);
 
 	x_bank->changeState(this);
-	if (nullptr != x_prevState)
-		delete x_prevState;
 }
 
 bool c_BankStateRefresh::isCommandAllowed(c_BankCommand* x_cmdPtr,
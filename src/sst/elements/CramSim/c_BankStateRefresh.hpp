@@ -63,7 +63,7 @@ public:
 private:
 
 
-	std::list<e_BankCommandType> m_allowedCommands;
+	c_BankCommandSet m_allowedCommands;
 	c_BankCommand* m_receivedCommandPtr;
 	c_BankCommand* m_prevCommandPtr;
 	SimTime_t m_timer;
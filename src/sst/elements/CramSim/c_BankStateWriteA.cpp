@@ -156,16 +156,14 @@ void c_BankStateWriteA::enter(c_BankInfo* x_bank, c_BankState* x_prevState,
 							+ m_bankParams->at("nCWL") + m_bankParams->at("nBL")
 							+ m_bankParams->at("nWR"))-2);
 
-	m_nextStatePtr = new c_BankStatePrecharge(m_bankParams);
+	m_nextStatePtr = x_bank->acquireState(e_BankState::PRE);
 
 	x_bank->changeState(this);
-	if (nullptr != x_prevState)
-		delete x_prevState;
 
 }
 
 std::list<e_BankCommandType> c_BankStateWriteA::getAllowedCommands() {
-	return (m_allowedCommands);
+	return (m_allowedCommands.toList());
 }
 
 bool c_BankStateWriteA::isCommandAllowed(c_BankCommand* x_cmdPtr,
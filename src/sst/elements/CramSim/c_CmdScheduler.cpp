@@ -92,6 +92,28 @@ c_CmdScheduler::~c_CmdScheduler(){
 
 
 
+bool c_CmdScheduler::isEmpty() {
+    for (auto &l_chQueues : m_cmdQueues)
+        for (auto &l_cmdQueue : l_chQueues)
+            if (!l_cmdQueue.empty())
+                return false;
+    return true;
+}
+
+
+// run() with empty queues only moves the round-robin pointers
+void c_CmdScheduler::skipIdleCycles(SimTime_t x_cycles) {
+    assert(isEmpty());
+
+    for (auto &l_idx : m_nextCmdQIdx) {
+        if (m_schedulingPolicy == e_SchedulingPolicy::BANK)
+            l_idx = (l_idx + x_cycles % m_numBanksPerChannel) % m_numBanksPerChannel;
+        else if (m_schedulingPolicy == e_SchedulingPolicy::RANK)
+            l_idx = (l_idx + (x_cycles % (m_numBanksPerChannel - 1)) * m_numBanksPerRank) % (m_numBanksPerChannel - 1);
+    }
+}
+
+
 void c_CmdScheduler::run(SimTime_t simCycle){
 
     bool isSuccess = false;
@@ -72,6 +72,9 @@ namespace SST{
             void run(SimTime_t simCycle);
             bool push(c_BankCommand* x_cmd);
             unsigned getToken(const c_HashedAddress &x_addr);
+            unsigned getNumBanksPerChannel() {return m_numBanksPerChannel;}
+            bool isEmpty();
+            void skipIdleCycles(SimTime_t x_cycles);
 
 
         private:
@@ -29,6 +29,8 @@
 
 #include "sst_config.h"
 
+#include <limits>
+
 #include "c_Controller.hpp"
 #include "c_TxnReqEvent.hpp"
 #include "c_TxnResEvent.hpp"
@@ -118,16 +120,21 @@ c_Controller::c_Controller(ComponentId_t id, Params &params) :
                   << std::endl;
     }
 
+    k_skipIdleCycles = params.find<bool>("boolSkipIdleCycles", false);
+
     // get configured clock frequency
     k_controllerClockFreqStr = (std::string)params.find<std::string>("strControllerClockFrequency", "1GHz", l_found);
 
+    //set our clock
+    m_clockHandler = new Clock::Handler<c_Controller>(this, &c_Controller::clockTic);
+    m_clockTC = registerClock(k_controllerClockFreqStr, m_clockHandler);
+    m_clockOn = true;
+    m_wasIdle = false;
+    m_lastClockCycle = 0;
+
     //configure SST link
     configure_link();
 
-    //set our clock
-    registerClock(k_controllerClockFreqStr,
-                  new Clock::Handler<c_Controller>(this, &c_Controller::clockTic));
-
 
 
 }
@@ -149,6 +156,10 @@ void c_Controller::configure_link() {
     m_memLink = configureLink("memLink",
                                        new Event::Handler<c_Controller>(this,
                                                                         &c_Controller::handleInDeviceResPtrEvent));
+    // Controller -> Controller, in controller cycles
+    m_wakeupLink = configureSelfLink("wakeupLink", m_clockTC,
+                                     new Event::Handler<c_Controller>(this,
+                                                                      &c_Controller::handleWakeup));
 }
 
 
@@ -221,11 +232,65 @@ bool c_Controller::clockTic(SST::Cycle_t clock) {
     // 6. run device driver
     m_deviceDriver->run();
 
+    // 7. stop the clock once a whole cycle has gone by without work. Until a
+    // transaction arrives, the only change left is the next refresh. A
+    // controller with queued work keeps ticking even when every command is
+    // waiting on bank timing; the scheduler state advances every cycle.
+    if (k_skipIdleCycles) {
+        bool l_isIdle = isIdle();
+
+        if (l_isIdle && m_wasIdle) {
+            SimTime_t l_skippable = m_deviceDriver->getNumSkippableCycles();
+
+            if (l_skippable > 0) {
+                if (l_skippable != std::numeric_limits<SimTime_t>::max())
+                    m_wakeupLink->send(l_skippable, nullptr);
+
+                m_lastClockCycle = clock;
+                m_clockOn = false;
+                return true;
+            }
+        }
+        m_wasIdle = l_isIdle;
+    }
 
     return false;
 }
 
 
+bool c_Controller::isIdle() {
+    return m_ReqQ.empty() && m_ResQ.empty()
+           && m_txnScheduler->isEmpty()
+           && m_txnConverter->isEmpty()
+           && m_cmdScheduler->isEmpty()
+           && m_deviceDriver->isIdle();
+}
+
+
+// Restart the clock, first bringing the pipeline up to date with the cycles
+// that were skipped. Each of them would have been an idle cycle.
+void c_Controller::turnClockOn() {
+    if (m_clockOn)
+        return;
+
+    Cycle_t l_nextCycle = reregisterClock(m_clockTC, m_clockHandler);
+    SimTime_t l_skipped = l_nextCycle - 1 - m_lastClockCycle;
+
+    m_simCycle += l_skipped;
+    m_txnConverter->skipIdleCycles(l_skipped);
+    m_cmdScheduler->skipIdleCycles(l_skipped);
+    m_deviceDriver->skipIdleCycles(l_skipped);
+
+    m_clockOn = true;
+}
+
+
+void c_Controller::handleWakeup(SST::Event *ev) {
+    // a stale wakeup only costs one idle cycle
+    turnClockOn();
+}
+
+
 void c_Controller::sendCommand(c_BankCommand* cmd)
 {
      c_CmdReqEvent *l_cmdReqEventPtr = new c_CmdReqEvent();
@@ -271,6 +336,8 @@ void c_Controller::handleIncomingTransaction(SST::Event *ev){
     c_TxnReqEvent* l_txnReqEventPtr = dynamic_cast<c_TxnReqEvent*>(ev);
 
     if (l_txnReqEventPtr) {
+        turnClockOn();
+
         c_Transaction* newTxn=l_txnReqEventPtr->m_payload;
 
         #ifdef __SST_DEBUG_OUTPUT__
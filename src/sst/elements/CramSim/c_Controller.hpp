@@ -65,7 +65,8 @@ namespace SST {
 
             SST_ELI_DOCUMENT_PARAMS(
                 {"verbose", "Output verbosity", "0"},
-                {"strControllerClockFrequency", "Controller clock frequency, with units", "1GHz" }
+                {"strControllerClockFrequency", "Controller clock frequency, with units", "1GHz" },
+                {"boolSkipIdleCycles", "Stop the clock while the controller is completely idle (no queued transaction or command, every bank quiescent), until a transaction arrives or a refresh is due. Cycles where work is only waiting on bank timing are still clocked, 1: enable, 0: disable (default)", "0"}
             )
 
             SST_ELI_DOCUMENT_PORTS(
@@ -111,6 +112,11 @@ namespace SST {
             // Controller <--> memory devices
             void handleInDeviceResPtrEvent(SST::Event *ev);
 
+            // skip-ahead clocking
+            bool isIdle();
+            void turnClockOn();
+            void handleWakeup(SST::Event *ev);
+
             SimTime_t m_simCycle;
 
             SST::Output *output;
@@ -127,6 +133,7 @@ namespace SST {
 
             // params for system configuration
             int k_enableQuickResponse;
+            bool k_skipIdleCycles;
 
 		    // clock frequency
 			std::string k_controllerClockFreqStr;
@@ -135,6 +142,14 @@ namespace SST {
             SST::Link *m_txngenLink;
             // Controller <-> Memory device Links
             SST::Link *m_memLink;
+
+            // Clock handler, and a self link to restart the clock when a refresh is due
+            Clock::HandlerBase *m_clockHandler;
+            TimeConverter *m_clockTC;
+            SST::Link *m_wakeupLink;
+            bool m_clockOn;
+            bool m_wasIdle;
+            Cycle_t m_lastClockCycle;   // last cycle clockTic() ran before the clock was stopped
         };
     }
 }
@@ -38,6 +38,7 @@
 #include <vector>
 #include <list>
 #include <algorithm>
+#include <limits>
 #include <assert.h>
 
 // CramSim includes
@@ -463,21 +464,14 @@ void c_DeviceDriver::update(SimTime_t simCycle) {
 		// m_banks.at(l_i)->printState();
 	}
 	//update ACTFAWTracker info
-	for (int l_rankNum = 0; l_rankNum < m_numRanks; l_rankNum++) {
-		m_cmdACTFAWtrackers[l_rankNum].push_back(
-				m_isACTIssued[l_rankNum] ? static_cast<unsigned>(1) : static_cast<unsigned>(0));
-		m_cmdACTFAWtrackers[l_rankNum].pop_front();
-	}
+	shiftACTFAWTracker(m_isACTIssued);
 
 	// do the member var setup up before calling any req sending policy function
-	if (m_inflightWrites.size() > 0)
-		m_inflightWrites.clear();
+	m_inflightWrites.clear();
 
-	m_blockBank.clear();
-	m_blockBank.resize(m_numBanks, false);
+	std::fill(m_blockBank.begin(), m_blockBank.end(), false);
 	releaseCommandBus();  //update the command bus status
-	m_isACTIssued.clear();
-	m_isACTIssued.resize(m_numRanks, false);
+	std::fill(m_isACTIssued.begin(), m_isACTIssued.end(), false);
 }
 
 
@@ -488,6 +482,74 @@ void c_DeviceDriver::update(SimTime_t simCycle) {
  * @param x_bankCommandPtr
  * @return
  */
+/*!
+ *
+ * @return "true" if no command is queued or in flight and no bank can change
+ * state before it receives a new command
+ */
+bool c_DeviceDriver::isIdle() {
+	if (!m_inputQ.empty() || !m_outputQ.empty())
+		return false;
+
+	for (auto &l_cmdQ : m_refreshCmdQ)
+		if (!l_cmdQ.empty())
+			return false;
+
+	for (auto &l_bank : m_banks)
+		if (!l_bank->isQuiescent())
+			return false;
+
+	return true;
+}
+
+/*!
+ *
+ * @return the number of cycles an idle driver can skip before the next
+ * refresh command has to be created. Only valid when isIdle(); banks with
+ * pending commands are not considered
+ */
+SimTime_t c_DeviceDriver::getNumSkippableCycles() {
+	SimTime_t l_cycles = std::numeric_limits<SimTime_t>::max();
+
+	if (k_useRefresh)
+		for (auto &l_count : m_currentREFICount)
+			l_cycles = std::min(l_cycles, (SimTime_t) l_count);
+
+	return l_cycles;
+}
+
+/*!
+ * Account for cycles in which the driver was idle and not clocked, leaving it
+ * as update() and run() would have for each of them
+ *
+ * @param x_cycles
+ */
+void c_DeviceDriver::skipIdleCycles(SimTime_t x_cycles) {
+	assert(isIdle());
+	assert(x_cycles <= getNumSkippableCycles());
+
+	m_simCycle += x_cycles;
+
+	for (auto &l_bank : m_banks)
+		l_bank->skipCycles(x_cycles);
+
+	// no ACT is issued while idle
+	std::vector<bool> l_noACT(m_numRanks, false);
+	SimTime_t l_shift = std::min(x_cycles, (SimTime_t) m_ACTFAWWindowLength);
+	for (SimTime_t l_i = 0; l_i < l_shift; l_i++)
+		shiftACTFAWTracker(l_noACT);
+
+	// the command bus is released twice per cycle
+	for (auto &l_value : m_blockColCmd)
+		l_value = (l_value > 2 * x_cycles) ? l_value - 2 * x_cycles : 0;
+	for (auto &l_value : m_blockRowCmd)
+		l_value = (l_value > 2 * x_cycles) ? l_value - 2 * x_cycles : 0;
+
+	if (k_useRefresh)
+		for (auto &l_count : m_currentREFICount)
+			l_count -= x_cycles;
+}
+
 bool c_DeviceDriver::isCmdAllowed(c_BankCommand* x_bankCommandPtr)
 {
 	SimTime_t l_time = m_simCycle;
@@ -558,15 +620,6 @@ c_BankInfo* c_DeviceDriver::getBankInfo(unsigned x_bankId)
  */
 void c_DeviceDriver::sendRequest() {
 
-	// get count of ACT cmds issued in the FAW
-	std::vector<unsigned> l_numACTIssuedInFAW;
-	l_numACTIssuedInFAW.clear();
-	for(int l_rankId=0;l_rankId<m_numRanks;l_rankId++)
-	{
-		l_numACTIssuedInFAW.push_back(getNumIssuedACTinFAW(l_rankId));
-	}
-
-
 	for (auto l_cmdPtrItr = m_inputQ.begin(); l_cmdPtrItr != m_inputQ.end();)  {
 
 		bool l_proceed = true;
@@ -594,15 +647,16 @@ void c_DeviceDriver::sendRequest() {
 		if ((l_cmdPtr)->getCommandMnemonic() == e_BankCommandType::REF)
 			break;
 
-		if ((e_BankCommandType::ACT == ((l_cmdPtr))->getCommandMnemonic()) && (l_numACTIssuedInFAW[l_rankNum] >= 4))
+		// the count of ACT cmds issued in the FAW only changes in update()
+		if ((e_BankCommandType::ACT == ((l_cmdPtr))->getCommandMnemonic()) && (getNumIssuedACTinFAW(l_rankNum) >= 4))
 		{
 			l_proceed = false;
 		}
 
 		// block: READ after WRITE to the same address
 		// block: WRITE after WRITE to the same address. Processor should make sure that the older WRITE is annulled but we will block the younger here.
-		if (m_inflightWrites.find((l_cmdPtr)->getAddress())
-			!= m_inflightWrites.end()) {
+		if (std::find(m_inflightWrites.begin(), m_inflightWrites.end(),
+				(unsigned) (l_cmdPtr)->getAddress()) != m_inflightWrites.end()) {
 			l_proceed = false;
 		}
 
@@ -611,7 +665,7 @@ void c_DeviceDriver::sendRequest() {
 			|| (e_BankCommandType::WRITEA
 				== (l_cmdPtr)->getCommandMnemonic())) {
 
-			m_inflightWrites.insert((l_cmdPtr)->getAddress());
+			m_inflightWrites.push_back((l_cmdPtr)->getAddress());
 		}
 
 
@@ -880,14 +934,33 @@ bool c_DeviceDriver::sendCommand(c_BankCommand* x_bankCommandPtr,
  */
 void c_DeviceDriver::initACTFAWTracker()
 {
-	m_cmdACTFAWtrackers.clear();
-	for(int i=0; i<m_numRanks;i++)
-	{
-		std::list<unsigned> l_cmdACTFAWTracker;
-		l_cmdACTFAWTracker.clear();
-		l_cmdACTFAWTracker.resize(m_bankParams.at("nFAW")-1, 0);
-		m_cmdACTFAWtrackers.push_back(l_cmdACTFAWTracker);
+	m_ACTFAWWindowLength = m_bankParams.at("nFAW")-1;
+	m_ACTFAWWindowHead = 0;
+	m_ACTFAWWindow.assign(m_numRanks * m_ACTFAWWindowLength, 0);
+	m_numACTinFAW.assign(m_numRanks, 0);
+}
+
+/*!
+ * Advance every rank's FAW window by a cycle: the oldest slot drops out of
+ * the window and is reused for the cycle being recorded
+ *
+ * @param x_isACTIssued per rank, whether an ACT was issued in that cycle
+ */
+void c_DeviceDriver::shiftACTFAWTracker(const std::vector<bool> &x_isACTIssued)
+{
+	if (0 == m_ACTFAWWindowLength)
+		return;
+
+	for (int l_rankNum = 0; l_rankNum < m_numRanks; l_rankNum++) {
+		uint8_t &l_slot = m_ACTFAWWindow[l_rankNum * m_ACTFAWWindowLength + m_ACTFAWWindowHead];
+		uint8_t l_issued = x_isACTIssued[l_rankNum] ? 1 : 0;
+		m_numACTinFAW[l_rankNum] += l_issued;
+		m_numACTinFAW[l_rankNum] -= l_slot;
+		l_slot = l_issued;
 	}
+
+	if (++m_ACTFAWWindowHead == m_ACTFAWWindowLength)
+		m_ACTFAWWindowHead = 0;
 }
 
 /*!
@@ -918,11 +991,7 @@ unsigned c_DeviceDriver::getNumIssuedACTinFAW(unsigned x_rankid) {
 	assert(x_rankid<m_numRanks);
 
 	// get count of ACT cmds issued in the FAW
-	unsigned l_cmdACTIssuedInFAW = 0;
-	assert(m_cmdACTFAWtrackers[x_rankid].size() == m_bankParams.at("nFAW")-1);
-	for(auto& l_issued : m_cmdACTFAWtrackers[x_rankid])
-		l_cmdACTIssuedInFAW += l_issued;
-	return l_cmdACTIssuedInFAW;
+	return m_numACTinFAW[x_rankid];
 }
 
 /*!
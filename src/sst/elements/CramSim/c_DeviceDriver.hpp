@@ -137,6 +137,11 @@ public:
     virtual c_BankInfo* getBankInfo(unsigned x_bankId);
     void update(SimTime_t simCycle);
 
+    // skip-ahead clocking
+    bool isIdle();
+    SimTime_t getNumSkippableCycles();
+    void skipIdleCycles(SimTime_t x_cycles);
+
     unsigned getNumChannel(){return k_numChannels;}
     unsigned getNumPChPerChannel(){return k_numPChannelsPerChannel;}
     unsigned getNumRanksPerChannel(){return k_numRanksPerChannel;}
@@ -162,6 +167,7 @@ private:
     void releaseCommandBus();
 
     void initACTFAWTracker();
+    void shiftACTFAWTracker(const std::vector<bool> &x_isACTIssued);
     void initRefresh();
     unsigned getNumIssuedACTinFAW(unsigned x_rankid);
     void createRefreshCmds(unsigned x_rank);
@@ -172,9 +178,9 @@ private:
 	std::deque<c_BankCommand*> m_inputQ;
 	std::deque<c_BankCommand*> m_outputQ;
 	std::vector<bool> m_blockBank;
-	std::set<unsigned> m_inflightWrites; // track inflight write commands
-	std::deque<unsigned> m_blockRowCmd; //command bus occupancy info
-	std::deque<unsigned> m_blockColCmd; //command bus occupancy info
+	std::vector<unsigned> m_inflightWrites; // track inflight write commands, cleared every cycle
+	std::vector<unsigned> m_blockRowCmd; //command bus occupancy info
+	std::vector<unsigned> m_blockColCmd; //command bus occupancy info
 
 	std::vector<unsigned> m_currentREFICount; //per rank REFICounter
 	std::vector<std::vector<c_BankCommand*>> m_refreshCmdQ; //per rank refresh commandQ
@@ -184,7 +190,13 @@ private:
 	e_BankCommandType m_lastDataCmdType;
 	unsigned m_lastChannel;
 	unsigned m_lastPseudoChannel;
-	std::vector<std::list<unsigned>> m_cmdACTFAWtrackers; // FIXME: change this to a circular buffer for speed. Could also implement as shift register.
+	// per-rank ACT history over the last nFAW-1 cycles, kept as rings of
+	// m_ACTFAWWindowLength slots stored back to back. All ranks advance
+	// together so they share the index of the oldest slot.
+	std::vector<uint8_t> m_ACTFAWWindow;
+	std::vector<unsigned> m_numACTinFAW; // per-rank count of ACTs in the window
+	unsigned m_ACTFAWWindowLength;
+	unsigned m_ACTFAWWindowHead;
 	std::vector<bool> m_isACTIssued;
 	bool m_issuedACT;
 
@@ -114,6 +114,8 @@ c_Dimm::c_Dimm(SST::ComponentId_t x_id, SST::Params& x_params) :
 				  << std::endl;
 	}
 
+	k_skipIdleCycles = (bool) x_params.find<bool> ("boolSkipIdleCycles", false);
+
 
 	m_numRanks = k_numChannels * k_numPChannelsPerChannel * k_numRanksPerChannel;
 	m_numBanks = m_numRanks* k_numBankGroupsPerRank * k_numBanksPerBankGroup;
@@ -246,7 +248,9 @@ c_Dimm::c_Dimm(SST::ComponentId_t x_id, SST::Params& x_params) :
 
 	//set our clock
 	m_clockHandler=new Clock::Handler<c_Dimm>(this, &c_Dimm::clockTic);
-	registerClock(l_clockFreqStr, m_clockHandler);
+	m_clockTC=registerClock(l_clockFreqStr, m_clockHandler);
+	m_clockOn=true;
+	m_lastClockCycle=0;
 
 	// Statistics setup
 	s_actCmdsRecvd     = registerStatistic<uint64_t>("actCmdsRecvd");
@@ -294,7 +298,7 @@ void c_Dimm::printQueues() {
 		(l_cmdPtr)->print(m_simCycle);
 }
 
-bool c_Dimm::clockTic(SST::Cycle_t) {
+bool c_Dimm::clockTic(SST::Cycle_t x_cycle) {
 	m_simCycle++;
 	for (int l_i = 0; l_i != m_banks.size(); ++l_i) {
 
@@ -309,13 +313,51 @@ bool c_Dimm::clockTic(SST::Cycle_t) {
 	if(k_boolPowerCalc)
 		updateBackgroundEnergy();
 
+	// Commands reach the banks only over ctrlLink, so with every bank idle
+	// nothing changes until the next command arrives
+	if(k_skipIdleCycles && isIdle()) {
+		m_lastClockCycle = x_cycle;
+		m_clockOn = false;
+		return true;
+	}
+
 	return false;
 }
 
+bool c_Dimm::isIdle() {
+	for (auto &l_bank : m_banks)
+		if (!l_bank->isIdle())
+			return false;
+
+	return m_cmdResQ.empty();
+}
+
+void c_Dimm::turnClockOn() {
+	if (m_clockOn)
+		return;
+
+	Cycle_t l_nextCycle = reregisterClock(m_clockTC, m_clockHandler);
+	skipIdleCycles(l_nextCycle - 1 - m_lastClockCycle);
+	m_clockOn = true;
+}
+
+// Account for cycles the clock was stopped as clockTic() would have
+void c_Dimm::skipIdleCycles(SimTime_t x_cycles) {
+	m_simCycle += x_cycles;
+	m_lastClockCycle += x_cycles;
+
+	if(k_boolPowerCalc)
+	{
+		for(unsigned i=0;i<m_numRanks;i++)
+			m_backgroundEnergy[i]+= (double) x_cycles * (k_IDD3N * k_VDD * k_numDevices);
+	}
+}
+
 void c_Dimm::handleInCmdUnitReqPtrEvent(SST::Event *ev) {
 
 	c_CmdReqEvent* l_cmdReqEventPtr = dynamic_cast<c_CmdReqEvent*>(ev);
 	if (l_cmdReqEventPtr) {
+		turnClockOn();
 
 		c_BankCommand* l_cmdReq = l_cmdReqEventPtr->m_payload;
 		unsigned l_rank=l_cmdReq->getHashedAddress()->getRankId();
@@ -453,6 +495,10 @@ void c_Dimm::finish(){
 	double l_refreshPower=0;
 	double l_backgroundPower=0;
 
+	// count the cycles since the clock was last stopped
+	if(!m_clockOn)
+		skipIdleCycles(getCurrentSimTime(m_clockTC) - m_lastClockCycle);
+
 	uint64_t l_actRecvd=0;
 	uint64_t l_readRecvd=0;
 	uint64_t l_writeRecvd=0;
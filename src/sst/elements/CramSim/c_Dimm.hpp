@@ -80,6 +80,7 @@ public:
         {"boolAllocateCmdResWRITE", "Allocate space in Controller Res Q for WRITE Cmds", NULL},
         {"boolAllocateCmdResWRITEA", "Allocate space in Controller Res Q for WRITEA Cmds", NULL},
         {"boolAllocateCmdResPRE", "Allocate space in Controller Res Q for PRE Cmds", NULL},
+        {"boolSkipIdleCycles", "Stop the clock while no bank has a command, 1: enable, 0: disable (default)", "0"},
     )
 
     SST_ELI_DOCUMENT_PORTS(
@@ -1398,11 +1399,19 @@ private:
 	void updateDynamicEnergy(c_BankCommand* x_bankCommandPtr);
 	void updateBackgroundEnergy();
 
+	// skip-ahead clocking
+	bool isIdle();
+	void turnClockOn();
+	void skipIdleCycles(SimTime_t x_cycles);
+
 	// Links
 	SST::Link* m_ctrlLink;
 
 	// Clock Handler
 	Clock::HandlerBase *m_clockHandler;
+	TimeConverter *m_clockTC;
+	bool m_clockOn;
+	Cycle_t m_lastClockCycle; // last cycle clockTic() ran before the clock was stopped
 
 	// params
 	int k_numChannels;
@@ -1413,6 +1422,7 @@ private:
 	int k_numDevices;
 
 	bool k_boolPowerCalc;
+	bool k_skipIdleCycles;
 	int k_IDD0;
 	int k_IDD2P;
 	int k_IDD2N;
@@ -354,6 +354,19 @@ void c_TxnConverter::updateBankInfo(c_Transaction* x_txn)
 }
 
 
+// run() with an empty queue only counts down the pseudo open page timers
+void c_TxnConverter::skipIdleCycles(SimTime_t x_cycles)
+{
+	assert(m_inputQ.empty());
+
+	if(k_bankPolicy==2) {
+		for (auto &it:m_bankInfo)
+			if(it->isRowOpen())
+				it->skipCycles(x_cycles);
+	}
+}
+
+
 c_BankInfo* c_TxnConverter::getBankInfo(unsigned x_bankId)
 {
 	return m_bankInfo[x_bankId];
@@ -295,6 +295,18 @@ bool c_TxnScheduler::isHit(c_Transaction* x_txn)
     return l_isHit;
 }
 
+bool c_TxnScheduler::isEmpty()
+{
+    for(auto l_queues: {&m_txnQ, &m_txnReadQ, &m_txnWriteQ}) {
+        for(auto &l_queue: *l_queues) {
+            if(!l_queue.empty())
+                return false;
+        }
+    }
+    return true;
+}
+
+
 bool c_TxnScheduler::hasDependancy(c_Transaction *x_txn, int x_ch)
 {
     TxnQueue* l_queue= nullptr;
@@ -80,9 +80,10 @@ namespace SST {
             virtual void run(SimTime_t simCycle);
             virtual bool push(c_Transaction* newTxn);
             virtual bool isHit(c_Transaction* newTxn);
+            virtual bool isEmpty();
 
 
-        private:
+        protected:
             virtual c_Transaction* getNextTxn(TxnQueue& x_queue, int x_ch);
             virtual bool hasDependancy(c_Transaction* x_txn, int x_ch);
             virtual void popTxn(TxnQueue& x_queue, c_Transaction* x_txn);
@@ -0,0 +1,133 @@
+#!/bin/bash
+#
+# Runs the DDR4 and HBM configs through test_txngen.py with the command
+# trace enabled and diffs each trace against a reference.  The cases stress
+# the bank timing checks: a tight tFAW window with rank round robin command
+# scheduling, auto-precharge reads/writes, and refresh on both HBM modes.
+#
+# The reference traces must come from sst running a CramSim build of the tree
+# before the fixed-size timing tracker rewrite.  Either point --baseline at
+# that build's library directory to run it alongside, or run once with
+# --gen --baseline to write refFiles/ and check against those afterwards.
+#
+# With --traces, the test_CramSim_<n>_<R|W> cases of the default testsuite are
+# also run on the sst-CramSim-trace_verimem_* traces and their transaction
+# counts and simulated time are checked against refFiles/.
+#
+# Usage: runCmdTraceTests.sh [--gen] [--baseline=<libdir>] [--traces=<dir>]
+#   --gen                 regenerate the reference traces instead of checking them
+#   --baseline=<libdir>   take the reference traces from the libCramSim in <libdir>
+#   --traces=<dir>        directory holding sst-CramSim-trace_verimem_*.trc
+
+cd "$(dirname "$0")"
+
+gen=0
+baseline=""
+traces=""
+for arg in "$@"; do
+    case ${arg} in
+        --gen)        gen=1 ;;
+        --baseline=*) baseline=${arg#*=} ;;
+        --traces=*)   traces=${arg#*=} ;;
+        *)            echo "unknown option ${arg}"; exit 1 ;;
+    esac
+done
+
+status=0
+
+runCase() {
+    name=$1
+    cfg=$2
+    shift 2
+
+    ref=refFiles/test_CramSim_cmdtrace_${name}.out
+    out=test_CramSim_cmdtrace_${name}.new
+    rm -f ${out}
+
+    echo ${name}
+    if [ -n "${baseline}" ]; then
+        base=test_CramSim_cmdtrace_${name}.base
+        rm -f ${base}
+        sst --lib-path=${baseline} --model-options="--configfile=../${cfg} mode=rand boolPrintCmdTrace=1 strCmdTraceFile=${base} $*" test_txngen.py > ${base}.log 2>&1
+        if [ $? -ne 0 ]; then
+            echo "${name} failed on the baseline, see ${base}.log"
+            status=1
+            return
+        fi
+        rm -f ${base}.log
+        if [ ${gen} -eq 1 ]; then
+            mv ${base} ${ref}
+            return
+        fi
+        ref=${base}
+    elif [ ! -f ${ref} ]; then
+        echo "${name} failed, ${ref} is missing; generate it with --gen --baseline=<libdir>"
+        status=1
+        return
+    fi
+
+    sst --model-options="--configfile=../${cfg} mode=rand boolPrintCmdTrace=1 strCmdTraceFile=${out} $*" test_txngen.py > ${out}.log 2>&1
+    if [ $? -ne 0 ]; then
+        echo "${name} failed, see ${out}.log"
+        status=1
+        return
+    fi
+
+    if diff -q ${ref} ${out} > /dev/null; then
+        rm -f ${out}
+    else
+        echo "${name} failed, command trace differs from ${ref}"
+        status=1
+        return
+    fi
+    if [ -n "${baseline}" ]; then
+        rm -f ${ref}
+    fi
+    rm -f ${out}.log
+}
+
+runTraceCase() {
+    name=$1
+
+    ref=refFiles/test_CramSim_${name}.out
+    out=test_CramSim_${name}.log
+
+    echo ${name}
+    sst --model-options="--configfile=../ddr4_verimem.cfg --traceFile=${traces}/sst-CramSim-trace_verimem_${name}.trc" test_txntrace.py > ${out} 2>&1
+    if [ $? -ne 0 ]; then
+        echo "${name} failed, see ${out}"
+        status=1
+        return
+    fi
+
+    # The header lines echo the arguments, so only the results are compared
+    grep -e "Txns" -e "CPT" -e "simulated time" ${ref} | while read -r line; do
+        if ! grep -Fxq "${line}" ${out}; then
+            echo "${name} failed, missing \"${line}\""
+            exit 1
+        fi
+    done
+    if [ $? -ne 0 ]; then
+        status=1
+        return
+    fi
+    rm -f ${out}
+}
+
+if [ ${gen} -eq 1 ] && [ -z "${baseline}" ]; then
+    echo "--gen needs --baseline=<libdir> pointing at a CramSim build of the baseline tree"
+    exit 1
+fi
+
+runCase ddr4_faw_rank ddr4_verimem.cfg stopAtCycle=4000ns nRRD=2 nRRD_L=2 nRRD_S=2 nFAW=40 cmdSchedulingPolicy=RANK boolUseRefresh=1 nREFI=1500
+runCase ddr4_autopre  ddr4_verimem.cfg stopAtCycle=4000ns txnSchedulingPolicy=FRFCFS boolUseReadA=1 boolUseWriteA=1 boolUseRefresh=1 nREFI=1500
+runCase hbm_legacy    hbm_legacy_4h.cfg stopAtCycle=1500ns nREFI=1000
+runCase hbm_pseudo    hbm_pseudo_4h.cfg stopAtCycle=1500ns nREFI=1000
+
+if [ -n "${traces}" ] && [ ${gen} -eq 0 ]; then
+    for name in 1_R 1_RW 1_W 2_R 2_W 4_R 4_W 5_R 5_W 6_R 6_W; do
+        runTraceCase ${name}
+    done
+fi
+
+exit ${status}
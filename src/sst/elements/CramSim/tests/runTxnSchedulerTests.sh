@@ -0,0 +1,64 @@
+#!/bin/bash
+#
+# Runs test_txngen.py once with c_TxnScheduler and once with
+# c_BankIndexedTxnScheduler for each case and diffs the command traces and
+# the simulator output.  The bank-indexed scheduler must pick the same
+# transactions in the same order, so both runs have to match exactly.
+#
+# Usage: runTxnSchedulerTests.sh
+
+cd "$(dirname "$0")"
+
+status=0
+
+runSched() {
+    sched=$1
+    out=$2
+    cfg=$3
+    shift 3
+
+    sst --model-options="--configfile=../${cfg} mode=rand TxnScheduler=${sched} boolPrintCmdTrace=1 strCmdTraceFile=${out} $*" test_txngen.py 2>&1 \
+        | grep -v -e "^Override" -e "Setting cmd trace output to" > ${out}.log
+    return ${PIPESTATUS[0]}
+}
+
+runCase() {
+    name=$1
+    cfg=$2
+    shift 2
+
+    base=test_CramSim_txnsched_${name}.base
+    out=test_CramSim_txnsched_${name}.new
+    rm -f ${base} ${base}.log ${out} ${out}.log
+
+    echo ${name}
+    if ! runSched CramSim.c_TxnScheduler ${base} ${cfg} "$@"; then
+        echo "${name} failed, see ${base}.log"
+        status=1
+        return
+    fi
+    if ! runSched CramSim.c_BankIndexedTxnScheduler ${out} ${cfg} "$@"; then
+        echo "${name} failed, see ${out}.log"
+        status=1
+        return
+    fi
+
+    if ! diff -q ${base} ${out} > /dev/null; then
+        echo "${name} failed, command trace differs from c_TxnScheduler"
+        status=1
+        return
+    fi
+    if ! diff -q ${base}.log ${out}.log > /dev/null; then
+        echo "${name} failed, output differs from c_TxnScheduler"
+        status=1
+        return
+    fi
+    rm -f ${base} ${base}.log ${out} ${out}.log
+}
+
+runCase ddr4_frfcfs     ddr4_verimem.cfg stopAtCycle=6000ns txnSchedulingPolicy=FRFCFS
+runCase ddr4_readfirst  ddr4_verimem.cfg stopAtCycle=6000ns txnSchedulingPolicy=FRFCFS boolReadFirstTxnScheduling=1
+runCase hbm_frfcfs      hbm_pseudo_4h.cfg stopAtCycle=6000ns txnSchedulingPolicy=FRFCFS
+runCase hbm_readfirst   hbm_pseudo_4h.cfg stopAtCycle=6000ns txnSchedulingPolicy=FRFCFS boolReadFirstTxnScheduling=1
+
+exit ${status}
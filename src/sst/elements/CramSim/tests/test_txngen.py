@@ -91,7 +91,7 @@ comp_txnGen.enableAllStatistics()
 # controller
 comp_controller = sst.Component("MemController"+"0", "CramSim.c_Controller")
 comp_controller.addParams(g_params)
-c0 = comp_controller.setSubComponent("TxnScheduler", "CramSim.c_TxnScheduler")
+c0 = comp_controller.setSubComponent("TxnScheduler", g_params.get("TxnScheduler", "CramSim.c_TxnScheduler"))
 c1 = comp_controller.setSubComponent("TxnConverter", "CramSim.c_TxnConverter")
 c2 = comp_controller.setSubComponent("AddrMapper", "CramSim.c_AddressHasher")
 c3 = comp_controller.setSubComponent("CmdScheduler", "CramSim.c_CmdScheduler")
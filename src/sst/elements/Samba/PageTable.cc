@@ -0,0 +1,224 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+//
+
+#include <sst_config.h>
+#include "PageTable.h"
+
+using namespace SST::SambaComponent;
+
+
+PageTable::PageTable(bool confined) : confined(confined), cr3(0), cr3_init(false)
+{
+
+	for(int level=0; level < LEVELS; level++)
+		for(int i=0; i < CACHE_SIZE; i++)
+		{
+			cache[level][i].tag = 0;
+			cache[level][i].node = nullptr;
+		}
+
+}
+
+
+PageTable::~PageTable()
+{
+
+	for(auto & root : roots)
+		deleteNode(root.second, PGD);
+
+}
+
+
+void PageTable::deleteNode(Node * node, int level)
+{
+
+	if(level > PTE)
+		for(int i=0; i < ENTRIES; i++)
+			if(node->children[i] != nullptr)
+				deleteNode(node->children[i], level-1);
+
+	delete node;
+
+}
+
+
+PageTable::Node * PageTable::findNode(Address_t vaddr, int level, bool create)
+{
+
+	// The node is identified by the bits of vaddr above the ones indexing it
+	Address_t tag = vaddr >> shift(level+1);
+	CacheSlot & slot = cache[level][tag % CACHE_SIZE];
+
+	if(slot.node != nullptr && slot.tag == tag)
+		return slot.node;
+
+	Node * node;
+
+	if(level == PGD)
+	{
+		std::unordered_map<Address_t, Node *>::iterator root = roots.find(tag);
+
+		if(root != roots.end())
+			node = root->second;
+		else if(create)
+		{
+			node = new Node();
+			roots[tag] = node;
+		}
+		else
+			return nullptr;
+	}
+	else
+	{
+		Node * parent = findNode(vaddr, level+1, create);
+
+		if(parent == nullptr)
+			return nullptr;
+
+		Node * & child = parent->children[index(vaddr, level+1)];
+
+		if(child == nullptr)
+		{
+			if(!create)
+				return nullptr;
+
+			child = new Node();
+		}
+
+		node = child;
+	}
+
+	slot.tag = tag;
+	slot.node = node;
+
+	return node;
+
+}
+
+
+PageTable::Entry * PageTable::findEntry(Address_t vaddr, int level, bool create)
+{
+
+	vaddr = confine(vaddr);
+
+	Node * node = findNode(vaddr, level, create);
+
+	if(node == nullptr)
+		return nullptr;
+
+	return &node->entries[index(vaddr, level)];
+
+}
+
+
+bool PageTable::isPresent(Address_t vaddr, int level)
+{
+
+	Entry * entry = findEntry(vaddr, level, false);
+
+	return entry != nullptr && (entry->flags & PRESENT);
+
+}
+
+
+Address_t PageTable::getEntry(Address_t vaddr, int level)
+{
+
+	Entry * entry = findEntry(vaddr, level, false);
+
+	if(entry == nullptr)
+		return 0;
+
+	return entry->paddr;
+
+}
+
+
+void PageTable::setEntry(Address_t vaddr, int level, Address_t paddr)
+{
+
+	Entry * entry = findEntry(vaddr, level, true);
+
+	entry->paddr = paddr;
+	entry->flags |= PRESENT;
+
+}
+
+
+bool PageTable::isMapped(Address_t vaddr)
+{
+
+	// 1GB, 2MB and 4KB pages
+	for(int level=PUD; level >= PTE; level--)
+	{
+		Entry * entry = findEntry(vaddr, level, false);
+
+		if(entry == nullptr)
+			return false;
+
+		if(entry->flags & MAPPED)
+			return true;
+	}
+
+	return false;
+
+}
+
+
+void PageTable::setMapped(Address_t vaddr, int level)
+{
+
+	findEntry(vaddr, level, true)->flags |= MAPPED;
+
+}
+
+
+bool PageTable::isFaultPending(Address_t vaddr, int level)
+{
+
+	Entry * entry = findEntry(vaddr, level, false);
+
+	return entry != nullptr && (entry->flags & FAULT_PENDING);
+
+}
+
+
+bool PageTable::hasPendingFaults(Address_t vaddr, int level)
+{
+
+	for(; level >= PTE; level--)
+		if(isFaultPending(vaddr, level))
+			return true;
+
+	return false;
+
+}
+
+
+void PageTable::setFaultPending(Address_t vaddr, int level)
+{
+
+	for(; level >= PTE; level--)
+		findEntry(vaddr, level, true)->flags |= FAULT_PENDING;
+
+}
+
+
+void PageTable::clearFaultPending(Address_t vaddr, int level)
+{
+
+	Entry * entry = findEntry(vaddr, level, false);
+
+	if(entry != nullptr)
+		entry->flags &= ~FAULT_PENDING;
+
+}
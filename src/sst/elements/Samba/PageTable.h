@@ -0,0 +1,126 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+//
+
+
+#ifndef _H_SST_SAMBA_PAGE_TABLE
+#define _H_SST_SAMBA_PAGE_TABLE
+
+#include <stdint.h>
+#include <unordered_map>
+
+typedef uint64_t Address_t;
+
+namespace SST { namespace SambaComponent{
+
+	// The page table of the application running on a Samba instance, shared by all of its TLB hierarchies and page table walkers.
+	//
+	// It is a radix tree following the x86-64 layout: four levels of 512 entries, indexed by 9 bits of the virtual address each,
+	// starting at bit 12. Every entry holds the physical address installed at that level (the next-level table, or the page
+	// frame for a PTE) and flags telling if it was installed, if a page of that level's size is mapped there (the leaf size),
+	// and if a page fault building that level is pending. Virtual addresses above the 48 bits covered by the PGD are kept
+	// in a sparse map of roots.
+	//
+	// A confined page table only covers 48-bit virtual addresses; the bits above are ignored.
+	//
+	// Walks are short-cut by a small direct-mapped cache of table nodes per level. Nodes are never freed, so cached nodes
+	// never go stale. This only saves host time; the timing of walks is modelled by the walkers' own PTWC.
+	class PageTable
+	{
+		public:
+
+		// Levels, numbered as the walkers' page_size[] and fault levels
+		enum Level { PTE = 0, PMD = 1, PUD = 2, PGD = 3 };
+
+		PageTable(bool confined);
+		~PageTable();
+
+		// CR3 of the current context, and whether its allocation was requested
+		Address_t getCR3() { return cr3; }
+		void setCR3(Address_t paddr) { cr3 = paddr; }
+		bool isCR3Initialized() { return cr3_init; }
+		void setCR3Initialized() { cr3_init = true; }
+
+		// Was an entry installed at that level for vaddr
+		bool isPresent(Address_t vaddr, int level);
+
+		// The physical address installed at that level for vaddr, 0 if none
+		Address_t getEntry(Address_t vaddr, int level);
+
+		void setEntry(Address_t vaddr, int level, Address_t paddr);
+
+		// Is vaddr mapped by a page of any size
+		bool isMapped(Address_t vaddr);
+
+		// Map vaddr by a page of the size covered by an entry at that level
+		void setMapped(Address_t vaddr, int level);
+
+		// Is a page fault building that level for vaddr pending
+		bool isFaultPending(Address_t vaddr, int level);
+
+		// Is a page fault pending for vaddr at that level or any level below it
+		bool hasPendingFaults(Address_t vaddr, int level);
+
+		// Mark a page fault pending at that level and every level below it
+		void setFaultPending(Address_t vaddr, int level);
+
+		void clearFaultPending(Address_t vaddr, int level);
+
+		private:
+
+		enum EntryFlags { PRESENT = 1, MAPPED = 2, FAULT_PENDING = 4 };
+
+		static const int ENTRIES = 512;
+		static const int LEVELS = 4;
+		static const int CACHE_SIZE = 64;
+
+		struct Entry {
+			Address_t paddr;
+			uint8_t flags;
+		};
+
+		struct Node {
+			Entry entries[ENTRIES];
+			Node * children[ENTRIES]; // unused by PTE nodes
+		};
+
+		struct CacheSlot {
+			Address_t tag;
+			Node * node;
+		};
+
+		static int shift(int level) { return 12 + 9*level; }
+
+		static int index(Address_t vaddr, int level) { return (vaddr >> shift(level)) % ENTRIES; }
+
+		Address_t confine(Address_t vaddr) { return confined ? vaddr % ((Address_t) 1 << shift(LEVELS)) : vaddr; }
+
+		// The node holding vaddr's entry at that level, creating it (and the nodes above it) if asked to
+		Node * findNode(Address_t vaddr, int level, bool create);
+
+		Entry * findEntry(Address_t vaddr, int level, bool create);
+
+		void deleteNode(Node * node, int level);
+
+		bool confined;
+
+		Address_t cr3;
+		bool cr3_init;
+
+		// PGD nodes, the key is the bits above 47, i.e., VA/(4096*512*512*512*512)
+		std::unordered_map<Address_t, Node *> roots;
+
+		CacheSlot cache[LEVELS][CACHE_SIZE];
+	};
+
+}}
+
+#endif
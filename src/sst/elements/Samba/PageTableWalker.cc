@@ -183,7 +183,7 @@ void PageTableWalker::handleEvent( SST::Event* e )
 
 
 
-	//// ******** Important, for each level, we will update MAPPED_PAGE_SIZE** and PGD/PMD/PUD/PTE so the actual physical address is used later
+	//// ******** Important, for each level, we will update the page table entries and mapped pages so the actual physical address is used later
 	SambaEvent * temp_ptr =  dynamic_cast<SambaComponent::SambaEvent*> (e);
 
 	if(temp_ptr==nullptr)
@@ -194,35 +194,24 @@ void PageTableWalker::handleEvent( SST::Event* e )
 
 		// Send request to page fault handler starting from the first unmapped level (L4/CR3 if first fault in system)
 
-		if(!ptw_confined)
-		{
-			//if((*CR3) == -1)
-			if(!(*cr3_init))
-				fault_level = 4;
-			else if((*PGD).find(temp_ptr->getAddress()/page_size[3]) == (*PGD).end())
-				fault_level = 3;
-			else if((*PUD).find(temp_ptr->getAddress()/page_size[2]) == (*PUD).end())
-				fault_level = 2;
-			else if((*PMD).find(temp_ptr->getAddress()/page_size[1]) == (*PMD).end())
-				fault_level = 1;
-			else if((*PTE).find(temp_ptr->getAddress()/page_size[0]) == (*PTE).end())
-				fault_level = 0;
-			else
-				output->fatal(CALL_INFO, -1, "MMU: DANGER!!\n");
-		}
+		Address_t vaddr = temp_ptr->getAddress();
+
+		//if(pageTable->getCR3() == -1)
+		if(!pageTable->isCR3Initialized())
+			fault_level = 4;
+		else if(!pageTable->isPresent(vaddr, PageTable::PGD))
+			fault_level = 3;
+		else if(!pageTable->isPresent(vaddr, PageTable::PUD))
+			fault_level = 2;
+		else if(!pageTable->isPresent(vaddr, PageTable::PMD))
+			fault_level = 1;
+		else if(!pageTable->isPresent(vaddr, PageTable::PTE))
+			fault_level = 0;
 		else
-		{
-			uint64_t offset = (uint64_t)512*512*512*512;
-			if(!(*cr3_init)) fault_level = 4;
-			else if((*PGD).find((temp_ptr->getAddress()/page_size[3])%512) == (*PGD).end()) fault_level = 3;
-			else if((*PUD).find((temp_ptr->getAddress()/page_size[2])%(512*512)) == (*PUD).end()) fault_level = 2;
-			else if((*PMD).find((temp_ptr->getAddress()/page_size[1])%(512*512*512)) == (*PMD).end()) fault_level = 1;
-			else if((*PTE).find((temp_ptr->getAddress()/page_size[0])%offset) == (*PTE).end()) fault_level = 0;
-	 		else output->fatal(CALL_INFO, -1, "MMU: DANGER!!\n");
-		}
+			output->fatal(CALL_INFO, -1, "MMU: DANGER!!\n");
 
-		if(!(*cr3_init)) {
-			*cr3_init = 1;
+		if(!pageTable->isCR3Initialized()) {
+			pageTable->setCR3Initialized();
 			pageFaultHandler->allocatePage(coreId,fault_level,stall_addr,4096);
 		}else
 			pageFaultHandler->allocatePage(coreId,fault_level,stall_addr/page_size[fault_level],4096);
@@ -241,87 +230,32 @@ void PageTableWalker::handleEvent( SST::Event* e )
 		{
 			// We are building the first page in the page table!
 			//std::cout << getName().c_str() << " Core: " << coreId << " CR3 address: " << std::hex << temp_ptr->getPaddress() << std::endl;
-			*cr3_init = 1;
-			(*CR3) = temp_ptr->getPaddress();
+			pageTable->setCR3Initialized();
+			pageTable->setCR3(temp_ptr->getPaddress());
 			fault_level--;
 			pageFaultHandler->allocatePage(coreId,fault_level,stall_addr/page_size[fault_level],4096);
 		}
-		else if(fault_level == 3)
+		else if(fault_level > 0)
 		{
-			if(!ptw_confined)
-				(*PGD)[stall_addr/page_size[3]] = temp_ptr->getPaddress();
-			else
+			// PGD, PUD or PMD
+			if(ptw_confined)
 			{
-				if((*PGD).find((stall_addr/page_size[3])%512) != (*PGD).end())
-					output->fatal(CALL_INFO, -1, "MMU: PTW DANGER.. same PGD!!\n");
-				(*PGD)[(stall_addr/page_size[3])%512] = temp_ptr->getPaddress();
-				(*PENDING_PAGE_FAULTS_PGD).erase((stall_addr/page_size[3])%(512));
+				if(pageTable->isPresent(stall_addr, fault_level))
+					output->fatal(CALL_INFO, -1, "MMU: PTW DANGER.. same %s!!\n", fault_level == 3 ? "PGD" : (fault_level == 2 ? "PUD" : "PMD"));
+				pageTable->clearFaultPending(stall_addr, fault_level);
 			}
+			pageTable->setEntry(stall_addr, fault_level, temp_ptr->getPaddress());
+
+			// A large page would be tagged here with pageTable->setMapped(stall_addr, fault_level), ending the fault
 			fault_level--;
 			pageFaultHandler->allocatePage(coreId,fault_level,stall_addr/page_size[fault_level],4096);
 
-		}
-		else if(fault_level == 2)
-		{
-			if(!ptw_confined)
-				(*PUD)[stall_addr/page_size[2]] = temp_ptr->getPaddress();
-			else
-			{
-				if((*PUD).find((stall_addr/page_size[2])%(512*512)) != (*PUD).end())
-					output->fatal(CALL_INFO, -1, "MMU: PTW DANGER.. same PUD!!\n");
-				(*PUD)[(stall_addr/page_size[2])%(512*512)] = temp_ptr->getPaddress();
-				(*PENDING_PAGE_FAULTS_PUD).erase((stall_addr/page_size[2])%(512*512));
-			}
-			//if(temp_ptr->getSize() == page_size[2]) {
-			//	(*MAPPED_PAGE_SIZE1GB)[temp_ptr->getAddress()/page_size[2]] = 0;
-			//	fault_level = 0;
-			//	stall = false;
-			//	*hold = 0;
-
-			//} else {
-				fault_level--;
-				pageFaultHandler->allocatePage(coreId,fault_level,stall_addr/page_size[fault_level],4096);
-
-			//}
-
-		}
-
-		else if(fault_level == 1)
-		{
-			if(!ptw_confined)
-				(*PMD)[stall_addr/page_size[1]] = temp_ptr->getPaddress();
-			else
-			{
-				uint64_t offset = 512*512*512;
-				if((*PMD).find((stall_addr/page_size[1])%offset) != (*PMD).end())
-					output->fatal(CALL_INFO, -1, "MMU: PTW DANGER.. same PMD!!\n");
-				(*PMD)[(stall_addr/page_size[1])%offset] = temp_ptr->getPaddress();
-				(*PENDING_PAGE_FAULTS_PMD).erase((stall_addr/page_size[1])%offset);
-			}
-			//if(temp_ptr->getSize() == page_size[1]) {
-			//	(*MAPPED_PAGE_SIZE2MB)[temp_ptr->getAddress()/page_size[1]] = 0;
-			//	fault_level = 0;
-			//	stall = false;
-			//	*hold = 0;
-
-			//} else {
-				fault_level--;
-				pageFaultHandler->allocatePage(coreId,fault_level,stall_addr/page_size[fault_level],4096);
-
-			//}
-
 		}
 		else if(fault_level == 0)
 		{
-			if(!ptw_confined)
-				(*PTE)[stall_addr/page_size[0]] = temp_ptr->getPaddress();
-			else
-			{
-				uint64_t offset = (uint64_t)512*512*512*512;
-				if((*PTE).find((stall_addr/page_size[0])%offset) != (*PTE).end())
-					output->fatal(CALL_INFO, -1, "MMU: PTW DANGER.. same PTE!!\n");
-				(*PTE)[(stall_addr/page_size[0])%offset] = temp_ptr->getPaddress();
-			}
+			if(ptw_confined && pageTable->isPresent(stall_addr, PageTable::PTE))
+				output->fatal(CALL_INFO, -1, "MMU: PTW DANGER.. same PTE!!\n");
+			pageTable->setEntry(stall_addr, PageTable::PTE, temp_ptr->getPaddress());
 			SambaEvent * tse = new SambaEvent(EventType::PAGE_FAULT_SERVED);
 			s_EventChan->send(tse);
 		}
@@ -330,17 +264,8 @@ void PageTableWalker::handleEvent( SST::Event* e )
 	}
 	else if(temp_ptr->getType() == EventType::PAGE_FAULT_SERVED)
 	{
-		if(!ptw_confined)
-		{
-			(*MAPPED_PAGE_SIZE4KB)[stall_addr/page_size[0]] = 0;
-			(*PENDING_PAGE_FAULTS).erase(stall_addr/page_size[0]);
-		}
-		else
-		{
-			uint64_t offset = (uint64_t)512*512*512*512;
-			(*MAPPED_PAGE_SIZE4KB)[(stall_addr/page_size[0])%offset] = 0;
-			(*PENDING_PAGE_FAULTS_PTE).erase((stall_addr/page_size[0])%offset);
-		}
+		pageTable->setMapped(stall_addr, PageTable::PTE);
+		pageTable->clearFaultPending(stall_addr, PageTable::PTE);
 	}
 	delete temp_ptr;
 
@@ -410,29 +335,28 @@ void PageTableWalker::recvResp(SST::Event * event)
 			{
 				Address_t page_table_start = 0;
 				if(WSR_COUNT[pw_id]==4)
-					page_table_start = (*PGD)[addr/page_size[3]];
+					page_table_start = pageTable->getEntry(addr, PageTable::PGD);
 				else if(WSR_COUNT[pw_id]==3)
-					page_table_start = (*PUD) [addr/page_size[2]];
+					page_table_start = pageTable->getEntry(addr, PageTable::PUD);
 				else if(WSR_COUNT[pw_id]==2)
-					page_table_start = (*PMD) [addr/page_size[1]];
+					page_table_start = pageTable->getEntry(addr, PageTable::PMD);
 				else if (WSR_COUNT[pw_id] == 1)
-					page_table_start = (*PTE) [addr/page_size[0]];
+					page_table_start = pageTable->getEntry(addr, PageTable::PTE);
 
 				dummy_add = page_table_start + (addr/page_size[WSR_COUNT[pw_id]-1])%512;
 			}
 			else
 			{
 				if(WSR_COUNT[pw_id]==4) {
-					dummy_add = (*CR3) + ((addr/page_size[3])%512)*8;
+					dummy_add = pageTable->getCR3() + ((addr/page_size[3])%512)*8;
 				}
 				else if(WSR_COUNT[pw_id]==3) {
-					dummy_add = (*PGD)[(addr/page_size[3])%512] + ((addr/page_size[2])%512)*8;
+					dummy_add = pageTable->getEntry(addr, PageTable::PGD) + ((addr/page_size[2])%512)*8;
 				}
 				else if(WSR_COUNT[pw_id]==2) {
-					dummy_add = (*PUD)[(addr/page_size[2])%(512*512)] + ((addr/page_size[1])%512)*8;}
+					dummy_add = pageTable->getEntry(addr, PageTable::PUD) + ((addr/page_size[1])%512)*8;}
 				else if(WSR_COUNT[pw_id]==1) {
-					uint64_t offset = (uint64_t)512*512*512;
-					dummy_add = (*PMD)[(addr/page_size[1])%offset] + ((addr/page_size[0])%512)*8;
+					dummy_add = pageTable->getEntry(addr, PageTable::PMD) + ((addr/page_size[0])%512)*8;
 				}
 				else
 					output->fatal(CALL_INFO, -1, "MMU: PTW DANGER!!\n");
@@ -466,53 +390,39 @@ bool PageTableWalker::tick(SST::Cycle_t x)
 		if(!ptw_confined)
 		{
 			//std::cout<< getName().c_str() << " Core: " << coreId << " stalled with stall address: " << stall_addr << std::endl;
-			if((*PENDING_PAGE_FAULTS).find(stall_addr/page_size[0])==(*PENDING_PAGE_FAULTS).end()) {
+			if(!pageTable->isFaultPending(stall_addr, PageTable::PTE)) {
 				stall = false;
 				*hold = 0;
 			}
 		}
 		else
 		{
-			uint64_t offset = (uint64_t)512*512*512*512;
 			int release = 0;
 			switch(stall_at_levels) {
 			case 4:
 			{
-				if((*PENDING_PAGE_FAULTS_PGD).find((stall_addr/page_size[3])%(512))==(*PENDING_PAGE_FAULTS_PGD).end() &&
-					(*PENDING_PAGE_FAULTS_PUD).find((stall_addr/page_size[2])%(512*512))==(*PENDING_PAGE_FAULTS_PUD).end() &&
-					(*PENDING_PAGE_FAULTS_PMD).find((stall_addr/page_size[1])%(512*512*512))==(*PENDING_PAGE_FAULTS_PMD).end() &&
-					(*PENDING_PAGE_FAULTS_PTE).find((stall_addr/page_size[0])%(offset))==(*PENDING_PAGE_FAULTS_PTE).end())
-				{
+				if(!pageTable->hasPendingFaults(stall_addr, PageTable::PGD))
 					release = 1;
-				}
-
 			}
 				break;
 			case 3:
 			{
-				if((*PENDING_PAGE_FAULTS_PUD).find((stall_addr/page_size[2])%(512*512))==(*PENDING_PAGE_FAULTS_PUD).end() &&
-					(*PENDING_PAGE_FAULTS_PMD).find((stall_addr/page_size[1])%(512*512*512))==(*PENDING_PAGE_FAULTS_PMD).end() &&
-					(*PENDING_PAGE_FAULTS_PTE).find((stall_addr/page_size[0])%(offset))==(*PENDING_PAGE_FAULTS_PTE).end())
-				{
+				if(!pageTable->hasPendingFaults(stall_addr, PageTable::PUD))
 					release = 1;
-				}
 			}
 				break;
 			case 2:
 			{
-				if((*PENDING_PAGE_FAULTS_PMD).find((stall_addr/page_size[1])%(512*512*512))==(*PENDING_PAGE_FAULTS_PMD).end() &&
-					(*PENDING_PAGE_FAULTS_PTE).find((stall_addr/page_size[0])%(offset))==(*PENDING_PAGE_FAULTS_PTE).end())
-				{
+				if(!pageTable->hasPendingFaults(stall_addr, PageTable::PMD))
 					release = 1;
-				}
 			}
 				break;
 			case 1:
 			{
-				if(stall_at_PGD) {if((*PENDING_PAGE_FAULTS_PGD).find((stall_addr/page_size[3])%(512))==(*PENDING_PAGE_FAULTS_PGD).end()) release = 1;}
-				else if(stall_at_PUD) {if((*PENDING_PAGE_FAULTS_PUD).find((stall_addr/page_size[2])%(512*512))==(*PENDING_PAGE_FAULTS_PUD).end()) release = 1;}
-				else if(stall_at_PMD) {if((*PENDING_PAGE_FAULTS_PMD).find((stall_addr/page_size[1])%(512*512*512))==(*PENDING_PAGE_FAULTS_PMD).end()) release = 1;}
-				else if(stall_at_PTE) {if((*PENDING_PAGE_FAULTS_PTE).find((stall_addr/page_size[0])%(offset))==(*PENDING_PAGE_FAULTS_PTE).end()) release = 1;}
+				if(stall_at_PGD) {if(!pageTable->isFaultPending(stall_addr, PageTable::PGD)) release = 1;}
+				else if(stall_at_PUD) {if(!pageTable->isFaultPending(stall_addr, PageTable::PUD)) release = 1;}
+				else if(stall_at_PMD) {if(!pageTable->isFaultPending(stall_addr, PageTable::PMD)) release = 1;}
+				else if(stall_at_PTE) {if(!pageTable->isFaultPending(stall_addr, PageTable::PTE)) release = 1;}
 				else output->fatal(CALL_INFO, -1, "MMU: PTW DANGER!!.. stall at level not recognized..\n");
 			}
 				break;
@@ -554,14 +464,14 @@ bool PageTableWalker::tick(SST::Cycle_t x)
 			bool fault = true;
 			if(!ptw_confined)
 			{
-				if((*MAPPED_PAGE_SIZE4KB).find(addr/page_size[0])!=(*MAPPED_PAGE_SIZE4KB).end() || (*MAPPED_PAGE_SIZE2MB).find(addr/page_size[1])!=(*MAPPED_PAGE_SIZE2MB).end() || (*MAPPED_PAGE_SIZE1GB).find(addr/page_size[2])!=(*MAPPED_PAGE_SIZE1GB).end())
+				if(pageTable->isMapped(addr))
 					fault = false;
 
 				if(fault)
 				{
 					stall_addr = addr;
-					if((*PENDING_PAGE_FAULTS).find(addr/page_size[0])==(*PENDING_PAGE_FAULTS).end()) {
-						(*PENDING_PAGE_FAULTS)[addr/page_size[0]] = 0;
+					if(!pageTable->isFaultPending(addr, PageTable::PTE)) {
+						pageTable->setFaultPending(addr, PageTable::PTE);
 						SambaEvent * tse = new SambaEvent(EventType::PAGE_FAULT);
 						//std::cout<< getName().c_str() << " Core id: " << coreId << " Fault at address "<<addr<<std::endl;
 						tse->setResp(addr,0,4096);
@@ -571,31 +481,27 @@ bool PageTableWalker::tick(SST::Cycle_t x)
 
 					stall = true;
 					*hold = 1;
-	//				(*MAPPED_PAGE_SIZE4KB)[addr/page_size[0]] = 0; // FIXME: Hack to avoid propogating faulting VA through all events, only for initial testing
+	//				pageTable->setMapped(addr, PageTable::PTE); // FIXME: Hack to avoid propogating faulting VA through all events, only for initial testing
 					return false;
 				}
 			}
 			else
 			{
-				uint64_t offset = (uint64_t)512*512*512*512;
-				if((*MAPPED_PAGE_SIZE4KB).find((addr/page_size[0])%offset)!=(*MAPPED_PAGE_SIZE4KB).end() || (*MAPPED_PAGE_SIZE2MB).find((addr/page_size[1])%(512*512*512))!=(*MAPPED_PAGE_SIZE2MB).end() || (*MAPPED_PAGE_SIZE1GB).find((addr/page_size[2])%(512*512))!=(*MAPPED_PAGE_SIZE1GB).end())
+				if(pageTable->isMapped(addr))
  					fault = false;
 
 	 			if(fault)
 	 			{
 					stall_addr = addr;
 					if(to_mem!=NULL) {
-					if((*PGD).find((addr/page_size[3])%512) == (*PGD).end()) {
+					if(!pageTable->isPresent(addr, PageTable::PGD)) {
 						stall_at_levels = 1;
 						stall_at_PGD = 1;
 						stall_at_PUD = 0;
 						stall_at_PMD = 0;
 						stall_at_PTE = 0;
-						if((*PENDING_PAGE_FAULTS_PGD).find((addr/page_size[3])%(512))==(*PENDING_PAGE_FAULTS_PGD).end()) {
-							(*PENDING_PAGE_FAULTS_PGD)[(addr/page_size[3])%512] = 0;
-							(*PENDING_PAGE_FAULTS_PUD)[(addr/page_size[2])%(512*512)] = 0;
-							(*PENDING_PAGE_FAULTS_PMD)[(addr/page_size[1])%(512*512*512)] = 0;
-							(*PENDING_PAGE_FAULTS_PTE)[(addr/page_size[0])%(offset)] = 0;
+						if(!pageTable->isFaultPending(addr, PageTable::PGD)) {
+							pageTable->setFaultPending(addr, PageTable::PGD);
 							stall_at_levels += 3;
 							SambaEvent * tse = new SambaEvent(EventType::PAGE_FAULT);
 							tse->setResp(addr,0,4096);
@@ -605,16 +511,14 @@ bool PageTableWalker::tick(SST::Cycle_t x)
 							return false;
 						}
 					}
-					else if((*PUD).find((addr/page_size[2])%(512*512)) == (*PUD).end()) {
+					else if(!pageTable->isPresent(addr, PageTable::PUD)) {
 						stall_at_levels = 1;
 						stall_at_PGD = 0;
 						stall_at_PUD = 1;
 						stall_at_PMD = 0;
 						stall_at_PTE = 0;
-						if((*PENDING_PAGE_FAULTS_PUD).find((addr/page_size[2])%(512*512))==(*PENDING_PAGE_FAULTS_PUD).end()) {
-							(*PENDING_PAGE_FAULTS_PUD)[(addr/page_size[2])%(512*512)] = 0;
-							(*PENDING_PAGE_FAULTS_PMD)[(addr/page_size[1])%(512*512*512)] = 0;
-							(*PENDING_PAGE_FAULTS_PTE)[(addr/page_size[0])%(offset)] = 0;
+						if(!pageTable->isFaultPending(addr, PageTable::PUD)) {
+							pageTable->setFaultPending(addr, PageTable::PUD);
 							stall_at_levels += 2;
 							SambaEvent * tse = new SambaEvent(EventType::PAGE_FAULT);
 							tse->setResp(addr,0,4096);
@@ -624,15 +528,14 @@ bool PageTableWalker::tick(SST::Cycle_t x)
 							return false;
 						}
 					}
-					else if((*PMD).find((addr/page_size[1])%(512*512*512)) == (*PMD).end()) {
+					else if(!pageTable->isPresent(addr, PageTable::PMD)) {
 						stall_at_levels = 1;
 						stall_at_PGD = 0;
 						stall_at_PUD = 0;
 						stall_at_PMD = 1;
 						stall_at_PTE = 0;
-						if((*PENDING_PAGE_FAULTS_PMD).find((addr/page_size[1])%(512*512*512))==(*PENDING_PAGE_FAULTS_PMD).end()) {
-							(*PENDING_PAGE_FAULTS_PMD)[(addr/page_size[1])%(512*512*512)] = 0;
-							(*PENDING_PAGE_FAULTS_PTE)[(addr/page_size[0])%(offset)] = 0;
+						if(!pageTable->isFaultPending(addr, PageTable::PMD)) {
+							pageTable->setFaultPending(addr, PageTable::PMD);
 							stall_at_levels += 1;
 							SambaEvent * tse = new SambaEvent(EventType::PAGE_FAULT);
 							tse->setResp(addr,0,4096);
@@ -642,14 +545,14 @@ bool PageTableWalker::tick(SST::Cycle_t x)
 							return false;
 						}
 					}
-					else if((*PTE).find((addr/page_size[0])%(offset)) == (*PTE).end()) {
+					else if(!pageTable->isPresent(addr, PageTable::PTE)) {
 						stall_at_levels = 1;
 						stall_at_PGD = 0;
 						stall_at_PUD = 0;
 						stall_at_PMD = 0;
 						stall_at_PTE = 1;
-						if((*PENDING_PAGE_FAULTS_PTE).find((addr/page_size[0])%(offset))==(*PENDING_PAGE_FAULTS_PTE).end()) {
-							(*PENDING_PAGE_FAULTS_PTE)[(addr/page_size[0])%(offset)] = 0;
+						if(!pageTable->isFaultPending(addr, PageTable::PTE)) {
+							pageTable->setFaultPending(addr, PageTable::PTE);
 							SambaEvent * tse = new SambaEvent(EventType::PAGE_FAULT);
 							tse->setResp(addr,0,4096);
 							s_EventChan->send(tse);
@@ -668,8 +571,8 @@ bool PageTableWalker::tick(SST::Cycle_t x)
 						stall_at_PUD = 0;
 						stall_at_PMD = 0;
 						stall_at_PTE = 1;
-						if((*PENDING_PAGE_FAULTS_PTE).find((addr/page_size[0])%(offset))==(*PENDING_PAGE_FAULTS_PTE).end()) {
-							(*PENDING_PAGE_FAULTS_PTE)[(addr/page_size[0])%(offset)] = 0;
+						if(!pageTable->isFaultPending(addr, PageTable::PTE)) {
+							pageTable->setFaultPending(addr, PageTable::PTE);
 							SambaEvent * tse = new SambaEvent(EventType::PAGE_FAULT);
 							tse->setResp(addr,0,4096);
 							s_EventChan->send(tse);
@@ -742,21 +645,20 @@ bool PageTableWalker::tick(SST::Cycle_t x)
 					if(emulate_faults)
 					{
 						if(!ptw_confined)
-							dummy_add = (*CR3) + (addr/page_size[2])%512;
+							dummy_add = pageTable->getCR3() + (addr/page_size[2])%512;
 						else
 						{
 							if(k==4) {
-								dummy_add = (*CR3) + ((addr/page_size[3])%512)*8;
+								dummy_add = pageTable->getCR3() + ((addr/page_size[3])%512)*8;
 							}
 							else if(k==3) {
-								dummy_add = (*PGD)[(addr/page_size[3])%512] + ((addr/page_size[2])%512)*8;
+								dummy_add = pageTable->getEntry(addr, PageTable::PGD) + ((addr/page_size[2])%512)*8;
 							}
 							else if(k==2) {
-								dummy_add = (*PUD)[(addr/page_size[2])%(512*512)] + ((addr/page_size[1])%512)*8;
+								dummy_add = pageTable->getEntry(addr, PageTable::PUD) + ((addr/page_size[1])%512)*8;
 							}
 							else if (k==1) {
-								uint64_t offset = (uint64_t)512*512*512;
-								dummy_add = (*PMD)[(addr/page_size[1])%offset] + ((addr/page_size[0])%512)*8;
+								dummy_add = pageTable->getEntry(addr, PageTable::PMD) + ((addr/page_size[0])%512)*8;
 							}
 							else
 								output->fatal(CALL_INFO, -1, "MMU: PTW DANGER!!\n");
@@ -837,26 +739,11 @@ bool PageTableWalker::tick(SST::Cycle_t x)
 			service_back->push_back(st->first);
 
 
-			if(emulate_faults)
+			if(emulate_faults && !pageTable->isPresent(addr, PageTable::PTE))
 			{
-				if(!ptw_confined)
-				{
-					if((*PTE).find(addr/4096)==(*PTE).end())
-                	{
-						std::cout << "******* Major issue is in Page Table Walker **** " << std::endl;
-						std::cout << "The address is "<< hex << addr << " (" << addr / 4096 << ")" << std::endl;
-                    }
-                }
-                else
-                {
-                	uint64_t offset = (uint64_t)512*512*512*512;
-					if((*PTE).find((addr/4096)%offset)==(*PTE).end())
-                    {
- 						std::cout << "******* Major issue is in Page Table Walker **** " << std::endl;
- 						std::cout << "The address is "<< hex << addr << " (" << addr / 4096 << ")" << std::endl;
-					}
-                }
-            }
+				std::cout << "******* Major issue is in Page Table Walker **** " << std::endl;
+				std::cout << "The address is "<< hex << addr << " (" << addr / 4096 << ")" << std::endl;
+			}
 
 			(*service_back_size)[st->first]=ready_by_size[st->first];
 
@@ -31,11 +31,11 @@
 
 #include "utils.h"
 #include "PageFaultHandler.h"
+#include "PageTable.h"
 
 // This file defines the page table walker and
 
 typedef std::pair<uint64_t, int> id_type;
-typedef uint64_t Address_t;
 enum PageMigrationType { NONE, FTP};
 // FTP: First touch policy
 
@@ -86,33 +86,9 @@ namespace SST { namespace SambaComponent{
 		// ------------- Note that we assume that for each Samba componenet instance, all units run the same VMA, thus all share the same page table
 		// ------------- Our assumption is based on the fact that Ariel instances (mapped one-to-one to Samba instances) can only run one application
 
-		// Holds CR3 value of current context
-		Address_t *CR3;
-		int *cr3_init;
+		// Holds CR3 and the page table entries of each level, which pages are mapped and at which levels faults are pending
+		PageTable * pageTable;
 
-		// Holds the PGD physical pointers, the key is the 9 bits 39-47, i.e., VA/(4096*512*512*512)
-		std::map<Address_t, Address_t> * PGD;
-
-		// Holds the PUD physical pointers, the key is the 9 bits 30-38, i.e., VA/(4096*512*512)
-		std::map<Address_t, Address_t> * PUD;
-
-		// Holds the PMD physical pointers, the key is the 9 bits 21-29, i.e., VA/(4096*512)
-		std::map<Address_t, Address_t> * PMD;
-
-		// Holds the PTE physical pointers, the key is the 9 bits 12-20, i.e., VA/(4096)
-		std::map<Address_t, Address_t> * PTE; // This should give you the exact physical address of the page
-
-
-		// The structures below are used to quickly check if the page is mapped or not
-		std::map<Address_t,int> * MAPPED_PAGE_SIZE4KB;
-		std::map<Address_t,int> * MAPPED_PAGE_SIZE2MB;
-		std::map<Address_t,int> * MAPPED_PAGE_SIZE1GB;
-
-		std::map<Address_t,int> *PENDING_PAGE_FAULTS;
-		std::map<Address_t,int> *PENDING_PAGE_FAULTS_PGD;
-		std::map<Address_t,int> *PENDING_PAGE_FAULTS_PUD;
-		std::map<Address_t,int> *PENDING_PAGE_FAULTS_PMD;
-		std::map<Address_t,int> *PENDING_PAGE_FAULTS_PTE;
 		std::map<Address_t,int> *PENDING_SHOOTDOWN_EVENTS;
 
 
@@ -192,26 +168,7 @@ namespace SST { namespace SambaComponent{
 		PageTableWalker(ComponentId_t id, int page_size, int assoc, PageTableWalker * next_level, int size);
 		PageTableWalker(ComponentId_t id, int tlb_id, PageTableWalker * Next_level,int level, SST::Params& params);
 
-		void setPageTablePointers( Address_t * cr3, std::map<Address_t, Address_t> * pgd,  std::map<Address_t, Address_t> * pud,  std::map<Address_t, Address_t> * pmd, std::map<Address_t, Address_t> * pte,
-				std::map<Address_t,int> * gb,  std::map<Address_t,int> * mb,  std::map<Address_t,int> * kb, std::map<Address_t,int> * pr, int *cr3I, std::map<Address_t,int> *pf_pgd,  std::map<Address_t,int> *pf_pud,
-				std::map<Address_t,int> *pf_pmd, std::map<Address_t,int> * pf_pte)
-		{
-			CR3 = cr3;
-			PGD = pgd;
-			PUD = pud;
-			PMD = pmd;
-			PTE = pte;
-			MAPPED_PAGE_SIZE4KB = kb;
-			MAPPED_PAGE_SIZE2MB = mb;
-			MAPPED_PAGE_SIZE1GB = gb;
-			PENDING_PAGE_FAULTS = pr;
-			PENDING_PAGE_FAULTS_PGD = pf_pgd;
-			PENDING_PAGE_FAULTS_PUD = pf_pud;
-			PENDING_PAGE_FAULTS_PMD = pf_pmd;
-			PENDING_PAGE_FAULTS_PTE = pf_pte;
-
-			cr3_init = cr3I;
-		}
+		void setPageTable(PageTable * pt) { pageTable = pt; }
 
 		void setPageFaultHandler( PageFaultHandler *pfh) {
 			pageFaultHandler = pfh;
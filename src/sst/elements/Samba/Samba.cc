@@ -69,7 +69,9 @@ Samba::Samba(SST::ComponentId_t id, SST::Params& params): Component(id) {
 
 	ptw_to_mem = (SST::Link **) malloc( sizeof(SST::Link *) * core_count );
 
-	cr3I = 0;
+	pageTable = nullptr;
+	if(emulate_faults==1)
+		pageTable = new PageTable((uint32_t) params.find<uint32_t>("ptw_confined", 0));
 
 
 	char* link_buffer = (char*) malloc(sizeof(char) * 256);
@@ -120,7 +122,7 @@ Samba::Samba(SST::ComponentId_t id, SST::Params& params): Component(id) {
 			event_link = configureSelfLink(link_buffer, "1ns", new Event::Handler<PageTableWalker>(TLB[i]->getPTW(), &PageTableWalker::handleEvent));
 
 			TLB[i]->getPTW()->setEventChannel(event_link);
-			TLB[i]->setPageTablePointers(&CR3, &PGD, &PUD, &PMD, &PTE, &MAPPED_PAGE_SIZE1GB, &MAPPED_PAGE_SIZE2MB, &MAPPED_PAGE_SIZE4KB, &PENDING_PAGE_FAULTS, &cr3I, &PENDING_PAGE_FAULTS_PGD, &PENDING_PAGE_FAULTS_PUD, &PENDING_PAGE_FAULTS_PMD, &PENDING_PAGE_FAULTS_PTE);//, &PENDING_SHOOTDOWN_EVENTS, &PTR, &PTR_map);
+			TLB[i]->setPageTable(pageTable);
 
 		}
 
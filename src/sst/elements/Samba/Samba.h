@@ -38,6 +38,7 @@
 #include "TLBhierarchy.h"
 #include "PageTableWalker.h"
 #include "PageFaultHandler.h"
+#include "PageTable.h"
 #include <sst/elements/memHierarchy/memEventBase.h>
 
 //#include "arielcore.h"
@@ -85,7 +86,8 @@ namespace SST {
                     {"parallel_mode_L%(levels)d", "this is for the corner case of having a one cycle overlap with accessing cache","0"},
                     {"page_walk_latency", "Each page table walk latency in nanoseconds", "50"},
                     {"self_connected", "Determines if the page walkers are acutally connected to memory hierarchy or just add fixed latency (self-connected)", "0"},
-                    {"emulate_faults", "This indicates if the page faults should be emulated through requesting pages from page fault handler", "0"}
+                    {"emulate_faults", "This indicates if the page faults should be emulated through requesting pages from page fault handler", "0"},
+                    {"ptw_confined", "Confines the emulated page table to 48-bit virtual addresses", "0"}
                 )
 
                 SST_ELI_DOCUMENT_PORTS(
@@ -109,21 +111,7 @@ namespace SST {
 				// Following are the page table components of the application running on the Ariel instance that owns this Samba unit
 				// Note, the application might be multi-threaded, however, all threads will share the sambe page table components below
 
-				Address_t CR3;
-				std::map<Address_t, Address_t> PGD;
-				std::map<Address_t, Address_t> PUD;
-				std::map<Address_t, Address_t> PMD;
-				std::map<Address_t, Address_t> PTE;
-				std::map<Address_t,int>  MAPPED_PAGE_SIZE4KB;
-				std::map<Address_t,int>  MAPPED_PAGE_SIZE2MB;
-				std::map<Address_t,int>  MAPPED_PAGE_SIZE1GB;
-
-				std::map<Address_t,int> PENDING_PAGE_FAULTS;
-                std::map<Address_t,int> PENDING_PAGE_FAULTS_PGD;
-                std::map<Address_t,int> PENDING_PAGE_FAULTS_PUD;
-                std::map<Address_t,int> PENDING_PAGE_FAULTS_PMD;
-                std::map<Address_t,int> PENDING_PAGE_FAULTS_PTE;
-                int cr3I;
+				PageTable * pageTable;
 				std::map<Address_t,int> PENDING_SHOOTDOWN_EVENTS;
 
 
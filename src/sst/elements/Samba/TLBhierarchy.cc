@@ -251,22 +251,20 @@ bool TLBhierarchy::tick(SST::Cycle_t x)
 		if(emulate_faults)
 		{
 			Address_t vaddr = ((MemEvent*) event)->getVirtualAddress();
+			if(!pageTable->isPresent(vaddr, PageTable::PTE))
+				std::cout<<"Error: That page has never been mapped:  " << vaddr / 4096 << std::endl;
+
+			Address_t frame = pageTable->getEntry(vaddr, PageTable::PTE);
+
 			if(!ptw_confined)
 			{
-				if((*PTE).find(vaddr/4096)==(*PTE).end())
-					std::cout<<"Error: That page has never been mapped:  " << vaddr / 4096 << std::endl;
-
-				((MemEvent*) event)->setAddr((((*PTE)[vaddr / 4096] + vaddr % 4096) / 64) * 64);
-				((MemEvent*) event)->setBaseAddr((((*PTE)[vaddr / 4096] + vaddr % 4096) / 64) * 64);
+				((MemEvent*) event)->setAddr(((frame + vaddr % 4096) / 64) * 64);
+				((MemEvent*) event)->setBaseAddr(((frame + vaddr % 4096) / 64) * 64);
 			}
 			else
 			{
-				uint64_t offset = (uint64_t)512*512*512*512;
-				if((*PTE).find((vaddr/4096)%offset)==(*PTE).end())
-				std::cout<<"Error: That page has never been mapped:  " << vaddr / 4096 << std::endl;
-
-				((MemEvent*) event)->setAddr((((*PTE)[(vaddr / 4096)%offset] + vaddr % 4096)));
-				((MemEvent*) event)->setBaseAddr((((*PTE)[(vaddr / 4096)%offset] + vaddr % 4096) / 64) * 64);
+				((MemEvent*) event)->setAddr(frame + vaddr % 4096);
+				((MemEvent*) event)->setBaseAddr(((frame + vaddr % 4096) / 64) * 64);
 			}
 
 			/*if(page_placement) {
@@ -113,32 +113,9 @@ namespace SST { namespace SambaComponent{
 
 		uint32_t ptw_confined;
 
-		// Holds CR3 value of current context
-		Address_t *CR3;
-		//
-		// Holds the PGD physical pointers, the key is the 9 bits 39-47, i.e., VA/(4096*512*512*512)
-		std::map<Address_t, Address_t> * PGD;
+		// The page table shared with the page table walker and the other TLB hierarchies of this Samba unit
+		PageTable * pageTable;
 
-		// Holds the PUD physical pointers, the key is the 9 bits 30-38, i.e., VA/(4096*512*512)
-		std::map<Address_t, Address_t> * PUD;
-
-		// Holds the PMD physical pointers, the key is the 9 bits 21-29, i.e., VA/(4096*512)
-		std::map<Address_t, Address_t> * PMD;
-
-		// Holds the PTE physical pointers, the key is the 9 bits 12-20, i.e., VA/(4096)
-		std::map<Address_t, Address_t> * PTE; // This should give you the exact physical address of the page
-
-
-		// The structures below are used to quickly check if the page is mapped or not
-		std::map<Address_t,int> * MAPPED_PAGE_SIZE4KB;
-		std::map<Address_t,int> * MAPPED_PAGE_SIZE2MB;
-		std::map<Address_t,int> * MAPPED_PAGE_SIZE1GB;
-
-		std::map<Address_t,int> *PENDING_PAGE_FAULTS;
-		std::map<Address_t,int> *PENDING_PAGE_FAULTS_PGD;
-		std::map<Address_t,int> *PENDING_PAGE_FAULTS_PUD;
-		std::map<Address_t,int> *PENDING_PAGE_FAULTS_PMD;
-		std::map<Address_t,int> *PENDING_PAGE_FAULTS_PTE;
 		std::map<Address_t,int> *PENDING_SHOOTDOWN_EVENTS;
 
 		uint64_t memory_size;
@@ -154,27 +131,12 @@ namespace SST { namespace SambaComponent{
 		void handleEvent_CPU(SST::Event * event);
 
 
-		void setPageTablePointers( Address_t * cr3, std::map<Address_t, Address_t> * pgd,  std::map<Address_t, Address_t> * pud,  std::map<Address_t, Address_t> * pmd, std::map<Address_t, Address_t> * pte,
-				std::map<Address_t,int> * gb,  std::map<Address_t,int> * mb,  std::map<Address_t,int> * kb, std::map<Address_t,int> * pr, int *cr3I, std::map<Address_t,int> *pf_pgd,
-				std::map<Address_t,int> *pf_pud,  std::map<Address_t,int> *pf_pmd, std::map<Address_t,int> * pf_pte)
+		void setPageTable(PageTable * pt)
 		{
-	                CR3 = cr3;
-                        PGD = pgd;
-                        PUD = pud;
-                        PMD = pmd;
-                        PTE = pte;
-                        MAPPED_PAGE_SIZE4KB = kb;
-                        MAPPED_PAGE_SIZE2MB = mb;
-                        MAPPED_PAGE_SIZE1GB = gb;
-                        PENDING_PAGE_FAULTS = pr;
-                        PENDING_PAGE_FAULTS_PGD = pf_pgd;
-						PENDING_PAGE_FAULTS_PUD = pf_pud;
-						PENDING_PAGE_FAULTS_PMD = pf_pmd;
-						PENDING_PAGE_FAULTS_PTE = pf_pte;
+			pageTable = pt;
 
 			if(PTW!=nullptr)
-				//PTW->setPageTablePointers(cr3, pgd, pud, pmd, pte, gb, mb, kb, pr, sr);
-				PTW->setPageTablePointers(cr3, pgd, pud, pmd, pte, gb, mb, kb, pr, cr3I, pf_pgd, pf_pud, pf_pmd, pf_pte);
+				PTW->setPageTable(pt);
 
 		}
 		// Constructor for component
@@ -41,6 +41,13 @@
 #endif
 
 #define ARIEL_MAX_PAYLOAD_SIZE 64
+/* Memory operations carried by one ARIEL_PERFORM_MEM_OPS command */
+#define ARIEL_MAX_MEM_OPS 4
+
+/* ArielMemOp flags */
+#define ARIEL_MEMOP_WRITE 0x1   /* Write, otherwise read */
+#define ARIEL_MEMOP_START 0x2   /* First operation of an instruction */
+#define ARIEL_MEMOP_NOOP  0x4   /* Instruction without memory operations */
 
 namespace SST {
 namespace ArielComponent {
@@ -64,6 +71,8 @@ enum ArielShmemCmd_t {
     ARIEL_ISSUE_CUDA = 144,
     ARIEL_FLUSHLINE_INSTRUCTION = 154,
     ARIEL_FENCE_INSTRUCTION = 155,
+    ARIEL_PERFORM_MEM_OPS = 156,
+    ARIEL_WRITE_PAYLOAD = 157,
 };
 
 #ifdef HAVE_CUDA
@@ -126,6 +135,31 @@ struct CudaArguments {
 };
 #endif
 
+/*
+ * One read or write in an ARIEL_PERFORM_MEM_OPS command. The instruction
+ * class and SIMD width are only meaningful on the first operation of an
+ * instruction (ARIEL_MEMOP_START).
+ */
+struct ArielMemOp {
+    uint64_t addr;
+    uint32_t size;
+    uint8_t  flags;
+    uint8_t  instClass;
+    uint16_t simdElemCount;
+};
+
+/*
+ * Instructions are sent as ARIEL_PERFORM_MEM_OPS commands, each packing
+ * the reads, writes and no-ops of up to ARIEL_MAX_MEM_OPS operations from
+ * consecutive instructions, so the tunnel is written once per command
+ * instead of once per instruction marker and operation. Write
+ * data is only sent when write payload tracing is on: each write is then
+ * followed by an ARIEL_WRITE_PAYLOAD command holding its data, so the
+ * payload does not take space in every command.
+ *
+ * ARIEL_START_INSTRUCTION, ARIEL_PERFORM_READ/WRITE and
+ * ARIEL_END_INSTRUCTION (using 'inst') are still understood.
+ */
 struct ArielCommand {
     ArielShmemCmd_t command;
     uint64_t instPtr;
@@ -135,8 +169,14 @@ struct ArielCommand {
             uint64_t addr;
             uint32_t instClass;
             uint32_t simdElemCount;
-            uint8_t  payload[ARIEL_MAX_PAYLOAD_SIZE];
         } inst;
+        struct {
+            uint32_t count;
+            ArielMemOp ops[ARIEL_MAX_MEM_OPS];
+        } mem_ops;
+        struct {
+            uint8_t data[ARIEL_MAX_PAYLOAD_SIZE];
+        } payload;
         struct {
             uint64_t vaddr;
             uint64_t alloc_len;
@@ -0,0 +1,60 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+#include <sst_config.h>
+
+
+#include "arielcoltracegen.h"
+
+using namespace SST::ArielComponent;
+
+ArielColumnarTraceGenerator::ArielColumnarTraceGenerator(Params& params) :
+    ArielTraceGenerator() {
+
+    tracePrefix = params.find<std::string>("trace_prefix", "ariel-core");
+    chunkRecords = params.find<uint32_t>("chunk_records", 65536);
+    compressionLevel = params.find<int>("compression_level", 6);
+    coreID = 0;
+
+    output = new Output("ArielColumnarTraceGenerator[@f:@l:@p] ", 0, 0, Output::STDOUT);
+}
+
+ArielColumnarTraceGenerator::~ArielColumnarTraceGenerator() {
+    std::string error;
+
+    if(!writer.close(error)) {
+        output->output("Error finishing trace for core %" PRIu32 ": %s\n", coreID, error.c_str());
+    }
+
+    delete output;
+}
+
+void ArielColumnarTraceGenerator::publishEntry(const uint64_t picoS,
+        const uint64_t physAddr,
+        const uint32_t reqLength,
+        const ArielTraceEntryOperation op) {
+
+    writer.append(picoS, physAddr, reqLength, WRITE == op);
+}
+
+void ArielColumnarTraceGenerator::setCoreID(const uint32_t core) {
+    coreID = core;
+
+    const std::string tracePath = tracePrefix + "-" + std::to_string(core) + ".ctrace";
+    std::string error;
+
+    if(!writer.open(tracePath, chunkRecords, compressionLevel, error)) {
+        output->fatal(CALL_INFO, -1, "Unable to create trace for core %" PRIu32 ": %s\n", core, error.c_str());
+    }
+}
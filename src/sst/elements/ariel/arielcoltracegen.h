@@ -0,0 +1,69 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_ARIEL_COLUMNAR_TRACE_GEN
+#define _H_SST_ARIEL_COLUMNAR_TRACE_GEN
+
+#include <string>
+
+#include <sst/core/output.h>
+#include <sst/core/params.h>
+#include <sst/elements/prospero/proscolumnar.h>
+#include "arieltracegen.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * Writes each core's accesses in the Prospero columnar trace format,
+ * readable with prospero.ProsperoColumnarTraceReader.
+ */
+class ArielColumnarTraceGenerator : public ArielTraceGenerator {
+
+    public:
+
+        SST_ELI_REGISTER_MODULE(ArielColumnarTraceGenerator, "ariel", "ColumnarTraceGenerator",
+                SST_ELI_ELEMENT_VERSION(1,0,0), "Provides tracing to delta encoded, chunked columnar files", "SST::ArielComponent::ArielTraceGenerator")
+
+        SST_ELI_DOCUMENT_PARAMS(
+            { "trace_prefix", "Sets the prefix for the trace file, which is named <prefix>-<core>.ctrace", "ariel-core" },
+            { "chunk_records", "Number of records in each independently decoded chunk", "65536" },
+            { "compression_level", "zlib level for the chunks, 0 stores them uncompressed", "6" }
+        )
+
+        ArielColumnarTraceGenerator(Params& params);
+
+        ~ArielColumnarTraceGenerator();
+
+        void publishEntry(const uint64_t picoS, const uint64_t physAddr,
+                const uint32_t reqLength, const ArielTraceEntryOperation op);
+
+        void setCoreID(const uint32_t core);
+
+    private:
+        SST::Prospero::ProsperoColumnarTraceWriter writer;
+        std::string tracePrefix;
+        uint32_t chunkRecords;
+        int compressionLevel;
+        uint32_t coreID;
+        Output* output;
+
+};
+
+}
+}
+
+#endif
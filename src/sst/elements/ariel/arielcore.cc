@@ -55,7 +55,9 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
     memmgr = memMgr;
 
     writePayloads = params.find<int>("writepayloadtrace") == 0 ? false : true;
-    coreQ = new std::queue<ArielEvent*>();
+    // Room for a full queue plus the last command read to refill it
+    coreQ = new ArielCoreQueue(maxQLength + ARIEL_MAX_MEM_OPS,
+            writePayloads ? (uint32_t) std::max(cacheLineSize, (uint64_t) ARIEL_MAX_PAYLOAD_SIZE) : 0);
     pendingTransactions = new std::unordered_map<SimpleMem::Request::id_t, SimpleMem::Request*>();
     pending_transaction_count = 0;
 
@@ -124,6 +126,8 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
 }
 
 ArielCore::~ArielCore() {
+    delete coreQ;
+
     if(NULL != cacheLink) {
         delete cacheLink;
     }
@@ -352,9 +356,7 @@ void ArielCore::handleEvent(SimpleMem::Request* event) {
                         output->verbose(CALL_INFO, 16, 0, "\n");
                     }
 
-                    ArielWriteEvent* awe;
-                    awe = new ArielWriteEvent(getCurrentAddress(), current_transfer, &getDataAddress()[index]);
-                    handleWriteRequest(awe);
+                    handleWriteRequest(getCurrentAddress(), current_transfer, &getDataAddress()[index]);
                     setCurrentAddress(getCurrentAddress() + current_transfer);
                     setRemainingPageTransfer(getRemainingPageTransfer() - current_transfer);
                 }
@@ -459,17 +461,15 @@ void ArielCore::handleEvent(SimpleMem::Request* event) {
                 }
                 pendingGpuTransactions->erase(pendingGpuTransactions->find(mev_id));
                 pending_transaction_count--;
-                ArielReadEvent *are;
                 while((getOpenTransactions() > 0) && (getRemainingTransfer() > 0)){
                     if(getRemainingTransfer() <= 64) {
-                        are = new ArielReadEvent(getCurrentAddress(), getRemainingTransfer());
+                        handleReadRequest(getCurrentAddress(), getRemainingTransfer());
                         setRemainingTransfer(0);
                     }else {
-                        are = new ArielReadEvent(getCurrentAddress(), 64);
+                        handleReadRequest(getCurrentAddress(), 64);
                         setRemainingTransfer(getRemainingTransfer()-64);
                         setCurrentAddress(getCurrentAddress() + 64);
                     }
-                    handleReadRequest(are);
                 }
             }
         }
@@ -618,79 +618,100 @@ void ArielCore::unfence()
 }
 
 
-void ArielCore::handleSwitchPoolEvent(ArielSwitchPoolEvent* aSPE) {
-    ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Core: %" PRIu32 " set default memory pool to: %" PRIu32 "\n", coreID, aSPE->getPool()));
-    memmgr->setDefaultPool(aSPE->getPool());
+void ArielCore::handleSwitchPoolEvent(const ArielCoreOp& op) {
+    ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Core: %" PRIu32 " set default memory pool to: %" PRIu32 "\n", coreID, op.pool));
+    memmgr->setDefaultPool(op.pool);
 }
 
 void ArielCore::createSwitchPoolEvent(uint32_t newPool) {
-    ArielSwitchPoolEvent* ev = new ArielSwitchPoolEvent(newPool);
-    coreQ->push(ev);
+    ArielCoreOp& op = coreQ->push(SWITCH_POOL);
+    op.pool = newPool;
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a switch pool event on core %" PRIu32 ", new level is: %" PRIu32 "\n", coreID, newPool));
 }
 
 void ArielCore::createNoOpEvent() {
-    ArielNoOpEvent* ev = new ArielNoOpEvent();
-    coreQ->push(ev);
+    coreQ->push(NOOP);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a No Op event on core %" PRIu32 "\n", coreID));
 }
 
 void ArielCore::createReadEvent(uint64_t address, uint32_t length) {
-    ArielReadEvent* ev = new ArielReadEvent(address, length);
-    coreQ->push(ev);
+    ArielCoreOp& op = coreQ->push(READ_ADDRESS);
+    op.addr = address;
+    op.length = length;
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a READ event, addr=%" PRIu64 ", length=%" PRIu32 "\n", address, length));
 }
 
 void ArielCore::createAllocateEvent(uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr) {
-    ArielAllocateEvent* ev = new ArielAllocateEvent(vAddr, length, level, instPtr);
-    coreQ->push(ev);
+    ArielCoreOp& op = coreQ->push(MALLOC);
+    op.addr = vAddr;
+    op.length = length;
+    op.level = level;
+    op.instPtr = instPtr;
 
     ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated an allocate event, vAddr(map)=%" PRIu64 ", length=%" PRIu64 " in level %" PRIu32 " from IP %" PRIx64 "\n",
                     vAddr, length, level, instPtr));
 }
 
 void ArielCore::createMmapEvent(uint32_t fileID, uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr) {
-    ArielMmapEvent* ev = new ArielMmapEvent(fileID, vAddr, length, level, instPtr);
-    coreQ->push(ev);
+    ArielCoreOp& op = coreQ->push(MMAP);
+    op.addr = vAddr;
+    op.length = length;
+    op.level = level;
+    op.instPtr = instPtr;
+    op.fileID = fileID;
 
     ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated an mmap event, vAddr(map)=%" PRIu64 ", length=%" PRIu64 " in level %" PRIu32 " from IP %" PRIx64 "\n",
                     vAddr, length, level, instPtr));
 }
 
 void ArielCore::createFreeEvent(uint64_t vAddr) {
-    ArielFreeEvent* ev = new ArielFreeEvent(vAddr);
-    coreQ->push(ev);
+    ArielCoreOp& op = coreQ->push(FREE);
+    op.addr = vAddr;
 
     ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated a free event for virtual address=%" PRIu64 "\n", vAddr));
 }
 
 void ArielCore::createWriteEvent(uint64_t address, uint32_t length, const uint8_t* payload) {
-    ArielWriteEvent* ev = new ArielWriteEvent(address, length, payload);
-    coreQ->push(ev);
+    ArielCoreOp& op = coreQ->push(WRITE_ADDRESS);
+    op.addr = address;
+    op.length = length;
+
+    if(writePayloads) {
+        // Only the first ARIEL_MAX_PAYLOAD_SIZE bytes are traced, the
+        // rest of the slot (writes are trimmed to a line) is zeroed
+        const uint32_t slotSize = (uint32_t) std::max(cacheLineSize, (uint64_t) ARIEL_MAX_PAYLOAD_SIZE);
+        const uint32_t copySize = std::min(length, (uint32_t) ARIEL_MAX_PAYLOAD_SIZE);
+        uint8_t* slot = coreQ->backPayload();
+
+        if(payload != NULL) {
+            memcpy(slot, payload, copySize);
+        } else {
+            memset(slot, 0, copySize);
+        }
+        memset(slot + copySize, 0, std::min(length, slotSize) - copySize);
+    }
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a WRITE event, addr=%" PRIu64 ", length=%" PRIu32 "\n", address, length));
 }
 
 void ArielCore::createFlushEvent(uint64_t vAddr){
-    ArielFlushEvent *ev = new ArielFlushEvent(vAddr, cacheLineSize);
-    coreQ->push(ev);
+    ArielCoreOp& op = coreQ->push(FLUSH);
+    op.addr = vAddr;
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO,4,0, "Generated a FLUSH event.\n"));
 }
 
 void ArielCore::createFenceEvent(){
-    ArielFenceEvent *ev = new ArielFenceEvent();
-    coreQ->push(ev);
+    coreQ->push(FENCE);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a FENCE event.\n"));
 }
 
 void ArielCore::createExitEvent() {
-    ArielExitEvent* xEv = new ArielExitEvent();
-    coreQ->push(xEv);
+    coreQ->push(CORE_EXIT);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated an EXIT event.\n"));
 }
@@ -705,8 +726,8 @@ bool ArielCore::isCoreStalled() const {
 
 #ifdef HAVE_CUDA
 void ArielCore::createGpuEvent(GpuApi_t API, CudaArguments CA) {
-    ArielGpuEvent* gEv = new ArielGpuEvent(API, CA);
-    coreQ->push(gEv);
+    ArielCoreOp& op = coreQ->push(GPU);
+    op.event = new ArielGpuEvent(API, CA);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a CUDA event.\n"));
 }
@@ -805,30 +826,12 @@ bool ArielCore::refillQueue() {
                 performGlobalStatisticOutput();
                 break;
 
-            case ARIEL_START_INSTRUCTION:
-                if(ARIEL_INST_SP_FP == ac.inst.instClass) {
-                        statFPSPIns->addData(1);
-
-                        if(ac.inst.simdElemCount > 1) {
-                            statFPSPSIMDIns->addData(1);
-                        } else {
-                            statFPSPScalarIns->addData(1);
-                        }
-
-                        if(ac.inst.simdElemCount < 32)
-                            statFPSPOps->addData(ac.inst.simdElemCount);
-                } else if(ARIEL_INST_DP_FP == ac.inst.instClass) {
-                        statFPDPIns->addData(1);
-
-                        if(ac.inst.simdElemCount > 1) {
-                            statFPDPSIMDIns->addData(1);
-                        } else {
-                            statFPDPScalarIns->addData(1);
-                        }
+            case ARIEL_PERFORM_MEM_OPS:
+                createMemOpEvents(ac);
+                break;
 
-                        if(ac.inst.simdElemCount < 16)
-                            statFPDPOps->addData(ac.inst.simdElemCount);
-                }
+            case ARIEL_START_INSTRUCTION:
+                countInstruction(ac.inst.instClass, ac.inst.simdElemCount);
 
                 while(ac.command != ARIEL_END_INSTRUCTION) {
                         ac = tunnel->readMessage(coreID);
@@ -839,7 +842,15 @@ bool ArielCore::refillQueue() {
                                     break;
 
                             case ARIEL_PERFORM_WRITE:
-                                    createWriteEvent(ac.inst.addr, ac.inst.size, &ac.inst.payload[0]);
+                                    if( writePayloads ) {
+                                        const ArielCommand pc = tunnel->readMessage(coreID);
+                                        if(pc.command != ARIEL_WRITE_PAYLOAD) {
+                                            output->fatal(CALL_INFO, -1, "Error: Ariel expected a write payload but received command (%d).\n", (int)(pc.command));
+                                        }
+                                        createWriteEvent(ac.inst.addr, ac.inst.size, &pc.payload.data[0]);
+                                    } else {
+                                        createWriteEvent(ac.inst.addr, ac.inst.size, NULL);
+                                    }
                                     break;
 
                             case ARIEL_END_INSTRUCTION:
@@ -904,17 +915,74 @@ bool ArielCore::refillQueue() {
     return true;
 }
 
-void ArielCore::handleFreeEvent(ArielFreeEvent* rFE) {
-    ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a free event (for virtual address=%" PRIu64 ")\n", coreID, rFE->getVirtualAddress()));
+void ArielCore::countInstruction(uint32_t instClass, uint32_t simdElemCount) {
+    if(ARIEL_INST_SP_FP == instClass) {
+            statFPSPIns->addData(1);
 
-    memmgr->freeMalloc(rFE->getVirtualAddress());
+            if(simdElemCount > 1) {
+                statFPSPSIMDIns->addData(1);
+            } else {
+                statFPSPScalarIns->addData(1);
+            }
+
+            if(simdElemCount < 32)
+                statFPSPOps->addData(simdElemCount);
+    } else if(ARIEL_INST_DP_FP == instClass) {
+            statFPDPIns->addData(1);
+
+            if(simdElemCount > 1) {
+                statFPDPSIMDIns->addData(1);
+            } else {
+                statFPDPScalarIns->addData(1);
+            }
+
+            if(simdElemCount < 16)
+                statFPDPOps->addData(simdElemCount);
+    }
+}
+
+void ArielCore::createMemOpEvents(const ArielCommand& ac) {
+    if(ac.mem_ops.count > ARIEL_MAX_MEM_OPS) {
+        output->fatal(CALL_INFO, -1, "Error: Ariel received %" PRIu32 " memory operations in one command, at most %d are allowed.\n",
+            ac.mem_ops.count, ARIEL_MAX_MEM_OPS);
+    }
+
+    for(uint32_t i = 0; i < ac.mem_ops.count; i++) {
+        const ArielMemOp& op = ac.mem_ops.ops[i];
+
+        if(op.flags & ARIEL_MEMOP_START) {
+            countInstruction(op.instClass, op.simdElemCount);
+        }
+
+        if(op.flags & ARIEL_MEMOP_NOOP) {
+            createNoOpEvent();
+        } else if(op.flags & ARIEL_MEMOP_WRITE) {
+            if( writePayloads ) {
+                // The data follows in its own command
+                const ArielCommand pc = tunnel->readMessage(coreID);
+                if(pc.command != ARIEL_WRITE_PAYLOAD) {
+                    output->fatal(CALL_INFO, -1, "Error: Ariel expected a write payload but received command (%d).\n", (int)(pc.command));
+                }
+                createWriteEvent(op.addr, op.size, &pc.payload.data[0]);
+            } else {
+                createWriteEvent(op.addr, op.size, NULL);
+            }
+        } else {
+            createReadEvent(op.addr, op.size);
+        }
+    }
 }
 
-void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
+void ArielCore::handleFreeEvent(const ArielCoreOp& op) {
+    ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a free event (for virtual address=%" PRIu64 ")\n", coreID, op.addr));
+
+    memmgr->freeMalloc(op.addr);
+}
+
+void ArielCore::handleReadRequest(uint64_t readAddress, uint32_t length) {
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a read event...\n", coreID));
 
-    const uint64_t readAddress = rEv->getAddress();
-    const uint64_t readLength  = std::min((uint64_t) rEv->getLength(), cacheLineSize); // Trim to cacheline size (occurs rarely for instructions such as xsave and fxsave)
+    const uint64_t readLength  = std::min((uint64_t) length, cacheLineSize); // Trim to cacheline size (occurs rarely for instructions such as xsave and fxsave)
 
     /* No longer neccessary due to trimming above
      * if(readLength > cacheLineSize) {
@@ -984,11 +1052,10 @@ void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
     statReadRequestSizes->addData(readLength);
 }
 
-void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
+void ArielCore::handleWriteRequest(uint64_t writeAddress, uint32_t length, const uint8_t* payload) {
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a write event...\n", coreID));
 
-    const uint64_t writeAddress = wEv->getAddress();
-    const uint64_t writeLength  = std::min((uint64_t) wEv->getLength(), cacheLineSize); // Trim to cacheline size (occurs rarely for instructions such as xsave and fxsave)
+    const uint64_t writeLength  = std::min((uint64_t) length, cacheLineSize); // Trim to cacheline size (occurs rarely for instructions such as xsave and fxsave)
 
     // No longer neccessary due to trimming above
 /*    if(writeLength > cacheLineSize) {
@@ -1018,8 +1085,7 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
                             coreID, writeAddress, writeLength, physAddr));
 
         if( writePayloads ) {
-            uint8_t* payloadPtr = wEv->getPayload();
-            commitWriteEvent(physAddr, writeAddress, (uint32_t) writeLength, payloadPtr);
+            commitWriteEvent(physAddr, writeAddress, (uint32_t) writeLength, payload);
         } else {
             commitWriteEvent(physAddr, writeAddress, (uint32_t) writeLength, NULL);
         }
@@ -1058,9 +1124,8 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
         }
 
         if( writePayloads ) {
-            uint8_t* payloadPtr = wEv->getPayload();
-            commitWriteEvent(physLeftAddr, leftAddr, (uint32_t) leftSize, payloadPtr);
-            commitWriteEvent(physRightAddr, rightAddr, (uint32_t) rightSize, &payloadPtr[leftSize]);
+            commitWriteEvent(physLeftAddr, leftAddr, (uint32_t) leftSize, payload);
+            commitWriteEvent(physRightAddr, rightAddr, (uint32_t) rightSize, &payload[leftSize]);
         } else {
             commitWriteEvent(physLeftAddr, leftAddr, (uint32_t) leftSize, NULL);
             commitWriteEvent(physRightAddr, rightAddr, (uint32_t) rightSize, NULL);
@@ -1074,27 +1139,25 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
 
 
 
-void ArielCore::handleMmapEvent(ArielMmapEvent* aEv) {
-    memmgr->allocateMMAP(aEv->getAllocationLength(), aEv->getAllocationLevel(), aEv->getVirtualAddress(),
-            aEv->getInstructionPointer(), aEv->getFileID(), coreID);
+void ArielCore::handleMmapEvent(const ArielCoreOp& op) {
+    memmgr->allocateMMAP(op.length, op.level, op.addr, op.instPtr, op.fileID, coreID);
 }
 
-void ArielCore::handleAllocationEvent(ArielAllocateEvent* aEv) {
+void ArielCore::handleAllocationEvent(const ArielCoreOp& op) {
     output->verbose(CALL_INFO, 2, 0, "Handling a memory allocation event, vAddr=%" PRIu64 ", length=%" PRIu64 ", at level=%" PRIu32 " with malloc ID=%" PRIu64 "\n",
-                aEv->getVirtualAddress(), aEv->getAllocationLength(), aEv->getAllocationLevel(), aEv->getInstructionPointer());
+                op.addr, op.length, op.level, op.instPtr);
 
-    memmgr->allocateMalloc(aEv->getAllocationLength(), aEv->getAllocationLevel(), aEv->getVirtualAddress(), aEv->getInstructionPointer(), coreID);
+    memmgr->allocateMalloc(op.length, op.level, op.addr, op.instPtr, coreID);
 }
 
-void ArielCore::handleFlushEvent(ArielFlushEvent *flEv) {
-    const uint64_t virtualAddress = (uint64_t) flEv->getVirtualAddress();
-    const uint64_t readLength = (uint64_t) flEv->getLength();
+void ArielCore::handleFlushEvent(const ArielCoreOp& op) {
+    const uint64_t virtualAddress = op.addr;
 
     const uint64_t physAddr = memmgr->translateAddress(virtualAddress);
-    commitFlushEvent(physAddr, virtualAddress, (uint32_t) readLength);
+    commitFlushEvent(physAddr, virtualAddress, (uint32_t) cacheLineSize);
 }
 
-void ArielCore::handleFenceEvent(ArielFenceEvent *fEv) {
+void ArielCore::handleFenceEvent() {
     /*  Todo: Should we treat this like the Flush event, and require that the Fence
     *  be put into a transaction queue?  */
     // Possibility A:
@@ -1166,9 +1229,7 @@ void ArielCore::handleGpuEvent(ArielGpuEvent* gEv){
                                 output->verbose(CALL_INFO, 16, 0, "\n");
                             }
 
-                            ArielWriteEvent* awe;
-                            awe = new ArielWriteEvent(getCurrentAddress(), current_transfer, &getDataAddress()[index]);
-                            handleWriteRequest(awe);
+                            handleWriteRequest(getCurrentAddress(), current_transfer, &getDataAddress()[index]);
                             setCurrentAddress(getCurrentAddress() + current_transfer);
                             setRemainingPageTransfer(getRemainingPageTransfer() - current_transfer);
                         }
@@ -1269,17 +1330,15 @@ void ArielCore::handleGpuAckEvent(SST::Event* e){
     if (ev->getType() == BalarComponent::EventType::RESPONSE){
         if((ev->API == GPU_MEMCPY_RET)&&(ev->CA.cuda_memcpy.kind == cudaMemcpyDeviceToHost)){
             // Device to Host still needs us to get the data for fesimple
-            ArielReadEvent *are;
             while((getOpenTransactions() > 0) && (getRemainingTransfer() > 0)){
                 if(getRemainingTransfer() <= 64) {
-                    are = new ArielReadEvent(getCurrentAddress(), getRemainingTransfer());
+                    handleReadRequest(getCurrentAddress(), getRemainingTransfer());
                     setRemainingTransfer(0);
                 }else {
-                    are = new ArielReadEvent(getCurrentAddress(), 64);
+                    handleReadRequest(getCurrentAddress(), 64);
                     setRemainingTransfer(getRemainingTransfer()-64);
                     setCurrentAddress(getCurrentAddress() + 64);
                 }
-                handleReadRequest(are);
             }
         } else {
             output->verbose(CALL_INFO, 16, 0, "CUDA: Ariel recieved ACK\n");
@@ -1330,10 +1389,10 @@ bool ArielCore::processNextEvent() {
 
     ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Processing next event in core %" PRIu32 "...\n", coreID));
 
-    ArielEvent* nextEvent = coreQ->front();
+    ArielCoreOp& nextOp = coreQ->front();
     bool removeEvent = false;
 
-    switch(nextEvent->getEventType()) {
+    switch(nextOp.type) {
         case NOOP:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is NOOP\n", coreID));
                 statInstructionCount->addData(1);
@@ -1351,7 +1410,7 @@ bool ArielCore::processNextEvent() {
                     statInstructionCount->addData(1);
                     inst_count++;
                     removeEvent = true;
-                    handleReadRequest(dynamic_cast<ArielReadEvent*>(nextEvent));
+                    handleReadRequest(nextOp.addr, (uint32_t) nextOp.length);
                 } else {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Pending transaction queue is currently full for core %" PRIu32 ", core will stall for new events\n", coreID));
                     break;
@@ -1367,7 +1426,7 @@ bool ArielCore::processNextEvent() {
                     statInstructionCount->addData(1);
                     inst_count++;
                             removeEvent = true;
-                    handleWriteRequest(dynamic_cast<ArielWriteEvent*>(nextEvent));
+                    handleWriteRequest(nextOp.addr, (uint32_t) nextOp.length, writePayloads ? coreQ->frontPayload() : NULL);
                 } else {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Pending transaction queue is currently full for core %" PRIu32 ", core will stall for new events\n", coreID));
                     break;
@@ -1387,25 +1446,25 @@ bool ArielCore::processNextEvent() {
         case SWITCH_POOL:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is a SWITCH_POOL\n", coreID));
                 removeEvent = true;
-                handleSwitchPoolEvent(dynamic_cast<ArielSwitchPoolEvent*>(nextEvent));
+                handleSwitchPoolEvent(nextOp);
                 break;
 
         case FREE:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is FREE\n", coreID));
                 removeEvent = true;
-                handleFreeEvent(dynamic_cast<ArielFreeEvent*>(nextEvent));
+                handleFreeEvent(nextOp);
                 break;
 
         case MALLOC:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is MALLOC\n", coreID));
                 removeEvent = true;
-                handleAllocationEvent(dynamic_cast<ArielAllocateEvent*>(nextEvent));
+                handleAllocationEvent(nextOp);
                 break;
 
         case MMAP:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is MMAP\n", coreID));
                 removeEvent = true;
-                handleMmapEvent(dynamic_cast<ArielMmapEvent*>(nextEvent));
+                handleMmapEvent(nextOp);
                 break;
 
         case CORE_EXIT:
@@ -1421,7 +1480,7 @@ bool ArielCore::processNextEvent() {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Found a FLUSH event, fewer pending transactions than permitted so will process..\n"));
                     statInstructionCount->addData(1);
                     inst_count++;
-                    handleFlushEvent(dynamic_cast<ArielFlushEvent*>(nextEvent));
+                    handleFlushEvent(nextOp);
                     removeEvent = true;
                 } else {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Pending transaction queue is currently full for core %" PRIu32 ",core will stall for new events\n", coreID));
@@ -1431,7 +1490,7 @@ bool ArielCore::processNextEvent() {
         case FENCE:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is a FENCE\n", coreID));
                 if(!isCoreFenced()) {// If core is fenced, drop this fence - they can be merged
-                    handleFenceEvent(dynamic_cast<ArielFenceEvent*>(nextEvent));
+                    handleFenceEvent();
                 }
                 removeEvent = true;
                 break;
@@ -1441,7 +1500,7 @@ bool ArielCore::processNextEvent() {
             removeEvent = true;
             stall();
             gpu();
-            handleGpuEvent(dynamic_cast<ArielGpuEvent*>(nextEvent));
+            handleGpuEvent(dynamic_cast<ArielGpuEvent*>(nextOp.event));
             break;
 #endif
         default:
@@ -1453,9 +1512,8 @@ bool ArielCore::processNextEvent() {
     if(removeEvent) {
         ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Removing event from pending queue, there are %" PRIu32 " events in the queue before deletion.\n",
                             (uint32_t) coreQ->size()));
+        delete nextOp.event;
         coreQ->pop();
-
-        delete nextEvent;
         return true;
     } else {
         ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Event removal was not requested, pending transaction queue length=%" PRIu32 ", maximum transactions: %" PRIu32 "\n",
@@ -33,20 +33,11 @@
 #include <poll.h>
 
 #include <string>
-#include <queue>
 #include <unordered_map>
 
 #include "arielmemmgr.h"
 #include "arielevent.h"
-#include "arielreadev.h"
-#include "arielwriteev.h"
-#include "arielexitev.h"
-#include "arielallocev.h"
-#include "arielfreeev.h"
-#include "arielnoop.h"
-#include "arielflushev.h"
-#include "arielfenceev.h"
-#include "arielswitchpool.h"
+#include "arielcorequeue.h"
 
 #include "ariel_shmem.h"
 #include "arieltracegen.h"
@@ -144,14 +135,14 @@ class ArielCore : public ComponentExtension {
 #endif
 
         void handleEvent(SimpleMem::Request* event);
-        void handleReadRequest(ArielReadEvent* wEv);
-        void handleWriteRequest(ArielWriteEvent* wEv);
-        void handleAllocationEvent(ArielAllocateEvent* aEv);
-        void handleMmapEvent(ArielMmapEvent* aEv);
-        void handleFreeEvent(ArielFreeEvent* aFE);
-        void handleSwitchPoolEvent(ArielSwitchPoolEvent* aSPE);
-        void handleFlushEvent(ArielFlushEvent *flEv);
-        void handleFenceEvent(ArielFenceEvent *fEv);
+        void handleReadRequest(uint64_t readAddress, uint32_t length);
+        void handleWriteRequest(uint64_t writeAddress, uint32_t length, const uint8_t* payload);
+        void handleAllocationEvent(const ArielCoreOp& op);
+        void handleMmapEvent(const ArielCoreOp& op);
+        void handleFreeEvent(const ArielCoreOp& op);
+        void handleSwitchPoolEvent(const ArielCoreOp& op);
+        void handleFlushEvent(const ArielCoreOp& op);
+        void handleFenceEvent();
 
 #ifdef HAVE_CUDA
         void handleGpuEvent(ArielGpuEvent* gEv);
@@ -175,6 +166,8 @@ class ArielCore : public ComponentExtension {
     private:
         bool processNextEvent();
         bool refillQueue();
+        void countInstruction(uint32_t instClass, uint32_t simdElemCount);
+        void createMemOpEvents(const ArielCommand& ac);
 
         bool writePayloads;
         uint32_t coreID;
@@ -199,7 +192,7 @@ class ArielCore : public ComponentExtension {
 #endif
 
         Output* output;
-        std::queue<ArielEvent*>* coreQ;
+        ArielCoreQueue* coreQ;
         bool isStalled;
         bool isHalted;
         bool isFenced;
@@ -0,0 +1,139 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_ARIEL_CORE_QUEUE
+#define _H_SST_ARIEL_CORE_QUEUE
+
+#include <stdint.h>
+#include <string.h>
+
+#include <vector>
+
+#include "arielevent.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * An operation waiting in an ArielCore's queue.  The fields used
+ * depend on the type:
+ *   READ_ADDRESS, WRITE_ADDRESS  addr, length
+ *   FLUSH, FREE                  addr
+ *   MALLOC, MMAP                 addr, length, instPtr, level, fileID (MMAP only)
+ *   SWITCH_POOL                  pool
+ *   GPU                          event, owned by the queue entry
+ * The payload of a WRITE_ADDRESS is held by the queue, in the payload
+ * slot of the same index.
+ */
+struct ArielCoreOp {
+    uint64_t addr;
+    uint64_t length;
+    uint64_t instPtr;
+    union {
+        uint32_t level;
+        uint32_t pool;
+    };
+    uint32_t fileID;
+    ArielEvent* event;
+    ArielEventType type;
+};
+
+/*
+ * Ring of ArielCoreOps.  The capacity is a power of two and should be
+ * sized so the ring never fills, but a refill that overruns it (a
+ * single instruction from the legacy START/END commands can carry any
+ * number of operations) grows it rather than failing.
+ *
+ * If payloadSize is not 0 every slot has room for a payload of that many
+ * bytes.
+ */
+class ArielCoreQueue {
+
+    public:
+        ArielCoreQueue(uint32_t minCapacity, uint32_t payloadSize) :
+                head(0), tail(0), payloadSize(payloadSize) {
+                uint32_t capacity = 1;
+                while(capacity < minCapacity) {
+                        capacity <<= 1;
+                }
+                resize(capacity);
+        }
+
+        ~ArielCoreQueue() {
+                while(!empty()) {
+                        delete front().event;
+                        pop();
+                }
+        }
+
+        bool empty() const { return head == tail; }
+        uint32_t size() const { return tail - head; }
+
+        ArielCoreOp& front() { return ops[head & mask]; }
+        uint8_t* frontPayload() { return &payloads[(head & mask) * payloadSize]; }
+        void pop() { head++; }
+
+        // Adds an entry with only the type set.  The returned entry and
+        // payload slot are valid until the next push.
+        ArielCoreOp& push(ArielEventType type) {
+                if(size() == ops.size()) {
+                        resize(ops.size() * 2);
+                }
+
+                ArielCoreOp& op = ops[tail & mask];
+                op.event = NULL;
+                op.type = type;
+                tail++;
+                return op;
+        }
+
+        uint8_t* backPayload() { return &payloads[((tail - 1) & mask) * payloadSize]; }
+
+    private:
+        void resize(uint32_t capacity) {
+                std::vector<ArielCoreOp> newOps(capacity);
+                std::vector<uint8_t> newPayloads(capacity * payloadSize);
+
+                const uint32_t count = size();
+                for(uint32_t i = 0; i < count; i++) {
+                        const uint32_t slot = (head + i) & mask;
+                        newOps[i] = ops[slot];
+                        if(payloadSize != 0) {
+                                memcpy(&newPayloads[i * payloadSize], &payloads[slot * payloadSize], payloadSize);
+                        }
+                }
+
+                ops.swap(newOps);
+                payloads.swap(newPayloads);
+                mask = capacity - 1;
+                head = 0;
+                tail = count;
+        }
+
+        std::vector<ArielCoreOp> ops;
+        std::vector<uint8_t> payloads;
+        uint32_t mask;
+        // Free running, the slot is the count masked
+        uint32_t head;
+        uint32_t tail;
+        const uint32_t payloadSize;
+
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,402 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <stdio.h>
+
+#include "arielmemmgr_hugepage.h"
+
+using namespace SST::ArielComponent;
+
+static const char* pageSizeNames[] = { "4KiB", "2MiB", "1GiB" };
+
+ArielMemoryManagerHugePage::ArielMemoryManagerHugePage(ComponentId_t id, Params& params) :
+            ArielMemoryManagerCache(id, params), root(new Node()), nodeCount(1) {
+
+    std::string policy = params.find<std::string>("hugepages", "2m");
+    if (policy == "none" || policy == "NONE") {
+        maxLevel = PAGE_4K;
+    } else if (policy == "2m" || policy == "2M") {
+        maxLevel = PAGE_2M;
+    } else if (policy == "1g" || policy == "1G") {
+        maxLevel = PAGE_1G;
+    } else {
+        output->fatal(CALL_INFO, -8, "Ariel memory manager - unknown huge page policy \"%s\"\n", policy.c_str());
+    }
+    output->verbose(CALL_INFO, 2, 0, "Largest page size is %s\n", pageSizeNames[maxLevel]);
+
+    const uint64_t pageCount = params.find<uint64_t>("pagecount", 131072);
+    const uint64_t memorySize = pageCount * pageSize(PAGE_4K);
+    output->verbose(CALL_INFO, 2, 0, "Page count is %" PRIu64 "\n", pageCount);
+
+    // Memory is handed out in frames of the largest page size, the
+    // remainder in smaller frames
+    uint64_t nextFrame = 0;
+    for (int level = (int) maxLevel; level >= 0; level--) {
+        const uint64_t frameCount = (memorySize - nextFrame) / pageSize(level);
+        if (frameCount == 0) continue;
+
+        if (mapPolicy == ArielPageMappingPolicy::LINEAR) {
+            mapPagesLinear(frameCount, pageSize(level), nextFrame, &freeFrames[level]);
+        } else {
+            mapPagesRandom(frameCount, pageSize(level), nextFrame, &freeFrames[level]);
+        }
+        nextFrame += frameCount * pageSize(level);
+
+        output->verbose(CALL_INFO, 2, 0, "Usable (free) %s frame queue contains %" PRIu64 " entries\n",
+                pageSizeNames[level], frameCount);
+    }
+
+    // Front cache, rounded down to a power of two
+    uint64_t frontEntries = 1;
+    while (frontEntries * 2 <= translationCacheEntries) {
+        frontEntries *= 2;
+    }
+    FrontEntry empty = { noFrame, 0 };
+    frontCache.assign(frontEntries, empty);
+    frontMask = frontEntries - 1;
+
+    for (uint32_t level = PAGE_4K; level <= PAGE_1G; level++) {
+        mappedPages[level] = 0;
+    }
+
+    statPagesMapped[PAGE_4K] = registerStatistic<uint64_t>("pages_4k");
+    statPagesMapped[PAGE_2M] = registerStatistic<uint64_t>("pages_2m");
+    statPagesMapped[PAGE_1G] = registerStatistic<uint64_t>("pages_1g");
+    statWalks[PAGE_4K]       = registerStatistic<uint64_t>("walks_4k");
+    statWalks[PAGE_2M]       = registerStatistic<uint64_t>("walks_2m");
+    statWalks[PAGE_1G]       = registerStatistic<uint64_t>("walks_1g");
+    statReservationBreaks    = registerStatistic<uint64_t>("reservation_breaks");
+
+    std::string popFilePath = params.find<std::string>("page_populate", "");
+    if (popFilePath != "") {
+        output->verbose(CALL_INFO, 1, 0, "Populating page table from %s...\n", popFilePath.c_str());
+        populate(popFilePath);
+    }
+}
+
+ArielMemoryManagerHugePage::~ArielMemoryManagerHugePage() {
+    deleteNode(root);
+}
+
+void ArielMemoryManagerHugePage::deleteNode(Node* node) {
+    for (uint32_t i = 0; i < entriesPerNode; i++) {
+        if (node->child[i] != NULL) {
+            deleteNode(node->child[i]);
+        }
+    }
+    delete node;
+}
+
+void ArielMemoryManagerHugePage::populate(const std::string& popFilePath) {
+    FILE* popFile = fopen(popFilePath.c_str(), "rt");
+    if (NULL == popFile) {
+        output->fatal(CALL_INFO, -1, "Unable to open page populate file: %s\n", popFilePath.c_str());
+    }
+
+    char line[256];
+    while (NULL != fgets(line, sizeof(line), popFile)) {
+        uint64_t pinAddr = 0;
+        uint64_t size = pageSize(PAGE_4K);
+
+        if (sscanf(line, "%" SCNu64 " %" SCNu64, &pinAddr, &size) < 1) {
+            continue;
+        }
+
+        uint32_t level = PAGE_4K;
+        while (level <= PAGE_1G && pageSize(level) != size) {
+            level++;
+        }
+
+        if (level > PAGE_1G) {
+            output->fatal(CALL_INFO, -1, "Attempted to pin address %" PRIu64 " with unsupported page size %" PRIu64 "\n", pinAddr, size);
+        }
+
+        if (level > maxLevel) {
+            output->fatal(CALL_INFO, -1, "Attempted to pin address %" PRIu64 " with a %s page but the huge page policy only allows up to %s pages\n",
+                    pinAddr, pageSizeNames[level], pageSizeNames[maxLevel]);
+        }
+
+        if ((pinAddr % size) > 0 || (pinAddr >> 48) != 0) {
+            output->fatal(CALL_INFO, -1, "Attempted to pin address %" PRIu64 " but address is not a page aligned 48 bit address (page size %" PRIu64 ")\n",
+                    pinAddr, size);
+        }
+
+        const uint64_t freePhysical = mapPage(pinAddr, level);
+
+        output->verbose(CALL_INFO, 4, 0, "Pinning address %" PRIu64 " (physical=%" PRIu64 ", %s page)\n",
+                pinAddr, freePhysical, pageSizeNames[level]);
+    }
+
+    fclose(popFile);
+}
+
+uint64_t ArielMemoryManagerHugePage::translateAddress(uint64_t virtAddr) {
+    // If translation is disabled, then just return address
+    if( ! translationEnabled ) {
+        return virtAddr;
+    }
+
+    // Keep track of how many translations we are performing
+    statTranslationQueries->addData(1);
+
+    const uint64_t vpn = virtAddr >> 12;
+    FrontEntry& entry = frontCache[vpn & frontMask];
+
+    if (entry.vpn == vpn) {
+        statTranslationCacheHits->addData(1);
+        return entry.frame + (virtAddr % pageSize(PAGE_4K));
+    }
+
+    if ((virtAddr >> 48) != 0) {
+        output->fatal(CALL_INFO, -1, "Virtual address %" PRIu64 " is outside the 48 bit address space\n", virtAddr);
+    }
+
+    uint32_t level;
+    uint64_t page = lookup(virtAddr, level);
+
+    if (page == noFrame) {
+        output->verbose(CALL_INFO, 4, 0, "Page table miss for virtual address: %" PRIu64 "\n", virtAddr);
+
+        statPageAllocationCount->addData(1);
+        level = PAGE_4K;
+        page = mapPage(virtAddr - (virtAddr % pageSize(PAGE_4K)), PAGE_4K);
+    }
+
+    statWalks[level]->addData(1);
+
+    const uint64_t physAddr = page + (virtAddr % pageSize(level));
+
+    output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " translates to: phys address: %" PRIu64 " (%s page)\n",
+            virtAddr, physAddr, pageSizeNames[level]);
+
+    if (entry.vpn != noFrame) {
+        statTranslationCacheEvict->addData(1);
+    }
+    entry.vpn = vpn;
+    entry.frame = physAddr - (physAddr % pageSize(PAGE_4K));
+
+    return physAddr;
+}
+
+uint64_t ArielMemoryManagerHugePage::lookup(const uint64_t virtAddr, uint32_t& level) {
+    Node* node = root;
+
+    for (uint32_t depth = 0; depth < levelCount && node != NULL; depth++) {
+        const uint32_t index = entryIndex(virtAddr, depth);
+
+        if (node->frame[index] != noFrame) {
+            level = levelCount - 1 - depth;
+            return node->frame[index];
+        }
+
+        node = node->child[index];
+    }
+
+    return noFrame;
+}
+
+uint64_t ArielMemoryManagerHugePage::mapPage(const uint64_t virtAddr, const uint32_t level) {
+    const uint32_t leafDepth = levelCount - 1 - level;
+    Node* path[levelCount];
+    Node* node = root;
+
+    for (uint32_t depth = 0; depth < leafDepth; depth++) {
+        path[depth] = node;
+        const uint32_t index = entryIndex(virtAddr, depth);
+
+        if (node->frame[index] != noFrame) {
+            output->fatal(CALL_INFO, -1, "Virtual address %" PRIu64 " is already mapped by a %s page\n",
+                    virtAddr, pageSizeNames[levelCount - 1 - depth]);
+        }
+
+        if (node->child[index] == NULL) {
+            node->child[index] = createNode(virtAddr, depth + 1, node);
+        }
+        node = node->child[index];
+    }
+    path[leafDepth] = node;
+
+    const uint32_t index = entryIndex(virtAddr, leafDepth);
+    if (node->frame[index] != noFrame || node->child[index] != NULL) {
+        output->fatal(CALL_INFO, -1, "Virtual address %" PRIu64 " is already mapped\n", virtAddr);
+    }
+
+    uint64_t frame;
+    if (node->reserved != noFrame) {
+        frame = node->reserved + index * pageSize(level);
+    } else {
+        frame = takeFrame(level);
+        while (frame == noFrame && level == PAGE_4K && breakReservation()) {
+            frame = takeFrame(level);
+        }
+    }
+
+    if (frame == noFrame) {
+        output->fatal(CALL_INFO, -1, "Requested a %s page for virtual address %" PRIu64 " which failed due to not having enough free pages\n",
+                pageSizeNames[level], virtAddr);
+    }
+
+    output->verbose(CALL_INFO, 4, 0, "Allocating %s memory page, physical page=%" PRIu64 ", virtual page=%" PRIu64 "\n",
+            pageSizeNames[level], frame, virtAddr);
+
+    node->frame[index] = frame;
+    node->mapped++;
+    mappedPages[level]++;
+    statPagesMapped[level]->addData(1);
+
+    promote(path, virtAddr, leafDepth);
+    return frame;
+}
+
+ArielMemoryManagerHugePage::Node* ArielMemoryManagerHugePage::createNode(const uint64_t virtAddr, const uint32_t depth, Node* parent) {
+    Node* node = new Node();
+    nodeCount++;
+
+    // Size of the region the node covers
+    const uint32_t regionLevel = levelCount - depth;
+
+    if (parent->reserved != noFrame) {
+        // Part of a larger reservation
+        node->reserved = parent->reserved + entryIndex(virtAddr, depth - 1) * pageSize(regionLevel);
+    } else if (regionLevel <= maxLevel && regionLevel != PAGE_4K) {
+        node->reserved = takeFrame(regionLevel);
+
+        if (node->reserved != noFrame) {
+            reservedRegions[regionLevel].push_back(virtAddr - (virtAddr % pageSize(regionLevel)));
+        }
+
+        output->verbose(CALL_INFO, 4, 0, "Reserving a %s frame for virtual address %" PRIu64 " %s\n",
+                pageSizeNames[regionLevel], virtAddr, node->reserved != noFrame ? "succeeded" : "failed");
+    }
+
+    return node;
+}
+
+void ArielMemoryManagerHugePage::promote(Node** path, const uint64_t virtAddr, uint32_t depth) {
+    // Only nodes whose pages all came from a reservation can be promoted
+    for (; depth > 1; depth--) {
+        Node* node = path[depth];
+        if (node->mapped < entriesPerNode || node->reserved == noFrame) {
+            return;
+        }
+
+        const uint32_t level = levelCount - depth;
+        Node* parent = path[depth - 1];
+        const uint32_t index = entryIndex(virtAddr, depth - 1);
+
+        parent->frame[index] = node->reserved;
+        parent->child[index] = NULL;
+        parent->mapped++;
+
+        mappedPages[level - 1] -= entriesPerNode;
+        mappedPages[level]++;
+        statPagesMapped[level]->addData(1);
+
+        output->verbose(CALL_INFO, 4, 0, "Promoted virtual address %" PRIu64 " to a %s page, physical page=%" PRIu64 "\n",
+                virtAddr, pageSizeNames[level], node->reserved);
+
+        delete node;
+        nodeCount--;
+    }
+}
+
+uint64_t ArielMemoryManagerHugePage::takeFrame(const uint32_t level) {
+    if (freeFrames[level].empty()) {
+        if (level == maxLevel) {
+            return noFrame;
+        }
+
+        // Split a larger frame
+        const uint64_t larger = takeFrame(level + 1);
+        if (larger == noFrame) {
+            return noFrame;
+        }
+
+        for (uint32_t i = 0; i < entriesPerNode; i++) {
+            freeFrames[level].push_back(larger + i * pageSize(level));
+        }
+    }
+
+    const uint64_t frame = freeFrames[level].front();
+    freeFrames[level].pop_front();
+    return frame;
+}
+
+bool ArielMemoryManagerHugePage::breakReservation() {
+    for (uint32_t level = PAGE_2M; level <= maxLevel; level++) {
+        while (!reservedRegions[level].empty()) {
+            const uint64_t region = reservedRegions[level].front();
+            reservedRegions[level].pop_front();
+
+            // Promoted regions have no node left
+            Node* node = findNode(region, levelCount - level);
+            if (node == NULL || node->reserved == noFrame) {
+                continue;
+            }
+
+            for (uint32_t i = 0; i < entriesPerNode; i++) {
+                if (node->frame[i] != noFrame) {
+                    continue;
+                }
+
+                const uint64_t offset = i * pageSize(level - 1);
+                if (node->child[i] != NULL) {
+                    // Keeps its part as a reservation of its own
+                    reservedRegions[level - 1].push_back(region + offset);
+                } else {
+                    freeFrames[level - 1].push_back(node->reserved + offset);
+                }
+            }
+
+            output->verbose(CALL_INFO, 4, 0, "Breaking %s reservation of virtual region %" PRIu64 ", %" PRIu32 " pages were mapped\n",
+                    pageSizeNames[level], region, node->mapped);
+
+            node->reserved = noFrame;
+            statReservationBreaks->addData(1);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+ArielMemoryManagerHugePage::Node* ArielMemoryManagerHugePage::findNode(const uint64_t virtAddr, const uint32_t depth) {
+    Node* node = root;
+    for (uint32_t i = 0; i < depth && node != NULL; i++) {
+        node = node->child[entryIndex(virtAddr, i)];
+    }
+    return node;
+}
+
+void ArielMemoryManagerHugePage::printStats() {
+    output->output("\n");
+    output->output("Ariel Memory Management Statistics:\n");
+    output->output("---------------------------------------------------------------------\n");
+    output->output("Page Table Sizes:\n");
+
+    output->output("- Radix tree nodes    %" PRIu64 "\n", nodeCount);
+    output->output("- 4KiB pages          %" PRIu64 "\n", mappedPages[PAGE_4K]);
+    output->output("- 2MiB pages          %" PRIu64 "\n", mappedPages[PAGE_2M]);
+    output->output("- 1GiB pages          %" PRIu64 "\n", mappedPages[PAGE_1G]);
+
+    output->output("Page Table Coverages:\n");
+
+    uint64_t bytes = 0;
+    for (uint32_t level = PAGE_4K; level <= PAGE_1G; level++) {
+        bytes += mappedPages[level] * pageSize(level);
+    }
+    output->output("- Bytes               %" PRIu64 "\n", bytes);
+}
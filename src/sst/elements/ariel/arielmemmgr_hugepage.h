@@ -0,0 +1,145 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_ARIEL_MEM_MANAGER_HUGEPAGE
+#define _H_ARIEL_MEM_MANAGER_HUGEPAGE
+
+#include <sst/core/output.h>
+
+#include <stdint.h>
+#include <deque>
+#include <vector>
+
+#include "arielmemmgr_cache.h"
+
+using namespace SST;
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * Allocate-on-first-touch memory manager with 4KiB, 2MiB and 1GiB pages.
+ *
+ * Translations are kept in a four level radix tree like the x86-64 page
+ * table: 1GiB and 2MiB pages are leaves at the upper levels.  A direct
+ * mapped cache of 4KiB translations sits in front of the tree.
+ *
+ * Huge pages are made by promotion.  The first touch of a 2MiB region
+ * reserves an aligned 2MiB physical frame for it and every 4KiB page of
+ * the region is placed at its offset in that frame.  Once all of them
+ * have been touched the region becomes a single 2MiB page.  With the
+ * '1g' policy 1GiB regions are reserved and promoted the same way from
+ * 2MiB pages.  Promotion never moves a page, so cached translations stay
+ * valid.  When no free 4KiB frame is left the oldest reservation that
+ * was not promoted gives its untouched frames back, 2MiB reservations
+ * before 1GiB ones.
+ */
+class ArielMemoryManagerHugePage : public ArielMemoryManagerCache {
+
+    public:
+        /* SST ELI */
+        SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(ArielMemoryManagerHugePage, "ariel", "MemoryManagerHugePage", SST_ELI_ELEMENT_VERSION(1,0,0),
+                "Allocate-on-first touch memory manager with 4KiB pages promoted to 2MiB and 1GiB pages", SST::ArielComponent::ArielMemoryManager)
+
+#define MEMMGR_HUGEPAGE_ELI_PARAMS ARIEL_ELI_MEMMGR_CACHE_PARAMS,\
+            {"pagecount", "Size of physical memory, in 4KiB pages", "131072"},\
+            {"hugepages", "Huge page policy [none|2m|1g]. 'none' maps 4KiB pages only, '2m' promotes fully touched 2MiB regions to 2MiB pages, '1g' also promotes fully mapped 1GiB regions to 1GiB pages", "2m"},\
+            {"page_populate", "Pre-populate the page table from this file. Each line is a virtual address, optionally followed by a page size of 4096, 2097152 or 1073741824 (default 4096).", ""}
+
+#define MEMMGR_HUGEPAGE_ELI_STATS ARIEL_ELI_MEMMGR_CACHE_STATS,\
+            { "pages_4k",           "4KiB pages mapped, including pages later promoted", "pages", 2 },\
+            { "pages_2m",           "2MiB pages mapped by promotion or pre-population", "pages", 2 },\
+            { "pages_1g",           "1GiB pages mapped by promotion or pre-population", "pages", 2 },\
+            { "walks_4k",           "Page table walks that found a 4KiB page", "walks", 2 },\
+            { "walks_2m",           "Page table walks that found a 2MiB page", "walks", 2 },\
+            { "walks_1g",           "Page table walks that found a 1GiB page", "walks", 2 },\
+            { "reservation_breaks", "Huge page reservations given up to free 4KiB frames", "reservations", 2 }
+
+        SST_ELI_DOCUMENT_PARAMS( MEMMGR_HUGEPAGE_ELI_PARAMS )
+        SST_ELI_DOCUMENT_STATISTICS( MEMMGR_HUGEPAGE_ELI_STATS )
+
+        /* ArielMemoryManagerHugePage */
+        ArielMemoryManagerHugePage(ComponentId_t id, Params& params);
+        ~ArielMemoryManagerHugePage();
+
+        uint64_t translateAddress(uint64_t virtAddr);
+        void printStats();
+
+    private:
+        // Page sizes, the tree level that maps a page is levelCount - 1 - size
+        enum PageLevel { PAGE_4K = 0, PAGE_2M = 1, PAGE_1G = 2 };
+
+        static const uint32_t levelCount = 4;
+        static const uint32_t entriesPerNode = 512;
+        static const uint64_t noFrame = ~((uint64_t) 0);
+
+        struct Node {
+            Node* child[entriesPerNode];
+            uint64_t frame[entriesPerNode];     // Physical page mapped by the entry, or noFrame
+            uint64_t reserved;                  // Physical frame reserved for the region the node covers, or noFrame
+            uint32_t mapped;                    // Entries that map a page
+
+            Node() : reserved(noFrame), mapped(0) {
+                for(uint32_t i = 0; i < entriesPerNode; i++) {
+                    child[i] = NULL;
+                    frame[i] = noFrame;
+                }
+            }
+        };
+
+        struct FrontEntry {
+            uint64_t vpn;
+            uint64_t frame;
+        };
+
+        static uint64_t pageSize(uint32_t level) { return ((uint64_t) 1) << (12 + 9 * level); }
+
+        // The root is depth 0, entries at depth 3 map 4KiB pages
+        static uint32_t entryShift(uint32_t depth) { return 39 - 9 * depth; }
+        static uint32_t entryIndex(uint64_t virtAddr, uint32_t depth) {
+            return (uint32_t) ((virtAddr >> entryShift(depth)) & (entriesPerNode - 1));
+        }
+
+        uint64_t lookup(const uint64_t virtAddr, uint32_t& level);
+        uint64_t mapPage(const uint64_t virtAddr, const uint32_t level);
+        Node* createNode(const uint64_t virtAddr, const uint32_t depth, Node* parent);
+        void promote(Node** path, const uint64_t virtAddr, uint32_t depth);
+        uint64_t takeFrame(const uint32_t level);
+        bool breakReservation();
+        Node* findNode(const uint64_t virtAddr, const uint32_t depth);
+        void populate(const std::string& popFilePath);
+        void deleteNode(Node* node);
+
+        uint32_t maxLevel;                      // Largest page size made, from the huge page policy
+        Node* root;
+        uint64_t nodeCount;
+        uint64_t mappedPages[3];
+
+        std::vector<FrontEntry> frontCache;
+        uint64_t frontMask;
+
+        std::deque<uint64_t> freeFrames[3];
+        std::deque<uint64_t> reservedRegions[3];    // Virtual regions with a reservation by size, oldest first
+
+        Statistic<uint64_t>* statPagesMapped[3];
+        Statistic<uint64_t>* statWalks[3];
+        Statistic<uint64_t>* statReservationBreaks;
+};
+
+}
+}
+
+#endif
@@ -91,6 +91,15 @@ ArielTunnel *tunnel = NULL;
 bool enable_output;
 PIN_LOCK mainLock;
 
+// Memory operations of each thread waiting to be sent.  The command is
+// written to the tunnel when it is full or before any other command from
+// the thread.  Padded so threads do not share cache lines.
+struct ArielPendingOps {
+    ArielCommand ac;
+    uint8_t __pad[64];
+};
+ArielPendingOps* pendingOps;
+
 // Instrumentation control
 UINT32 instrument_instructions;
 bool writeTrace;
@@ -281,12 +290,41 @@ VOID InstrumentTrace (TRACE trace, VOID* args)
 /******************** END SHADOW STACK **************************/
 /****************************************************************/
 
+VOID FlushMemOps(UINT32 thr)
+{
+    ArielCommand& ac = pendingOps[thr].ac;
+    if(ac.mem_ops.count > 0) {
+        tunnel->writeMessage(thr, ac);
+        ac.mem_ops.count = 0;
+    }
+}
+
+/* Send a command other than a memory operation, anything buffered for the thread goes first */
+VOID WriteCommand(UINT32 thr, const ArielCommand& ac)
+{
+    if(thr < core_count) {
+        FlushMemOps(thr);
+    }
+    tunnel->writeMessage(thr, ac);
+}
+
+VOID ThreadFini(THREADID thr, const CONTEXT* ctxt, INT32 code, VOID* v)
+{
+    if(thr < core_count) {
+        FlushMemOps(thr);
+    }
+}
+
 VOID Fini(INT32 code, VOID* v)
 {
     if(SSTVerbosity.Value() > 0) {
         std::cout << "SSTARIEL: Execution completed, shutting down." << std::endl;
     }
 
+    for(UINT32 i = 0; i < core_count; i++) {
+        FlushMemOps(i);
+    }
+
     ArielCommand ac;
     ac.command = ARIEL_PERFORM_EXIT;
     ac.instPtr = (uint64_t) 0;
@@ -338,7 +376,7 @@ VOID WriteFlushInstructionMarker(UINT32 thr, ADDRINT ip, ADDRINT vaddr)
     ac.instPtr = (uint64_t) ip;
     ac.flushline.vaddr = (uint32_t) vaddr;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 VOID WriteFenceInstructionMarker(UINT32 thr, ADDRINT ip)
@@ -347,73 +385,33 @@ VOID WriteFenceInstructionMarker(UINT32 thr, ADDRINT ip)
     ac.command = ARIEL_FENCE_INSTRUCTION;
     ac.instPtr = (uint64_t) ip;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
-VOID WriteInstructionRead(ADDRINT* address, UINT32 readSize, THREADID thr, ADDRINT ip,
+VOID AddMemOp(ADDRINT* address, UINT32 size, UINT32 flags, THREADID thr,
             UINT32 instClass, UINT32 simdOpWidth)
 {
-
-    const uint64_t addr64 = (uint64_t) address;
-
-    ArielCommand ac;
-
-    ac.command = ARIEL_PERFORM_READ;
-    ac.instPtr = (uint64_t) ip;
-    ac.inst.addr = addr64;
-    ac.inst.size = readSize;
-    ac.inst.instClass = instClass;
-    ac.inst.simdElemCount = simdOpWidth;
-
-    tunnel->writeMessage(thr, ac);
-}
-
-VOID WriteInstructionWrite(ADDRINT* address, UINT32 writeSize, THREADID thr, ADDRINT ip,
-            UINT32 instClass, UINT32 simdOpWidth)
-{
-
-    const uint64_t addr64 = (uint64_t) address;
-    ArielCommand ac;
-
-    ac.command = ARIEL_PERFORM_WRITE;
-    ac.instPtr = (uint64_t) ip;
-    ac.inst.addr = addr64;
-    ac.inst.size = writeSize;
-    ac.inst.instClass = instClass;
-    ac.inst.simdElemCount = simdOpWidth;
-
-    if( writeTrace ) {
-//      if( writeSize > ARIEL_MAX_PAYLOAD_SIZE ) {
-//          fprintf(stderr, "Error: Payload exceeds maximum size (%d > %d)\n",
-//              writeSize, ARIEL_MAX_PAYLOAD_SIZE);
-//          exit(-1);
-//      }
-        PIN_SafeCopy( &ac.inst.payload[0], address, ARIEL_MIN( writeSize, (UINT32) ARIEL_MAX_PAYLOAD_SIZE ) );
+    ArielCommand& ac = pendingOps[thr].ac;
+    ArielMemOp& op = ac.mem_ops.ops[ac.mem_ops.count++];
+
+    op.addr = (uint64_t) address;
+    op.size = size;
+    op.flags = (uint8_t) flags;
+    op.instClass = (uint8_t) instClass;
+    op.simdElemCount = (uint16_t) simdOpWidth;
+
+    if( writeTrace && (flags & ARIEL_MEMOP_WRITE) ) {
+        // The payload has to follow the command holding the write
+        FlushMemOps(thr);
+
+        ArielCommand pc;
+        pc.command = ARIEL_WRITE_PAYLOAD;
+        pc.instPtr = (uint64_t) 0;
+        PIN_SafeCopy( &pc.payload.data[0], address, ARIEL_MIN( size, (UINT32) ARIEL_MAX_PAYLOAD_SIZE ) );
+        tunnel->writeMessage(thr, pc);
+    } else if(ac.mem_ops.count == ARIEL_MAX_MEM_OPS) {
+        FlushMemOps(thr);
     }
-/*
-    printf("CU Instruction %p ",address);
-    for(int i = 0; i < ARIEL_MIN(writeSize, ARIEL_MAX_PAYLOAD_SIZE); i++){
-        printf("%d ", ac.inst.payload[i]);
-    }
-    printf("\n");
-*/
-    tunnel->writeMessage(thr, ac);
-}
-
-VOID WriteStartInstructionMarker(UINT32 thr, ADDRINT ip)
-{
-    ArielCommand ac;
-    ac.command = ARIEL_START_INSTRUCTION;
-    ac.instPtr = (uint64_t) ip;
-    tunnel->writeMessage(thr, ac);
-}
-
-VOID WriteEndInstructionMarker(UINT32 thr, ADDRINT ip)
-{
-    ArielCommand ac;
-    ac.command = ARIEL_END_INSTRUCTION;
-    ac.instPtr = (uint64_t) ip;
-    tunnel->writeMessage(thr, ac);
 }
 
 VOID WriteInstructionReadWrite(THREADID thr, ADDRINT* readAddr, UINT32 readSize,
@@ -423,10 +421,8 @@ VOID WriteInstructionReadWrite(THREADID thr, ADDRINT* readAddr, UINT32 readSize,
 
     if(enable_output) {
         if(thr < core_count) {
-            WriteStartInstructionMarker( thr, ip );
-            WriteInstructionRead(  readAddr,  readSize,  thr, ip, instClass, simdOpWidth );
-            WriteInstructionWrite( writeAddr, writeSize, thr, ip, instClass, simdOpWidth );
-            WriteEndInstructionMarker( thr, ip );
+            AddMemOp( readAddr,  readSize,  ARIEL_MEMOP_START, thr, instClass, simdOpWidth );
+            AddMemOp( writeAddr, writeSize, ARIEL_MEMOP_WRITE, thr, instClass, simdOpWidth );
         }
     }
 }
@@ -437,9 +433,7 @@ VOID WriteInstructionReadOnly(THREADID thr, ADDRINT* readAddr, UINT32 readSize,
 
     if(enable_output) {
         if(thr < core_count) {
-            WriteStartInstructionMarker(thr, ip);
-            WriteInstructionRead(  readAddr,  readSize,  thr, ip, instClass, simdOpWidth );
-            WriteEndInstructionMarker(thr, ip);
+            AddMemOp( readAddr, readSize, ARIEL_MEMOP_START, thr, instClass, simdOpWidth );
         }
     }
 
@@ -449,10 +443,7 @@ VOID WriteNoOp(THREADID thr, ADDRINT ip)
 {
     if(enable_output) {
         if(thr < core_count) {
-            ArielCommand ac;
-            ac.command = ARIEL_NOOP;
-            ac.instPtr = (uint64_t) ip;
-            tunnel->writeMessage(thr, ac);
+            AddMemOp( NULL, 0, ARIEL_MEMOP_NOOP, thr, ARIEL_INST_UNKNOWN, 1 );
         }
     }
 }
@@ -463,9 +454,7 @@ VOID WriteInstructionWriteOnly(THREADID thr, ADDRINT* writeAddr, UINT32 writeSiz
 
     if(enable_output) {
         if(thr < core_count) {
-            WriteStartInstructionMarker(thr, ip);
-            WriteInstructionWrite(writeAddr, writeSize,  thr, ip, instClass, simdOpWidth);
-            WriteEndInstructionMarker(thr, ip);
+            AddMemOp( writeAddr, writeSize, ARIEL_MEMOP_START | ARIEL_MEMOP_WRITE, thr, instClass, simdOpWidth );
         }
     }
 
@@ -713,7 +702,7 @@ void mapped_ariel_output_stats()
     ArielCommand ac;
     ac.command = ARIEL_OUTPUT_STATS;
     ac.instPtr = (uint64_t) 0;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 // same effect as mapped_ariel_output_stats(), but it also sends a user-defined reference number back
@@ -723,7 +712,7 @@ void mapped_ariel_output_stats_buoy(uint64_t marker)
     ArielCommand ac;
     ac.command = ARIEL_OUTPUT_STATS;
     ac.instPtr = (uint64_t) marker; //user the instruction pointer slot to send the marker number
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 void mapped_ariel_flushline(void *virtualAddress)
@@ -777,7 +766,7 @@ int ariel_mlm_memcpy(void* dest, void* source, size_t size) {
     ac.dma_start.dest = ariel_dest;
     ac.dma_start.len = length;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "Done with ariel memcpy.\n");
@@ -805,7 +794,7 @@ void ariel_mlm_set_pool(int new_pool)
     ArielCommand ac;
     ac.command = ARIEL_SWITCH_POOL;
     ac.switchPool.pool = newDefaultPool;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     // Keep track of the default pool
     default_pool = (UINT32) new_pool;
@@ -857,7 +846,7 @@ void* ariel_mmap_mlm(int fileID, size_t size, int level)
     std::cout<<"File ID at FESIMPLE IS : "<<ac.mlm_mmap.fileID<<std::endl;
     std::cout<<"After ******"<<std::endl;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "%u: Ariel mmap_mlm call allocates data at address: 0x%llx\n",
@@ -912,7 +901,7 @@ void* ariel_mlm_malloc(size_t size, int level) {
         ac.mlm_map.alloc_level = allocationLevel;
     }
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "%u: Ariel mlm_malloc call allocates data at address: 0x%llx\n",
@@ -957,7 +946,7 @@ void ariel_mlm_free(void* ptr)
         ArielCommand ac;
         ac.command = ARIEL_ISSUE_TLM_FREE;
         ac.mlm_free.vaddr = virtAddr;
-        tunnel->writeMessage(thr, ac);
+        WriteCommand(thr, ac);
 
     } else {
         fprintf(stderr, "ARIEL: Call to free in Ariel did not find a matching local allocation, this memory will be leaked.\n");
@@ -1009,14 +998,14 @@ VOID ariel_postmalloc_instrument(ADDRINT allocLocation)
                 if (toFast[thr].count == 0) {
                     toFast[thr].valid = false;
                 }
-                tunnel->writeMessage(thr, ac);
+                WriteCommand(thr, ac);
             }
         } else if (shouldOverride) {
             ac.mlm_map.alloc_level = overridePool;
-            tunnel->writeMessage(thr, ac);
+            WriteCommand(thr, ac);
         } else if (InterceptMemAllocations.Value()) {
             ac.mlm_map.alloc_level = allocationLevel;
-            tunnel->writeMessage(thr, ac);
+            WriteCommand(thr, ac);
         }
 
         /*printf("ARIEL: Created a malloc of size: %" PRIu64 " in Ariel\n",
@@ -1043,7 +1032,7 @@ __host__ cudaError_t CUDARTAPI cudaMalloc(void **devPtr, size_t size){
     ac.API.name = GPU_MALLOC;
     ac.API.CA.cuda_malloc.dev_ptr = devPtr;
     ac.API.CA.cuda_malloc.size = size;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail = false;
@@ -1073,7 +1062,7 @@ void** CUDARTAPI __cudaRegisterFatBinary(void *fatCubin) {
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_REG_FAT_BINARY;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1114,7 +1103,7 @@ void CUDARTAPI __cudaRegisterFunction(
     ac.API.CA.register_function.fat_cubin_handle = (unsigned)(unsigned long long)fatCubinHandle;
     ac.API.CA.register_function.host_fun = reinterpret_cast<uint64_t>(hostFun);
     strncpy(ac.API.CA.register_function.device_fun, deviceFun, 512);
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1179,7 +1168,7 @@ __host__ cudaError_t CUDARTAPI cudaMemcpy(void *dst, const void *src, size_t cou
     ac.API.CA.cuda_memcpy.src = (uint64_t) src;
     ac.API.CA.cuda_memcpy.count = count;
     ac.API.CA.cuda_memcpy.kind = final_kind;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     if(final_kind == cudaMemcpyHostToDevice) {
         if(count <= max_page_size){
@@ -1308,7 +1297,7 @@ __host__ cudaError_t CUDARTAPI cudaConfigureCall(dim3 gridDim, dim3 blockDim, si
     ac.API.CA.cfg_call.bdz = blockDim.z;
     ac.API.CA.cfg_call.sharedMem = sharedMem;
     ac.API.CA.cfg_call.stream = stream;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1356,7 +1345,7 @@ __host__ cudaError_t CUDARTAPI cudaSetupArgument(const void *arg, size_t size, s
     ac.API.CA.set_arg.offset = offset;
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_SET_ARG;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1381,7 +1370,7 @@ __host__ cudaError_t CUDARTAPI cudaLaunch(const void *func){
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_LAUNCH;
     ac.API.CA.cuda_launch.func = reinterpret_cast<uint64_t>(func);
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1405,7 +1394,7 @@ __host__ cudaError_t CUDARTAPI cudaFree(void *devPtr){
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_FREE;
     ac.API.CA.free_address = (uint64_t)devPtr;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1428,7 +1417,7 @@ __host__ __cudart_builtin__ cudaError_t CUDARTAPI cudaGetLastError(void){
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_GET_LAST_ERROR;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
     GpuCommand gc;
 
     bool avail=false;
@@ -1467,7 +1456,7 @@ void CUDARTAPI __cudaRegisterVar(
     ac.API.CA.register_var.size = size;
     ac.API.CA.register_var.constant = constant;
     ac.API.CA.register_var.global = global;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1503,7 +1492,7 @@ __host__ cudaError_t CUDARTAPI __maxActiveBlock(
     ac.API.CA.max_active_block.blockSize = blockSize;
     ac.API.CA.max_active_block.dynamicSMemSize = dynamicSMemSize;
     ac.API.CA.max_active_block.flags = flags;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1531,7 +1520,7 @@ VOID ariel_postfree_instrument(ADDRINT allocLocation)
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_TLM_FREE;
     ac.mlm_free.vaddr = virtAddr;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 void mapped_ariel_malloc_flag_fortran(int* mallocLocId, int* count, int* level)
@@ -1823,6 +1812,13 @@ int main(int argc, char *argv[])
     tunnelR = tunnelRmgr->getTunnel();
     tunnelD = tunnelDmgr->getTunnel();
 #endif
+    pendingOps = (ArielPendingOps*) malloc(sizeof(ArielPendingOps) * core_count);
+    for(unsigned int i = 0; i < core_count; i++) {
+        pendingOps[i].ac.command = ARIEL_PERFORM_MEM_OPS;
+        pendingOps[i].ac.instPtr = (uint64_t) 0;
+        pendingOps[i].ac.mem_ops.count = 0;
+    }
+
     lastMallocSize = (UINT64*) malloc(sizeof(UINT64) * core_count);
     lastMallocLoc = (UINT64*) malloc(sizeof(UINT64) * core_count);
     mallocIndex = 0;
@@ -1890,6 +1886,7 @@ int main(int argc, char *argv[])
     }
 
     RTN_AddInstrumentFunction(InstrumentRoutine, 0);
+    PIN_AddThreadFiniFunction(ThreadFini, 0);
 
     // Instrument traces to capture stack
     if (KeepMallocStackTrace.Value() == 1)
@@ -383,22 +383,16 @@ VOID WriteInstructionWrite(ADDRINT* address, UINT32 writeSize, THREADID thr, ADD
     ac.inst.instClass = instClass;
     ac.inst.simdElemCount = simdOpWidth;
 
+    tunnel->writeMessage(thr, ac);
+
+    // The payload follows the write in its own command
     if( writeTrace ) {
-//      if( writeSize > ARIEL_MAX_PAYLOAD_SIZE ) {
-//          fprintf(stderr, "Error: Payload exceeds maximum size (%d > %d)\n",
-//              writeSize, ARIEL_MAX_PAYLOAD_SIZE);
-//          exit(-1);
-//      }
-        PIN_SafeCopy( &ac.inst.payload[0], address, ARIEL_MIN( writeSize, ARIEL_MAX_PAYLOAD_SIZE ) );
+        ArielCommand pc;
+        pc.command = ARIEL_WRITE_PAYLOAD;
+        pc.instPtr = (uint64_t) ip;
+        PIN_SafeCopy( &pc.payload.data[0], address, ARIEL_MIN( writeSize, ARIEL_MAX_PAYLOAD_SIZE ) );
+        tunnel->writeMessage(thr, pc);
     }
-/*
-    printf("CU Instruction %p ",address);
-    for(int i = 0; i < ARIEL_MIN(writeSize, ARIEL_MAX_PAYLOAD_SIZE); i++){
-        printf("%d ", ac.inst.payload[i]);
-    }
-    printf("\n");
-*/
-    tunnel->writeMessage(thr, ac);
 }
 
 VOID WriteStartInstructionMarker(UINT32 thr, ADDRINT ip)
@@ -17,6 +17,7 @@
 #define CACHEARRAY_H
 
 #include <vector>
+#include <new>
 
 #include <sst/core/output.h>
 
@@ -33,6 +34,18 @@ namespace SST { namespace MemHierarchy {
 /*
  * CacheArrays should  be templated on a line type
  * See the comment in lineTypes.h for the required API
+ *
+ * Two tag store layouts are supported:
+ *  - object (default): each line is individually allocated and lookups
+ *    dereference each line in the set to compare addresses
+ *  - flat: line objects are allocated in one contiguous block and a copy of
+ *    each line's address is kept in a contiguous per-set tag array so that
+ *    lookups compare a whole set without touching the line objects
+ *
+ * The packed-state replacement policies (lru-packed, plru, srrip/brrip/drrip)
+ * are recognized at construction and their state is called directly, without
+ * virtual calls or the per-set ReplacementInfo vectors. Other policies go
+ * through the ReplacementPolicy interface.
  */
 
 template <class T>
@@ -51,10 +64,31 @@ class CacheArray {
         unsigned int    banks_;
         vector<T*>      lines_; // The actual cache
         State* setStates;
-        std::map<unsigned int, std::vector<ReplacementInfo*> > rInfo;   // Lookup a vector of replacementInfo by set ID
+        std::vector<std::vector<ReplacementInfo*> > rInfo;   // Lookup a vector of replacementInfo by set ID (unpacked policies only)
+
+        /* Packed replacement state, if the policy has one */
+        enum class Packed { None, LRU, PLRU, RRIP };
+        Packed          packed_;
+        PackedLRUState* lruState_;
+        TreePLRUState*  plruState_;
+        RRIPPackedState* rripState_;
+
+        /* Flat tag store */
+        bool            flat_;      // Whether the flat (structure-of-arrays) tag store is in use
+        T*              lineStore_; // Contiguous storage for all line objects (flat only)
+        vector<Addr>    tags_;      // Per-line address, contiguous by set (flat only)
+
+        /** Compute the set an address maps to */
+        unsigned int getSet(Addr addr) { return hash_->hash(0, toLineAddr(addr)) % numSets_; }
+
+        /** Replacement state updates, dispatched to the packed state when there is one */
+        inline void touchLine(unsigned int index);
+        inline void insertLine(unsigned int index);
+        inline void invalidateLine(unsigned int index);
+        inline unsigned int victimLine(unsigned int set);
     public:
 
-        CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash);
+        CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash, bool flat = false);
 
         /** Destructor - Delete all cache line objects */
         virtual ~CacheArray();
@@ -94,8 +128,9 @@ class CacheArray {
 /************* Function definitions *****************/
 
 template <class T>
-CacheArray<T>::CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash) :
-    dbg_(dbg), numLines_(numLines), associativity_(associativity), lineSize_(lineSize), replacementMgr_(replacementMgr), hash_(hash) {
+CacheArray<T>::CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash, bool flat) :
+    dbg_(dbg), numLines_(numLines), associativity_(associativity), lineSize_(lineSize), replacementMgr_(replacementMgr), hash_(hash),
+    packed_(Packed::None), lruState_(nullptr), plruState_(nullptr), rripState_(nullptr), flat_(flat), lineStore_(nullptr) {
 
     // Error check parameters
     if (numLines_ == 0)
@@ -121,28 +156,57 @@ CacheArray<T>::CacheArray(Output* dbg, unsigned int numLines, unsigned int assoc
     sliceSize_ = 1;
     banks_ = 1;
 
-    for (unsigned int i = 0; i < numLines_; i++) {
-        lines_[i] = new T(lineSize_, i);
+    if (flat_) {
+        lineStore_ = static_cast<T*>(::operator new(sizeof(T) * numLines_));
+        for (unsigned int i = 0; i < numLines_; i++) {
+            lines_[i] = new (&lineStore_[i]) T(lineSize_, i);
+        }
+        tags_.resize(numLines_);
+        for (unsigned int i = 0; i < numLines_; i++)
+            tags_[i] = lines_[i]->getAddr();
+    } else {
+        for (unsigned int i = 0; i < numLines_; i++) {
+            lines_[i] = new T(lineSize_, i);
+        }
     }
 
-    // Construct rInfo
-    for (unsigned int i = 0; i < numSets_; i++) {
-        std::vector<ReplacementInfo*> setInfo;
-        for (unsigned int j = 0; j < associativity; j++)
-            setInfo.push_back(lines_[i*associativity + j]->getReplacementInfo());
-        rInfo.insert(std::make_pair(i, setInfo));
-    }
-    ReplacementInfo * info = rInfo.find(0)->second.front();
+    ReplacementInfo * info = lines_[0]->getReplacementInfo();
     if (!replacementMgr_->checkCompatibility(info))
         dbg_->fatal(CALL_INFO, -1, "CacheArray, Error: The replacement policy expects cache line state that is not provided by the cache line type of this cache. Check the type of the ReplacementInfo returned by the coherence protocol's line type and the ReplacementInfo type expected by the replacement policy.\n");
 
+    // Pick the replacement path once
+    if (LRUPacked* lru = dynamic_cast<LRUPacked*>(replacementMgr_)) {
+        packed_ = Packed::LRU;
+        lruState_ = &lru->getPackedState();
+    } else if (TreePLRU* plru = dynamic_cast<TreePLRU*>(replacementMgr_)) {
+        packed_ = Packed::PLRU;
+        plruState_ = &plru->getPackedState();
+    } else if (RRIPBase* rrip = dynamic_cast<RRIPBase*>(replacementMgr_)) {
+        packed_ = Packed::RRIP;
+        rripState_ = &rrip->getPackedState();
+    } else {
+        // Construct rInfo
+        rInfo.resize(numSets_);
+        for (unsigned int i = 0; i < numSets_; i++) {
+            rInfo[i].reserve(associativity_);
+            for (unsigned int j = 0; j < associativity; j++)
+                rInfo[i].push_back(lines_[i*associativity + j]->getReplacementInfo());
+        }
+    }
+
     setStates = new State[associativity_];
 }
 
 template <class T>
 CacheArray<T>::~CacheArray() {
-    for (size_t i = 0; i < lines_.size(); i++)
-        delete lines_[i];
+    if (flat_) {
+        for (size_t i = 0; i < lines_.size(); i++)
+            lines_[i]->~T();
+        ::operator delete(lineStore_);
+    } else {
+        for (size_t i = 0; i < lines_.size(); i++)
+            delete lines_[i];
+    }
     delete replacementMgr_;
     delete hash_;
     delete [] setStates;
@@ -158,15 +222,28 @@ Addr CacheArray<T>::toLineAddr(Addr addr) {
 
 template <class T>
 T* CacheArray<T>::lookup(const Addr addr, bool updateReplacement) {
-    Addr laddr = toLineAddr(addr);
-    int set = hash_->hash(0, laddr) % numSets_;
-    int setBegin = set * associativity_;
+    int setBegin = getSet(addr) * associativity_;
     int setEnd = setBegin + associativity_;
 
+    if (flat_) {
+        /* Compare every way without branching so the compiler can vectorize the loop */
+        const Addr* tags = &tags_[setBegin];
+        int hit = -1;
+        for (int i = associativity_ - 1; i >= 0; i--)
+            hit = (tags[i] == addr) ? i : hit;
+        if (hit < 0)
+            return nullptr; // Not found
+
+        unsigned int index = setBegin + hit;
+        if (updateReplacement)
+            touchLine(index);
+        return lines_[index];
+    }
+
     for (int i = setBegin; i < setEnd; i++) {
         if (lines_[i]->getAddr() == addr) {
             if (updateReplacement)
-                replacementMgr_->update(i, lines_[i]->getReplacementInfo());
+                touchLine(i);
             return lines_[i];
         }
     }
@@ -175,10 +252,7 @@ T* CacheArray<T>::lookup(const Addr addr, bool updateReplacement) {
 
 template <class T>
 T * CacheArray<T>::findReplacementCandidate(Addr addr) {
-    Addr laddr = toLineAddr(addr);
-    int set = hash_->hash(0, laddr) % numSets_;
-
-    unsigned int id = replacementMgr_->findBestCandidate(rInfo[set]);
+    unsigned int id = victimLine(getSet(addr));
 
     return lines_[id];
 }
@@ -186,19 +260,70 @@ T * CacheArray<T>::findReplacementCandidate(Addr addr) {
 template <class T>
 void CacheArray<T>::replace(Addr addr, T* candidate) {
     unsigned int index = candidate->getIndex();
-    replacementMgr_->replaced(index);
+    invalidateLine(index);
     candidate->reset();
     candidate->setAddr(addr);
-    replacementMgr_->update(index, lines_[index]->getReplacementInfo());
+    if (flat_)
+        tags_[index] = addr;
+    insertLine(index);
 }
 
 template <class T>
 void CacheArray<T>::deallocate(T* candidate) {
     unsigned int index = candidate->getIndex();
-    replacementMgr_->replaced(index);
+    invalidateLine(index);
     candidate->reset();
 }
 
+template <class T>
+void CacheArray<T>::touchLine(unsigned int index) {
+    switch (packed_) {
+        case Packed::LRU:   lruState_->touch(index / associativity_, index % associativity_); break;
+        case Packed::PLRU:  plruState_->touch(index / associativity_, index % associativity_); break;
+        case Packed::RRIP:  rripState_->touch(index / associativity_, index % associativity_); break;
+        default:            replacementMgr_->update(index, lines_[index]->getReplacementInfo());
+    }
+}
+
+template <class T>
+void CacheArray<T>::insertLine(unsigned int index) {
+    switch (packed_) {
+        case Packed::LRU:   lruState_->insert(index / associativity_, index % associativity_); break;
+        case Packed::PLRU:  plruState_->insert(index / associativity_, index % associativity_); break;
+        case Packed::RRIP:  rripState_->insert(index / associativity_, index % associativity_); break;
+        default:            replacementMgr_->update(index, lines_[index]->getReplacementInfo());
+    }
+}
+
+/* Interface policies are told about replacements and deallocations the same way */
+template <class T>
+void CacheArray<T>::invalidateLine(unsigned int index) {
+    switch (packed_) {
+        case Packed::LRU:   lruState_->invalidate(index / associativity_, index % associativity_); break;
+        case Packed::PLRU:  plruState_->invalidate(index / associativity_, index % associativity_); break;
+        case Packed::RRIP:  rripState_->invalidate(index / associativity_, index % associativity_); break;
+        default:            replacementMgr_->replaced(index);
+    }
+}
+
+/* Invalid lines are always replaced first, otherwise the packed state picks a victim way */
+template <class T>
+unsigned int CacheArray<T>::victimLine(unsigned int set) {
+    if (packed_ == Packed::None)
+        return replacementMgr_->findBestCandidate(rInfo[set]);
+
+    unsigned int setBegin = set * associativity_;
+    for (unsigned int i = setBegin; i < setBegin + associativity_; i++) {
+        if (lines_[i]->getState() == I)
+            return i;
+    }
+    switch (packed_) {
+        case Packed::LRU:   return setBegin + lruState_->victim(set);
+        case Packed::PLRU:  return setBegin + plruState_->victim(set);
+        default:            return setBegin + rripState_->victim(set);
+    }
+}
+
 template <class T>
 void CacheArray<T>::setSliceAware(Addr size, Addr step) {
     sliceSize_ = size >> lineOffset_;
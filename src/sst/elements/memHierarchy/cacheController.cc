@@ -14,6 +14,7 @@
 // distribution.
 
 #include <sst_config.h>
+#include <algorithm>
 #include <sst/core/params.h>
 #include <sst/core/simulation.h>
 #include <sst/core/interfaces/stringEvent.h>
@@ -38,12 +39,13 @@ using namespace SST::MemHierarchy;
 /* Handle incoming event on the cache links */
 void Cache::handleEvent(SST::Event * ev) {
     MemEventBase* event = static_cast<MemEventBase*>(ev);
-    if (!clockIsOn_)
+    if (!clockIsOn_ || eventDriven_)
         turnClockOn();
 
-    // Record the time at which requests arrive for latency statistics
+    // Record the time at which requests arrive for latency statistics.
+    // When event-driven, this cycle may not have been ticked yet.
     if (CommandClassArr[(int)event->getCmd()] == CommandClass::Request && !CommandWriteback[(int)event->getCmd()])
-        coherenceMgr_->recordIncomingRequest(event);
+        coherenceMgr_->recordIncomingRequest(event, eventDriven_ ? getCurrentSimTime(defaultTimeBase_) : timestamp_);
 
     eventBuffer_.push_back(event);
 }
@@ -60,7 +62,7 @@ void Cache::processPrefetchEvent(SST::Event * ev) {
     event->setRqstr(getName());
     event->setSrc(getName());
 
-    if (!clockIsOn_) {
+    if (!clockIsOn_ || eventDriven_) {
         turnClockOn();
     }
 
@@ -75,26 +77,30 @@ void Cache::processPrefetchEvent(SST::Event * ev) {
 
 /* Clock handler */
 bool Cache::clockTick(Cycle_t time) {
+    MEMH_PROFILE_SCOPE(&hostProfile_, profileClock_);
     timestamp_++;
 
     // Drain any outgoing messages
     bool idle = coherenceMgr_->sendOutgoingEvents();
 
+    bool linksIdle = true;
     if (clockUpLink_) {
-        idle &= linkUp_->clock();
+        linksIdle &= linkUp_->clock();
     }
     if (clockDownLink_) {
-        idle &= linkDown_->clock();
+        linksIdle &= linkDown_->clock();
     }
+    idle &= linksIdle;
 
     // MSHR occupancy
     statMSHROccupancy->addData(mshr_->getSize());
 
     // Clear bank status to prepare for event handling
-    for (unsigned int bank = 0; bank < bankStatus_.size(); bank++)
-        bankStatus_[bank] = false;
-
-    addrsThisCycle_.clear();
+    if (banked_) {
+        for (std::vector<Addr>::iterator it = accessesThisCycle_.begin(); it != accessesThisCycle_.end(); it++)
+            bankStatus_[*it] = false;
+    }
+    accessesThisCycle_.clear();
 
     // Handle events from each of the buffers
     // 1. Retry buffer      -> Events that need to be retried, e.g., were stalled due to a pending action that is now resolved
@@ -173,10 +179,26 @@ bool Cache::clockTick(Cycle_t time) {
     }
 
     // Keep the clock on
+    if (eventDriven_)
+        scheduleWakeup(linksIdle ? getNextWorkCycle() : timestamp_ + 1);
     return false;
 }
 
 void Cache::turnClockOn() {
+    if (eventDriven_) {
+        // A registered clock ticks before the events of its cycle are
+        // delivered, so a wakeup due this cycle is run now. Otherwise the
+        // current cycle is left for the next clockTick to count as idle.
+        Cycle_t cycle = getCurrentSimTime(defaultTimeBase_);
+        skipCycles(cycle);
+        if (wakeupCycle_ == cycle) {
+            wakeupCycle_ = 0;
+            clockTick(cycle);
+        }
+        scheduleWakeup(cycle + 1);
+        clockIsOn_ = true;
+        return;
+    }
     Cycle_t time = reregisterClock(defaultTimeBase_, clockHandler_);
     timestamp_ = time - 1;
     coherenceMgr_->updateTimestamp(timestamp_);
@@ -193,6 +215,49 @@ void Cache::turnClockOff() {
     lastActiveClockCycle_ = timestamp_;
 }
 
+/*
+ * Event-driven clocking (clock_mode = event)
+ * No clock is registered. Instead, the cache sends itself a wakeup for the next
+ * cycle that has work: the next cycle if events are buffered or a link needs
+ * its clock (see clockTick), otherwise the cycle the next outgoing event is
+ * due. Arriving events pull a later wakeup forward (turnClockOn); a wakeup
+ * that has been superseded or already run is ignored.
+ */
+void Cache::handleWakeup(SST::Event * ev) {
+    Cycle_t cycle = getCurrentSimTime(defaultTimeBase_);
+    if (cycle != wakeupCycle_)
+        return;
+    wakeupCycle_ = 0;
+
+    skipCycles(cycle);
+    clockTick(cycle);
+}
+
+void Cache::scheduleWakeup(Cycle_t cycle) {
+    if (wakeupCycle_ != 0 && wakeupCycle_ <= cycle)
+        return;
+    wakeupCycle_ = cycle;
+    wakeupSelfLink_->send(cycle * defaultTimeBase_->getFactor() - getCurrentSimCycle(), nullptr);
+}
+
+Cycle_t Cache::getNextWorkCycle() {
+    if (!eventBuffer_.empty() || !retryBuffer_.empty())
+        return timestamp_ + 1;
+    uint64_t next = coherenceMgr_->getNextSendTime();
+    return next > timestamp_ ? next : timestamp_ + 1;
+}
+
+/* Bring timestamps up to the cycle before 'cycle', recording statistics for the cycles that were skipped */
+void Cache::skipCycles(Cycle_t cycle) {
+    if (cycle <= timestamp_ + 1)
+        return;
+    uint64_t occupancy = mshr_->getSize();
+    for (uint64_t i = timestamp_ + 1; i < cycle; i++)
+        statMSHROccupancy->addData(occupancy);
+    timestamp_ = cycle - 1;
+    coherenceMgr_->updateTimestamp(timestamp_);
+}
+
 /**************************************************************************
  * Event processing
  **************************************************************************/
@@ -240,6 +305,7 @@ bool Cache::processEvent(MemEventBase* ev, bool inMSHR) {
     bool dbgevent = is_debug_event(event);
     bool accepted = false;
 
+    MEMH_PROFILE_SCOPE(&hostProfile_, profileHandler_[(int)event->getCmd()]);
     switch (event->getCmd()) {
         case Command::GetS:
             accepted = coherenceMgr_->handleGetS(event, inMSHR);
@@ -327,7 +393,7 @@ bool Cache::processEvent(MemEventBase* ev, bool inMSHR) {
 /* Arbitrate for access. Return whether successful */
 bool Cache::arbitrateAccess(Addr addr) {
     if (!banked_) {
-        if (addrsThisCycle_.find(addr) == addrsThisCycle_.end()) {
+        if (std::find(accessesThisCycle_.begin(), accessesThisCycle_.end(), addr) == accessesThisCycle_.end()) {
             return true;
         }
         return false;
@@ -344,10 +410,12 @@ bool Cache::arbitrateAccess(Addr addr) {
 
 /* Block banks that have been accessed */
 void Cache::updateAccessStatus(Addr addr) {
-    addrsThisCycle_.insert(addr);
     if (banked_) {
         Addr bank = coherenceMgr_->getBank(addr);
         bankStatus_[bank] = true;
+        accessesThisCycle_.push_back(bank);
+    } else {
+        accessesThisCycle_.push_back(addr);
     }
 }
 
@@ -493,9 +561,14 @@ void Cache::setup() {
 
 
 void Cache::finish() {
-    if (!clockIsOn_) { // Correct statistics
+    if (eventDriven_) { // Correct statistics
+        skipCycles(getCurrentSimTime(defaultTimeBase_) + 1);
+    } else if (!clockIsOn_) {
         turnClockOn();
     }
+#ifdef MEMH_HOST_PROFILE
+    hostProfile_.finish();
+#endif
     for (int i = 0; i < listeners_.size(); i++)
         listeners_[i]->printStats(*out_);
     linkDown_->finish();
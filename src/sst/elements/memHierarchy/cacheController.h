@@ -35,6 +35,7 @@
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/cacheListener.h"
 #include "sst/elements/memHierarchy/memLinkBase.h"
+#include "sst/elements/memHierarchy/hostProfiler.h"
 
 namespace SST { namespace MemHierarchy {
 
@@ -69,6 +70,7 @@ public:
             {"noninclusive_directory_entries", "(uint) Number of entries in the directory. Must be at least 1 if the non-inclusive directory exists.", "0"},
             {"noninclusive_directory_associativity", "(uint) For a set-associative directory, number of ways.", "1"},
             {"mshr_num_entries",        "(int) Number of MSHR entries. Not valid for L1s because L1 MSHRs assumed to be sized for the CPU's load/store queue. Setting this to -1 will create a very large MSHR.", "-1"},
+            {"mshr_type",               "(string) MSHR lookup structure. 'map' uses an ordered map, 'hash' uses an open-addressing table sized from mshr_num_entries. Options: map, hash", "map"},
             {"tag_access_latency_cycles",
                 "(uint) Latency (in cycles) to access tag portion only of cache. Paid by misses and coherence requests that don't need data. If not specified, defaults to access_latency_cycles","access_latency_cycles"},
             {"mshr_latency_cycles",
@@ -89,6 +91,8 @@ public:
             {"force_noncacheable_reqs", "(bool) Used for verification purposes. All requests are considered to be 'noncacheable'. Options: 0[off], 1[on]", "false"},
             {"min_packet_size",         "(string) Number of bytes in a request/response not including payload (e.g., addr + cmd). Specify in B.", "8B"},
             {"banks",                   "(uint) Number of cache banks: One access per bank per cycle. Use '0' to simulate no bank limits (only limits on bandwidth then are max_requests_per_cycle and *_link_width", "0"},
+            {"clock_mode",              "(string) How the cache schedules its work. 'clock' registers a clock that is turned off while the cache is idle. 'event' has the cache wake itself only for cycles in which it has work to do, skipping cycles spent waiting out access latencies. Options: clock, event", "clock"},
+            {"tag_store",               "(string) Layout of the cache tag array. 'flat' keeps tags in contiguous per-set arrays which speeds up lookups in large caches. Options: object, flat", "object"},
             /* Old parameters - deprecated or moved */
             {"network_address",             "DEPRECATED - Now auto-detected by link control."}, // Remove 9.0
             {"network_bw",                  "MOVED - Now a member of the MemNIC subcomponent.", "80GiB/s"}, // Remove 9.0
@@ -154,6 +158,8 @@ public:
             {"GetSX_uncache_recv",      "Noncacheable Event: GetSX received", "count", 4},
             {"GetSResp_uncache_recv",   "Noncacheable Event: GetSResp received", "count", 4},
             {"GetXResp_uncache_recv",   "Noncacheable Event: GetXResp received", "count", 4},
+            {"host_calls",              "Host profiling: number of times a region ran. One statistic per region (subId): handle<Command> for each coherence handler, clockTick, mshr_insert, mshr_remove. Only collected when built with MEMH_HOST_PROFILE.", "count", 5},
+            {"host_time_ns",            "Host profiling: wall-clock time spent in a region, inclusive of nested regions. One statistic per region (subId) as for host_calls. Only collected when built with MEMH_HOST_PROFILE.", "ns", 5},
             {"default_stat",            "Default statistic used for unexpected events/cases/etc. Should be 0, if not, check for missing statistic registrations.", "none", 7})
 
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
@@ -236,6 +242,12 @@ private:
     void turnClockOn();
     void turnClockOff();
 
+    // Event-driven clocking - wake up for the cycles that have work
+    void handleWakeup(SST::Event * ev);
+    void scheduleWakeup(Cycle_t cycle);
+    Cycle_t getNextWorkCycle();
+    void skipCycles(Cycle_t cycle);
+
     // Trigger timeouts if events sit in MSHR for too long
     void timeoutWakeup(SST::Event * ev);
     void checkTimeout();
@@ -254,6 +266,7 @@ private:
     MemLinkBase* linkDown_;                 // link manager down (towards memory)
     Link* prefetchSelfLink_;                // link to delay prefetch request receive
     Link* timeoutSelfLink_;                 // link to check for timeouts (possible deadlock)
+    Link* wakeupSelfLink_;                  // link to wake the cache when clock_mode is 'event'
     MSHR* mshr_;                            // MSHR
     CoherenceController* coherenceMgr_;     // Coherence protocol - where most of the event handling happens
 
@@ -276,12 +289,14 @@ private:
     bool                    clockUpLink_;   // Whether link actually needs clock() called or not
     bool                    clockDownLink_; // Whether link actually needs clock() called or not
     SimTime_t               lastActiveClockCycle_;  // Cycle we turned the clock off at - for re-syncing stats
+    bool                    eventDriven_;   // Whether clock_mode is 'event'
+    Cycle_t                 wakeupCycle_;   // Cycle of the pending wakeup, 0 if none
 
     /** Cache state ************************************************************/
     uint64_t                    timestamp_;
     int                         requestsThisCycle_;
     std::vector<bool>           bankStatus_;
-    std::set<Addr>              addrsThisCycle_;
+    std::vector<Addr>           accessesThisCycle_; // Banks (if banked) or addresses accessed this cycle
     std::list<MemEventBase*>    retryBuffer_;
     std::list<MemEventBase*>    eventBuffer_;
     std::queue<MemEventBase*>   prefetchBuffer_;
@@ -306,6 +321,13 @@ private:
     Statistic<uint64_t>* statRetryEvents;
     Statistic<uint64_t>* statUncacheRecv[(int)Command::LAST_CMD];
     Statistic<uint64_t>* statCacheRecv[(int)Command::LAST_CMD];
+
+#ifdef MEMH_HOST_PROFILE
+    /** Host profiling *********************************************************/
+    HostProfiler    hostProfile_;
+    unsigned int    profileHandler_[(int)Command::LAST_CMD];
+    unsigned int    profileClock_;
+#endif
 };
 
 }}
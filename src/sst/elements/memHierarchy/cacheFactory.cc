@@ -16,6 +16,7 @@
 #include <sst_config.h>
 #include <sst/core/stringize.h>
 #include <sst/core/params.h>
+#include <sst/core/simulation.h>
 #include <sst/core/timeLord.h>
 
 #include "hash.h"
@@ -156,6 +157,12 @@ void Cache::createCoherenceManager(Params &params) {
     coherenceParams.insert("dassoc", params.find<std::string>("noninclusive_directory_associativity", "0"));
     coherenceParams.insert("drpolicy", params.find<std::string>("noninclusive_directory_repl", "lru"));
 
+    std::string tagStore = params.find<std::string>("tag_store", "object");
+    to_lower(tagStore);
+    if (tagStore != "object" && tagStore != "flat")
+        out_->fatal(CALL_INFO, -1, "%s, Invalid param: tag_store - must be 'object' or 'flat'. You specified '%s'.\n", getName().c_str(), tagStore.c_str());
+    coherenceParams.insert("flat_tag_store", (tagStore == "flat") ? "true" : "false");
+
     bool prefetch = (statPrefetchRequest != nullptr);
 
     if (!L1) {
@@ -647,7 +654,11 @@ uint64_t Cache::createMSHR(Params &params, uint64_t accessLatency, bool L1) {
     if (mshrSize == 1 || mshrSize == 0)
         out_->fatal(CALL_INFO, -1, "Invalid param: mshr_num_entries - MSHR requires at least 2 entries to avoid deadlock. You specified %d\n", mshrSize);
 
-    mshr_ = new MSHR(dbg_, mshrSize, getName(), DEBUG_ADDR);
+    std::string mshrType = params.find<std::string>("mshr_type", "map");
+    if (mshrType != "map" && mshrType != "hash")
+        out_->fatal(CALL_INFO, -1, "%s, Invalid param: mshr_type - must be 'map' or 'hash'. You specified '%s'.\n", getName().c_str(), mshrType.c_str());
+
+    mshr_ = new MSHR(dbg_, mshrSize, getName(), DEBUG_ADDR, mshrType == "hash");
 
     if (mshrLatency > 0 && found)
         return mshrLatency;
@@ -728,10 +739,24 @@ void Cache::createClock(Params &params) {
     if (!found)
         out_->fatal(CALL_INFO, -1, "%s, Param not specified: frequency - cache frequency.\n", getName().c_str());
 
+    std::string clockMode = params.find<std::string>("clock_mode", "clock");
+    if (clockMode != "clock" && clockMode != "event")
+        out_->fatal(CALL_INFO, -1, "%s, Invalid param: clock_mode - must be 'clock' or 'event'. You specified '%s'.\n", getName().c_str(), clockMode.c_str());
+    eventDriven_ = (clockMode == "event");
+
     clockHandler_       = new Clock::Handler<Cache>(this, &Cache::clockTick);
-    defaultTimeBase_    = registerClock(frequency, clockHandler_);
+    wakeupSelfLink_     = nullptr;
+    wakeupCycle_        = 0;
+    if (eventDriven_) {
+        // Wakeup delays are computed in core time so wakeups land on clock edges
+        defaultTimeBase_    = registerTimeBase(frequency);
+        wakeupSelfLink_     = configureSelfLink("wakeup", getTimeConverter(Simulation::getSimulation()->getTimeLord()->getTimeBase()),
+                new Event::Handler<Cache>(this, &Cache::handleWakeup));
+    } else {
+        defaultTimeBase_    = registerClock(frequency, clockHandler_);
+    }
 
-    clockIsOn_ = true;
+    clockIsOn_ = !eventDriven_;
     timestamp_ = 0;
     lastActiveClockCycle_ = 0;
 
@@ -801,4 +826,20 @@ void Cache::registerStatistics() {
 
     statMSHROccupancy               = registerStatistic<uint64_t>("MSHR_occupancy");
     statBankConflicts               = registerStatistic<uint64_t>("Bank_conflicts");
+
+#ifdef MEMH_HOST_PROFILE
+    // Commands the coherence manager does not expect to receive share one region
+    unsigned int other = hostProfile_.addRegion("handleOther");
+    for (int i = 0; i < (int)Command::LAST_CMD; i++)
+        profileHandler_[i] = other;
+    for (std::set<Command>::iterator it = validrecv.begin(); it != validrecv.end(); it++)
+        profileHandler_[(int)(*it)] = hostProfile_.addRegion(std::string("handle") + CommandString[(int)(*it)]);
+    profileClock_ = hostProfile_.addRegion("clockTick");
+    mshr_->setHostProfiler(&hostProfile_);
+
+    for (unsigned int i = 0; i < hostProfile_.getRegionCount(); i++) {
+        hostProfile_.setStatistics(i, registerStatistic<uint64_t>("host_calls", hostProfile_.getRegionName(i)),
+                registerStatistic<uint64_t>("host_time_ns", hostProfile_.getRegionName(i)));
+    }
+#endif
 }
@@ -289,7 +289,7 @@ bool Incoherent::handlePutE(MemEvent * event, bool inMSHR) {
         case I:
             status = allocateLine(event, line, inMSHR);
             if (status == MemEventStatus::OK) {
-                line->setData(event->getPayload(), 0);
+                line->setData(event->getConstPayload(), 0);
                 line->setState(E);
                 if (sendWritebackAck_)
                     sendWritebackAck(event);
@@ -332,7 +332,7 @@ bool Incoherent::handlePutM(MemEvent * event, bool inMSHR) {
         case I:
             status = allocateLine(event, line, inMSHR);
             if (status == MemEventStatus::OK) {
-                line->setData(event->getPayload(), 0);
+                line->setData(event->getConstPayload(), 0);
                 line->setState(M);
                 if (sendWritebackAck_)
                     sendWritebackAck(event);
@@ -342,7 +342,7 @@ bool Incoherent::handlePutM(MemEvent * event, bool inMSHR) {
         case E:
             line->setState(M);
         case M:
-            line->setData(event->getPayload(), 0);
+            line->setData(event->getConstPayload(), 0);
             if (sendWritebackAck_)
                 sendWritebackAck(event);
             cleanUpAfterRequest(event, inMSHR);
@@ -381,7 +381,7 @@ bool Incoherent::handleGetSResp(MemEvent * event, bool inMSHR) {
 
     if (line) {
         line->setState(E);
-        line->setData(event->getPayload(), 0);
+        line->setData(event->getConstPayload(), 0);
         // Has to be a local prefetch
         line->setPrefetch(true);
         recordPrefetchLatency(req->getID(), LatType::MISS);
@@ -664,7 +664,7 @@ void Incoherent::doEvict(MemEvent * event, PrivateCacheLine * line) {
     if (state == E || state == M) {
         if (event->getDirty()) {
             line->setState(M);
-            line->setData(event->getPayload(), 0);
+            line->setData(event->getConstPayload(), 0);
         }
 
         event->setEvict(false);
@@ -140,7 +140,7 @@ bool IncoherentL1::handleGetX(MemEvent* event, bool inMSHR){
             recordLatencyType(event->getID(), LatType::HIT);
             // Handle
             if (!event->isStoreConditional() || line->isAtomic()) { /* Don't write on a non-atomic SC */
-                line->setData(event->getPayload(), event->getAddr() - event->getBaseAddr());
+                line->setData(event->getConstPayload(), event->getAddr() - event->getBaseAddr());
                 atomic = line->isAtomic();
                 line->atomicEnd();
             }
@@ -320,7 +320,7 @@ bool IncoherentL1::handleGetSResp(MemEvent * event, bool inMSHR) {
     bool localPrefetch = req->isPrefetch() && (req->getRqstr() == cachename_);
 
     // Update line
-    line->setData(event->getPayload(), 0);
+    line->setData(event->getConstPayload(), 0);
     line->setState(E);
     if (is_debug_addr(line->getAddr()))
         printData(line->getData(), true);
@@ -361,7 +361,7 @@ bool IncoherentL1::handleGetXResp(MemEvent * event, bool inMSHR) {
     req->setMemFlags(event->getMemFlags());
 
     // Set line data
-    line->setData(event->getPayload(), 0);
+    line->setData(event->getConstPayload(), 0);
     if (is_debug_addr(line->getAddr()))
         printData(line->getData(), true);
 
@@ -373,7 +373,7 @@ bool IncoherentL1::handleGetXResp(MemEvent * event, bool inMSHR) {
     std::vector<uint8_t> data;
     if (req->getCmd() == Command::GetX) {
         if (!req->isStoreConditional() || line->isAtomic()) {
-            line->setData(req->getPayload(), offset);
+            line->setData(req->getConstPayload(), offset);
             if (is_debug_addr(line->getAddr()))
                 printData(line->getData(), true);
             line->atomicEnd();
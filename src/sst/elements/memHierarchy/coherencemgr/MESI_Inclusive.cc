@@ -1300,7 +1300,7 @@ bool MESIInclusive::handleGetSResp(MemEvent * event, bool inMSHR) {
         printData(line->getData(), true);
 
     // Update line
-    line->setData(event->getPayload(), 0);
+    line->setData(event->getConstPayload(), 0);
     line->setState(S);
     if (localPrefetch) {
         line->setPrefetch(true);
@@ -1347,7 +1347,7 @@ bool MESIInclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
     switch (state) {
         case IS:
         {
-            line->setData(event->getPayload(), 0);
+            line->setData(event->getConstPayload(), 0);
             if (is_debug_addr(line->getAddr()))
                 printData(line->getData(), true);
 
@@ -1376,7 +1376,7 @@ bool MESIInclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
             break;
         }
         case IM:
-            line->setData(event->getPayload(), 0);
+            line->setData(event->getConstPayload(), 0);
             if (is_debug_addr(line->getAddr()))
                 printData(line->getData(), true);
         case SM:
@@ -1933,7 +1933,7 @@ State MESIInclusive::doEviction(MemEvent * event, SharedCacheLine * line, State
     recordPrefetchResult(line, statPrefetchEvict);
 
     if (event->getDirty()) {
-        line->setData(event->getPayload(), 0);
+        line->setData(event->getConstPayload(), 0);
         switch (state) {
             case E:
                 nState = M;
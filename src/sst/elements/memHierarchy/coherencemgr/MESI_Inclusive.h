@@ -256,7 +256,7 @@ public:
 
         ReplacementPolicy * rmgr = createReplacementPolicy(lines, assoc, params, false);
         HashFunction * ht = createHashFunction(params);
-        cacheArray_ = new CacheArray<SharedCacheLine>(debug, lines, assoc, lineSize_, rmgr, ht);
+        cacheArray_ = new CacheArray<SharedCacheLine>(debug, lines, assoc, lineSize_, rmgr, ht, params.find<bool>("flat_tag_store", false));
         cacheArray_->setBanked(params.find<uint64_t>("banks", 0));
 
         /* Statistics */
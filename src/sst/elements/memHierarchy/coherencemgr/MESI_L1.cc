@@ -208,7 +208,7 @@ bool MESIL1::handleGetX(MemEvent* event, bool inMSHR) {
             }
 
             if (!event->isStoreConditional() || line->isAtomic()) { // Don't write on a non-atomic SC
-                line->setData(event->getPayload(), event->getAddr() - event->getBaseAddr());
+                line->setData(event->getConstPayload(), event->getAddr() - event->getBaseAddr());
                 atomic = line->isAtomic();
                 line->atomicEnd();
             }
@@ -770,7 +770,7 @@ bool MESIL1::handleGetSResp(MemEvent* event, bool inMSHR) {
     req->setMemFlags(event->getMemFlags()); // Copy MemFlags through
 
     // Update line
-    line->setData(event->getPayload(), 0);
+    line->setData(event->getConstPayload(), 0);
     line->setState(S);
 
     if (is_debug_addr(addr))
@@ -820,7 +820,7 @@ bool MESIL1::handleGetXResp(MemEvent* event, bool inMSHR) {
     switch (state) {
         case IS:
             {
-                line->setData(event->getPayload(), 0);
+                line->setData(event->getConstPayload(), 0);
                 if (is_debug_addr(addr))
                     printData(line->getData(), true);
 
@@ -844,7 +844,7 @@ bool MESIL1::handleGetXResp(MemEvent* event, bool inMSHR) {
                 break;
             }
         case IM:
-            line->setData(event->getPayload(), 0);
+            line->setData(event->getConstPayload(), 0);
             if (is_debug_addr(addr))
                 printData(line->getData(), true);
         case SM:
@@ -853,7 +853,7 @@ bool MESIL1::handleGetXResp(MemEvent* event, bool inMSHR) {
 
                 if (req->getCmd() == Command::GetX) {
                     if (!req->isStoreConditional() || line->isAtomic()) { // Normal or successful store-conditional
-                        line->setData(req->getPayload(), offset);
+                        line->setData(req->getConstPayload(), offset);
 
                         if (is_debug_addr(addr))
                             printData(line->getData(), true);
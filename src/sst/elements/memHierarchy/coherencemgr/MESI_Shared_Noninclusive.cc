@@ -645,7 +645,7 @@ bool MESISharNoninclusive::handlePutS(MemEvent * event, bool inMSHR) {
                     break;
                 }
                 data = dataArray_->lookup(addr, true);
-                data->setData(event->getPayload(), 0);
+                data->setData(event->getConstPayload(), 0);
                 inMSHR = true;
             }
             if (!inMSHR || !mshr_->getProfiled(addr)) {
@@ -689,7 +689,7 @@ bool MESISharNoninclusive::handlePutS(MemEvent * event, bool inMSHR) {
             if (event->getSrc() == *(tag->getSharers()->begin())) { // Sent fetch to this requestor
                 // Retry the pending fetch
                 mshr_->decrementAcksNeeded(addr);
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->getConstPayload());
                 responses.find(addr)->second.erase(event->getSrc());
                 if (responses.find(addr)->second.empty())
                     responses.erase(addr);
@@ -772,7 +772,7 @@ bool MESISharNoninclusive::handlePutE(MemEvent * event, bool inMSHR) {
                     break;
                 }
                 data = dataArray_->lookup(addr, true);
-                data->setData(event->getPayload(), 0);
+                data->setData(event->getConstPayload(), 0);
                 inMSHR = true;
             }
             tag->removeOwner();
@@ -787,7 +787,7 @@ bool MESISharNoninclusive::handlePutE(MemEvent * event, bool inMSHR) {
             tag->removeOwner();
             mshr_->decrementAcksNeeded(addr);
             if (!data && !mshr_->hasData(addr))
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->getConstPayload());
             responses.find(addr)->second.erase(event->getSrc());
             if (responses.find(addr)->second.empty())
                 responses.erase(addr);
@@ -817,7 +817,7 @@ bool MESISharNoninclusive::handlePutE(MemEvent * event, bool inMSHR) {
             tag->removeOwner();
             mshr_->decrementAcksNeeded(addr);
             if (!data && !mshr_->hasData(addr))
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->getConstPayload());
             responses.find(addr)->second.erase(event->getSrc());
             if (responses.find(addr)->second.empty())
                 responses.erase(addr);
@@ -876,7 +876,7 @@ bool MESISharNoninclusive::handlePutM(MemEvent * event, bool inMSHR) {
                     break;
                 }
                 data = dataArray_->lookup(addr, true);
-                data->setData(event->getPayload(), 0);
+                data->setData(event->getConstPayload(), 0);
                 inMSHR = true;
             } else if (!inMSHR || !mshr_->getProfiled(addr)) {
                 stat_eventState[(int)Command::PutM][state]->addData(1);
@@ -903,13 +903,13 @@ bool MESISharNoninclusive::handlePutM(MemEvent * event, bool inMSHR) {
                 if (!inMSHR || !mshr_->getProfiled(addr)) {
                     stat_eventState[(int)Command::PutM][state]->addData(1);
                 }
-                data->setData(event->getPayload(), 0);
+                data->setData(event->getConstPayload(), 0);
                 sendWritebackAck(event);
                 cleanUpEvent(event, inMSHR);
             } else {
                 tag->addSharer(event->getSrc());
                 event->setCmd(Command::PutS);
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->getConstPayload());
                 if (inMSHR)
                     mshr_->removeFront(addr); // Need to reinsert after the conflicting request
                 MemEventBase* entry = mshr_->getEntryEvent(addr, 1);
@@ -930,7 +930,7 @@ bool MESISharNoninclusive::handlePutM(MemEvent * event, bool inMSHR) {
             tag->removeOwner();
             mshr_->decrementAcksNeeded(addr);
             if (!data && !mshr_->hasData(addr))
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->getConstPayload());
             responses.find(addr)->second.erase(event->getSrc());
             if (responses.find(addr)->second.empty())
                 responses.erase(addr);
@@ -984,7 +984,7 @@ bool MESISharNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
                 tag->setState(M);
 
             if (data)
-                data->setData(event->getPayload(), 0);
+                data->setData(event->getConstPayload(), 0);
 
             cleanUpAfterRequest(event, inMSHR);
             break;
@@ -996,9 +996,9 @@ bool MESISharNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
                 tag->setState(E);
 
             if (data)
-                data->setData(event->getPayload(), 0);
+                data->setData(event->getConstPayload(), 0);
             else
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->getConstPayload());
 
             mshr_->decrementAcksNeeded(addr);
 
@@ -1010,9 +1010,9 @@ bool MESISharNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
                 tag->setState(M_Inv);
 
             if (data)
-                data->setData(event->getPayload(), 0);
+                data->setData(event->getConstPayload(), 0);
             else
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->getConstPayload());
 
             cleanUpEvent(event, inMSHR);
             break;
@@ -1827,7 +1827,7 @@ bool MESISharNoninclusive::handleGetSResp(MemEvent * event, bool inMSHR) {
 
     tag->setState(S);
     if (data)
-        data->setData(event->getPayload(), 0);
+        data->setData(event->getConstPayload(), 0);
 
     if (localPrefetch) {
         tag->setPrefetch(true);
@@ -1869,7 +1869,7 @@ bool MESISharNoninclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
         eventDI.prefill(event->getID(), Command::GetXResp, localPrefetch, addr, state);
 
     if (data)
-        data->setData(event->getPayload(), 0);
+        data->setData(event->getConstPayload(), 0);
 
     stat_eventState[(int)Command::GetXResp][state]->addData(1);
 
@@ -1927,7 +1927,7 @@ bool MESISharNoninclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
             tag->setState(M_Inv);
             mshr_->setInProgress(addr, false);
             if (!data && event->getPayloadSize() != 0)
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->getConstPayload());
             if (is_debug_event(event)) {
                 eventDI.action = "Stall";
                 eventDI.reason = "Acks needed";
@@ -2014,9 +2014,9 @@ bool MESISharNoninclusive::handleFetchResp(MemEvent * event, bool inMSHR) {
         responses.erase(addr);
 
     if (data)
-        data->setData(event->getPayload(), 0);
+        data->setData(event->getConstPayload(), 0);
     else
-        mshr_->setData(addr, event->getPayload());
+        mshr_->setData(addr, event->getConstPayload());
 
     stat_eventState[(int)Command::FetchResp][state]->addData(1);
 
@@ -2115,9 +2115,9 @@ bool MESISharNoninclusive::handleFetchXResp(MemEvent * event, bool inMSHR) {
 
     // Save data
     if (data)
-        data->setData(event->getPayload(), 0);
+        data->setData(event->getConstPayload(), 0);
     else
-        mshr_->setData(addr, event->getPayload());
+        mshr_->setData(addr, event->getConstPayload());
 
     // Clean up and retry
     retry(addr);
@@ -3122,7 +3122,7 @@ void MESISharNoninclusive::removeSharerViaInv(MemEvent * event, DirectoryLine *
     Addr addr = event->getBaseAddr();
     tag->removeSharer(event->getSrc());
     if (!data && !mshr_->hasData(addr))
-        mshr_->setData(addr, event->getPayload());
+        mshr_->setData(addr, event->getConstPayload());
 
     if (remove) {
         responses.find(addr)->second.erase(event->getSrc());
@@ -3135,9 +3135,9 @@ void MESISharNoninclusive::removeOwnerViaInv(MemEvent * event, DirectoryLine * t
     Addr addr = event->getBaseAddr();
     tag->removeOwner();
     if (data)
-        data->setData(event->getPayload(), 0);
+        data->setData(event->getConstPayload(), 0);
     else
-        mshr_->setData(addr, event->getPayload());
+        mshr_->setData(addr, event->getConstPayload());
 
     if (event->getDirty()) {
         if (tag->getState() == E)
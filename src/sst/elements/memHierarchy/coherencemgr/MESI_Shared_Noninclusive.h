@@ -273,14 +273,14 @@ public:
 
         ReplacementPolicy * rmgr = createReplacementPolicy(lines, assoc, params, false);
         HashFunction * ht = createHashFunction(params);
-        dataArray_ = new CacheArray<DataLine>(debug, lines, assoc, lineSize_, rmgr, ht);
+        dataArray_ = new CacheArray<DataLine>(debug, lines, assoc, lineSize_, rmgr, ht, params.find<bool>("flat_tag_store", false));
         dataArray_->setBanked(params.find<uint64_t>("banks", 0));
 
         uint64_t dLines = params.find<uint64_t>("dlines");
         uint64_t dAssoc = params.find<uint64_t>("dassoc");
         params.insert("replacement_policy", params.find<std::string>("drpolicy", "lru"));
         ReplacementPolicy *drmgr = createReplacementPolicy(dLines, dAssoc, params, 1, false);
-        dirArray_ = new CacheArray<DirectoryLine>(debug, dLines, dAssoc, lineSize_, drmgr, ht);
+        dirArray_ = new CacheArray<DirectoryLine>(debug, dLines, dAssoc, lineSize_, drmgr, ht, params.find<bool>("flat_tag_store", false));
         dirArray_->setBanked(params.find<uint64_t>("banks", 0));
 
         /* Statistics */
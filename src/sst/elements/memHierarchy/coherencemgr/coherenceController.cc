@@ -15,6 +15,7 @@
 
 
 #include <sst_config.h>
+#include <limits>
 
 #include "coherencemgr/coherenceController.h"
 
@@ -147,8 +148,13 @@ ReplacementPolicy* CoherenceController::createReplacementPolicy(uint64_t lines,
     }
     if (policy == "random") return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.random", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
     if (policy == "nmru")   return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.nmru", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "lru-packed") return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.lru-packed", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "plru")   return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.plru", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "srrip")  return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.srrip", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "brrip")  return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.brrip", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "drrip")  return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.drrip", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
 
-    debug->fatal(CALL_INFO, -1, "%s, Invalid param: replacement_policy - supported policies are 'lru', 'lfu', 'random', 'mru', and 'nmru'. You specified '%s'.\n", getName().c_str(), policy.c_str());
+    debug->fatal(CALL_INFO, -1, "%s, Invalid param: replacement_policy - supported policies are 'lru', 'lfu', 'random', 'mru', 'nmru', 'lru-packed', 'plru', 'srrip', 'brrip', and 'drrip'. You specified '%s'.\n", getName().c_str(), policy.c_str());
     return nullptr;
 }
 
@@ -380,6 +386,16 @@ bool CoherenceController::checkIdle() {
     return outgoingEventQueue_.empty() && outgoingEventQueueUp_.empty();
 }
 
+/* Events leave each queue in order, so only the queue heads matter */
+uint64_t CoherenceController::getNextSendTime() {
+    uint64_t next = std::numeric_limits<uint64_t>::max();
+    if (!outgoingEventQueue_.empty())
+        next = outgoingEventQueue_.front().deliveryTime;
+    if (!outgoingEventQueueUp_.empty() && outgoingEventQueueUp_.front().deliveryTime < next)
+        next = outgoingEventQueueUp_.front().deliveryTime;
+    return next;
+}
+
 
 /* Forward an events toward memory. Return expected send time. */
 uint64_t CoherenceController::forwardTowardsMem(MemEventBase * event) {
@@ -716,9 +732,9 @@ void CoherenceController::addToOutgoingQueueUp(Response& resp) {
 /******** Statistics handling *********/
 /**************************************/
 
-void CoherenceController::recordIncomingRequest(MemEventBase* event) {
+void CoherenceController::recordIncomingRequest(MemEventBase* event, uint64_t arrivalCycle) {
     // Default type is -1
-    LatencyStat lat(timestamp_, event->getCmd(), -1);
+    LatencyStat lat(arrivalCycle, event->getCmd(), -1);
     startTimes_.insert(std::make_pair(event->getID(), lat));
 }
 
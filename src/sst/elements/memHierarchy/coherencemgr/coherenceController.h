@@ -106,6 +106,9 @@ public:
     /* Check whether the event queues are empty/subcomponent is doing anything */
     bool checkIdle();
 
+    /* Earliest time at which a queued event can be sent, or uint64_t max if the queues are empty */
+    uint64_t getNextSendTime();
+
     /* Get which bank an address maps to (call through to cache array) */
     virtual Addr getBank(Addr addr) = 0;
 
@@ -173,7 +176,7 @@ public:
     virtual void recordLatency(Command cmd, int type, uint64_t latency) =0;
 
     // TODO are these needed still?
-    virtual void recordIncomingRequest(MemEventBase* event);
+    virtual void recordIncomingRequest(MemEventBase* event, uint64_t arrivalCycle);
     virtual void removeRequestRecord(SST::Event::id_type id);
     virtual void recordMiss(SST::Event::id_type id);
 
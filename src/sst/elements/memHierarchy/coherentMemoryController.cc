@@ -293,7 +293,7 @@ void CoherentMemController::handleFlush(MemEvent * ev) {
                     MemEvent * resp = new MemEvent(ev->getSrc(), ev->getBaseAddr(), ev->getBaseAddr(), Command::AckInv);
                     if (ev->getPayloadSize() != 0) {
                         resp->setDirty(ev->getDirty());
-                        resp->setPayload(ev->getPayload());
+                        resp->sharePayload(ev);
                         ev->setPayload(0, nullptr);
                         ev->setDirty(false);
                         handleFetchResp(resp);
@@ -256,6 +256,9 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
     stat_getRequestLatency          = registerStatistic<uint64_t>("get_request_latency");
     stat_cacheHits                  = registerStatistic<uint64_t>("directory_cache_hits");
     stat_mshrHits                   = registerStatistic<uint64_t>("mshr_hits");
+    stat_dirEvictions               = registerStatistic<uint64_t>("directory_evictions");
+    stat_dirEvictionInvs            = registerStatistic<uint64_t>("directory_eviction_invalidations");
+    stat_dirOverflows               = registerStatistic<uint64_t>("directory_overflows");
     stat_eventRecv[(int)Command::GetX] = registerStatistic<uint64_t>("GetX_recv");
     stat_eventRecv[(int)Command::GetS] = registerStatistic<uint64_t>("GetS_recv");
     stat_eventRecv[(int)Command::GetSX] = registerStatistic<uint64_t>("GetSX_recv");
@@ -315,6 +318,21 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
     entryCacheSize = 0;
     entrySize = 4; // Bytes, TODO parameterize
 
+    std::string dirType = params.find<std::string>("directory_type", "full");
+    if (dirType == "full") {
+        directory = new DirectoryStorage(0, 0, lineSize);
+    } else if (dirType == "sparse") {
+        uint64_t sparseEntries = params.find<uint64_t>("sparse_entries", 65536);
+        uint32_t sparseAssoc = params.find<uint32_t>("sparse_associativity", 16);
+        if (sparseAssoc == 0 || sparseEntries == 0 || sparseEntries % sparseAssoc != 0)
+            dbg.fatal(CALL_INFO, -1, "Invalid param(%s): sparse_entries must be a non-zero multiple of sparse_associativity. You specified sparse_entries=%" PRIu64 " and sparse_associativity=%" PRIu32 "\n",
+                    getName().c_str(), sparseEntries, sparseAssoc);
+        directory = new DirectoryStorage(sparseEntries / sparseAssoc, sparseAssoc, lineSize);
+    } else {
+        dbg.fatal(CALL_INFO, -1, "Invalid param(%s): directory_type - must be 'full' or 'sparse'. You specified: %s\n", getName().c_str(), dirType.c_str());
+    }
+    useCounter = 0;
+
     string protstr  = params.find<std::string>("coherence_protocol", "MESI");
     if (protstr == "mesi" || protstr == "MESI") protocol = CoherenceProtocol::MESI;
     else if (protstr == "msi" || protstr == "MSI") protocol = CoherenceProtocol::MSI;
@@ -324,6 +342,24 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
     if (mshrSize == 0) dbg.fatal(CALL_INFO, -1, "Invalid param(%s): mshr_num_entries - must be at least 1 or else negative to indicate an unlimited size MSHR\n", getName().c_str());
     mshr                = new MSHR(&dbg, mshrSize, getName(), DEBUG_ADDR);
 
+#ifdef MEMH_HOST_PROFILE
+    Command handled[] = { Command::GetS, Command::GetSX, Command::GetX, Command::PutS, Command::PutE, Command::PutX, Command::PutM,
+        Command::FlushLineInv, Command::FlushLine, Command::FetchInv, Command::ForceInv, Command::GetXResp, Command::GetSResp,
+        Command::FlushLineResp, Command::AckInv, Command::AckPut, Command::FetchResp, Command::FetchXResp, Command::NACK };
+    unsigned int other = hostProfile.addRegion("handleOther");
+    for (int i = 0; i < (int)Command::LAST_CMD; i++)
+        profileHandler[i] = other;
+    for (size_t i = 0; i < sizeof(handled) / sizeof(handled[0]); i++)
+        profileHandler[(int)handled[i]] = hostProfile.addRegion(std::string("handle") + CommandString[(int)handled[i]]);
+    profileClock = hostProfile.addRegion("clock");
+    mshr->setHostProfiler(&hostProfile);
+
+    for (unsigned int i = 0; i < hostProfile.getRegionCount(); i++) {
+        hostProfile.setStatistics(i, registerStatistic<uint64_t>("host_calls", hostProfile.getRegionName(i)),
+                registerStatistic<uint64_t>("host_time_ns", hostProfile.getRegionName(i)));
+    }
+#endif
+
     /* Get latencies */
     accessLatency   = params.find<uint64_t>("access_latency_cycles", 0);
     mshrLatency     = params.find<uint64_t>("mshr_latency_cycles", 0);
@@ -332,10 +368,7 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
 
 
 DirectoryController::~DirectoryController(){
-    for(std::unordered_map<Addr, DirEntry*>::iterator i = directory.begin(); i != directory.end() ; ++i){
-        delete i->second;
-    }
-    directory.clear();
+    delete directory;
 }
 
 
@@ -373,6 +406,7 @@ void DirectoryController::handlePacket(SST::Event *event){
  *  Called each cycle. Handle any waiting events in the queue.
  */
 bool DirectoryController::clock(SST::Cycle_t cycle){
+    MEMH_PROFILE_SCOPE(&hostProfile, profileClock);
     timestamp = cycle;
     stat_MSHROccupancy->addData(mshr->getSize());
 
@@ -421,6 +455,10 @@ bool DirectoryController::clock(SST::Cycle_t cycle){
         }
     }
 
+    for (std::vector<DirEntry*>::iterator rit = releasedEntries.begin(); rit != releasedEntries.end(); rit++)
+        directory->recycle(*rit);
+    releasedEntries.clear();
+
     idle &= (eventBuffer.empty() && retryBuffer.empty());
     idle &= (cpuMsgQueue.empty() && memMsgQueue.empty());
 
@@ -452,6 +490,7 @@ bool DirectoryController::processPacket(MemEvent * ev, bool replay) {
         stat_eventRecv[(int)cmd]->addData(1);
     }
 
+    MEMH_PROFILE_SCOPE(&hostProfile, profileHandler[(int)cmd]);
     switch (cmd) {
         case Command::GetS:
             retval = handleGetS(ev, replay);
@@ -576,9 +615,9 @@ void DirectoryController::printStatus(Output &statusOut) {
     }
 
     statusOut.output("  Directory entries:\n");
-    for (std::unordered_map<Addr, DirEntry*>::iterator it = directory.begin(); it != directory.end(); it++) {
-        statusOut.output("    0x%" PRIx64 " %s\n", it->first, it->second->getString().c_str());
-    }
+    directory->forEach([&statusOut](DirEntry* entry) {
+        statusOut.output("    0x%" PRIx64 " %s\n", entry->getBaseAddr(), entry->getString().c_str());
+    });
     statusOut.output("End MemHierarchy::DirectoryController\n\n");
 }
 
@@ -702,6 +741,9 @@ void DirectoryController::init(unsigned int phase) {
 
 
 void DirectoryController::finish(void){
+#ifdef MEMH_HOST_PROFILE
+    hostProfile.finish();
+#endif
     cpuLink->finish();
 }
 
@@ -709,6 +751,11 @@ void DirectoryController::finish(void){
 
 void DirectoryController::setup(void){
     cpuLink->setup();
+
+    // Number the caches we already know about so that sharer vectors start out wide enough
+    std::set<MemLinkBase::EndpointInfo>* sources = cpuLink->getSources();
+    for (std::set<MemLinkBase::EndpointInfo>::iterator it = sources->begin(); it != sources->end(); it++)
+        nodeId(it->name);
     //MemLinkBase * mem = memLink ? memLink : network;
     // dircc->configure(getName(), memoryName, sendWBAck, recvWBAck, network, mem);
 }
@@ -743,12 +790,12 @@ bool DirectoryController::handleGetS(MemEvent * event, bool inMSHR) {
                 else {
                     if (protocol == CoherenceProtocol::MESI) {
                         entry->setState(M);
-                        entry->setOwner(event->getSrc());
+                        entry->setOwner(nodeId(event->getSrc()));
                         sendDataResponse(event, entry, mshr->getData(addr), Command::GetXResp);
                         mshr->clearData(addr);
                     } else {
                         entry->setState(S);
-                        entry->addSharer(event->getSrc());
+                        entry->addSharer(nodeId(event->getSrc()));
                         sendDataResponse(event, entry, mshr->getData(addr), Command::GetSResp);
                     }
                     if (is_debug_event(event)) {
@@ -770,7 +817,7 @@ bool DirectoryController::handleGetS(MemEvent * event, bool inMSHR) {
             break;
         case S:
             if (mshr->hasData(addr)) { // saved from earlier request
-                entry->addSharer(event->getSrc());
+                entry->addSharer(nodeId(event->getSrc()));
                 sendDataResponse(event, entry, mshr->getData(addr), Command::GetSResp);
                 if (is_debug_event(event)) {
                     eventDI.reason = "hit";
@@ -844,7 +891,7 @@ bool DirectoryController::handleGetX(MemEvent * event, bool inMSHR) {
                     out.output("ALERT (%s): mshr should NOT have data for 0x%" PRIx64 " but it does...\n", getName().c_str(), addr);
                 else {
                     entry->setState(M);
-                    entry->setOwner(event->getSrc());
+                    entry->setOwner(nodeId(event->getSrc()));
                     sendDataResponse(event, entry, mshr->getData(addr), Command::GetXResp);
                     mshr->clearData(addr);
                     if (is_debug_event(event)) {
@@ -868,13 +915,13 @@ bool DirectoryController::handleGetX(MemEvent * event, bool inMSHR) {
             // Upgrade request and no other sharers -> respond & M
             // Upgrade request and other sharers -> invalidate other sharers & S_Inv
             // Otherwise need data & invalidate sharers -> invalidate other sharers, request data from Memory, SM_Inv
-            if (entry->isSharer(event->getSrc())) { // Don't need data
+            if (entry->isSharer(nodeId(event->getSrc()))) { // Don't need data
                 if (entry->getSharerCount() == 1) { // Also don't need to invalidate
                     if (mshr->hasData(addr))
                         mshr->clearData(addr);
                     entry->setState(M);
-                    entry->removeSharer(event->getSrc());
-                    entry->setOwner(event->getSrc());
+                    entry->removeSharer(nodeId(event->getSrc()));
+                    entry->setOwner(nodeId(event->getSrc()));
                     sendResponse(event);
                     if (is_debug_event(event)) {
                         eventDI.reason = "hit";
@@ -970,8 +1017,8 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
             if (status == MemEventStatus::OK) {
                 if (event->getEvict()) {
                     entry->removeOwner();
-                    entry->addSharer(event->getSrc());
-                    mshr->setData(addr, event->getPayload(), event->getDirty());
+                    entry->addSharer(nodeId(event->getSrc()));
+                    mshr->setData(addr, event->getConstPayload(), event->getDirty());
                     event->setEvict(false);
                 } else if (entry->hasOwner()) {
                     issueFetch(event, entry, Command::FetchInvX);
@@ -985,8 +1032,8 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
         case M_Inv:
             if (event->getEvict()) {
                 entry->removeOwner();
-                entry->addSharer(event->getSrc());
-                mshr->setData(addr, event->getPayload(), event->getDirty());
+                entry->addSharer(nodeId(event->getSrc()));
+                mshr->setData(addr, event->getConstPayload(), event->getDirty());
                 event->setEvict(false);
                 entry->setState(S_Inv);
             }
@@ -994,12 +1041,11 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
         case M_InvX:
             if (event->getEvict()) {
                 entry->removeOwner();
-                entry->addSharer(event->getSrc());
-                mshr->setData(addr, event->getPayload(), event->getDirty());
+                entry->addSharer(nodeId(event->getSrc()));
+                mshr->setData(addr, event->getConstPayload(), event->getDirty());
                 entry->setState(S);
                 mshr->decrementAcksNeeded(addr);
-                responses.find(addr)->second.erase(event->getSrc());
-                if (responses.find(addr)->second.empty()) responses.erase(addr);
+                removeResponse(addr, nodeId(event->getSrc()));
                 retryBuffer.push_back(static_cast<MemEvent*>(mshr->getFrontEvent(addr)));
             }
             break;
@@ -1045,7 +1091,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
         case S:
             if (status == MemEventStatus::OK) {
                 if (event->getEvict()) {
-                    entry->removeSharer(event->getSrc());
+                    entry->removeSharer(nodeId(event->getSrc()));
                     event->setEvict(false);
                 }
 
@@ -1062,7 +1108,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             if (status == MemEventStatus::OK) {
                 if (event->getEvict()) {
                     entry->removeOwner();
-                    mshr->setData(addr, event->getPayload(), event->getDirty());
+                    mshr->setData(addr, event->getConstPayload(), event->getDirty());
                     event->setEvict(false);
                 }
 
@@ -1077,7 +1123,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case S_D:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(nodeId(event->getSrc()));
                 event->setEvict(false);
                 if (!entry->hasSharers())
                     entry->setState(IS);
@@ -1085,7 +1131,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case S_B:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(nodeId(event->getSrc()));
                 event->setEvict(false);
                 if (!entry->hasSharers())
                     entry->setState(I);
@@ -1094,10 +1140,9 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
         case M_InvX:
             if (event->getEvict()) {
                 entry->removeOwner();
-                mshr->setData(addr, event->getPayload(), event->getDirty());
+                mshr->setData(addr, event->getConstPayload(), event->getDirty());
                 event->setEvict(false);
-                responses.find(addr)->second.erase(event->getSrc());
-                if (responses.find(addr)->second.empty()) responses.erase(addr);
+                removeResponse(addr, nodeId(event->getSrc()));
 
                 if (mshr->decrementAcksNeeded(addr)) {
                     entry->setState(I);
@@ -1107,10 +1152,9 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case SD_Inv:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(nodeId(event->getSrc()));
                 event->setEvict(false);
-                responses.find(addr)->second.erase(event->getSrc());
-                if (responses.find(addr)->second.empty()) responses.erase(addr);
+                removeResponse(addr, nodeId(event->getSrc()));
                 if (mshr->decrementAcksNeeded(addr)) {
                     entry->hasSharers() ? entry->setState(S_D) : entry->setState(IS);
                     retryBuffer.push_back(static_cast<MemEvent*>(mshr->getFrontEvent(addr)));
@@ -1119,10 +1163,9 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case SM_Inv:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(nodeId(event->getSrc()));
                 event->setEvict(false);
-                responses.find(addr)->second.erase(event->getSrc());
-                if (responses.find(addr)->second.empty()) responses.erase(addr);
+                removeResponse(addr, nodeId(event->getSrc()));
                 if (mshr->decrementAcksNeeded(addr)) {
                     entry->setState(IM);
                 }
@@ -1130,10 +1173,9 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case S_Inv:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(nodeId(event->getSrc()));
                 event->setEvict(false);
-                responses.find(addr)->second.erase(event->getSrc());
-                if (responses.find(addr)->second.empty()) responses.erase(addr);
+                removeResponse(addr, nodeId(event->getSrc()));
                 if (mshr->decrementAcksNeeded(addr)) {
                     entry->hasSharers() ? entry->setState(S) : entry->setState(I);
                     retryBuffer.push_back(static_cast<MemEvent*>(mshr->getFrontEvent(addr)));
@@ -1142,10 +1184,9 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case M_Inv:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(nodeId(event->getSrc()));
                 event->setEvict(false);
-                responses.find(addr)->second.erase(event->getSrc());
-                if (responses.find(addr)->second.empty()) responses.erase(addr);
+                removeResponse(addr, nodeId(event->getSrc()));
                 if (mshr->decrementAcksNeeded(addr)) {
                     entry->setState(I);
                     retryBuffer.push_back(static_cast<MemEvent*>(mshr->getFrontEvent(addr)));
@@ -1183,13 +1224,10 @@ bool DirectoryController::handlePutS(MemEvent * event, bool inMSHR) {
     if (!inMSHR)
         stat_cacheHits->addData(1);
 
-    entry->removeSharer(event->getSrc());
+    entry->removeSharer(nodeId(event->getSrc()));
     sendAckPut(event);
 
-    if (responses.find(addr) != responses.end() && responses.find(addr)->second.find(event->getSrc()) != responses.find(addr)->second.end()) {
-        responses.find(addr)->second.erase(event->getSrc());
-        if (responses.find(addr)->second.empty()) responses.erase(addr);
-    }
+    removeResponse(addr, nodeId(event->getSrc()));
 
     bool update = false;
     switch (state) {
@@ -1258,7 +1296,7 @@ bool DirectoryController::handlePutX(MemEvent * event, bool inMSHR) {
         stat_cacheHits->addData(1);
 
     entry->removeOwner();
-    entry->addSharer(event->getSrc());
+    entry->addSharer(nodeId(event->getSrc()));
 
     sendAckPut(event);
 
@@ -1272,14 +1310,13 @@ bool DirectoryController::handlePutX(MemEvent * event, bool inMSHR) {
             update = true;
             break;
         case M_Inv:
-            mshr->setData(addr, event->getPayload(), event->getDirty());
+            mshr->setData(addr, event->getConstPayload(), event->getDirty());
             entry->setState(S_Inv);
             break;
         case M_InvX:
             mshr->decrementAcksNeeded(addr);
-            responses.find(addr)->second.erase(event->getSrc());
-            if (responses.find(addr)->second.empty()) responses.erase(addr);
-            mshr->setData(addr, event->getPayload(), event->getDirty());
+            removeResponse(addr, nodeId(event->getSrc()));
+            mshr->setData(addr, event->getConstPayload(), event->getDirty());
             entry->setState(S);
             break;
         default:
@@ -1326,9 +1363,8 @@ bool DirectoryController::handlePutE(MemEvent * event, bool inMSHR) {
         case M_Inv:
         case M_InvX:
             mshr->decrementAcksNeeded(addr);
-            responses.find(addr)->second.erase(event->getSrc());
-            if (responses.find(addr)->second.empty()) responses.erase(addr);
-            mshr->setData(addr, event->getPayload(), event->getDirty());
+            removeResponse(addr, nodeId(event->getSrc()));
+            mshr->setData(addr, event->getConstPayload(), event->getDirty());
             entry->setState(I);
             break;
         default:
@@ -1376,9 +1412,8 @@ bool DirectoryController::handlePutM(MemEvent * event, bool inMSHR) {
         case M_Inv:
         case M_InvX:
             mshr->decrementAcksNeeded(addr);
-            responses.find(addr)->second.erase(event->getSrc());
-            if (responses.find(addr)->second.empty()) responses.erase(addr);
-            mshr->setData(addr, event->getPayload(), event->getDirty());
+            removeResponse(addr, nodeId(event->getSrc()));
+            mshr->setData(addr, event->getConstPayload(), event->getDirty());
             entry->setState(I);
             break;
         default:
@@ -1624,10 +1659,10 @@ bool DirectoryController::handleGetSResp(MemEvent * event, bool inMSHR) {
     }
 
     entry->setState(S);
-    entry->addSharer(reqEv->getSrc());
+    entry->addSharer(nodeId(reqEv->getSrc()));
 
     sendDataResponse(reqEv, entry, event->getPayload(), Command::GetSResp);
-    mshr->setData(addr, event->getPayload(), false); // Save data for a subsequent GetS
+    mshr->setData(addr, event->getConstPayload(), false); // Save data for a subsequent GetS
     cleanUpAfterResponse(event, inMSHR);
 
     if (is_debug_addr(addr)) {
@@ -1652,24 +1687,24 @@ bool DirectoryController::handleGetXResp(MemEvent * event, bool inMSHR) {
         case IS:
             if (protocol == CoherenceProtocol::MESI) {
                 entry->setState(M);
-                entry->setOwner(reqEv->getSrc());
+                entry->setOwner(nodeId(reqEv->getSrc()));
                 sendDataResponse(reqEv, entry, event->getPayload(), Command::GetXResp);
                 break;
             }
         case S_D:
             entry->setState(S);
-            entry->addSharer(reqEv->getSrc());
+            entry->addSharer(nodeId(reqEv->getSrc()));
             sendDataResponse(reqEv, entry, event->getPayload(), Command::GetSResp);
-            mshr->setData(addr, event->getPayload(), false); // So subsequent GetS can get data
+            mshr->setData(addr, event->getConstPayload(), false); // So subsequent GetS can get data
             break;
         case IM:
             entry->setState(M);
-            entry->setOwner(reqEv->getSrc());
+            entry->setOwner(nodeId(reqEv->getSrc()));
             sendDataResponse(reqEv, entry, event->getPayload(), Command::GetXResp);
             break;
         case SM_Inv:
             entry->setState(S_Inv);
-            mshr->setData(addr, event->getPayload(), false); // Save data for when the invalidations finish
+            mshr->setData(addr, event->getConstPayload(), false); // Save data for when the invalidations finish
             if (is_debug_addr(addr)) {
                 eventDI.newst = entry->getState();
                 eventDI.verboseline = entry->getString();
@@ -1751,14 +1786,13 @@ bool DirectoryController::handleAckInv(MemEvent* event, bool inMSHR) {
     if (is_debug_addr(addr))
         eventDI.prefill(event->getID(), Command::AckInv, false, addr, state);
 
-    if (entry->isSharer(event->getSrc()))
-        entry->removeSharer(event->getSrc());
+    if (entry->isSharer(nodeId(event->getSrc())))
+        entry->removeSharer(nodeId(event->getSrc()));
     else
         entry->removeOwner();
 
     bool done = mshr->decrementAcksNeeded(addr);
-    responses.find(addr)->second.erase(event->getSrc());
-    if (responses.find(addr)->second.empty()) responses.erase(addr);
+    removeResponse(addr, nodeId(event->getSrc()));
 
     if (!done) {
         delete event;
@@ -1812,13 +1846,12 @@ bool DirectoryController::handleFetchXResp(MemEvent* event, bool inMSHR) {
                 getName().c_str(), StateString[state], event->getVerboseString().c_str(), getCurrentSimTimeNano());
 
     mshr->decrementAcksNeeded(addr);
-    responses.find(addr)->second.erase(event->getSrc());
-    if (responses.find(addr)->second.empty()) responses.erase(addr);
+    removeResponse(addr, nodeId(event->getSrc()));
 
-    mshr->setData(addr, event->getPayload(), event->getDirty());       // Save data for retry
+    mshr->setData(addr, event->getConstPayload(), event->getDirty());       // Save data for retry
 
     entry->removeOwner();
-    entry->addSharer(event->getSrc());
+    entry->addSharer(nodeId(event->getSrc()));
     entry->setState(S);
     retryBuffer.push_back(static_cast<MemEvent*>(mshr->getFrontEvent(addr)));
 
@@ -1847,10 +1880,8 @@ bool DirectoryController::handleFetchResp(MemEvent* event, bool inMSHR) {
     MemEvent * reqEv = static_cast<MemEvent*>(mshr->getFrontEvent(addr));
 
     mshr->decrementAcksNeeded(addr);
-    responses.find(addr)->second.erase(event->getSrc());
-    if (responses.find(addr)->second.empty())
-        responses.erase(addr);
-    mshr->setData(addr, event->getPayload(), event->getDirty());       // Save data for retry
+    removeResponse(addr, nodeId(event->getSrc()));
+    mshr->setData(addr, event->getConstPayload(), event->getDirty());       // Save data for retry
 
     entry->setState(I);
 
@@ -1895,8 +1926,8 @@ bool DirectoryController::handleNACK(MemEvent* event, bool inMSHR) {
         case Command::ForceInv:
             // Only retry if we still need the response)
             if (responses.find(addr) != responses.end()
-                    && responses.find(addr)->second.find(nackedEvent->getDst()) != responses.find(addr)->second.end()
-                    && responses.find(addr)->second.find(nackedEvent->getDst())->second == nackedEvent->getID())
+                    && responses.find(addr)->second.find(nodeId(nackedEvent->getDst())) != responses.find(addr)->second.end()
+                    && responses.find(addr)->second.find(nodeId(nackedEvent->getDst()))->second == nackedEvent->getID())
                 break;
             delete nackedEvent;
             return true;
@@ -1918,17 +1949,113 @@ bool DirectoryController::handleNACK(MemEvent* event, bool inMSHR) {
 /****************************
  * Manage data structures
  ****************************/
-DirectoryController::DirEntry* DirectoryController::getDirEntry(Addr addr) {
-    std::unordered_map<Addr,DirEntry*>::iterator i = directory.find(addr);
+DirEntry* DirectoryController::getDirEntry(Addr addr) {
+    DirEntry* entry = directory->find(addr);
 
-    if (directory.end() == i) {
-        directory[addr] = new DirEntry(addr);
-        i = directory.find(addr);
-        i->second->cacheIter = entryCache.end();
-        i->second->setCached(true);
+    if (!entry) {
+        if (directory->isSparse()) {
+            entry = allocateSparseEntry(addr);
+        } else {
+            entry = directory->allocate(addr);
+            entry->cacheIter = entryCache.end();
+        }
+    }
+    entry->lastUse = ++useCounter;
+    return entry;
+}
 
+/*
+ * Sparse directory: find a way in the set that 'addr' maps to, replacing the least recently
+ * used entry that has nothing in the MSHR if the set is full. Returns -1 if no way can be freed.
+ */
+int DirectoryController::findSparseWay(Addr addr) {
+    DirEntry** set = directory->getSet(addr);
+    DirEntry* victim = nullptr;
+    for (uint32_t i = 0; i < directory->getWays(); i++) {
+        if (set[i] == nullptr)
+            return i;
+        if (mshr->exists(set[i]->getBaseAddr()))
+            continue;
+        if (victim == nullptr || set[i]->lastUse < victim->lastUse)
+            victim = set[i];
+    }
+
+    if (!victim)
+        return -1;
+    int way = directory->getWay(victim);
+    return evictSparseEntry(victim) ? way : -1;
+}
+
+/* Sparse directory: new entries that cannot get a way are left unindexed until updateCache() can place them */
+DirEntry* DirectoryController::allocateSparseEntry(Addr addr) {
+    int way = findSparseWay(addr);
+    if (way < 0)
+        stat_dirOverflows->addData(1);
+    return directory->allocate(addr, way);
+}
+
+/* Sparse directory: move an unindexed entry into its set */
+bool DirectoryController::placeSparseEntry(DirEntry* entry) {
+    int way = findSparseWay(entry->getBaseAddr());
+    if (way < 0)
+        return false;
+    directory->index(entry, way);
+    return true;
+}
+
+/*
+ * Sparse directory: remove an entry from its set. Invalid entries are dropped. Valid entries
+ * are invalidated with a FetchInv that the directory sends itself and that is handled like one
+ * from memory; the entry stays findable until the FetchInv completes (see finishEviction).
+ * Returns false if the MSHR has no room for the FetchInv, in which case the entry is kept.
+ */
+bool DirectoryController::evictSparseEntry(DirEntry* entry) {
+    Addr addr = entry->getBaseAddr();
+    if (entry->getState() == I) {
+        directory->release(entry);
+        return true;
+    }
+
+    MemEvent* inv = new MemEvent(getName(), addr, addr, Command::FetchInv, lineSize);
+    inv->setDst(getName());
+    inv->setRqstr(getName());
+    if (mshr->insertEvent(addr, inv, -1, true, false) == -1) {
+        delete inv;
+        return false;
+    }
+
+    if (is_debug_addr(addr)) {
+        dbg.debug(_L5_, "C: %-20" PRIu64 " %-20" PRIu64 " %-20s Evict         0x%-16" PRIx64 " %s\n",
+                Simulation::getSimulation()->getCurrentSimCycle(), timestamp, getName().c_str(), addr, entry->getString().c_str());
+    }
+
+    stat_dirEvictions->addData(1);
+    directory->unindex(entry);
+    entry->setEvicting(true);
+
+    // Evictions happen while another event is being handled; keep its debug info intact
+    dbgin outerDI = eventDI;
+    handleFetchInv(inv, true);
+    eventDI = outerDI;
+    return true;
+}
+
+/* Sparse directory: the FetchInv for an eviction has finished, release the entry */
+void DirectoryController::finishEviction(MemEvent* event) {
+    Addr addr = event->getBaseAddr();
+    DirEntry* entry = directory->find(addr);
+
+    if (mshr->hasData(addr)) {
+        if (mshr->getDataDirty(addr))
+            writebackDataFromMSHR(addr);
+        mshr->clearData(addr);
+    }
+
+    // Handlers may still hold the entry, so its slot is recycled at the end of the cycle
+    if (entry && entry->isEvicting()) {
+        directory->remove(entry);
+        releasedEntries.push_back(entry);
     }
-    return i->second;
 }
 
 bool DirectoryController::retrieveDirEntry(DirEntry* entry, MemEvent* event, bool inMSHR) {
@@ -2027,7 +2154,15 @@ void DirectoryController::cleanUpAfterResponse(MemEvent * event, bool inMSHR) {
 }
 
 void DirectoryController::updateCache(DirEntry * entry) { // TODO replace with a proper cache!
-    if (0 == entryCacheMaxSize) {
+    if (directory->isSparse()) {
+        // Sparse entries are always on chip. Drop invalid ones and try to find a set way for any that overflowed
+        if (entry->isEvicting())
+            return;
+        if (entry->getState() == I && !mshr->exists(entry->getBaseAddr()))
+            directory->release(entry);
+        else if (directory->getWay(entry) < 0)
+            placeSparseEntry(entry);
+    } else if (0 == entryCacheMaxSize) {
         sendEntryToMemory(entry);
     } else {
         if (entry->cacheIter != entryCache.end()) {
@@ -2037,8 +2172,7 @@ void DirectoryController::updateCache(DirEntry * entry) { // TODO replace with a
         }
 
         if (entry->getState() == I) {
-            directory.erase(entry->getBaseAddr());
-            delete entry;
+            directory->release(entry);
             return;
         } else  {
             entryCache.push_front(entry);
@@ -2073,6 +2207,19 @@ void DirectoryController::sendEntryToMemory(DirEntry *entry) {
     memMsgQueue.insert(std::make_pair(deliveryTime, MemMsg(me, true)));
 }
 
+void DirectoryController::addResponse(Addr addr, NodeId node, MemEvent::id_type id) {
+    responses[addr][node] = id;
+}
+
+void DirectoryController::removeResponse(Addr addr, NodeId node) {
+    std::unordered_map<Addr, std::map<NodeId, MemEvent::id_type> >::iterator it = responses.find(addr);
+    if (it == responses.end())
+        return;
+    it->second.erase(node);
+    if (it->second.empty())
+        responses.erase(it);
+}
+
 /****************************
  * Send events
  ****************************/
@@ -2120,31 +2267,28 @@ void DirectoryController::issueFlush(MemEvent* event) {
 void DirectoryController::issueFetch(MemEvent* event, DirEntry* entry, Command cmd) {
     Addr addr = event->getBaseAddr();
     MemEvent * fetch = new MemEvent(getName(), event->getAddr(), addr, cmd, lineSize);
-    fetch->setDst(entry->getOwner());
+    fetch->setDst(nodeName(entry->getOwner()));
 
-    if (responses.find(addr) == responses.end()) {
-        std::map<std::string,MemEvent::id_type> resp;
-        resp.insert(std::make_pair(entry->getOwner(), fetch->getID()));
-        responses.insert(std::make_pair(addr, resp));
-    } else {
-        responses.find(addr)->second.insert(std::make_pair(entry->getOwner(), fetch->getID()));
-    }
+    addResponse(addr, entry->getOwner(), fetch->getID());
 
     mshr->incrementAcksNeeded(addr);
 
+    if (isEviction(event))
+        stat_dirEvictionInvs->addData(1);
+
     cpuMsgQueue.insert(std::make_pair(timestamp+accessLatency, fetch));
 }
 
 void DirectoryController::issueInvalidations(MemEvent* event, DirEntry* entry, Command cmd) {
-    std::string rqstr = (event->getSrc());
+    NodeId rqstr = directory->getSharerTable()->findNodeId(event->getSrc());
 
-    for (set<std::string>::iterator it = entry->getSharers()->begin(); it != entry->getSharers()->end(); it++) {
-        if (*it == rqstr) continue;
-        issueInvalidation(*it, event, entry, cmd);
-    }
+    entry->forEachSharer([&](NodeId shr) {
+        if (shr != rqstr)
+            issueInvalidation(shr, event, entry, cmd);
+    });
 }
 
-void DirectoryController::issueInvalidation(std::string dst, MemEvent* event, DirEntry* entry, Command cmd) {
+void DirectoryController::issueInvalidation(NodeId dst, MemEvent* event, DirEntry* entry, Command cmd) {
     Addr addr = entry->getBaseAddr();
     MemEvent* inv = new MemEvent(getName(), addr, addr, cmd, lineSize);
     if (event) {
@@ -2153,17 +2297,14 @@ void DirectoryController::issueInvalidation(std::string dst, MemEvent* event, Di
     } else {
         inv->setRqstr(getName());
     }
-    inv->setDst(dst);
+    inv->setDst(nodeName(dst));
 
     mshr->incrementAcksNeeded(addr);
 
-    if (responses.find(addr) == responses.end()) {
-        std::map<std::string,MemEvent::id_type> resp;
-        resp.insert(std::make_pair(entry->getOwner(), inv->getID()));
-        responses.insert(std::make_pair(addr, resp));
-    } else {
-        responses.find(addr)->second.insert(std::make_pair(entry->getOwner(), inv->getID()));
-    }
+    addResponse(addr, dst, inv->getID());
+
+    if (event && isEviction(event))
+        stat_dirEvictionInvs->addData(1);
 
     uint64_t deliveryTime = timestamp + accessLatency;
     cpuMsgQueue.insert(std::make_pair(deliveryTime, inv));
@@ -2219,6 +2360,11 @@ void DirectoryController::writebackDataFromMSHR(Addr addr) {
 
 void DirectoryController::sendFetchResponse(MemEvent * event) {
     Addr addr = event->getBaseAddr();
+    if (isEviction(event)) {
+        finishEviction(event);
+        return;
+    }
+
     MemEvent * ack = event->makeResponse();
     if (memoryName == "")
         ack->setDst(memLink->findTargetDestination(ack->getRoutingAddress()));
@@ -2235,6 +2381,11 @@ void DirectoryController::sendFetchResponse(MemEvent * event) {
 
 void DirectoryController::sendAckInv(MemEvent * event) {
     Addr addr = event->getBaseAddr();
+    if (isEviction(event)) {
+        finishEviction(event);
+        return;
+    }
+
     MemEvent * ack = event->makeResponse(Command::AckInv);
     if (memoryName == "")
         ack->setDst(memLink->findTargetDestination(ack->getRoutingAddress()));
@@ -37,6 +37,8 @@
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/mshr.h"
+#include "sst/elements/memHierarchy/directoryStorage.h"
+#include "sst/elements/memHierarchy/hostProfiler.h"
 
 using namespace std;
 
@@ -51,6 +53,9 @@ public:
     SST_ELI_DOCUMENT_PARAMS(
             {"clock",                   "Clock rate of controller.", "1GHz"},
             {"entry_cache_size",        "Size (in # of entries) the controller will cache.", "0"},
+            {"directory_type",          "Directory organization. 'full' tracks every line, keeping entries in memory and caching 'entry_cache_size' of them. 'sparse' tracks a fixed number of lines and invalidates the sharers of a line when its entry is replaced", "full"},
+            {"sparse_entries",          "For sparse directories, number of entries", "65536"},
+            {"sparse_associativity",    "For sparse directories, number of entries per set", "16"},
             {"debug",                   "Where to send debug output. 0: No debugging, 1: STDOUT, 2: STDERR, 3: FILE.", "0"},
             {"debug_level",             "Debugging level: 0 to 10. Must configure sst-core with '--enable-debug'. 1=info, 2-10=debug output", "0"},
             {"debug_addr",              "(comma separated uint) Address(es) to be debugged. Leave empty for all, otherwise specify one or more, comma-separated values. Start and end string with brackets",""},
@@ -87,6 +92,9 @@ public:
             {"get_request_latency",         "Total latency in ns of all get* requests handled",                 "nanoseconds",  1},
             {"directory_cache_hits",        "Number of requests that hit in the directory cache",               "requests",     1},
             {"mshr_hits",                   "Number of requests that hit in the MSHRs",                         "requests",     1},
+            {"directory_evictions",         "Sparse directory: number of valid entries replaced",               "count",        1},
+            {"directory_eviction_invalidations", "Sparse directory: number of invalidations sent to replace entries", "count",  1},
+            {"directory_overflows",         "Sparse directory: number of entries allocated while every way in their set was busy", "count", 1},
             /* Event received */
             {"GetS_recv",           "Event received: GetS (read-shared)", "count", 1},
             {"GetX_recv",           "Event received: GetX (write-exclusive)", "count", 1},
@@ -135,6 +143,8 @@ public:
             {"eventSent_FlushLineInv",  "Event sent: FlushLineInv", "count", 2},
             {"eventSent_FlushLineResp", "Event sent: FlushLineResp", "count", 2},
             {"MSHR_occupancy",          "Number of events in MSHR each cycle",  "events",       1},
+            {"host_calls",              "Host profiling: number of times a region ran. One statistic per region (subId): handle<Command> for each event handler, clock, mshr_insert, mshr_remove. Only collected when built with MEMH_HOST_PROFILE", "count", 5},
+            {"host_time_ns",            "Host profiling: wall-clock time spent in a region, inclusive of nested regions. One statistic per region (subId) as for host_calls. Only collected when built with MEMH_HOST_PROFILE", "ns", 5},
             {"default_stat",            "Default statistic. If not 0 then a statistic is missing", "", 1})
 
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
@@ -170,6 +180,9 @@ private:
     Statistic<uint64_t> * stat_getRequestLatency;           // totalGetReqProcessTime;
     Statistic<uint64_t> * stat_cacheHits;                   // numCacheHits;
     Statistic<uint64_t> * stat_mshrHits;                    // mshrHits;
+    Statistic<uint64_t> * stat_dirEvictions;
+    Statistic<uint64_t> * stat_dirEvictionInvs;
+    Statistic<uint64_t> * stat_dirOverflows;
     // Received events
     Statistic<uint64_t> * stat_eventRecv[(int)Command::LAST_CMD];
     Statistic<uint64_t> * stat_noncacheRecv[(int)Command::LAST_CMD];
@@ -180,6 +193,12 @@ private:
 
     Statistic<uint64_t> * stat_MSHROccupancy;
 
+#ifdef MEMH_HOST_PROFILE
+    HostProfiler    hostProfile;
+    unsigned int    profileHandler[(int)Command::LAST_CMD];
+    unsigned int    profileClock;
+#endif
+
     /* Queue of packets to work on */
     std::list<MemEvent*> eventBuffer;
     std::list<MemEvent*> retryBuffer;
@@ -283,81 +302,20 @@ private:
         }
     } eventDI, evictDI;
 
-    struct DirEntry {
-	bool                cached;         // whether block is cached or not
-        Addr                addr;           // block address
-        State               state;          // state
-        std::list<DirEntry*>::iterator cacheIter;
-	std::set<std::string> sharers;      // set of sharers for block
-        std::string         owner;          // Owner of block
-
-        DirEntry(Addr a) {
-            clearEntry();
-            addr = a;
-            state = I;
-            cached = false;
-        }
-
-        void clearEntry(){
-            cached = true;
-            addr = 0;
-            sharers.clear();
-            owner = "";
-        }
-
-        std::string getString() {
-            std::ostringstream str;
-            str << "State: " << StateString[state];
-            str << " Sharers: [";
-            bool comma = false;
-            for (std::set<std::string>::iterator it = sharers.begin(); it != sharers.end(); it++) {
-                if (comma)
-                    str << ",";
-                str << *it;
-                comma = true;
-            }
-            str << "] Owner: " << owner;
-            str << " Cached: " << (cached ? "y" : "n");
-            return str.str();
-        }
-
-        bool isCached() { return cached; }
-
-        void setCached(bool cache) { cached = cache; }
-
-        Addr getBaseAddr() { return addr; }
-
-        size_t getSharerCount() { return sharers.size(); }
-
-        void clearSharers() { sharers.clear(); }
-
-        void addSharer(std::string shr) { sharers.insert(shr); }
-
-        bool isSharer(std::string shr) { return sharers.find(shr) != sharers.end(); }
-
-        bool hasSharers() { return !(sharers.empty()); }
-
-        std::set<std::string>* getSharers() { return &sharers; }
-
-        void removeSharer(std::string shr) { sharers.erase(shr); }
-
-        std::string getOwner() { return owner; }
-
-        bool hasOwner() { return owner != ""; }
-
-        void removeOwner() { owner = ""; }
-
-        void setOwner(std::string own) { owner = own; }
-
-        void setState(State nState) { state = nState; }
-
-        State getState() { return state; }
-    };
-
     int dlevel;
     void printDebugInfo();
 
     DirEntry* getDirEntry(Addr addr); // find entry in the master list
+    int findSparseWay(Addr addr);
+    DirEntry* allocateSparseEntry(Addr addr);
+    bool placeSparseEntry(DirEntry* entry);
+    bool evictSparseEntry(DirEntry* entry);
+    void finishEviction(MemEvent* event);
+    bool isEviction(MemEvent* event) { return event->getSrc() == getName(); }
+    NodeId nodeId(const std::string& name) { return directory->getSharerTable()->getNodeId(name); }
+    const std::string& nodeName(NodeId node) { return directory->getSharerTable()->getNodeName(node); }
+    void addResponse(Addr addr, NodeId node, MemEvent::id_type id);
+    void removeResponse(Addr addr, NodeId node);
     bool retrieveDirEntry(DirEntry* entry, MemEvent* event, bool inMSHR); // Simulate fetching entry from memory
 
     MemEventStatus allocateMSHR(MemEvent* event, bool fwdReq, int pos = -1);
@@ -372,7 +330,7 @@ private:
     void issueFlush(MemEvent* event);
     void issueFetch(MemEvent* event, DirEntry* entry, Command cmd);
     void issueInvalidations(MemEvent* event, DirEntry* entry, Command cmd);
-    void issueInvalidation(std::string dst, MemEvent* event, DirEntry* entry, Command cmd);
+    void issueInvalidation(NodeId dst, MemEvent* event, DirEntry* entry, Command cmd);
     void sendDataResponse(MemEvent* event, DirEntry* entry, std::vector<uint8_t>& data, Command cmd, uint32_t flags = 0);
     void sendResponse(MemEvent* event, uint32_t flags = 0, uint32_t memflags = 0);
     void writebackData(MemEvent* event);
@@ -383,7 +341,9 @@ private:
     void sendNACK(MemEvent* event);
 
     MSHR * mshr;
-    std::unordered_map<Addr, DirEntry*> directory; // Master list of all directory entries, including noncached ones
+    DirectoryStorage* directory;    // Master list of all directory entries, including noncached ones
+    std::vector<DirEntry*> releasedEntries; // Evicted sparse entries, recycled at the end of the cycle
+    uint64_t useCounter;
 
 
     struct MemMsg {
@@ -410,7 +370,7 @@ private:
     uint64_t mshrLatency;
 
     std::map<MemEvent::id_type, Addr> memReqs;
-    std::map<Addr, std::map<std::string, MemEvent::id_type> > responses;
+    std::unordered_map<Addr, std::map<NodeId, MemEvent::id_type> > responses;
 
     CoherenceProtocol protocol;
     bool waitWBAck;
@@ -0,0 +1,368 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_DIRECTORYSTORAGE_H
+#define MEMHIERARCHY_DIRECTORYSTORAGE_H
+
+#include <stdint.h>
+#include <deque>
+#include <list>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "sst/elements/memHierarchy/memTypes.h"
+#include "sst/elements/memHierarchy/mshrTable.h"
+
+namespace SST { namespace MemHierarchy {
+
+typedef uint32_t NodeId;
+static const NodeId NO_NODE = (NodeId)-1;
+
+/*
+ * Sharer bit-vectors for every directory entry slot, stored as rows in a
+ * single array. Caches are numbered in the order they are first seen and
+ * a cache's number is its bit position in each row. The row width is
+ * widened, which rewrites the whole array, when a number beyond it is
+ * handed out; this only happens while caches are being discovered.
+ */
+class SharerTable {
+public:
+    SharerTable() : words_(1) { }
+
+    NodeId getNodeId(const std::string& name) {
+        std::unordered_map<std::string,NodeId>::iterator it = ids_.find(name);
+        if (it != ids_.end())
+            return it->second;
+        NodeId node = names_.size();
+        names_.push_back(name);
+        ids_.insert(std::make_pair(name, node));
+        if (node >= words_ * 64)
+            widen(node / 64 + 1);
+        return node;
+    }
+
+    /* Like getNodeId but does not number unknown names */
+    NodeId findNodeId(const std::string& name) const {
+        std::unordered_map<std::string,NodeId>::const_iterator it = ids_.find(name);
+        return it == ids_.end() ? NO_NODE : it->second;
+    }
+
+    const std::string& getNodeName(NodeId node) const { return names_[node]; }
+
+    uint32_t getWidth() const { return words_ * 64; }
+
+    void addRow() { bits_.resize(bits_.size() + words_, 0); }
+
+    void set(uint32_t row, NodeId node) { bits_[row * words_ + node / 64] |= bit(node); }
+    void reset(uint32_t row, NodeId node) { bits_[row * words_ + node / 64] &= ~bit(node); }
+    bool test(uint32_t row, NodeId node) const { return bits_[row * words_ + node / 64] & bit(node); }
+
+    void clear(uint32_t row) {
+        for (uint32_t i = 0; i < words_; i++)
+            bits_[row * words_ + i] = 0;
+    }
+
+    bool any(uint32_t row) const {
+        for (uint32_t i = 0; i < words_; i++) {
+            if (bits_[row * words_ + i])
+                return true;
+        }
+        return false;
+    }
+
+    size_t count(uint32_t row) const {
+        size_t n = 0;
+        for (uint32_t i = 0; i < words_; i++)
+            n += __builtin_popcountll(bits_[row * words_ + i]);
+        return n;
+    }
+
+    template <class F>
+    void forEach(uint32_t row, F func) const {
+        for (uint32_t i = 0; i < words_; i++) {
+            uint64_t word = bits_[row * words_ + i];
+            while (word) {
+                func((NodeId)(i * 64 + __builtin_ctzll(word)));
+                word &= word - 1;
+            }
+        }
+    }
+
+private:
+    static uint64_t bit(NodeId node) { return (uint64_t)1 << (node % 64); }
+
+    void widen(uint32_t words) {
+        size_t rows = bits_.size() / words_;
+        std::vector<uint64_t> wide(rows * words, 0);
+        for (size_t r = 0; r < rows; r++) {
+            for (uint32_t i = 0; i < words_; i++)
+                wide[r * words + i] = bits_[r * words_ + i];
+        }
+        bits_.swap(wide);
+        words_ = words;
+    }
+
+    uint32_t words_;
+    std::vector<uint64_t> bits_;
+    std::vector<std::string> names_;
+    std::unordered_map<std::string,NodeId> ids_;
+};
+
+/*
+ * Directory entry. Entries are fixed size: the sharer list is a row in the
+ * SharerTable and the owner is a node number.
+ */
+class DirEntry {
+public:
+    DirEntry(SharerTable* table, uint32_t slot) : sharers_(table), slot_(slot) {
+        sharers_->addRow();
+        reset(0);
+    }
+
+    void reset(Addr a) {
+        addr = a;
+        state = I;
+        owner = NO_NODE;
+        cached = true;
+        evicting = false;
+        lastUse = 0;
+        sharers_->clear(slot_);
+    }
+
+    std::string getString() {
+        std::ostringstream str;
+        str << "State: " << StateString[state];
+        str << " Sharers: [";
+        bool comma = false;
+        for (std::string& name : getSharerNames()) {
+            if (comma)
+                str << ",";
+            str << name;
+            comma = true;
+        }
+        str << "] Owner: " << (hasOwner() ? sharers_->getNodeName(owner) : "");
+        str << " Cached: " << (cached ? "y" : "n");
+        return str.str();
+    }
+
+    bool isCached() { return cached; }
+
+    void setCached(bool cache) { cached = cache; }
+
+    Addr getBaseAddr() { return addr; }
+
+    uint32_t getSlot() { return slot_; }
+
+    size_t getSharerCount() { return sharers_->count(slot_); }
+
+    void clearSharers() { sharers_->clear(slot_); }
+
+    void addSharer(NodeId shr) { sharers_->set(slot_, shr); }
+
+    bool isSharer(NodeId shr) { return sharers_->test(slot_, shr); }
+
+    bool hasSharers() { return sharers_->any(slot_); }
+
+    void removeSharer(NodeId shr) { sharers_->reset(slot_, shr); }
+
+    template <class F>
+    void forEachSharer(F func) { sharers_->forEach(slot_, func); }
+
+    std::vector<std::string> getSharerNames() {
+        std::vector<std::string> names;
+        SharerTable* table = sharers_;
+        sharers_->forEach(slot_, [&names, table](NodeId n) { names.push_back(table->getNodeName(n)); });
+        return names;
+    }
+
+    NodeId getOwner() { return owner; }
+
+    bool hasOwner() { return owner != NO_NODE; }
+
+    void removeOwner() { owner = NO_NODE; }
+
+    void setOwner(NodeId own) { owner = own; }
+
+    void setState(State nState) { state = nState; }
+
+    State getState() { return state; }
+
+    bool isEvicting() { return evicting; }
+
+    void setEvicting(bool evict) { evicting = evict; }
+
+    std::list<DirEntry*>::iterator cacheIter;   // Position in the directory's entry cache (full directories only)
+    uint64_t lastUse;                           // Replacement order (sparse directories only)
+
+private:
+    SharerTable* sharers_;
+    uint32_t slot_;
+    Addr addr;
+    State state;
+    NodeId owner;
+    bool cached;
+    bool evicting;
+};
+
+/*
+ * Storage for directory entries.
+ *
+ * Entries come from a pool of fixed-size slots and are reused once released.
+ * A full directory tracks every line and indexes entries by address in a
+ * hash table. A sparse directory indexes entries in a set-associative array
+ * of 'ways' entries per set; an entry that has no way is 'unindexed', either
+ * because it was displaced and is being invalidated or because every way in
+ * its set was busy when it was allocated. Choosing a victim is up to the
+ * owner, which knows which entries have requests in flight.
+ */
+class DirectoryStorage {
+public:
+    DirectoryStorage(uint64_t sets, uint32_t ways, uint64_t lineSize) :
+        sets_(sets), ways_(ways), lineSize_(lineSize), index_(1024, nullptr) {
+        if (sets_ != 0)
+            setArray_.assign(sets_ * ways_, nullptr);
+    }
+
+    bool isSparse() const { return sets_ != 0; }
+    uint32_t getWays() const { return ways_; }
+    size_t size() const { return entries_.size() - freeSlots_.size(); }
+
+    SharerTable* getSharerTable() { return &sharers_; }
+
+    DirEntry* find(Addr addr) {
+        if (!isSparse()) {
+            DirEntry** entry = index_.find(addr);
+            return entry ? *entry : nullptr;
+        }
+        DirEntry** set = getSet(addr);
+        for (uint32_t i = 0; i < ways_; i++) {
+            if (set[i] && set[i]->getBaseAddr() == addr)
+                return set[i];
+        }
+        if (unindexed_.empty())
+            return nullptr;
+        std::unordered_map<Addr,DirEntry*>::iterator it = unindexed_.find(addr);
+        return it == unindexed_.end() ? nullptr : it->second;
+    }
+
+    /* Allocate an entry. For sparse directories the entry takes 'way' in its set, or is unindexed if way < 0 */
+    DirEntry* allocate(Addr addr, int way = -1) {
+        DirEntry* entry;
+        if (freeSlots_.empty()) {
+            entries_.emplace_back(&sharers_, entries_.size());
+            inUse_.push_back(true);
+            entry = &entries_.back();
+        } else {
+            inUse_[freeSlots_.back()] = true;
+            entry = &entries_[freeSlots_.back()];
+            freeSlots_.pop_back();
+        }
+        entry->reset(addr);
+
+        if (!isSparse())
+            *(index_.insert(addr)) = entry;
+        else if (way < 0)
+            unindexed_.insert(std::make_pair(addr, entry));
+        else
+            getSet(addr)[way] = entry;
+        return entry;
+    }
+
+    void release(DirEntry* entry) {
+        remove(entry);
+        recycle(entry);
+    }
+
+    /* Make an entry unfindable without reusing its slot yet */
+    void remove(DirEntry* entry) {
+        Addr addr = entry->getBaseAddr();
+        if (!isSparse()) {
+            index_.erase(addr);
+        } else {
+            int way = getWay(entry);
+            if (way >= 0)
+                getSet(addr)[way] = nullptr;
+            else
+                unindexed_.erase(addr);
+        }
+    }
+
+    /* Return a removed entry's slot to the pool */
+    void recycle(DirEntry* entry) {
+        inUse_[entry->getSlot()] = false;
+        freeSlots_.push_back(entry->getSlot());
+    }
+
+    /* Sparse directories: remove an entry from its way, it remains findable until released */
+    void unindex(DirEntry* entry) {
+        int way = getWay(entry);
+        if (way < 0)
+            return;
+        getSet(entry->getBaseAddr())[way] = nullptr;
+        unindexed_.insert(std::make_pair(entry->getBaseAddr(), entry));
+    }
+
+    /* Sparse directories: move an unindexed entry into a free way of its set */
+    void index(DirEntry* entry, int way) {
+        unindexed_.erase(entry->getBaseAddr());
+        getSet(entry->getBaseAddr())[way] = entry;
+    }
+
+    /* Sparse directories: the ways of the set that 'addr' maps to */
+    DirEntry** getSet(Addr addr) {
+        uint64_t line = addr / lineSize_;
+        return &setArray_[((line * 0x9E3779B97F4A7C15ULL) >> 16) % sets_ * ways_];
+    }
+
+    int getWay(DirEntry* entry) {
+        DirEntry** set = getSet(entry->getBaseAddr());
+        for (uint32_t i = 0; i < ways_; i++) {
+            if (set[i] == entry)
+                return i;
+        }
+        return -1;
+    }
+
+    template <class F>
+    void forEach(F func) {
+        for (size_t i = 0; i < entries_.size(); i++) {
+            if (inUse_[i])
+                func(&entries_[i]);
+        }
+    }
+
+private:
+    DirectoryStorage(const DirectoryStorage&);
+    DirectoryStorage& operator=(const DirectoryStorage&);
+
+    uint64_t sets_;
+    uint32_t ways_;
+    uint64_t lineSize_;
+
+    SharerTable sharers_;
+    std::deque<DirEntry> entries_;              // Slot pool; deque::emplace_back never moves existing entries
+    std::vector<uint32_t> freeSlots_;
+    std::vector<bool> inUse_;
+
+    AddrHashTable<DirEntry*> index_;            // Full directory index
+    std::vector<DirEntry*> setArray_;           // Sparse directory index, sets_ x ways_
+    std::unordered_map<Addr,DirEntry*> unindexed_;
+};
+
+}}
+
+#endif
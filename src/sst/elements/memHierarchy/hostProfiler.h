@@ -0,0 +1,116 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_HOSTPROFILER_H
+#define MEMHIERARCHY_HOSTPROFILER_H
+
+/*
+ * Host-side profiling for memHierarchy components.
+ *
+ * Build with -DMEMH_HOST_PROFILE to record how many times, and for how much
+ * wall-clock time, each instrumented region of a component ran. Regions are
+ * reported at the end of simulation through the 'host_calls' and
+ * 'host_time_ns' statistics, one statistic per region (the region name is
+ * the statistic's subId), so any statistic output, including JSON, can be
+ * used to collect them. Without MEMH_HOST_PROFILE the MEMH_PROFILE_SCOPE
+ * macro expands to nothing and nothing is recorded.
+ */
+
+#ifdef MEMH_HOST_PROFILE
+
+#include <stdint.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <sst/core/statapi/statbase.h>
+
+namespace SST { namespace MemHierarchy {
+
+class HostProfiler {
+public:
+    unsigned int addRegion(const std::string& name) {
+        Region region = { name, 0, 0, nullptr, nullptr };
+        regions_.push_back(region);
+        return regions_.size() - 1;
+    }
+
+    unsigned int getRegionCount() const { return regions_.size(); }
+    const std::string& getRegionName(unsigned int region) const { return regions_[region].name; }
+
+    void setStatistics(unsigned int region, Statistic<uint64_t>* calls, Statistic<uint64_t>* time) {
+        regions_[region].statCalls = calls;
+        regions_[region].statTime = time;
+    }
+
+    void record(unsigned int region, uint64_t ns) {
+        regions_[region].calls++;
+        regions_[region].ns += ns;
+    }
+
+    /* Report totals to the statistics, call from finish() */
+    void finish() {
+        for (std::vector<Region>::iterator it = regions_.begin(); it != regions_.end(); it++) {
+            if (it->calls == 0)
+                continue;
+            if (it->statCalls)
+                it->statCalls->addData(it->calls);
+            if (it->statTime)
+                it->statTime->addData(it->ns);
+        }
+    }
+
+private:
+    struct Region {
+        std::string name;
+        uint64_t calls;
+        uint64_t ns;
+        Statistic<uint64_t>* statCalls;
+        Statistic<uint64_t>* statTime;
+    };
+
+    std::vector<Region> regions_;
+};
+
+/* Records the lifetime of the enclosing scope against a region. A null profiler records nothing. */
+class HostProfileScope {
+public:
+    HostProfileScope(HostProfiler* profiler, unsigned int region) : profiler_(profiler), region_(region) {
+        if (profiler_)
+            start_ = std::chrono::steady_clock::now();
+    }
+
+    ~HostProfileScope() {
+        if (profiler_)
+            profiler_->record(region_, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count());
+    }
+
+private:
+    HostProfiler* profiler_;
+    unsigned int region_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+}}
+
+#define MEMH_PROFILE_SCOPE(profiler, region) SST::MemHierarchy::HostProfileScope memhProfileScope_((profiler), (region))
+
+#else
+
+#define MEMH_PROFILE_SCOPE(profiler, region)
+
+#endif
+
+#endif
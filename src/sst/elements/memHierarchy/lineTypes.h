@@ -164,7 +164,7 @@ class DataLine {
 
         // Data
         vector<uint8_t>* getData() { return &data_; }
-        void setData(vector<uint8_t> data, uint32_t offset) {
+        void setData(const vector<uint8_t>& data, uint32_t offset) {
             std::copy(data.begin(), data.end(), data_.begin() + offset);
         }
 
@@ -217,7 +217,7 @@ class CacheLine {
 
         // Data
         vector<uint8_t>* getData() { return &data_; }
-        void setData(vector<uint8_t> in, uint32_t offset) {
+        void setData(const vector<uint8_t>& in, uint32_t offset) {
             std::copy(in.begin(), in.end(), std::next(data_.begin(), offset));
         }
 
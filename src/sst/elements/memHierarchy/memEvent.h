@@ -21,6 +21,9 @@
 #include <sst/core/event.h>
 #include <sst/core/warnmacros.h>
 
+#include <atomic>
+#include <map>
+
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/memEventBase.h"
 #include "sst/elements/memHierarchy/memTypes.h"
@@ -29,6 +32,123 @@ namespace SST { namespace MemHierarchy {
 
 using namespace std;
 
+/**
+ * Reference-counted, copy-on-write handle to a MemEvent data payload.
+ *
+ * Copies of a MemEvent (responses, forwards, clones, NACKs) share the
+ * payload buffer instead of duplicating line data; the buffer is only
+ * copied if a sharer asks for writable access. Events without data hold
+ * just a null pointer. Zero-filled payloads, which is all a timing-only
+ * model (no backing store) ever produces, share one immutable buffer per size.
+ */
+class MemEventPayload {
+public:
+    MemEventPayload() : buf_(nullptr) { }
+    MemEventPayload(const MemEventPayload& other) : buf_(other.buf_) {
+        if (buf_) buf_->refs++;
+    }
+    MemEventPayload& operator=(const MemEventPayload& other) {
+        Buffer* buf = other.buf_;
+        if (buf) buf->refs++;
+        release();
+        buf_ = buf;
+        return *this;
+    }
+    ~MemEventPayload() { release(); }
+
+    size_t size() const { return buf_ ? buf_->data.size() : 0; }
+    bool empty() const { return size() == 0; }
+
+    /* Read-only view, never copies */
+    const std::vector<uint8_t>& get() const { return buf_ ? buf_->data : zero(0)->data; }
+
+    /* Writable view, detaches from any other sharers first */
+    std::vector<uint8_t>& getWritable() {
+        if (buf_ == nullptr) {
+            buf_ = new Buffer();
+        } else if (buf_->refs > 1) {
+            Buffer* copy = new Buffer(buf_->data);
+            release();
+            buf_ = copy;
+        }
+        return buf_->data;
+    }
+
+    void assign(const std::vector<uint8_t>& data) {
+        if (buf_ && &(buf_->data) == &data)
+            return;
+        if (data.empty()) {
+            release();
+        } else if (buf_ && buf_->refs == 1) {
+            buf_->data = data;  // Reuse the existing allocation
+        } else {
+            release();
+            buf_ = new Buffer(data);
+        }
+    }
+
+    void assign(uint32_t size, const uint8_t* data) {
+        if (size == 0 || data == nullptr) {
+            release();
+            return;
+        }
+        if (buf_ && buf_->refs == 1 && (buf_->data.empty() || data < buf_->data.data() || data >= buf_->data.data() + buf_->data.size())) {
+            buf_->data.assign(data, data + size);
+        } else {
+            Buffer* nbuf = new Buffer(std::vector<uint8_t>(data, data + size));
+            release();
+            buf_ = nbuf;
+        }
+    }
+
+    void assignZero(uint32_t size) {
+        Buffer* zbuf = zero(size);
+        zbuf->refs++;
+        release();
+        buf_ = zbuf;
+    }
+
+    void clear() { release(); }
+
+private:
+    struct Buffer {
+        Buffer() : refs(1) { }
+        Buffer(const std::vector<uint8_t>& d) : refs(1), data(d) { }
+        std::atomic<uint32_t> refs;
+        std::vector<uint8_t> data;
+    };
+
+    void release() {
+        if (buf_ && --(buf_->refs) == 0)
+            delete buf_;
+        buf_ = nullptr;
+    }
+
+    /* Per-thread cache of shared zero buffers. The cache holds one reference
+     * to each buffer, dropped at thread exit; events still sharing a buffer keep it alive */
+    struct ZeroCache {
+        std::map<uint32_t, Buffer*> buffers;
+        ~ZeroCache() {
+            for (std::map<uint32_t, Buffer*>::iterator it = buffers.begin(); it != buffers.end(); it++) {
+                if (--(it->second->refs) == 0)
+                    delete it->second;
+            }
+        }
+    };
+
+    static Buffer* zero(uint32_t size) {
+        static thread_local ZeroCache zeros;
+        std::map<uint32_t, Buffer*>::iterator it = zeros.buffers.find(size);
+        if (it != zeros.buffers.end())
+            return it->second;
+        Buffer* zbuf = new Buffer(std::vector<uint8_t>(size, 0));
+        zeros.buffers.insert(std::make_pair(size, zbuf));
+        return zbuf;
+    }
+
+    Buffer* buf_;
+};
+
 /**
  * Interface Event used to represent Memory-based communication.
  *
@@ -201,20 +321,31 @@ public:
     bool fromHighNetNACK()  { return !CommandCPUSide[(int)cmd_];}
     bool fromLowNetNACK()   { return CommandCPUSide[(int)cmd_];}
 
-    /** @return  the data payload. */
+    /** @return  the data payload, writable. Copies the payload if it is shared with another event. */
     dataVec& getPayload(void) {
         /* Lazily allocate space for payload */
-        if ( payload_.size() < size_ )  payload_.resize(size_);
-        return payload_;
+        dataVec& data = payload_.getWritable();
+        if ( data.size() < size_ )  data.resize(size_);
+        return data;
     }
 
+    /** @return  the data payload, read-only. Does not copy or allocate; an
+     * event without data reads as size_ zero bytes, as getPayload() would.
+     */
+    const dataVec& getConstPayload(void) {
+        if ( payload_.empty() && size_ != 0 )
+            payload_.assignZero(size_);
+        else if ( payload_.size() < size_ )
+            return getPayload();
+        return payload_.get();
+    }
 
     /** Sets the data payload and payload size.
      * @param[in] data  Vector from which to copy data
      */
-    void setPayload(std::vector<uint8_t>& data) {
+    void setPayload(const std::vector<uint8_t>& data) {
         setSize(data.size());
-        payload_ = data;
+        payload_.assign(data);
     }
 
     /** Sets the data payload and payload size.
@@ -223,16 +354,19 @@ public:
      */
     void setPayload(uint32_t size, uint8_t* data) {
         setSize(size);
-        payload_.resize(size);
-        for ( uint32_t i = 0 ; i < size ; i++ ) {
-            payload_[i] = data[i];
-        }
+        payload_.assign(size, data);
+    }
+
+    /** Shares another event's payload (and payload size) without copying it */
+    void sharePayload(MemEvent* ev) {
+        ev->getConstPayload();
+        setSize(ev->getPayloadSize());
+        payload_ = ev->payload_;
     }
 
     void setZeroPayload(uint32_t size) {
         setSize(size);
-        payload_.clear();
-        payload_.resize(size, 0);
+        payload_.assignZero(size);
     }
 
     size_t getPayloadSize() override {
@@ -305,7 +439,7 @@ private:
     bool            addrGlobal_;        // Whether address is a local or global address
     MemEvent*       NACKedEvent_;       // For a NACK, pointer to the NACKed event
     int             retries_;           // For NACKed events, how many times a retry has been sent
-    dataVec         payload_;           // Data
+    MemEventPayload payload_;           // Data, shared copy-on-write between copies of this event
     bool            prefetch_;          // Whether this request came from a prefetcher
     bool            blocked_;           // Whether this request blocked for another pending request (for profiling) TODO move to mshrs
     bool            dirty_;             // For a replacement, whether the data is dirty or not
@@ -325,7 +459,13 @@ public:
         ser & addrGlobal_;
         ser & NACKedEvent_;
         ser & retries_;
-        ser & payload_;
+        if (ser.mode() == SST::Core::Serialization::serializer::UNPACK) {
+            dataVec payload;
+            ser & payload;
+            payload_.assign(payload);
+        } else {
+            ser & const_cast<dataVec&>(payload_.get());
+        }
         ser & prefetch_;
         ser & blocked_;
         ser & dirty_;
@@ -18,6 +18,15 @@
 
 #include <fcntl.h>
 #include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
 #include "sst/elements/memHierarchy/util.h"
 
 namespace SST {
@@ -27,13 +36,16 @@ namespace Backend {
 class Backing {
 public:
     Backing( ) { }
-    ~Backing() { }
+    virtual ~Backing() { }
 
     virtual void set( Addr addr, uint8_t value ) = 0;
     virtual void set( Addr addr, size_t size, std::vector<uint8_t>& data) = 0;
 
     virtual uint8_t get( Addr addr) = 0;
     virtual void get( Addr addr, size_t size, std::vector<uint8_t>& data) = 0;
+
+    /* Host memory currently used to hold simulated memory contents */
+    virtual size_t getResidentBytes() = 0;
 };
 
 class BackingMMAP : public Backing {
@@ -80,6 +92,8 @@ public:
             data[i] = m_buffer[addr + i];
     }
 
+    size_t getResidentBytes() { return m_size; }
+
 private:
     uint8_t* m_buffer;
     int m_fd;
@@ -153,6 +167,8 @@ public:
         return m_buffer[bAddr][offset];
     }
 
+    size_t getResidentBytes() { return m_buffer.size() * m_allocUnit; }
+
 private:
     void allocIfNeeded(Addr bAddr) {
         if (m_buffer.find(bAddr) == m_buffer.end()) {
@@ -170,6 +186,408 @@ private:
     unsigned int m_shift;
 };
 
+/*
+ * Sparse backing store
+ *  - Pages are indexed by a radix tree (like a page table) sized to the memory
+ *  - Reads of pages that were never written are served from a single shared zero page
+ *    and do not allocate
+ *  - Multi-byte accesses are copied with memcpy a page at a time
+ *  - Pages are carved out of large anonymous mmap arenas (MAP_NORESERVE, optionally huge pages)
+ *    so the host only commits memory that is actually touched
+ *
+ * Contents can be saved to and restored from a sparse image file:
+ *   header | index (page number, file offset, length per page) | page data
+ * Only pages that contain non-zero data are saved; data may be zlib-compressed. Images are
+ * loaded lazily: the file is mmap'd and uncompressed pages are read in place until they are
+ * written (copy-on-write), compressed pages are inflated on first access.
+ */
+class BackingSparse : public Backing {
+public:
+    BackingSparse(size_t memSize, size_t pageSize, size_t arenaSize = 0, bool hugePages = false) : Backing(),
+        m_pageSize(pageSize), m_hugePages(hugePages), m_arenaNext(nullptr), m_arenaEnd(nullptr), m_image(nullptr), m_imageSize(0), m_imageCompressed(false),
+        m_numPages(0), m_numNodes(0) {
+        if (!isPowerOfTwo(m_pageSize)) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "BackingSparse: Error - page size must be a power of two. Got: %zu\n", pageSize);
+        }
+        m_shift = log2Of(m_pageSize);
+        m_pageMask = m_pageSize - 1;
+
+        /* Arenas are a whole number of pages */
+        m_arenaSize = std::max(arenaSize, m_pageSize);
+        m_arenaSize = ((m_arenaSize + m_pageSize - 1) >> m_shift) << m_shift;
+
+        /* Enough levels to index every page in memory */
+        unsigned int pageBits = 0;
+        while (pageBits < 64 - m_shift && (Addr(1) << (pageBits + m_shift)) < memSize)
+            pageBits++;
+        m_levels = std::max(1u, (pageBits + LEVEL_BITS - 1) / LEVEL_BITS);
+        m_maxPage = (m_levels * LEVEL_BITS >= 64) ? ~Addr(0) : ((Addr(1) << (m_levels * LEVEL_BITS)) - 1);
+
+        m_root = newNode();
+        m_zeroPage = (uint8_t*) calloc(m_pageSize, sizeof(uint8_t));
+        if (!m_zeroPage) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "BackingSparse: Error - unable to allocate zero page.\n");
+        }
+    }
+
+    ~BackingSparse() {
+        if (m_image)
+            munmap(m_image, m_imageSize);
+        freeNode(m_root, 1);
+        for (size_t i = 0; i < m_arenas.size(); i++)
+            munmap(m_arenas[i], m_arenaSize);
+        for (size_t i = 0; i < m_mallocPages.size(); i++)
+            free(m_mallocPages[i]);
+        free(m_zeroPage);
+    }
+
+    void set( Addr addr, uint8_t value ) {
+        getPageForWrite(addr >> m_shift)[addr & m_pageMask] = value;
+    }
+
+    void set( Addr addr, size_t size, std::vector<uint8_t> &data ) {
+        size_t done = 0;
+        while (done != size) {
+            Addr offset = (addr + done) & m_pageMask;
+            size_t chunk = std::min(size - done, (size_t)(m_pageSize - offset));
+            memcpy(getPageForWrite((addr + done) >> m_shift) + offset, &data[done], chunk);
+            done += chunk;
+        }
+    }
+
+    uint8_t get( Addr addr ) {
+        return getPageForRead(addr >> m_shift)[addr & m_pageMask];
+    }
+
+    void get( Addr addr, size_t size, std::vector<uint8_t> &data ) {
+        size_t done = 0;
+        while (done != size) {
+            Addr offset = (addr + done) & m_pageMask;
+            size_t chunk = std::min(size - done, (size_t)(m_pageSize - offset));
+            memcpy(&data[done], getPageForRead((addr + done) >> m_shift) + offset, chunk);
+            done += chunk;
+        }
+    }
+
+    size_t getResidentBytes() {
+        return m_numPages * m_pageSize + m_numNodes * sizeof(void*) * LEVEL_ENTRIES + m_pageSize;
+    }
+
+    /* Write every non-zero page to 'file'. Returns the number of pages written.
+     * The image is written to 'file'.tmp and renamed over 'file' once complete, so 'file' may be
+     * the image this store was loaded from: its pages are still read from the old mapping. */
+    size_t saveImage(const std::string &file, bool compress) {
+        Output out("", 1, 0, Output::STDOUT);
+#ifndef HAVE_LIBZ
+        if (compress) {
+            out.output("BackingSparse: Warning - zlib is not available, image '%s' will not be compressed.\n", file.c_str());
+            compress = false;
+        }
+#endif
+        std::vector<std::pair<Addr,uint8_t*> > pages;
+        collectPages(m_root, 1, 0, pages);
+
+        std::string tmpFile = file + ".tmp";
+        FILE* fp = fopen(tmpFile.c_str(), "wb");
+        if (!fp)
+            out.fatal(CALL_INFO, -1, "BackingSparse: Error - unable to open image file '%s' for writing.\n", tmpFile.c_str());
+
+        ImageHeader header;
+        memcpy(header.magic, imageMagic(), sizeof(header.magic));
+        header.version = IMAGE_VERSION;
+        header.flags = compress ? IMAGE_COMPRESSED : 0;
+        header.pageSize = m_pageSize;
+        header.numPages = pages.size();
+        header.indexOffset = sizeof(ImageHeader);
+        header.dataOffset = alignUp(header.indexOffset + pages.size() * sizeof(ImageIndexEntry), std::min(m_pageSize, (size_t)4096));
+
+        /* Uncompressed pages are page-aligned in the file; compressed pages are packed */
+        std::vector<ImageIndexEntry> index(pages.size());
+        std::vector<uint8_t> buffer;
+        uint64_t offset = header.dataOffset;
+        if (fseek(fp, header.dataOffset, SEEK_SET) != 0)
+            out.fatal(CALL_INFO, -1, "BackingSparse: Error - unable to write image file '%s'.\n", file.c_str());
+        for (size_t i = 0; i < pages.size(); i++) {
+            const uint8_t* data = pages[i].second;
+            uint64_t length = m_pageSize;
+#ifdef HAVE_LIBZ
+            if (compress) {
+                uLongf zlen = compressBound(m_pageSize);
+                buffer.resize(zlen);
+                if (compress2(&buffer[0], &zlen, data, m_pageSize, Z_BEST_SPEED) != Z_OK)
+                    out.fatal(CALL_INFO, -1, "BackingSparse: Error - compression failed while writing image '%s'.\n", file.c_str());
+                data = &buffer[0];
+                length = zlen;
+            }
+#endif
+            index[i].page = pages[i].first;
+            index[i].offset = offset;
+            index[i].length = length;
+            if (fwrite(data, 1, length, fp) != length)
+                out.fatal(CALL_INFO, -1, "BackingSparse: Error - unable to write image file '%s'.\n", file.c_str());
+            offset += length;
+        }
+
+        if (fseek(fp, 0, SEEK_SET) != 0 || fwrite(&header, sizeof(header), 1, fp) != 1 ||
+                (!index.empty() && fwrite(&index[0], sizeof(ImageIndexEntry), index.size(), fp) != index.size()))
+            out.fatal(CALL_INFO, -1, "BackingSparse: Error - unable to write image file '%s'.\n", file.c_str());
+        if (fclose(fp) != 0)
+            out.fatal(CALL_INFO, -1, "BackingSparse: Error - unable to write image file '%s'.\n", tmpFile.c_str());
+        if (rename(tmpFile.c_str(), file.c_str()) != 0)
+            out.fatal(CALL_INFO, -1, "BackingSparse: Error - unable to rename '%s' to '%s'.\n", tmpFile.c_str(), file.c_str());
+        return pages.size();
+    }
+
+    /* Map an image written by saveImage(). Pages are brought in on demand. Returns the number of pages in the image. */
+    size_t loadImage(const std::string &file) {
+        Output out("", 1, 0, Output::STDOUT);
+        int fd = open(file.c_str(), O_RDONLY);
+        if (fd < 0)
+            out.fatal(CALL_INFO, -1, "BackingSparse: Error - unable to open image file '%s'.\n", file.c_str());
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(ImageHeader))
+            out.fatal(CALL_INFO, -1, "BackingSparse: Error - image file '%s' is too small to be a memory image.\n", file.c_str());
+        m_imageSize = st.st_size;
+        m_image = (uint8_t*)mmap(NULL, m_imageSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (m_image == MAP_FAILED) {
+            m_image = nullptr;
+            out.fatal(CALL_INFO, -1, "BackingSparse: Error - unable to mmap image file '%s'.\n", file.c_str());
+        }
+
+        const ImageHeader* header = (const ImageHeader*)m_image;
+        if (memcmp(header->magic, imageMagic(), sizeof(header->magic)) != 0 || header->version != IMAGE_VERSION)
+            out.fatal(CALL_INFO, -1, "BackingSparse: Error - '%s' is not a memory image or has an unsupported version.\n", file.c_str());
+        if (header->pageSize != m_pageSize)
+            out.fatal(CALL_INFO, -1, "BackingSparse: Error - image '%s' has page size %" PRIu64 " but this backing store uses %zu. Set backing_page_size to match.\n",
+                    file.c_str(), header->pageSize, m_pageSize);
+        if (header->indexOffset + header->numPages * sizeof(ImageIndexEntry) > m_imageSize)
+            out.fatal(CALL_INFO, -1, "BackingSparse: Error - image '%s' is truncated.\n", file.c_str());
+#ifndef HAVE_LIBZ
+        if (header->flags & IMAGE_COMPRESSED)
+            out.fatal(CALL_INFO, -1, "BackingSparse: Error - image '%s' is compressed but zlib is not available.\n", file.c_str());
+#endif
+        m_imageCompressed = header->flags & IMAGE_COMPRESSED;
+
+        const ImageIndexEntry* index = (const ImageIndexEntry*)(m_image + header->indexOffset);
+        for (uint64_t i = 0; i < header->numPages; i++) {
+            if (index[i].offset + index[i].length > m_imageSize)
+                out.fatal(CALL_INFO, -1, "BackingSparse: Error - image '%s' is truncated.\n", file.c_str());
+            if (m_imageCompressed) {
+                m_imagePages[index[i].page] = index[i];
+            } else {
+                *getLeaf(index[i].page) = tagImagePage(m_image + index[i].offset);
+            }
+        }
+        return header->numPages;
+    }
+
+private:
+    static const unsigned int LEVEL_BITS = 9;
+    static const size_t LEVEL_ENTRIES = size_t(1) << LEVEL_BITS;
+
+    static const uint32_t IMAGE_VERSION = 1;
+    static const uint32_t IMAGE_COMPRESSED = 0x1;
+
+    struct ImageHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t flags;
+        uint64_t pageSize;
+        uint64_t numPages;
+        uint64_t indexOffset;
+        uint64_t dataOffset;
+    };
+
+    struct ImageIndexEntry {
+        uint64_t page;
+        uint64_t offset;
+        uint64_t length;
+    };
+
+    static const char* imageMagic() { return "SSTMEMIM"; }
+
+    static uint64_t alignUp(uint64_t val, uint64_t align) { return (val + align - 1) / align * align; }
+
+    /* Leaves that point into an uncompressed image are tagged in the low bit; they are read-only */
+    static inline void* tagImagePage(uint8_t* page) { return (void*)((uintptr_t)page | 1); }
+    static inline bool isImagePage(void* leaf) { return ((uintptr_t)leaf & 1) != 0; }
+    static inline uint8_t* untag(void* leaf) { return (uint8_t*)((uintptr_t)leaf & ~(uintptr_t)1); }
+
+    void collectPages(void** node, unsigned int level, Addr prefix, std::vector<std::pair<Addr,uint8_t*> > &pages) {
+        for (size_t i = 0; i < LEVEL_ENTRIES; i++) {
+            if (!node[i]) continue;
+            Addr page = (prefix << LEVEL_BITS) | i;
+            if (level < m_levels) {
+                collectPages((void**)node[i], level + 1, page, pages);
+            } else {
+                uint8_t* data = untag(node[i]);
+                if (memcmp(data, m_zeroPage, m_pageSize) != 0)
+                    pages.push_back(std::make_pair(page, data));
+            }
+        }
+        /* Compressed image pages that were never touched */
+        if (level == 1) {
+            for (std::unordered_map<Addr,ImageIndexEntry>::iterator it = m_imagePages.begin(); it != m_imagePages.end(); it++)
+                pages.push_back(std::make_pair(it->first, inflateImagePage(it->second)));
+            std::sort(pages.begin(), pages.end());
+        }
+    }
+
+    /* Decompress an image page into a newly allocated page */
+    uint8_t* inflateImagePage(const ImageIndexEntry &entry) {
+        uint8_t* data = allocPage();
+#ifdef HAVE_LIBZ
+        uLongf len = m_pageSize;
+        if (uncompress(data, &len, m_image + entry.offset, entry.length) != Z_OK || len != m_pageSize) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "BackingSparse: Error - corrupt compressed page 0x%" PRIx64 " in memory image.\n", entry.page);
+        }
+#endif
+        return data;
+    }
+
+    /* Bring a compressed image page in, if 'page' is one. Returns the leaf or nullptr. */
+    inline void* faultImagePage(Addr page) {
+        std::unordered_map<Addr,ImageIndexEntry>::iterator it = m_imagePages.find(page);
+        if (it == m_imagePages.end()) return nullptr;
+        uint8_t* data = inflateImagePage(it->second);
+        m_imagePages.erase(it);
+        *getLeaf(page) = data;
+        return data;
+    }
+
+    void** newNode() {
+        void** node = new void*[LEVEL_ENTRIES]();
+        m_numNodes++;
+        return node;
+    }
+
+    void freeNode(void** node, unsigned int level) {
+        if (level < m_levels) {
+            for (size_t i = 0; i < LEVEL_ENTRIES; i++) {
+                if (node[i]) freeNode((void**)node[i], level + 1);
+            }
+        }
+        delete [] node;
+    }
+
+    inline size_t indexAt(Addr page, unsigned int level) {
+        return (page >> ((m_levels - level) * LEVEL_BITS)) & (LEVEL_ENTRIES - 1);
+    }
+
+    /* Returns the zero page if 'page' has never been written */
+    inline uint8_t* getPageForRead(Addr page) {
+        if (page > m_maxPage) return m_zeroPage;
+        void** node = m_root;
+        for (unsigned int level = 1; level < m_levels && node; level++)
+            node = (void**)node[indexAt(page, level)];
+        void* leaf = node ? node[indexAt(page, m_levels)] : nullptr;
+        if (!leaf && !m_imagePages.empty())
+            leaf = faultImagePage(page);
+        return leaf ? untag(leaf) : m_zeroPage;
+    }
+
+    inline uint8_t* getPageForWrite(Addr page) {
+        void** leaf = getLeaf(page);
+        if (!*leaf && !m_imagePages.empty())
+            faultImagePage(page);
+        if (!*leaf) {
+            *leaf = allocPage();
+        } else if (isImagePage(*leaf)) {
+            uint8_t* data = allocPage();
+            memcpy(data, untag(*leaf), m_pageSize);
+            *leaf = data;
+        }
+        return (uint8_t*)*leaf;
+    }
+
+    /* Find the leaf slot for 'page', creating interior nodes as needed */
+    inline void** getLeaf(Addr page) {
+        if (page > m_maxPage) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "BackingSparse: Error - page 0x%" PRIx64 " is outside of the backing store.\n", page);
+        }
+        void** node = m_root;
+        for (unsigned int level = 1; level < m_levels; level++) {
+            void** next = (void**)node[indexAt(page, level)];
+            if (!next) {
+                next = newNode();
+                node[indexAt(page, level)] = next;
+            }
+            node = next;
+        }
+        return &node[indexAt(page, m_levels)];
+    }
+
+    /* Pages come back zeroed: anonymous mappings are zero-filled and the fallback uses calloc */
+    uint8_t* allocPage() {
+        m_numPages++;
+        if (m_arenaNext == m_arenaEnd && !newArena()) {
+            uint8_t* data = (uint8_t*) calloc(m_pageSize, sizeof(uint8_t));
+            if (!data) {
+                Output out("", 1, 0, Output::STDOUT);
+                out.fatal(CALL_INFO, -1, "BackingSparse: Error - malloc failed.\n");
+            }
+            m_mallocPages.push_back(data);
+            return data;
+        }
+        uint8_t* data = m_arenaNext;
+        m_arenaNext += m_pageSize;
+        return data;
+    }
+
+    bool newArena() {
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+        flags |= MAP_NORESERVE;
+#endif
+        void* arena = MAP_FAILED;
+#ifdef MAP_HUGETLB
+        if (m_hugePages)
+            arena = mmap(NULL, m_arenaSize, PROT_READ|PROT_WRITE, flags | MAP_HUGETLB, -1, 0);
+#endif
+        if (arena == MAP_FAILED) {
+            arena = mmap(NULL, m_arenaSize, PROT_READ|PROT_WRITE, flags, -1, 0);
+            if (arena == MAP_FAILED)
+                return false;
+#ifdef MADV_HUGEPAGE
+            if (m_hugePages)
+                madvise(arena, m_arenaSize, MADV_HUGEPAGE);
+#endif
+        }
+        m_arenas.push_back(arena);
+        m_arenaNext = (uint8_t*)arena;
+        m_arenaEnd = m_arenaNext + m_arenaSize;
+        return true;
+    }
+
+    size_t m_pageSize;
+    unsigned int m_shift;
+    Addr m_pageMask;
+    unsigned int m_levels;
+    Addr m_maxPage;
+    void** m_root;
+    uint8_t* m_zeroPage;
+
+    size_t m_arenaSize;
+    bool m_hugePages;
+    std::vector<void*> m_arenas;
+    std::vector<uint8_t*> m_mallocPages;
+    uint8_t* m_arenaNext;
+    uint8_t* m_arenaEnd;
+
+    uint8_t* m_image;
+    size_t m_imageSize;
+    bool m_imageCompressed;
+    std::unordered_map<Addr,ImageIndexEntry> m_imagePages; // Compressed image pages not yet brought in
+
+    size_t m_numPages;
+    size_t m_numNodes;
+};
+
 }
 }
 }
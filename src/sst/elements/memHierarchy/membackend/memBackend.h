@@ -120,6 +120,25 @@ class SimpleMemBackend : public MemBackend {
 
     virtual bool issueRequest( ReqId, Addr, bool isWrite, unsigned numBytes ) = 0;
 
+    typedef MemBackendConvertor::BatchReq Request;
+
+    /*
+     * Offer a window of pending requests, oldest first. The backend may accept
+     * any of them, in any order, up to its per-cycle limit. Accepted requests
+     * are marked 'issued' and the number accepted is returned.
+     * The default accepts requests in order until one is rejected.
+     */
+    virtual unsigned issueRequests( std::vector<Request>& reqs ) {
+        unsigned count = 0;
+        for (std::vector<Request>::iterator it = reqs.begin(); it != reqs.end(); it++) {
+            if (count == (unsigned)m_maxReqPerCycle || !issueRequest(it->id, it->addr, it->isWrite, it->numBytes))
+                break;
+            it->issued = true;
+            count++;
+        }
+        return count;
+    }
+
     void handleMemResponse( ReqId id ) {
         m_respFunc( id );
     }
@@ -15,6 +15,7 @@
 
 
 #include <sst_config.h>
+#include <algorithm>
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/memoryController.h"
 #include "membackend/memBackendConvertor.h"
@@ -49,6 +50,9 @@ MemBackendConvertor::MemBackendConvertor(ComponentId_t id, Params& params, MemBa
 
     m_clockBackend = m_backend->isClocked();
 
+    m_windowSize = params.find<uint32_t>("request_window", 1);
+    if (m_windowSize == 0) m_windowSize = 1;
+
     stat_GetSReqReceived    = registerStatistic<uint64_t>("requests_received_GetS");
     stat_GetSXReqReceived   = registerStatistic<uint64_t>("requests_received_GetSX");
     stat_GetXReqReceived    = registerStatistic<uint64_t>("requests_received_GetX");
@@ -63,6 +67,17 @@ MemBackendConvertor::MemBackendConvertor(ComponentId_t id, Params& params, MemBa
     stat_cyclesAttemptIssueButRejected = registerStatistic<uint64_t>( "cycles_attempted_issue_but_rejected" );
     stat_totalCycles = registerStatistic<uint64_t>( "total_cycles" );;
 
+#ifdef MEMH_HOST_PROFILE
+    m_profileClock = m_hostProfile.addRegion("clock");
+    m_profileIssue = m_hostProfile.addRegion("issue");
+    m_profileBackendClock = m_hostProfile.addRegion("backend_clock");
+    m_profileResponse = m_hostProfile.addRegion("response");
+    for (unsigned int i = 0; i < m_hostProfile.getRegionCount(); i++) {
+        m_hostProfile.setStatistics(i, registerStatistic<uint64_t>("host_calls", m_hostProfile.getRegionName(i)),
+                registerStatistic<uint64_t>("host_time_ns", m_hostProfile.getRegionName(i)));
+    }
+#endif
+
     m_clockOn = true; /* Maybe parent should set this */
 }
 
@@ -93,8 +108,37 @@ void MemBackendConvertor::handleCustomEvent( CustomCmdInfo * info) {
 }
 
 bool MemBackendConvertor::clock(Cycle_t cycle) {
+    MEMH_PROFILE_SCOPE(&m_hostProfile, m_profileClock);
     m_cycleCount++;
 
+    bool cycleWithIssue;
+    {
+        MEMH_PROFILE_SCOPE(&m_hostProfile, m_profileIssue);
+        cycleWithIssue = (m_windowSize > 1) ? issueWindow() : issueInOrder();
+    }
+
+    if (cycleWithIssue)
+        stat_cyclesWithIssue->addData(1);
+
+    stat_outstandingReqs->addData( m_pendingRequests.size() );
+
+    bool unclock = !m_clockBackend;
+    if (m_clockBackend) {
+        MEMH_PROFILE_SCOPE(&m_hostProfile, m_profileBackendClock);
+        unclock = m_backend->clock(cycle);
+    }
+
+    // Can turn off the clock if:
+    // 1) backend says it's ok
+    // 2) requestQueue is empty
+    if (unclock && m_requestQueue.empty())
+        return true;
+
+    return false;
+}
+
+/* Issue from the head of the request queue until the backend rejects a request */
+bool MemBackendConvertor::issueInOrder() {
     int reqsThisCycle = 0;
     bool cycleWithIssue = false;
     while ( !m_requestQueue.empty()) {
@@ -121,23 +165,72 @@ bool MemBackendConvertor::clock(Cycle_t cycle) {
             m_requestQueue.pop_front();
         }
     }
+    return cycleWithIssue;
+}
 
-    if (cycleWithIssue)
-        stat_cyclesWithIssue->addData(1);
-
-    stat_outstandingReqs->addData( m_pendingRequests.size() );
+/*
+ * Offer the backend up to m_windowSize requests from the front of the queue and let it
+ * choose which to accept. Only the oldest request to each line is offered so that
+ * requests to the same line complete in order. Custom requests are not reordered: one
+ * at the head of the queue is issued on its own and one behind it ends the window.
+ */
+bool MemBackendConvertor::issueWindow() {
+    if (m_requestQueue.empty())
+        return false;
+
+    if (!m_requestQueue.front()->isMemEv())
+        return issueInOrder();
+
+    m_window.clear();
+    std::deque<BaseReq*>::iterator end = m_requestQueue.begin();
+    while (end != m_requestQueue.end() && m_window.size() < m_windowSize && (*end)->isMemEv()) {
+        MemReq* req = static_cast<MemReq*>(*end);
+        end++;
+        bool conflict = false;
+        for (std::vector<MemReq*>::iterator it = m_window.begin(); it != m_window.end(); it++) {
+            if ((*it)->baseAddr() == req->baseAddr()) {
+                conflict = true;
+                break;
+            }
+        }
+        if (!conflict)
+            m_window.push_back(req);
+    }
 
-    bool unclock = !m_clockBackend;
-    if (m_clockBackend)
-        unclock = m_backend->clock(cycle);
+    m_windowIssued.assign(m_window.size(), false);
+    unsigned count = issueBatch(m_window, m_windowIssued);
+
+    if (count < m_window.size())
+        stat_cyclesAttemptIssueButRejected->addData(1);
+    if (count == 0)
+        return false;
+
+    bool anyDone = false;
+    for (size_t i = 0; i < m_window.size(); i++) {
+        if (!m_windowIssued[i])
+            continue;
+        Debug(_L10_, "Processing request: %s\n", m_window[i]->getString().c_str());
+        m_window[i]->increment( m_backendRequestWidth );
+        anyDone |= m_window[i]->issueDone();
+    }
 
-    // Can turn off the clock if:
-    // 1) backend says it's ok
-    // 2) requestQueue is empty
-    if (unclock && m_requestQueue.empty())
-        return true;
+    if (anyDone) {
+        Debug(_L10_, "Completed issue of request(s)\n");
+        std::deque<BaseReq*>::iterator last = std::remove_if(m_requestQueue.begin(), end, [](BaseReq* req) { return req->issueDone(); });
+        m_requestQueue.erase(last, end);
+    }
+    return true;
+}
 
-    return false;
+unsigned MemBackendConvertor::issueBatch( std::vector<MemReq*>& reqs, std::vector<bool>& issued ) {
+    unsigned count = 0;
+    for (size_t i = 0; i < reqs.size(); i++) {
+        if ((int)count == m_backend->getMaxReqPerCycle() || !issue(reqs[i]))
+            break;
+        issued[i] = true;
+        count++;
+    }
+    return count;
 }
 
 /*
@@ -160,6 +253,7 @@ void MemBackendConvertor::turnClockOff() {
 }
 
 void MemBackendConvertor::doResponse( ReqId reqId, uint32_t flags ) {
+    MEMH_PROFILE_SCOPE(&m_hostProfile, m_profileResponse);
 
     /* If clock is not on, turn it back on */
     if (!m_clockOn) {
@@ -198,23 +292,17 @@ void MemBackendConvertor::doResponse( ReqId reqId, uint32_t flags ) {
             doResponseStat( event->getCmd(), latency );
 
             if (!flags) flags = event->getFlags();
-            SST::Event::id_type evID = event->getID();
             sendResponse(event->getID(), flags); // Needs to occur before a flush is completed since flush is dependent
 
             // TODO clock responses
             // Check for flushes that are waiting on this event to finish
-            if (m_dependentRequests.find(evID) != m_dependentRequests.end()) {
-                std::set<MemEvent*, memEventCmp> flushes = m_dependentRequests.find(evID)->second;
-
-                for (std::set<MemEvent*, memEventCmp>::iterator it = flushes.begin(); it != flushes.end(); it++) {
-                    (m_waitingFlushes.find(*it)->second).erase(evID);
-                    if ((m_waitingFlushes.find(*it)->second).empty()) {
-                        MemEvent * flush = *it;
-                        sendResponse(flush->getID(), (flush->getFlags() | MemEvent::F_SUCCESS));
-                        m_waitingFlushes.erase(flush);
-                    }
+            std::vector<FlushWait*>& flushes = static_cast<MemReq*>(req)->getFlushes();
+            for (std::vector<FlushWait*>::iterator it = flushes.begin(); it != flushes.end(); it++) {
+                if (--((*it)->pending) == 0) {
+                    MemEvent * flush = (*it)->flush;
+                    sendResponse(flush->getID(), (flush->getFlags() | MemEvent::F_SUCCESS));
+                    delete *it;
                 }
-                m_dependentRequests.erase(evID);
             }
         }
         delete req;
@@ -228,6 +316,9 @@ void MemBackendConvertor::sendResponse( SST::Event::id_type id, uint32_t flags )
 }
 
 void MemBackendConvertor::finish(void) {
+#ifdef MEMH_HOST_PROFILE
+    m_hostProfile.finish();
+#endif
     stat_totalCycles->addData(m_cycleCount);
     m_backend->finish();
 }
@@ -23,6 +23,7 @@
 
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/customcmd/customCmdMemory.h"
+#include "sst/elements/memHierarchy/hostProfiler.h"
 
 namespace SST {
 namespace MemHierarchy {
@@ -40,7 +41,8 @@ class MemBackendConvertor : public SubComponent {
 /* ELI definitions for subclasses */
 #define MEMBACKENDCONVERTOR_ELI_PARAMS {"debug_level",     "(uint) Debugging level: 0 (no output) to 10 (all output). Output also requires that SST Core be compiled with '--enable-debug'", "0"},\
             {"debug_mask",      "(uint) Mask on debug_level", "0"},\
-            {"debug_location",  "(uint) 0: No debugging, 1: STDOUT, 2: STDERR, 3: FILE", "0"}
+            {"debug_location",  "(uint) 0: No debugging, 1: STDOUT, 2: STDERR, 3: FILE", "0"},\
+            {"request_window",  "(uint) Number of pending requests offered to the backend each cycle. With 1, requests issue strictly in order; larger windows let backends that support it (e.g., simpleDRAM, timingDRAM) schedule row hits first. Requests to the same line are never reordered.", "1"}
 
 #define MEMBACKENDCONVERTOR_ELI_STATS { "cycles_with_issue",                  "Total cycles with successful issue to back end",   "cycles",   1 },\
             { "cycles_attempted_issue_but_rejected","Total cycles where an attempt to issue to backend was rejected (indicates backend full)", "cycles", 1 },\
@@ -53,12 +55,23 @@ class MemBackendConvertor : public SubComponent {
             { "latency_GetS",                       "Total latency of handled GetS requests",           "cycles",   1 },\
             { "latency_GetSX",                      "Total latency of handled GetSX requests",          "cycles",   1 },\
             { "latency_GetX",                       "Total latency of handled GetX requests",           "cycles",   1 },\
-            { "latency_PutM",                       "Total latency of handled PutM requests",           "cycles",   1 }
+            { "latency_PutM",                       "Total latency of handled PutM requests",           "cycles",   1 },\
+            { "host_calls",                         "Host profiling: number of times a region ran. One statistic per region (subId): clock, issue, backend_clock, response. Only collected when built with MEMH_HOST_PROFILE", "count", 5 },\
+            { "host_time_ns",                       "Host profiling: wall-clock time spent in a region, inclusive of nested regions. One statistic per region (subId) as for host_calls. Only collected when built with MEMH_HOST_PROFILE", "ns", 5 }
 
     SST_ELI_REGISTER_SUBCOMPONENT_API(SST::MemHierarchy::MemBackendConvertor, MemBackend*, uint32_t)
 
     typedef uint64_t ReqId;
 
+    /* A request offered to a backend as part of a batch, see SimpleMemBackend::issueRequests() */
+    struct BatchReq {
+        ReqId       id;
+        Addr        addr;
+        bool        isWrite;
+        unsigned    numBytes;
+        bool        issued;     // Set if the backend accepted the request
+    };
+
     class BaseReq {
     public:
 
@@ -100,6 +113,13 @@ class MemBackendConvertor : public SubComponent {
 
     };
 
+    /* A flush waiting on earlier requests to the same line, counted down as they finish */
+    struct FlushWait {
+        FlushWait(MemEvent* ev) : flush(ev), pending(0) { }
+        MemEvent*   flush;
+        uint32_t    pending;
+    };
+
     class MemReq : public BaseReq {
       public:
         MemReq( MemEvent* event, uint32_t reqId ) : BaseReq(reqId, BaseReq::ReqType::MEM),
@@ -136,10 +156,14 @@ class MemBackendConvertor : public SubComponent {
             return BaseReq::getString() + str.str();
         }
 
+        void addFlush( FlushWait* flush ) { m_flushes.push_back(flush); }
+        std::vector<FlushWait*>& getFlushes() { return m_flushes; }
+
       private:
         MemEvent*   m_event;
         uint32_t    m_offset;
         uint32_t    m_numReq;
+        std::vector<FlushWait*> m_flushes;  // Flushes waiting for this request
     };
 
   public:
@@ -186,36 +210,39 @@ class MemBackendConvertor : public SubComponent {
 
     bool m_clockBackend;
 
+    /*
+     * Issue the next chunk of each request in 'reqs', which are in arrival order and
+     * target distinct lines. Set issued[i] for each accepted request and return the number
+     * accepted. Convertors whose backend can schedule a window of requests override this;
+     * the default issues in order until a request is rejected.
+     */
+    virtual unsigned issueBatch( std::vector<MemReq*>& reqs, std::vector<bool>& issued );
+
   private:
     virtual bool issue(BaseReq*) = 0;
 
+    bool issueInOrder();
+    bool issueWindow();
 
 
 
     bool setupMemReq( MemEvent* ev ) {
         if ( Command::FlushLine == ev->getCmd() || Command::FlushLineInv == ev->getCmd() ) {
-            // TODO optimize if this becomes a problem, it is slow
-            std::set<SST::Event::id_type> dependsOn;
+            // The flush completes once every request to the line that is still queued has completed
+            FlushWait* wait = nullptr;
             for (std::deque<BaseReq*>::iterator it = m_requestQueue.begin(); it != m_requestQueue.end(); it++) {
                 if (!(*it)->isMemEv())
                     continue;
                 MemReq * mr = static_cast<MemReq*>(*it);
                 if (mr->baseAddr() == ev->getBaseAddr()) {
-                    MemEvent * req = mr->getMemEvent();
-                    dependsOn.insert(req->getID());
-                    if (m_dependentRequests.find(req->getID()) == m_dependentRequests.end()) {
-                        std::set<MemEvent*, memEventCmp> flushSet;
-                        flushSet.insert(ev);
-                        m_dependentRequests.insert(std::make_pair(req->getID(), flushSet));
-                    } else {
-                        (m_dependentRequests.find(req->getID())->second).insert(ev);
-                    }
+                    if (!wait)
+                        wait = new FlushWait(ev);
+                    wait->pending++;
+                    mr->addFlush(wait);
                 }
             }
 
-            if (dependsOn.empty()) return false;
-            m_waitingFlushes.insert(std::make_pair(ev, dependsOn));
-            return true;
+            return wait != nullptr;
         }
 
         uint32_t id = genReqId();
@@ -287,8 +314,9 @@ class MemBackendConvertor : public SubComponent {
     PendingRequests         m_pendingRequests;
     uint32_t                m_frontendRequestWidth;
 
-    std::map<MemEvent*, std::set<SST::Event::id_type> > m_waitingFlushes; // Set of request IDs for each flush
-    std::map<SST::Event::id_type, std::set<MemEvent*, memEventCmp> > m_dependentRequests; // Reverse map, set of flushes for each request ID, for faster lookup
+    uint32_t                m_windowSize;
+    std::vector<MemReq*>    m_window;           // Scratch space for issueWindow()
+    std::vector<bool>       m_windowIssued;
 
     Statistic<uint64_t>* stat_GetSLatency;
     Statistic<uint64_t>* stat_GetSXLatency;
@@ -305,6 +333,13 @@ class MemBackendConvertor : public SubComponent {
     Statistic<uint64_t>* stat_totalCycles;
     Statistic<uint64_t>* stat_outstandingReqs;
 
+#ifdef MEMH_HOST_PROFILE
+    HostProfiler m_hostProfile;
+    unsigned int m_profileClock;
+    unsigned int m_profileIssue;
+    unsigned int m_profileBackendClock;
+    unsigned int m_profileResponse;
+#endif
 };
 
 #if defined(__clang__)
@@ -167,3 +167,29 @@ bool SimpleDRAM::issueRequest( ReqId reqId, Addr addr, bool isWrite, unsigned nu
 
     return true;
 }
+
+/*
+ * FR-FCFS over a window of requests: first the oldest request to each idle bank whose
+ * row is already open, then the oldest remaining request to each idle bank.
+ */
+unsigned SimpleDRAM::issueRequests( std::vector<Request>& reqs ) {
+    unsigned count = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        for (std::vector<Request>::iterator it = reqs.begin(); it != reqs.end(); it++) {
+            if (count == (unsigned)m_maxReqPerCycle)
+                return count;
+            if (it->issued)
+                continue;
+            int bank = (it->addr >> lineOffset) & bankMask;
+            if (busy[bank])
+                continue;
+            if (pass == 0 && openRow[bank] != (int)(it->addr >> rowOffset))
+                continue;
+            if (issueRequest(it->id, it->addr, it->isWrite, it->numBytes)) {
+                it->issued = true;
+                count++;
+            }
+        }
+    }
+    return count;
+}
@@ -50,6 +50,7 @@ public:
     SimpleDRAM();
     SimpleDRAM(ComponentId_t id, Params &params);
     bool issueRequest( ReqId, Addr, bool, unsigned );
+    unsigned issueRequests( std::vector<Request>& reqs );
     bool isClocked() { return false; }
 
     typedef enum {OPEN, CLOSED, DYNAMIC, TIMEOUT } RowPolicy;
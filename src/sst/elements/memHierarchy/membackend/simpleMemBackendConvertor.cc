@@ -40,3 +40,20 @@ bool SimpleMemBackendConvertor::issue( BaseReq* req ) {
         return static_cast<SimpleMemBackend*>(m_backend)->issueCustomRequest( creq->id(), creq->getInfo() );
     }
 }
+
+unsigned SimpleMemBackendConvertor::issueBatch( std::vector<MemReq*>& reqs, std::vector<bool>& issued ) {
+    m_batch.resize(reqs.size());
+    for (size_t i = 0; i < reqs.size(); i++) {
+        m_batch[i].id = reqs[i]->id();
+        m_batch[i].addr = reqs[i]->addr();
+        m_batch[i].isWrite = reqs[i]->isWrite();
+        m_batch[i].numBytes = m_backendRequestWidth;
+        m_batch[i].issued = false;
+    }
+
+    unsigned count = static_cast<SimpleMemBackend*>(m_backend)->issueRequests( m_batch );
+
+    for (size_t i = 0; i < reqs.size(); i++)
+        issued[i] = m_batch[i].issued;
+    return count;
+}
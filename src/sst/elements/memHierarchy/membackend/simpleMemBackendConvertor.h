@@ -39,10 +39,14 @@ public:
     SimpleMemBackendConvertor(ComponentId_t id, Params &params, MemBackend* backend, uint32_t);
 
     virtual bool issue( BaseReq* req );
+    virtual unsigned issueBatch( std::vector<MemReq*>& reqs, std::vector<bool>& issued );
 
     virtual void handleMemResponse( ReqId reqId ) {
         doResponse(reqId);
     }
+
+private:
+    std::vector<BatchReq> m_batch;
 };
 
 }
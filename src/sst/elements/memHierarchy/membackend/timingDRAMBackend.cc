@@ -79,6 +79,32 @@ bool TimingDRAM::issueRequest( ReqId id, Addr addr, bool isWrite, unsigned numBy
     return ret;
 }
 
+/*
+ * FR-FCFS over a window of requests: requests to rows that are open in their bank
+ * are queued first, then the rest in arrival order. A full channel only holds up
+ * requests to that channel.
+ */
+unsigned TimingDRAM::issueRequests( std::vector<Request>& reqs )
+{
+    unsigned count = 0;
+    for ( int pass = 0; pass < 2; pass++ ) {
+        for ( std::vector<Request>::iterator it = reqs.begin(); it != reqs.end(); it++ ) {
+            if ( count == (unsigned)m_maxReqPerCycle )
+                return count;
+            if ( it->issued )
+                continue;
+            Channel* chan = m_channels[ m_mapper->getChannel(it->addr) ];
+            if ( chan->isFull() || ( pass == 0 && ! chan->isRowOpen(it->addr) ) )
+                continue;
+            if ( issueRequest( it->id, it->addr, it->isWrite, it->numBytes ) ) {
+                it->issued = true;
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
 bool TimingDRAM::clock(Cycle_t cycle)
 {
     output->verbose(CALL_INFO, 5, DBG_MASK, "cycle %" PRIu64 "\n",m_cycle);
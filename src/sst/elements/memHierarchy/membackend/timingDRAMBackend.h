@@ -105,6 +105,7 @@ private:
 
         unsigned getRank() { return m_rank; }
         unsigned getBank() { return m_bank; }
+        unsigned getOpenRow() { return m_row; }
 
       private:
         void update( SimTime_t );
@@ -256,6 +257,10 @@ private:
             return !m_banksActive.empty();
         }
 
+        bool isRowOpen( unsigned bank, unsigned row ) {
+            return m_banks[bank]->getOpenRow() == row;
+        }
+
       private:
 
         const char* prefix() { return m_pre.c_str(); }
@@ -295,6 +300,14 @@ private:
             return true;
         }
 
+        bool isFull() {
+            return m_maxPendingTrans == m_pendingCount;
+        }
+
+        bool isRowOpen( Addr addr ) {
+            return m_ranks[ m_mapper->getRank(addr) ]->isRowOpen( m_mapper->getBank(addr), m_mapper->getRow(addr) );
+        }
+
         void clock(SimTime_t );
 
       private:
@@ -323,6 +336,7 @@ public:
     TimingDRAM();
     TimingDRAM(ComponentId_t, Params& );
     virtual bool issueRequest( ReqId, Addr, bool, unsigned );
+    virtual unsigned issueRequests( std::vector<Request>& reqs );
     void handleResponse(ReqId  id ) {
         output->verbose(CALL_INFO, 2, DBG_MASK, "req=%" PRIu64 "\n", id );
         handleMemResponse( id );
@@ -377,7 +377,7 @@ void MemCacheController::handleDataResponse(MemEvent* event) {
     it->second.reqev->setAddr(cacheIndex);
     it->second.reqev->setBaseAddr(cacheIndex);
     it->second.reqev->setCmd(Command::PutM);
-    it->second.reqev->setPayload(event->getPayload());
+    it->second.reqev->sharePayload(event);
     it->second.reqev->clearFlag();
     it->second.reqev->setFlag(MemEvent::F_NORESPONSE);
     it->second.status = AccessStatus::FIN;
@@ -61,6 +61,7 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
     fixupParam( params, "backend", "backendConvertor.backend" );
     fixupParams( params, "backend.", "backendConvertor.backend." );
     fixupParams( params, "request_width", "backendConvertor.request_width" );
+    fixupParams( params, "request_window", "backendConvertor.request_window" );
     fixupParams( params, "max_requests_per_cycle", "backendConvertor.backend.max_requests_per_cycle" );
 
     uint32_t requestWidth = params.find<uint32_t>("backendConvertor.request_width", 64);
@@ -244,8 +245,8 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
         if (oldBackVal) backingType = "none";
     }
 
-    if (backingType != "none" && backingType != "mmap" && backingType != "malloc") {
-        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing. Must be one of 'none', 'malloc', or 'mmap'. You specified: %s\n",
+    if (backingType != "none" && backingType != "mmap" && backingType != "malloc" && backingType != "sparse") {
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing. Must be one of 'none', 'malloc', 'mmap', or 'sparse'. You specified: %s\n",
                 getName().c_str(), backingType.c_str());
     }
 
@@ -283,8 +284,38 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
         }
     } else if (backingType == "malloc") {
         backing_ = new Backend::BackingMalloc(sizeBytes);
+    } else if (backingType == "sparse") {
+        std::string arena = params.find<std::string>("backing_arena_size", "64MiB");
+        UnitAlgebra arena_ua(arena);
+        if (!arena_ua.hasUnits("B")) {
+            out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing_arena_size. Must have units of bytes (B). SI ok. You specified: %s\n",
+                    getName().c_str(), arena.c_str());
+        }
+        std::string page = params.find<std::string>("backing_page_size", "4KiB");
+        UnitAlgebra page_ua(page);
+        if (!page_ua.hasUnits("B") || page_ua.getRoundedValue() <= 0 || !isPowerOfTwo(page_ua.getRoundedValue())) {
+            out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing_page_size. Must have units of bytes (B) and be a power of two. SI ok. You specified: %s\n",
+                    getName().c_str(), page.c_str());
+        }
+        bool hugePages = params.find<bool>("backing_huge_pages", false);
+        Backend::BackingSparse* sparse = new Backend::BackingSparse(memBackendConvertor_->getMemSize(), page_ua.getRoundedValue(), arena_ua.getRoundedValue(), hugePages);
+        backing_ = sparse;
+
+        std::string inImage = params.find<std::string>("backing_in_image", "");
+        if (!inImage.empty()) {
+            size_t pages = sparse->loadImage(inImage);
+            out.verbose(CALL_INFO, 1, 0, "%s, Mapped %zu pages from memory image '%s'.\n", getName().c_str(), pages, inImage.c_str());
+        }
     }
 
+    backingOutImage_ = params.find<std::string>("backing_out_image", "");
+    backingOutCompress_ = params.find<bool>("backing_out_compress", false);
+    if (backingType != "sparse" && (!backingOutImage_.empty() || !params.find<std::string>("backing_in_image", "").empty())) {
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param combo: backing_in_image and backing_out_image require backing = 'sparse'. You specified backing = '%s'.\n",
+                getName().c_str(), backingType.c_str());
+    }
+    stat_backingResident = registerStatistic<uint64_t>("backing_resident_bytes");
+
     /* Clock Handler */
     std::string clockfreq = params.find<std::string>("clock");
     UnitAlgebra clock_ua(clockfreq);
@@ -502,6 +533,14 @@ void MemController::finish(void) {
     }
     memBackendConvertor_->finish();
     link_->finish();
+
+    if (backing_)
+        stat_backingResident->addData(backing_->getResidentBytes());
+
+    if (!backingOutImage_.empty()) {
+        size_t pages = static_cast<Backend::BackingSparse*>(backing_)->saveImage(backingOutImage_, backingOutCompress_);
+        out.verbose(CALL_INFO, 1, 0, "%s, Wrote %zu pages to memory image '%s'.\n", getName().c_str(), pages, backingOutImage_.c_str());
+    }
 }
 
 void MemController::writeData(MemEvent* event) {
@@ -532,11 +571,15 @@ void MemController::readData(MemEvent* event) {
     bool noncacheable = event->queryFlag(MemEvent::F_NONCACHEABLE);
     Addr localAddr = noncacheable ? event->getAddr() : event->getBaseAddr();
 
+    if (!backing_) { // Timing-only, share a zero payload instead of allocating one per response
+        event->setZeroPayload(event->getSize());
+        return;
+    }
+
     vector<uint8_t> payload;
     payload.resize(event->getSize(), 0);
 
-    if (backing_)
-        backing_->get(localAddr, event->getSize(), payload);
+    backing_->get(localAddr, event->getSize(), payload);
 
     event->setPayload(payload);
 }
@@ -546,8 +589,7 @@ void MemController::readData(MemEvent* event) {
 void MemController::writeData(Addr addr, std::vector<uint8_t> * data) {
     if (!backing_) return;
 
-    for (size_t i = 0; i < data->size(); i++)
-        backing_->set(addr + i, data->at(i));
+    backing_->set(addr, data->size(), *data);
 }
 
 
@@ -556,8 +598,7 @@ void MemController::readData(Addr addr, size_t bytes, std::vector<uint8_t> &data
 
     if (!backing_) return;
 
-    for (size_t i = 0; i < bytes; i++)
-        data[i] = backing_->get(addr + i);
+    backing_->get(addr, bytes, data);
 }
 
 
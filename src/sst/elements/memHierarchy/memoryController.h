@@ -43,6 +43,7 @@ public:
             {"backendConvertor",    "(string) Backend convertor to load", "memHierarchy.simpleMembackendConvertor"},\
             {"backend",             "(string) Backend memory model to use for timing.  Defaults to simpleMem", "memHierarchy.simpleMem"},\
             {"request_width",       "(uint) Max request width to the backend", "64"},\
+            {"request_window",      "(uint) Number of pending requests the backend convertor offers the backend each cycle. Backends that support it (e.g., simpleDRAM, timingDRAM) schedule row hits first within the window", "1"},\
             {"trace_file",          "(string) File name (optional) of a trace-file to generate.", ""},\
             {"verbose",             "(uint) Output verbosity for warnings/errors. 0[fatal error only], 1[warnings], 2[full state dump on fatal error]","1"},\
             {"debug_level",         "(uint) Debugging level: 0 to 10. Must configure sst-core with '--enable-debug'. 1=info, 2-10=debug output", "0"},\
@@ -50,8 +51,14 @@ public:
             {"debug_addr",          "(comma separated uint) Address(es) to be debugged. Leave empty for all, otherwise specify one or more, comma-separated values. Start and end string with brackets",""},\
             {"listenercount",       "(uint) Counts the number of listeners attached to this controller, these are modules for tracing or components like prefetchers", "0"},\
             {"listener%(listenercount)d", "(string) Loads a listener module into the controller", ""},\
-            {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', or 'mmap'", "mmap"},\
+            {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', 'mmap', or 'sparse' (radix-indexed pages allocated on first write)", "mmap"},\
             {"backing_size_unit",   "(string) For 'malloc' backing stores, malloc granularity", "1MiB"},\
+            {"backing_page_size",   "(string) For 'sparse' backing stores, page size. Must be a power of two", "4KiB"},\
+            {"backing_arena_size",  "(string) For 'sparse' backing stores, size of each host memory region that pages are allocated from", "64MiB"},\
+            {"backing_huge_pages",  "(bool) For 'sparse' backing stores, back arenas with huge pages if the host allows it", "false"},\
+            {"backing_in_image",    "(string) For 'sparse' backing stores, memory image to preload. The image is mapped at startup and pages are read in as they are accessed", ""},\
+            {"backing_out_image",   "(string) For 'sparse' backing stores, file to write the backing store contents to at the end of simulation", ""},\
+            {"backing_out_compress","(bool) Compress pages written to 'backing_out_image' (requires zlib)", "false"},\
             {"memory_file",         "(string) Optional backing-store file to pre-load memory, or store resulting state", "N/A"},\
             {"addr_range_start",    "(uint) Lowest address handled by this memory.", "0"},\
             {"addr_range_end",      "(uint) Highest address handled by this memory.", "uint64_t-1"},\
@@ -70,6 +77,10 @@ public:
 
     SST_ELI_DOCUMENT_PORTS( MEMCONTROLLER_ELI_PORTS )
 
+#define MEMCONTROLLER_ELI_STATS {"backing_resident_bytes", "Host memory used by the backing store at the end of simulation", "bytes", 1}
+
+    SST_ELI_DOCUMENT_STATISTICS( MEMCONTROLLER_ELI_STATS )
+
 
 #define MEMCONTROLLER_ELI_SUBCOMPONENTSLOTS {"backend", "Backend memory model to use for timing. Defaults to simpleMem", "SST::MemHierarchy::MemBackend"},\
             {"customCmdHandler", "Optional handler for custom command types", "SST::MemHierarchy::CustomCmdMemHandler"}, \
@@ -121,6 +132,9 @@ protected:
 
     MemBackendConvertor*    memBackendConvertor_;
     Backend::Backing*       backing_;
+    Statistic<uint64_t>*    stat_backingResident;
+    std::string             backingOutImage_;
+    bool                    backingOutCompress_;
 
     MemLinkBase* link_;         // Link to the rest of memHierarchy
     bool clockLink_;            // Flag - should we call clock() on this link or not
@@ -21,7 +21,7 @@
 using namespace SST;
 using namespace SST::MemHierarchy;
 
-MSHR::MSHR(Output* debug, int maxSize, string cacheName, std::set<Addr> debugAddr) {
+MSHR::MSHR(Output* debug, int maxSize, string cacheName, std::set<Addr> debugAddr, bool hashed) {
     d_ = debug;
     maxSize_ = maxSize;
     size_ = 0;
@@ -32,6 +32,84 @@ MSHR::MSHR(Output* debug, int maxSize, string cacheName, std::set<Addr> debugAdd
     d2_->init("", 10, 0, (Output::output_location_t)1);
 
     DEBUG_ADDR = debugAddr;
+
+    hashed_ = hashed;
+    table_ = nullptr;
+    if (hashed_) // Unlimited MSHRs start small and grow
+        table_ = new MSHRTable(maxSize_ > 0 ? maxSize_ : 0, MSHRRegister(&entryPool_));
+
+#ifdef MEMH_HOST_PROFILE
+    profiler_ = nullptr;
+    profileInsert_ = 0;
+    profileRemove_ = 0;
+#endif
+}
+
+#ifdef MEMH_HOST_PROFILE
+void MSHR::setHostProfiler(HostProfiler* profiler) {
+    profiler_ = profiler;
+    profileInsert_ = profiler_->addRegion("mshr_insert");
+    profileRemove_ = profiler_->addRegion("mshr_remove");
+}
+#endif
+
+MSHRRegister* MSHR::findReg(Addr addr) {
+    if (hashed_)
+        return table_->find(addr);
+    MSHRBlock::iterator it = mshr_.find(addr);
+    return (it == mshr_.end()) ? nullptr : &(it->second);
+}
+
+MSHRRegister* MSHR::createReg(Addr addr) {
+    if (hashed_)
+        return table_->insert(addr);
+    return &(mshr_.insert(std::make_pair(addr, MSHRRegister(&entryPool_))).first->second);
+}
+
+void MSHR::eraseReg(Addr addr) {
+    if (hashed_)
+        table_->erase(addr);
+    else
+        mshr_.erase(addr);
+}
+
+template <class F>
+void MSHR::forEachReg(F func) {
+    if (hashed_) {
+        table_->forEach(func);
+    } else {
+        for (MSHRBlock::iterator it = mshr_.begin(); it != mshr_.end(); it++)
+            func(it->first, it->second);
+    }
+}
+
+MSHR::~MSHR() {
+    forEachReg([this](Addr addr, MSHRRegister& reg) {
+        for (MSHREntryList::iterator it = reg.entries.begin(); it != reg.entries.end(); it++)
+            releaseEntry(*it);
+    });
+    if (table_)
+        delete table_;
+    mshr_.clear();
+    for (std::vector<std::list<Addr>*>::iterator it = evictPtrPool_.begin(); it != evictPtrPool_.end(); it++)
+        delete *it;
+    delete d2_;
+}
+
+std::list<Addr>* MSHR::allocEvictPointers() {
+    if (evictPtrPool_.empty())
+        return new std::list<Addr>;
+    std::list<Addr>* ptrs = evictPtrPool_.back();
+    evictPtrPool_.pop_back();
+    return ptrs;
+}
+
+/* Return an entry's evict pointer list to the pool once the entry is removed */
+void MSHR::releaseEntry(MSHREntry& entry) {
+    if (entry.getType() != MSHREntryType::Evict)
+        return;
+    entry.getPointers()->clear();
+    evictPtrPool_.push_back(entry.getPointers());
 }
 
 int MSHR::getMaxSize() {
@@ -43,49 +121,53 @@ int MSHR::getSize() {
 }
 
 unsigned int MSHR::getSize(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr)
         return 0;
     else
-        return mshr_.find(addr)->second.entries.size();
+        return reg->entries.size();
 }
 
 bool MSHR::exists(Addr addr) {
-    return mshr_.find(addr) != mshr_.end();
+    return findReg(addr) != nullptr;
 }
 
 MSHREntry MSHR::getEntry(Addr addr, size_t index) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntry(0x%" PRIx64 ", %zu). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
     }
-    if (mshr_.find(addr)->second.entries.size() <= index) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntry(0x%" PRIx64 ", %zu). Entry list size is %zu.\n", ownerName_.c_str(), addr, index, mshr_.find(addr)->second.entries.size());
+    if (reg->entries.size() <= index) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntry(0x%" PRIx64 ", %zu). Entry list size is %zu.\n", ownerName_.c_str(), addr, index, reg->entries.size());
     }
-    std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
+    MSHREntryList::iterator it = reg->entries.begin();
     std::advance(it, index);
     return *it;
 }
 
 MSHREntry MSHR::getFront(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFront(0x%" PRIx64 "). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr);
     }
 
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->entries.empty()) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFront(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
-    return mshr_.find(addr)->second.entries.front();
+    return reg->entries.front();
 }
 
 void MSHR::removeEntry(Addr addr, size_t index) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MEMH_PROFILE_SCOPE(profiler_, profileRemove_);
+    MSHRRegister * reg = findReg(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEntry(0x%" PRIx64 ", %zu). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
     }
-    MSHRRegister * reg = &(mshr_.find(addr)->second);
     if (reg->entries.size() <= index) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEntry(0x%" PRIx64 ", %zu). Entry list is shorter than requested index.\n", ownerName_.c_str(), addr, index);
     }
 
-    std::list<MSHREntry>::iterator entry = reg->entries.begin();
+    MSHREntryList::iterator entry = reg->entries.begin();
     std::advance(entry, index);
 
     if (entry->getType() == MSHREntryType::Event)
@@ -94,6 +176,7 @@ void MSHR::removeEntry(Addr addr, size_t index) {
     if (is_debug_addr(addr))
         printDebug(10, "Remove", addr, (*entry).getString().c_str());
 
+    releaseEntry(*entry);
     reg->entries.erase(entry);
     if (reg->entries.empty()) {
         if (is_debug_addr(addr))
@@ -101,15 +184,16 @@ void MSHR::removeEntry(Addr addr, size_t index) {
             //d_->debug(_L10_, "M: %-41" PRIu64 " %-20s Erase        0x%-16" PRIx64 " %-10d\n",
             //        Simulation::getSimulation()->getCurrentSimCycle(), ownerName_.c_str(), addr, size_);
             //d_->debug(_L10_, "    MSHR: erasing 0x%" PRIx64 " from MSHR\n", addr);
-        mshr_.erase(addr);
+        eraseReg(addr);
     }
 }
 
 void MSHR::removeFront(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MEMH_PROFILE_SCOPE(profiler_, profileRemove_);
+    MSHRRegister * reg = findReg(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeFront(0x%" PRIx64 "). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    MSHRRegister * reg = &(mshr_.find(addr)->second);
     if (reg->entries.empty()) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeFront(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
@@ -117,31 +201,33 @@ void MSHR::removeFront(Addr addr) {
    // if (is_debug_addr(addr))
    //     d_->debug(_L10_, "    MSHR::removeFront(0x%" PRIx64 ", %s)\n", addr, reg->entries.front().getString().c_str());
 
-    if (getFrontType(addr) == MSHREntryType::Event)
+    if (reg->entries.front().getType() == MSHREntryType::Event)
         size_--;
 
     if (is_debug_addr(addr))
         printDebug(10, "RemFr", addr, (reg->entries.front()).getString().c_str());
 
+    releaseEntry(reg->entries.front());
     reg->entries.pop_front();
     if (reg->entries.empty()) {
         if (is_debug_addr(addr))
             printDebug(10, "Erase", addr, "");
             //d_->debug(_L10_, "    MSHR: erasing 0x%" PRIx64 " from MSHR\n", addr);
-        mshr_.erase(addr);
+        eraseReg(addr);
     }
 }
 
 MSHREntryType MSHR::getEntryType(Addr addr, size_t index) {
     //if (is_debug_addr(addr))
     //    d_->debug(_L20_, "    MSHR::getEntryType(0x%" PRIx64 ", %zu)\n", addr, index);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntryType(0x%" PRIx64 ", %zu). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
     }
-    if (mshr_.find(addr)->second.entries.size() <= index) {
+    if (reg->entries.size() <= index) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntryType(0x%" PRIx64 ", %zu). Entry list is shoerter than index.\n", ownerName_.c_str(), addr, index);
     }
-    std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
+    MSHREntryList::iterator it = reg->entries.begin();
     std::advance(it, index);
     return it->getType();
 }
@@ -149,23 +235,25 @@ MSHREntryType MSHR::getEntryType(Addr addr, size_t index) {
 MSHREntryType MSHR::getFrontType(Addr addr) {
     //if (is_debug_addr(addr))
     //    d_->debug(_L20_, "    MSHR::getFrontType(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFrontType(0x%" PRIx64 "). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->entries.empty()) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFrontType(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
-    return mshr_.find(addr)->second.entries.front().getType();
+    return reg->entries.front().getType();
 }
 
 MemEventBase* MSHR::getEntryEvent(Addr addr, size_t index) {
     //if (is_debug_addr(addr))
     //    d_->debug(_L20_, "    MSHR::getEntryEvent(0x%" PRIx64 ", %zu)\n", addr, index);
 
-    if (mshr_.find(addr) == mshr_.end() || mshr_.find(addr)->second.entries.size() <= index)
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr || reg->entries.size() <= index)
         return nullptr;
 
-    std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
+    MSHREntryList::iterator it = reg->entries.begin();
     std::advance(it, index);
     if (it->getType() != MSHREntryType::Event)
         return nullptr;
@@ -179,17 +267,18 @@ MemEventBase* MSHR::getFrontEvent(Addr addr) {
     if (getFrontType(addr) != MSHREntryType::Event) {
         return nullptr;
     }
-    return mshr_.find(addr)->second.entries.front().getEvent();
+    return findReg(addr)->entries.front().getEvent();
 }
 
 MemEventBase* MSHR::getFirstEventEntry(Addr addr, Command cmd) {
 //    if (is_debug_addr(addr))
 //        d_->debug(_L20_, "    MSHR::getFirstEventEntry(0x%" PRIx64 ", %s)\n", addr, CommandString[(int)cmd]);
 
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr)
         return nullptr;
 
-    for (std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin(); it != mshr_.find(addr)->second.entries.end(); it++) {
+    for (MSHREntryList::iterator it = reg->entries.begin(); it != reg->entries.end(); it++) {
         if (it->getType() == MSHREntryType::Event && it->getEvent()->getCmd() == cmd)
             return it->getEvent();
     }
@@ -200,7 +289,7 @@ std::list<Addr>* MSHR::getEvictPointers(Addr addr) {
     if (getFrontType(addr) != MSHREntryType::Evict)
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEvictPointers(0x%" PRIx64 "). Entry type is not Evict.\n", ownerName_.c_str(), addr);
 
-    return mshr_.find(addr)->second.entries.front().getPointers();
+    return findReg(addr)->entries.front().getPointers();
 }
 
 // Return whether we should retry a new event or not
@@ -215,15 +304,16 @@ bool MSHR::removeEvictPointer(Addr addr, Addr addrPtr) {
     }
 
     // Sometimes we insert a WB before the Evict & then remove the Evict pointer, othertimes the Evict is front
-    if (getFrontType(addr) == MSHREntryType::Evict) {
-        MSHREntry * entry = &(mshr_.find(addr)->second.entries.front());
+    MSHRRegister* reg = findReg(addr);
+    if (reg->entries.front().getType() == MSHREntryType::Evict) {
+        MSHREntry * entry = &(reg->entries.front());
         entry->getPointers()->remove(addrPtr);
         if (entry->getPointers()->empty()) {
             removeFront(addr);
             return true;
         }
     } else {
-        std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
+        MSHREntryList::iterator it = reg->entries.begin();
         it++;
         if (it->getType() != MSHREntryType::Evict)
             d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEvictPointer(0x%" PRIx64 ", 0x%" PRIx64 "). Entry type is not Evict.\n", ownerName_.c_str(), addr, addrPtr);
@@ -241,11 +331,12 @@ bool MSHR::pendingWriteback(Addr addr) {
 
 bool MSHR::pendingWritebackIsDowngrade(Addr addr) {
     if (pendingWriteback(addr))
-        return mshr_.find(addr)->second.entries.front().getDowngrade();
+        return findReg(addr)->entries.front().getDowngrade();
     return false;
 }
 
 int MSHR::insertEvent(Addr addr, MemEventBase* event, int pos, bool fwdRequest, bool stallEvict) {
+    MEMH_PROFILE_SCOPE(profiler_, profileInsert_);
     if ((size_ == maxSize_) || (!fwdRequest && (size_ == maxSize_-1))) {
         if (is_debug_addr(addr)) {
             stringstream reason;
@@ -258,11 +349,11 @@ int MSHR::insertEvent(Addr addr, MemEventBase* event, int pos, bool fwdRequest,
     // Success
     size_++;
 
-    if (mshr_.find(addr) == mshr_.end()) {
-        MSHRRegister reg;
-        reg.entries.push_back(MSHREntry(event, stallEvict));
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr) {
+        reg = createReg(addr);
+        reg->entries.push_back(MSHREntry(event, stallEvict));
 
-        mshr_.insert(std::make_pair(addr, reg));
         if (is_debug_addr(addr)) {
             stringstream reason;
             reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=0";
@@ -272,18 +363,18 @@ int MSHR::insertEvent(Addr addr, MemEventBase* event, int pos, bool fwdRequest,
 
         return 0;
     } else {
-        if (pos == -1 || pos > mshr_.find(addr)->second.entries.size()) {
-            mshr_.find(addr)->second.entries.push_back(MSHREntry(event, stallEvict));
+        if (pos == -1 || pos > reg->entries.size()) {
+            reg->entries.push_back(MSHREntry(event, stallEvict));
             if (is_debug_addr(addr)) {
                 stringstream reason;
-                reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << (mshr_.find(addr)->second.entries.size() - 1);
+                reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << (reg->entries.size() - 1);
                 printDebug(10, "InsEv", addr, reason.str());
             }
-            return (mshr_.find(addr)->second.entries.size() - 1);
+            return (reg->entries.size() - 1);
         } else {
-            std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
+            MSHREntryList::iterator it = reg->entries.begin();
             std::advance(it, pos);
-            mshr_.find(addr)->second.entries.insert(it, MSHREntry(event, stallEvict));
+            reg->entries.insert(it, MSHREntry(event, stallEvict));
             if (is_debug_addr(addr)) {
                 stringstream reason;
                 reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << pos;
@@ -298,33 +389,32 @@ MemEventBase* MSHR::swapFrontEvent(Addr addr, MemEventBase* event) {
     if (is_debug_addr(addr))
         printDebug(10, "SwpEv", addr, "");
 
-    if (mshr_.find(addr)->second.entries.empty())
+    MSHRRegister* reg = findReg(addr);
+    if (reg->entries.empty())
         return nullptr;
 
-    return  mshr_.find(addr)->second.entries.front().swapEvent(event);
+    return reg->entries.front().swapEvent(event);
 }
 
 void MSHR::moveEntryToFront(Addr addr, unsigned int index) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = findReg(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::moveEntryToFront(0x%" PRIx64 ", %u). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
     }
-    MSHRRegister * reg = &(mshr_.find(addr)->second);
     if (reg->entries.size() <= index) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::moveEntryToFront(0x%" PRIx64 ", %u). Entry list is shorter than requested index.\n", ownerName_.c_str(), addr, index);
     }
 
-    std::list<MSHREntry>::iterator entry = reg->entries.begin();
+    MSHREntryList::iterator entry = reg->entries.begin();
     std::advance(entry, index);
 
-    MSHREntry tmpEntry = *entry;
-
     if (is_debug_addr(addr))
         printDebug(10, "MvEnt", addr, entry->getString());
-    reg->entries.erase(entry);
-    reg->entries.push_front(tmpEntry);
+    reg->entries.splice(reg->entries.begin(), reg->entries, entry);
 }
 
 bool MSHR::insertWriteback(Addr addr, bool downgrade) {
+    MEMH_PROFILE_SCOPE(profiler_, profileInsert_);
 //    if (is_debug_addr(addr))
 //        d_->debug(_L10_, "    MSHR::insertWriteback(0x%" PRIx64 ")\n", addr);
 
@@ -334,12 +424,12 @@ bool MSHR::insertWriteback(Addr addr, bool downgrade) {
         printDebug(10, "InsWB", addr, reason.str());
     }
 
-    if (mshr_.find(addr) == mshr_.end()) {
-        MSHRRegister reg;
-        reg.entries.push_back(MSHREntry(downgrade));
-        mshr_.insert(std::make_pair(addr, reg));
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr) {
+        reg = createReg(addr);
+        reg->entries.push_back(MSHREntry(downgrade));
     } else {
-        mshr_.find(addr)->second.entries.push_front(MSHREntry(downgrade));
+        reg->entries.push_front(MSHREntry(downgrade));
     }
 
     return true;
@@ -347,6 +437,7 @@ bool MSHR::insertWriteback(Addr addr, bool downgrade) {
 
 
 bool MSHR::insertEviction(Addr oldAddr, Addr newAddr) {
+    MEMH_PROFILE_SCOPE(profiler_, profileInsert_);
 //    if (is_debug_addr(oldAddr) || is_debug_addr(newAddr))
 //        d_->debug(_L10_, "    MSHR::insertEviction(0x%" PRIx64 ", 0x%" PRIx64 ")\n", oldAddr, newAddr);
 
@@ -356,16 +447,16 @@ bool MSHR::insertEviction(Addr oldAddr, Addr newAddr) {
         printDebug(10, "InsPtr", oldAddr, reason.str());
     }
 
-    if (mshr_.find(oldAddr) == mshr_.end()) {  // No MSHR entry for oldAddr
-        MSHRRegister reg;
-        reg.entries.push_back(MSHREntry(newAddr));
-        mshr_.insert(std::make_pair(oldAddr, reg));
+    MSHRRegister* reg = findReg(oldAddr);
+    if (reg == nullptr) {  // No MSHR entry for oldAddr
+        reg = createReg(oldAddr);
+        reg->entries.push_back(MSHREntry(newAddr, allocEvictPointers()));
     } else {
-        list<MSHREntry>* entries = &(mshr_.find(oldAddr)->second.entries);
+        MSHREntryList* entries = &(reg->entries);
         if (!entries->empty() && entries->back().getType() == MSHREntryType::Evict) { // MSHR entry for oldAddr is an Evict
             entries->back().getPointers()->push_back(newAddr);
         } else { // MSHR entry for oldAddr is not an Evict (or no entry exists)
-            entries->push_back(MSHREntry(newAddr));
+            entries->push_back(MSHREntry(newAddr, allocEvictPointers()));
         }
     }
     return true;
@@ -375,27 +466,30 @@ void MSHR::addPendingRetry(Addr addr) {
     if (is_debug_addr(addr))
         printDebug(20, "IncRetry", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::addPendingRetry(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.addPendingRetry();
+    reg->addPendingRetry();
 }
 
 void MSHR::removePendingRetry(Addr addr) {
     if (is_debug_addr(addr))
         printDebug(20, "DecRetry", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removePendingRetry(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.removePendingRetry();
+    reg->removePendingRetry();
 }
 
 uint32_t MSHR::getPendingRetries(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr)
         return 0;
 
-    return mshr_.find(addr)->second.getPendingRetries();
+    return reg->getPendingRetries();
 }
 
 
@@ -405,23 +499,25 @@ void MSHR::setInProgress(Addr addr, bool value) {
     if (is_debug_addr(addr))
         printDebug(20, "InProg", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setInProgress(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->entries.empty()) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setInProgress(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.entries.front().setInProgress(value);
+    reg->entries.front().setInProgress(value);
 }
 
 bool MSHR::getInProgress(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr) {
         return false;
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->entries.empty()) {
         return false;
     }
-    return mshr_.find(addr)->second.entries.front().getInProgress();
+    return reg->entries.front().getInProgress();
 }
 
 void MSHR::setStalledForEvict(Addr addr, bool set) {
@@ -432,56 +528,61 @@ void MSHR::setStalledForEvict(Addr addr, bool set) {
             printDebug(20, "Unstall", addr, "");
     }
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setStalledForEvict(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->entries.empty()) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setStalledForEvict(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.entries.front().setStalledForEvict(set);
+    reg->entries.front().setStalledForEvict(set);
 }
 
 bool MSHR::getStalledForEvict(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr) {
         return false;
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->entries.empty()) {
         return false;
     }
-    return mshr_.find(addr)->second.entries.front().getStalledForEvict();
+    return reg->entries.front().getStalledForEvict();
 }
 
 void MSHR::setProfiled(Addr addr) {
     if (is_debug_addr(addr))
         printDebug(20, "Profile", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setProfiled(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->entries.empty()) {
         d_->fatal(CALL_INFO, -1, "%s Error: MSHR::setProfiled(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.entries.front().setProfiled();
+    reg->entries.front().setProfiled();
 }
 
 bool MSHR::getProfiled(Addr addr) {
 //    if (is_debug_addr(addr))
 //        d_->debug(_L20_, "    MSHR::getProfiled(0x%" PRIx64 "\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->entries.empty()) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
-    return mshr_.find(addr)->second.entries.front().getProfiled();
+    return reg->entries.front().getProfiled();
 }
 
 bool MSHR::getProfiled(Addr addr, SST::Event::id_type id) {
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr)
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Address does not exist in MSHR.\n", ownerName_.c_str(), addr, id.first, id.second);
-    if (mshr_.find(addr)->second.entries.empty())
+    if (reg->entries.empty())
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Entry list is empty.\n", ownerName_.c_str(), addr, id.first, id.second);
-    for (list<MSHREntry>::iterator jt = mshr_.find(addr)->second.entries.begin(); jt != mshr_.find(addr)->second.entries.end(); jt++) {
+    for (MSHREntryList::iterator jt = reg->entries.begin(); jt != reg->entries.end(); jt++) {
         if (jt->getType() == MSHREntryType::Event && jt->getEvent()->getID() == id) {
             return jt->getProfiled();
         }
@@ -493,13 +594,14 @@ void MSHR::setProfiled(Addr addr, SST::Event::id_type id) {
     if (is_debug_addr(addr))
         printDebug(20, "Profile", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Address does not exist in MSHR.\n", ownerName_.c_str(), addr, id.first, id.second);
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->entries.empty()) {
         d_->fatal(CALL_INFO, -1, "%s Error: MSHR::setProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Entry list is empty.\n", ownerName_.c_str(), addr, id.first, id.second);
     }
-    for (list<MSHREntry>::iterator jt = mshr_.find(addr)->second.entries.begin(); jt != mshr_.find(addr)->second.entries.end(); jt++) {
+    for (MSHREntryList::iterator jt = reg->entries.begin(); jt != reg->entries.end(); jt++) {
         if (jt->getType() == MSHREntryType::Event && jt->getEvent()->getID() == id) {
             jt->setProfiled();
             return;
@@ -507,39 +609,38 @@ void MSHR::setProfiled(Addr addr, SST::Event::id_type id) {
     }
 }
 
+/* Oldest event entry; ties go to the lowest address so both storage types agree */
 MSHREntry* MSHR::getOldestEntry() {
-    bool first = false;
     MSHREntry* entry = nullptr;
-    uint64_t time;
-
-    for (MSHRBlock::iterator it = mshr_.begin(); it != mshr_.end(); it++) {
-        for (list<MSHREntry>::iterator jt = it->second.entries.begin(); jt != it->second.entries.end(); jt++) {
-            if (jt->getType() == MSHREntryType::Event) {
-                if (!first) {
-                    entry = &(*jt);
-                    time = jt->getStartTime();
-                } else if (jt->getStartTime() < time) {
-                    entry = &(*jt);
-                    time = jt->getStartTime();
-                }
+    uint64_t time = 0;
+    Addr entryAddr = 0;
+
+    forEachReg([&](Addr addr, MSHRRegister& reg) {
+        for (MSHREntryList::iterator jt = reg.entries.begin(); jt != reg.entries.end(); jt++) {
+            if (jt->getType() != MSHREntryType::Event)
+                continue;
+            if (entry == nullptr || jt->getStartTime() < time || (jt->getStartTime() == time && addr < entryAddr)) {
+                entry = &(*jt);
+                time = jt->getStartTime();
+                entryAddr = addr;
             }
         }
-    }
+    });
     return entry;
 }
 
 void MSHR::incrementAcksNeeded(Addr addr) {
    // if (is_debug_addr(addr))
    //     d_->debug(_L10_, "    MSHR::incrementAcksNeeded(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
-        MSHRRegister reg;
-        mshr_.insert(std::make_pair(addr, reg));
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr) {
+        reg = createReg(addr);
     }
-    mshr_.find(addr)->second.acksNeeded++;
+    reg->acksNeeded++;
 
     if (is_debug_addr(addr)) {
         std::stringstream reason;
-        reason << mshr_.find(addr)->second.acksNeeded << " acks";
+        reason << reg->acksNeeded << " acks";
         printDebug(10, "IncAck", addr, reason.str());
     }
 }
@@ -548,44 +649,47 @@ void MSHR::incrementAcksNeeded(Addr addr) {
 bool MSHR::decrementAcksNeeded(Addr addr) {
    // if (is_debug_addr(addr))
    //     d_->debug(_L10_, "    MSHR::decrementAcksNeeded(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::decrementAcksNeeded(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.acksNeeded == 0) {
+    if (reg->acksNeeded == 0) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::decrementAcksNeeded(0x%" PRIx64 "). AcksNeeded is already 0.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.acksNeeded--;
+    reg->acksNeeded--;
 
     if (is_debug_addr(addr)) {
         std::stringstream reason;
-        reason << mshr_.find(addr)->second.acksNeeded << " acks";
+        reason << reg->acksNeeded << " acks";
         printDebug(10, "DecAck", addr, reason.str());
     }
 
-    return (mshr_.find(addr)->second.acksNeeded == 0);
+    return (reg->acksNeeded == 0);
 }
 
 uint32_t MSHR::getAcksNeeded(Addr addr) {
 //    if (is_debug_addr(addr))
 //        d_->debug(_L20_, "    MSHR::getAcksNeeded(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr) {
         return 0;
     }
-    return (mshr_.find(addr)->second.acksNeeded);
+    return reg->acksNeeded;
 }
 
-void MSHR::setData(Addr addr, vector<uint8_t>& data, bool dirty) {
+void MSHR::setData(Addr addr, const vector<uint8_t>& data, bool dirty) {
 //    if (is_debug_addr(addr))
 //        d_->debug(_L10_, "    MSHR::setData(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setData(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
 
     if (is_debug_addr(addr))
         printDebug(10, "SetData", addr, (dirty ? "Dirty" : "Clean"));
 
-    mshr_.find(addr)->second.dataBuffer = data;
-    mshr_.find(addr)->second.dataDirty = dirty;
+    reg->dataBuffer = data;
+    reg->dataDirty = dirty;
 }
 
 void MSHR::clearData(Addr addr) {
@@ -594,32 +698,36 @@ void MSHR::clearData(Addr addr) {
     if (is_debug_addr(addr))
         printDebug(10, "ClrData", addr, "");
 
-    mshr_.find(addr)->second.dataBuffer.clear();
-    mshr_.find(addr)->second.dataDirty = false;
+    MSHRRegister* reg = findReg(addr);
+    reg->dataBuffer.clear();
+    reg->dataDirty = false;
 }
 
 vector<uint8_t>& MSHR::getData(Addr addr) {
 //    if (is_debug_addr(addr))
 //        d_->debug(_L20_, "    MSHR::getData(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getData(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    return mshr_.find(addr)->second.dataBuffer;
+    return reg->dataBuffer;
 }
 
 bool MSHR::hasData(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr)
         return false;
-    return !(mshr_.find(addr)->second.dataBuffer.empty());
+    return !(reg->dataBuffer.empty());
 }
 
 bool MSHR::getDataDirty(Addr addr) {
 //    if (is_debug_addr(addr))
 //        d_->debug(_L20_, "    MSHR::getDataDirty(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getDataDirty(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    return mshr_.find(addr)->second.dataDirty;
+    return reg->dataDirty;
 }
 
 void MSHR::setDataDirty(Addr addr, bool dirty) {
@@ -629,10 +737,11 @@ void MSHR::setDataDirty(Addr addr, bool dirty) {
     if (is_debug_addr(addr))
         printDebug(20, "SetDirt", addr, (dirty ? "Dirty" : "Clean"));
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findReg(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setDataDirty(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.dataDirty = dirty;
+    reg->dataDirty = dirty;
 
 }
 
@@ -658,9 +767,13 @@ void MSHR::printDebug(uint32_t lev, std::string action, Addr addr, std::string r
 // Print status. Called by cache controller on EmergencyShutdown and printStatus()
 void MSHR::printStatus(Output &out) {
     out.output("    MSHR Status for %s. Size: %u. Prefetches: %u\b", ownerName_.c_str(), size_, prefetchCount_);
-    for (std::map<Addr,MSHRRegister>::iterator it = mshr_.begin(); it != mshr_.end(); it++) {   // Iterate over addresses
-        out.output("      Entry: Addr = 0x%" PRIx64 "\n", (it->first));
-        for (std::list<MSHREntry>::iterator it2 = it->second.entries.begin(); it2 != it->second.entries.end(); it2++) { // Iterate over entries for each address
+    std::vector<Addr> addrs;
+    forEachReg([&](Addr addr, MSHRRegister& reg) { addrs.push_back(addr); });
+    std::sort(addrs.begin(), addrs.end());
+    for (std::vector<Addr>::iterator it = addrs.begin(); it != addrs.end(); it++) {   // Iterate over addresses
+        MSHRRegister* reg = findReg(*it);
+        out.output("      Entry: Addr = 0x%" PRIx64 "\n", (*it));
+        for (MSHREntryList::iterator it2 = reg->entries.begin(); it2 != reg->entries.end(); it2++) { // Iterate over entries for each address
             out.output("        %s\n", it2->getString().c_str());
         }
     }
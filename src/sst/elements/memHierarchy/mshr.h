@@ -16,6 +16,7 @@
 #ifndef _MSHR_H_
 #define _MSHR_H_
 
+#include <list>
 #include <map>
 #include <string>
 #include <sstream>
@@ -28,6 +29,8 @@
 
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/util.h"
+#include "sst/elements/memHierarchy/mshrTable.h"
+#include "sst/elements/memHierarchy/hostProfiler.h"
 
 namespace SST { namespace MemHierarchy {
 
@@ -84,6 +87,19 @@ class MSHREntry {
             downgrade = false;
         }
 
+        // Evict entry with a pointer list supplied (and recycled) by the MSHR
+        MSHREntry(Addr addr, std::list<Addr>* ptrs) {
+            type = MSHREntryType::Evict;
+            event = nullptr;
+            evictPtrs = ptrs;
+            evictPtrs->push_back(addr);
+            time = Simulation::getSimulation()->getCurrentSimCycle();
+            inProgress = false;
+            needEvict = false;
+            profiled = false;
+            downgrade = false;
+        }
+
         MSHREntry(const MSHREntry& entry) {
             type = entry.type;
             evictPtrs = entry.evictPtrs;
@@ -163,9 +179,11 @@ class MSHREntry {
         bool downgrade;             // Specific to Writeback type
 };
 
+typedef list<MSHREntry, PoolAllocator<MSHREntry> > MSHREntryList;
+
 struct MSHRRegister {
-    MSHRRegister() : acksNeeded(0), dataDirty(false), pendingRetries(0) { }
-    list<MSHREntry> entries;
+    MSHRRegister(NodePool* pool) : entries(PoolAllocator<MSHREntry>(pool)), acksNeeded(0), dataDirty(false), pendingRetries(0) { }
+    MSHREntryList entries;
     uint32_t acksNeeded;
     vector<uint8_t> dataBuffer;
     bool dataDirty;
@@ -177,21 +195,30 @@ struct MSHRRegister {
 };
 
 typedef map<Addr, MSHRRegister> MSHRBlock;
+typedef AddrHashTable<MSHRRegister> MSHRTable;
 
 /**
  *  Implements an MSHR with entries of type mshrEntry
+ *  Registers are kept either in an ordered map or, if 'hashed' is set, in an
+ *  open-addressing hash table sized from maxSize. In both cases entry list
+ *  nodes and evict pointer lists are recycled through per-MSHR pools.
  */
 class MSHR {
 public:
 
     // used externally
-    MSHR(Output* dbg, int maxSize, string cacheName, std::set<Addr> debugAddr);
+    MSHR(Output* dbg, int maxSize, string cacheName, std::set<Addr> debugAddr, bool hashed = false);
+    ~MSHR();
 
     int getMaxSize();
     int getSize();
     unsigned int getSize(Addr addr);
     bool exists(Addr addr);
 
+#ifdef MEMH_HOST_PROFILE
+    void setHostProfiler(HostProfiler* profiler);
+#endif
+
     // Accessors for first event since that's most common
     MSHREntry getFront(Addr addr);
     void removeFront(Addr addr);
@@ -244,7 +271,7 @@ public:
     bool decrementAcksNeeded(Addr addr);
     uint32_t getAcksNeeded(Addr addr);
 
-    void setData(Addr addr, vector<uint8_t>& data, bool dirty = false);
+    void setData(Addr addr, const vector<uint8_t>& data, bool dirty = false);
     void clearData(Addr addr);
     vector<uint8_t>& getData(Addr addr);
     bool hasData(Addr addr);
@@ -257,7 +284,21 @@ private:
 
     void printDebug(uint32_t level, std::string action, Addr addr, std::string reason);
 
+    // Register storage
+    MSHRRegister* findReg(Addr addr);
+    MSHRRegister* createReg(Addr addr);
+    void eraseReg(Addr addr);
+    template <class F> void forEachReg(F func);
+
+    // Evict pointer list pool
+    std::list<Addr>* allocEvictPointers();
+    void releaseEntry(MSHREntry& entry);
+
+    NodePool entryPool_;    // Must outlive mshr_ and table_
+    std::vector<std::list<Addr>*> evictPtrPool_;
+    bool hashed_;
     MSHRBlock mshr_;
+    MSHRTable* table_;
     Output* d_;
     Output* d2_;
     int size_;
@@ -265,6 +306,12 @@ private:
     int prefetchCount_;
     string ownerName_;
     std::set<Addr> DEBUG_ADDR;
+
+#ifdef MEMH_HOST_PROFILE
+    HostProfiler* profiler_;
+    unsigned int profileInsert_;
+    unsigned int profileRemove_;
+#endif
 };
 }}
 #endif
@@ -0,0 +1,255 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_MSHRTABLE_H
+#define MEMHIERARCHY_MSHRTABLE_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <deque>
+#include <new>
+#include <vector>
+
+/*
+ * Storage helpers for the MSHR. These have no dependencies on sst-core so
+ * they can be exercised by the standalone benchmark in tests/benchmarks.
+ */
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Free-list pool of fixed-size blocks. The block size is fixed by the first
+ * allocation; requests of any other size fall through to operator new.
+ * Blocks are carved out of chunks that are only returned on destruction.
+ */
+class NodePool {
+public:
+    NodePool() : requestSize_(0), blockSize_(0), chunkBlocks_(64), free_(nullptr) { }
+    ~NodePool() {
+        for (std::vector<char*>::iterator it = chunks_.begin(); it != chunks_.end(); it++)
+            ::operator delete(*it);
+    }
+
+    void* allocate(size_t bytes) {
+        if (requestSize_ == 0) {
+            requestSize_ = bytes;
+            blockSize_ = (bytes < sizeof(FreeBlock) ? sizeof(FreeBlock) : bytes);
+        }
+        if (bytes != requestSize_)
+            return ::operator new(bytes);
+        if (free_ == nullptr)
+            refill();
+        FreeBlock* block = free_;
+        free_ = block->next;
+        return block;
+    }
+
+    void deallocate(void* ptr, size_t bytes) {
+        if (bytes != requestSize_) {
+            ::operator delete(ptr);
+            return;
+        }
+        FreeBlock* block = static_cast<FreeBlock*>(ptr);
+        block->next = free_;
+        free_ = block;
+    }
+
+private:
+    struct FreeBlock { FreeBlock* next; };
+
+    void refill() {
+        size_t stride = (blockSize_ + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+        char* chunk = static_cast<char*>(::operator new(stride * chunkBlocks_));
+        chunks_.push_back(chunk);
+        for (size_t i = chunkBlocks_; i > 0; i--) {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * stride);
+            block->next = free_;
+            free_ = block;
+        }
+        chunkBlocks_ *= 2;
+    }
+
+    NodePool(const NodePool&);
+    NodePool& operator=(const NodePool&);
+
+    size_t requestSize_;
+    size_t blockSize_;
+    size_t chunkBlocks_;
+    FreeBlock* free_;
+    std::vector<char*> chunks_;
+};
+
+/*
+ * Allocator for node-based containers (std::list) that draws single-node
+ * allocations from a NodePool. A default-constructed allocator has no pool
+ * and uses operator new.
+ */
+template <class T>
+class PoolAllocator {
+public:
+    typedef T value_type;
+
+    PoolAllocator() : pool(nullptr) { }
+    explicit PoolAllocator(NodePool* p) : pool(p) { }
+    template <class U> PoolAllocator(const PoolAllocator<U>& other) : pool(other.pool) { }
+
+    T* allocate(size_t n) {
+        if (pool && n == 1)
+            return static_cast<T*>(pool->allocate(sizeof(T)));
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n) {
+        if (pool && n == 1)
+            pool->deallocate(ptr, sizeof(T));
+        else
+            ::operator delete(ptr);
+    }
+
+    template <class U> bool operator==(const PoolAllocator<U>& other) const { return pool == other.pool; }
+    template <class U> bool operator!=(const PoolAllocator<U>& other) const { return pool != other.pool; }
+
+    NodePool* pool;
+};
+
+/*
+ * Address-keyed hash table using open addressing with linear probing.
+ * Slots hold only the key and a pointer to the value; values live in a
+ * pool whose storage never moves, so references to a value stay valid
+ * until that key is erased. Erase uses backward-shift deletion so the
+ * table never accumulates tombstones.
+ *
+ * The table is sized so that 'capacity' keys fit at a load factor of 1/2
+ * and doubles if that is exceeded.
+ * Recycled values are reset by assignment from the prototype passed at
+ * construction.
+ */
+template <class V>
+class AddrHashTable {
+public:
+    AddrHashTable(size_t capacity, const V& proto) : proto_(proto), count_(0) {
+        size_t slots = 16;
+        while (slots < 2 * capacity)
+            slots <<= 1;
+        slots_.assign(slots, Slot());
+        mask_ = slots - 1;
+    }
+
+    size_t size() const { return count_; }
+
+    V* find(uint64_t key) const {
+        for (size_t i = hash(key); ; i = (i + 1) & mask_) {
+            const Slot& slot = slots_[i];
+            if (slot.value == nullptr)
+                return nullptr;
+            if (slot.key == key)
+                return slot.value;
+        }
+    }
+
+    /* Insert a new key; the caller guarantees it is not already present */
+    V* insert(uint64_t key) {
+        if (2 * (count_ + 1) > slots_.size())
+            grow();
+
+        V* value;
+        if (free_.empty()) {
+            values_.push_back(proto_);
+            value = &values_.back();
+        } else {
+            value = free_.back();
+            free_.pop_back();
+        }
+        place(key, value);
+        count_++;
+        return value;
+    }
+
+    void erase(uint64_t key) {
+        size_t i = hash(key);
+        while (slots_[i].value != nullptr && slots_[i].key != key)
+            i = (i + 1) & mask_;
+        if (slots_[i].value == nullptr)
+            return;
+
+        *(slots_[i].value) = proto_;
+        free_.push_back(slots_[i].value);
+        count_--;
+
+        // Pull later members of the probe run back into the hole unless their home slot lies in (i, j]
+        size_t j = i;
+        for (;;) {
+            j = (j + 1) & mask_;
+            if (slots_[j].value == nullptr)
+                break;
+            size_t home = hash(slots_[j].key);
+            bool stays = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+            if (!stays) {
+                slots_[i] = slots_[j];
+                i = j;
+            }
+        }
+        slots_[i] = Slot();
+    }
+
+    template <class F>
+    void forEach(F func) {
+        for (typename std::vector<Slot>::iterator it = slots_.begin(); it != slots_.end(); it++) {
+            if (it->value != nullptr)
+                func(it->key, *(it->value));
+        }
+    }
+
+private:
+    struct Slot {
+        Slot() : key(0), value(nullptr) { }
+        uint64_t key;
+        V* value;
+    };
+
+    size_t hash(uint64_t key) const {
+        return (size_t)((key * 0x9E3779B97F4A7C15ULL) >> 32) & mask_;
+    }
+
+    void place(uint64_t key, V* value) {
+        size_t i = hash(key);
+        while (slots_[i].value != nullptr)
+            i = (i + 1) & mask_;
+        slots_[i].key = key;
+        slots_[i].value = value;
+    }
+
+    void grow() {
+        std::vector<Slot> old;
+        old.swap(slots_);
+        slots_.assign(old.size() * 2, Slot());
+        mask_ = slots_.size() - 1;
+        for (typename std::vector<Slot>::iterator it = old.begin(); it != old.end(); it++) {
+            if (it->value != nullptr)
+                place(it->key, it->value);
+        }
+    }
+
+    V proto_;
+    std::vector<Slot> slots_;
+    size_t mask_;
+    size_t count_;
+    std::deque<V> values_;      // Backing storage; deque::push_back never moves existing elements
+    std::vector<V*> free_;
+};
+
+}}
+
+#endif
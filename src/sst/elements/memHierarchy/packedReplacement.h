@@ -0,0 +1,312 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_PACKED_REPLACEMENT_H
+#define MEMHIERARCHY_PACKED_REPLACEMENT_H
+
+#include <stdint.h>
+#include <vector>
+
+/*
+ * Replacement state for the packed-state policies in replacementManager.h.
+ * These have no dependencies on sst-core so CacheArray can call them directly
+ * and they can be exercised by the standalone test in tests/unit.
+ *
+ * Each state class provides, with 'way' relative to the start of the set:
+ *  - touch(set, way)      a hit
+ *  - insert(set, way)     a fill into a line that was just replaced
+ *  - invalidate(set, way) a line was replaced or deallocated
+ *  - victim(set)          the way to evict when no line in the set is invalid
+ * Parameters are checked by the policies, not here.
+ */
+
+namespace SST { namespace MemHierarchy {
+
+/* Fixed-width unsigned fields packed into 64-bit words. Fields never straddle a word. */
+class PackedFieldArray {
+public:
+    PackedFieldArray() : width(1), perWord(64), mask(1) { }
+
+    void init(uint64_t count, unsigned int bits) {
+        width = bits;
+        perWord = 64 / bits;
+        mask = (bits == 64) ? ~0ULL : ((1ULL << bits) - 1);
+        words.assign((count + perWord - 1) / perWord, 0);
+    }
+
+    inline uint64_t get(uint64_t i) const {
+        return (words[i / perWord] >> ((i % perWord) * width)) & mask;
+    }
+
+    inline void set(uint64_t i, uint64_t val) {
+        uint64_t shift = (i % perWord) * width;
+        uint64_t& word = words[i / perWord];
+        word = (word & ~(mask << shift)) | ((val & mask) << shift);
+    }
+
+    uint64_t maxValue() const { return mask; }
+
+    /* Number of bits needed to hold maxVal */
+    static unsigned int bitsFor(uint64_t maxVal) {
+        unsigned int bits = 1;
+        while (bits < 64 && (maxVal >> bits) != 0) bits++;
+        return bits;
+    }
+
+private:
+    unsigned int width;
+    unsigned int perWord;
+    uint64_t mask;
+    std::vector<uint64_t> words;
+};
+
+/* True LRU with a per-line age of log2(ways) bits. Age 0 is MRU, age (ways-1) is LRU. */
+class PackedLRUState {
+public:
+    PackedLRUState() : ways(1) { }
+
+    void init(uint64_t lines, uint64_t associativity) {
+        ways = associativity;
+        age.init(lines, PackedFieldArray::bitsFor(ways - 1));
+        for (uint64_t s = 0; s < lines / ways; s++) {
+            for (uint64_t w = 0; w < ways; w++)
+                age.set(s * ways + w, ways - 1 - w);
+        }
+    }
+
+    inline void touch(uint64_t set, uint64_t way) {
+        uint64_t base = set * ways;
+        uint64_t old = age.get(base + way);
+        for (uint64_t w = 0; w < ways; w++) {
+            uint64_t a = age.get(base + w);
+            if (a < old) age.set(base + w, a + 1);
+        }
+        age.set(base + way, 0);
+    }
+
+    inline void insert(uint64_t set, uint64_t way) { touch(set, way); }
+
+    /* Move the line to the LRU position so it is reused first */
+    inline void invalidate(uint64_t set, uint64_t way) {
+        uint64_t base = set * ways;
+        uint64_t old = age.get(base + way);
+        for (uint64_t w = 0; w < ways; w++) {
+            uint64_t a = age.get(base + w);
+            if (a > old) age.set(base + w, a - 1);
+        }
+        age.set(base + way, ways - 1);
+    }
+
+    inline uint64_t victim(uint64_t set) {
+        uint64_t base = set * ways;
+        for (uint64_t w = 0; w < ways; w++) {
+            if (age.get(base + w) == ways - 1)
+                return w;
+        }
+        return 0;
+    }
+
+private:
+    uint64_t ways;
+    PackedFieldArray age;
+};
+
+/* Tree pseudo-LRU. Each set keeps (ways - 1) direction bits in a single word; ways must be a power of two no larger than 64. */
+class TreePLRUState {
+public:
+    TreePLRUState() : levels(0) { }
+
+    void init(uint64_t lines, uint64_t associativity) {
+        levels = PackedFieldArray::bitsFor(associativity) - 1;
+        tree.assign(lines / associativity, 0);
+    }
+
+    /* Point every node on the path away from 'way'. Node n's children are 2n+1 and 2n+2; bit set means the victim is on the right. */
+    inline void touch(uint64_t set, uint64_t way) {
+        uint64_t bits = tree[set];
+        uint64_t node = 0;
+        for (unsigned int l = 0; l < levels; l++) {
+            uint64_t right = (way >> (levels - 1 - l)) & 1;
+            if (right) bits &= ~(1ULL << node);
+            else       bits |= (1ULL << node);
+            node = 2 * node + 1 + right;
+        }
+        tree[set] = bits;
+    }
+
+    inline void insert(uint64_t set, uint64_t way) { touch(set, way); }
+
+    /* Point every node on the path toward 'way' */
+    inline void invalidate(uint64_t set, uint64_t way) {
+        uint64_t bits = tree[set];
+        uint64_t node = 0;
+        for (unsigned int l = 0; l < levels; l++) {
+            uint64_t right = (way >> (levels - 1 - l)) & 1;
+            if (right) bits |= (1ULL << node);
+            else       bits &= ~(1ULL << node);
+            node = 2 * node + 1 + right;
+        }
+        tree[set] = bits;
+    }
+
+    inline uint64_t victim(uint64_t set) {
+        uint64_t bits = tree[set];
+        uint64_t node = 0;
+        uint64_t way = 0;
+        for (unsigned int l = 0; l < levels; l++) {
+            uint64_t right = (bits >> node) & 1;
+            way = (way << 1) | right;
+            node = 2 * node + 1 + right;
+        }
+        return way;
+    }
+
+private:
+    unsigned int levels;
+    std::vector<uint64_t> tree;
+};
+
+/*
+ * Re-reference interval prediction (Jaleel et al., ISCA 2010)
+ * Each line holds an M-bit re-reference prediction value (RRPV). Hits set RRPV to 0,
+ * victims are lines with the maximum RRPV. If no line has it, the set is aged until one
+ * does. The aging is held back until the set next changes, so looking for a victim
+ * leaves the state unchanged. The insertion RRPV depends on the mode:
+ *  - Static (SRRIP): always insert at max-1 ("long" re-reference interval)
+ *  - Bimodal (BRRIP): insert at max ("distant"), and at max-1 once every 'throttle' insertions on average
+ *  - Dynamic (DRRIP): set dueling between SRRIP and BRRIP leader sets with a saturating selector
+ * R is the random number generator used by bimodal insertion; it provides generateNextUInt64().
+ */
+template <class R>
+class RRIPState {
+public:
+    enum class Insertion { Static, Bimodal, Dynamic };
+
+    RRIPState() : ways(1), maxRRPV(0), mode(Insertion::Static), throttle(1), gen(nullptr),
+        agingSet(0), agingDelta(0), psel(0), pselMax(0), constituency(0) { }
+
+    void init(uint64_t lines, uint64_t associativity, unsigned int bits, Insertion insertion, uint64_t brripThrottle, R* rng) {
+        ways = associativity;
+        rrpv.init(lines, bits);
+        maxRRPV = rrpv.maxValue();
+        for (uint64_t i = 0; i < lines; i++)
+            rrpv.set(i, maxRRPV);
+        mode = insertion;
+        throttle = brripThrottle ? brripThrottle : 1;
+        gen = rng;
+        agingSet = 0;
+        agingDelta = 0;
+    }
+
+    /* Spread leader sets evenly, an SRRIP leader followed by a BRRIP leader in each constituency */
+    void initDueling(uint64_t sets, uint64_t leaders, unsigned int pselBits) {
+        pselMax = (1ULL << pselBits) - 1;
+        psel = pselMax / 2;
+        if (leaders == 0 || 2 * leaders > sets) leaders = sets / 2;
+        constituency = leaders ? (sets / leaders) : 0;
+    }
+
+    inline void touch(uint64_t set, uint64_t way) {
+        settle(set);
+        rrpv.set(set * ways + way, 0);
+    }
+
+    inline void insert(uint64_t set, uint64_t way) {
+        settle(set);
+        rrpv.set(set * ways + way, insertionRRPV(set));
+    }
+
+    inline void invalidate(uint64_t set, uint64_t way) {
+        settle(set);
+        rrpv.set(set * ways + way, maxRRPV);
+    }
+
+    /* Find the first line at max RRPV, or the line that aging the set would bring there first */
+    inline uint64_t victim(uint64_t set) {
+        if (agingSet != set)
+            settle(agingSet);
+        agingDelta = 0;
+
+        uint64_t base = set * ways;
+        uint64_t oldest = 0;
+        uint64_t oldestWay = 0;
+        for (uint64_t w = 0; w < ways; w++) {
+            uint64_t r = rrpv.get(base + w);
+            if (r == maxRRPV)
+                return w;
+            if (r > oldest) {
+                oldest = r;
+                oldestWay = w;
+            }
+        }
+        agingSet = set;
+        agingDelta = maxRRPV - oldest;
+        return oldestWay;
+    }
+
+    uint64_t getRRPV(uint64_t set, uint64_t way) const { return rrpv.get(set * ways + way); }
+    uint64_t getPSEL() const { return psel; }
+
+private:
+    uint64_t ways;
+    PackedFieldArray rrpv;
+    uint64_t maxRRPV;
+    Insertion mode;
+    uint64_t throttle;
+    R* gen;
+
+    uint64_t agingSet;      // Set that the last victim search found needs aging
+    uint64_t agingDelta;    // How much to age it by, 0 if nothing is pending
+
+    uint64_t psel;
+    uint64_t pselMax;
+    uint64_t constituency;
+
+    /* Apply pending aging before the set changes */
+    inline void settle(uint64_t set) {
+        if (agingDelta == 0 || set != agingSet)
+            return;
+        uint64_t base = set * ways;
+        for (uint64_t w = 0; w < ways; w++)
+            rrpv.set(base + w, rrpv.get(base + w) + agingDelta);
+        agingDelta = 0;
+    }
+
+    inline uint64_t srripInsertion() { return maxRRPV - 1; }
+    inline uint64_t brripInsertion() { return (gen->generateNextUInt64() % throttle == 0) ? maxRRPV - 1 : maxRRPV; }
+
+    /* Insertions are misses, so a leader set's insertion votes against its own policy */
+    inline uint64_t insertionRRPV(uint64_t set) {
+        if (mode == Insertion::Static)
+            return srripInsertion();
+        if (mode == Insertion::Bimodal)
+            return brripInsertion();
+        if (constituency) {
+            uint64_t offset = set % constituency;
+            if (offset == 0) {
+                if (psel < pselMax) psel++;
+                return srripInsertion();
+            } else if (offset == 1) {
+                if (psel > 0) psel--;
+                return brripInsertion();
+            }
+        }
+        return (psel > pselMax / 2) ? brripInsertion() : srripInsertion();
+    }
+};
+
+}}
+
+#endif /* MEMHIERARCHY_PACKED_REPLACEMENT_H */
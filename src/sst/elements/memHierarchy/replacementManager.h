@@ -17,9 +17,11 @@
 #define	MEMHIERARCHY_REPLACEMENT_POLICY_H
 
 #include "sst/core/subcomponent.h"
+#include "sst/core/output.h"
 #include "sst/core/rng/marsaglia.h"
 
 #include "memEvent.h"
+#include "packedReplacement.h"
 
 using namespace std;
 
@@ -705,6 +707,175 @@ public:
 };
 
 
+
+/* ------------------------------------------------------------------------------------------
+ *  Packed-state policies
+ *  - State is kept in compact per-set bitfields rather than per-line objects
+ *  - The algorithms live in packedReplacement.h; CacheArray calls them directly through
+ *    getPackedState() and only the ReplacementPolicy interface below is virtual
+ *  - Replacement algorithm assumes indices are contiguous for the set
+ * ------------------------------------------------------------------------------------------*/
+template <class S>
+class PackedReplacementPolicy : public ReplacementPolicy {
+public:
+    PackedReplacementPolicy(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : ReplacementPolicy(id, params, lines, associativity),
+        ways(associativity), sets(lines / associativity), bestCandidate(0) {
+        filling.init(lines, 1);
+    }
+
+    virtual ~PackedReplacementPolicy() { }
+
+    S& getPackedState() { return packed; }
+
+    /* Only line state is used, no cast */
+    bool checkCompatibility(ReplacementInfo * rInfo) { return true; }
+
+    /* The interface does not separate fills from hits, so the first update after replaced() is the fill */
+    void update(uint64_t id, ReplacementInfo * rInfo) {
+        if (filling.get(id)) {
+            filling.set(id, 0);
+            packed.insert(id / ways, id % ways);
+        } else {
+            packed.touch(id / ways, id % ways);
+        }
+    }
+
+    void replaced(uint64_t id) {
+        packed.invalidate(id / ways, id % ways);
+        filling.set(id, 1);
+    }
+
+    /* Invalid lines are always replaced first, otherwise the policy picks a victim way */
+    uint64_t findBestCandidate(std::vector<ReplacementInfo*> &rInfo) {
+        for (uint64_t i = 0; i < rInfo.size(); i++) {
+            if (rInfo[i]->getState() == I) {
+                bestCandidate = rInfo[i]->getIndex();
+                return bestCandidate;
+            }
+        }
+        uint64_t set = rInfo[0]->getIndex() / ways;
+        bestCandidate = set * ways + packed.victim(set);
+        return bestCandidate;
+    }
+
+    uint64_t getBestCandidate() { return bestCandidate; }
+
+protected:
+    uint64_t ways;
+    uint64_t sets;
+    uint64_t bestCandidate;
+    S packed;
+    PackedFieldArray filling;   // Lines whose next update is a fill
+};
+
+class LRUPacked final : public PackedReplacementPolicy<PackedLRUState> {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(LRUPacked, "memHierarchy", "replacement.lru-packed", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "true least-recently-used replacement policy using bit-packed per-set age stacks", SST::MemHierarchy::ReplacementPolicy);
+
+    LRUPacked(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : PackedReplacementPolicy<PackedLRUState>(id, params, lines, associativity) {
+        packed.init(lines, associativity);
+    }
+
+    virtual ~LRUPacked() { }
+};
+
+class TreePLRU final : public PackedReplacementPolicy<TreePLRUState> {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(TreePLRU, "memHierarchy", "replacement.plru", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "tree-based pseudo-least-recently-used replacement policy. Associativity must be a power of two and at most 64.", SST::MemHierarchy::ReplacementPolicy);
+
+    TreePLRU(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : PackedReplacementPolicy<TreePLRUState>(id, params, lines, associativity) {
+        if (ways > 64 || (ways & (ways - 1)) != 0) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "%s, Error: tree-PLRU replacement requires a power-of-two associativity no larger than 64. Associativity is %" PRIu64 ".\n",
+                    getName().c_str(), ways);
+        }
+        packed.init(lines, associativity);
+    }
+
+    virtual ~TreePLRU() { }
+};
+
+typedef RRIPState<SST::RNG::MarsagliaRNG> RRIPPackedState;
+
+/* Common parameters of the RRIP variants, see RRIPState for the algorithm */
+class RRIPBase : public PackedReplacementPolicy<RRIPPackedState> {
+public:
+    RRIPBase(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity, RRIPPackedState::Insertion insertion) :
+            PackedReplacementPolicy<RRIPPackedState>(id, params, lines, associativity) {
+        unsigned int bits = params.find<unsigned int>("rrpv_bits", 2);
+        if (bits == 0 || bits > 8) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "%s, Invalid param: rrpv_bits - must be between 1 and 8. You specified %u.\n", getName().c_str(), bits);
+        }
+        uint64_t throttle = params.find<uint64_t>("brrip_throttle", 32);
+        uint64_t seeda = params.find<uint64_t>("seed_a", 1);
+        uint64_t seedb = params.find<uint64_t>("seed_b", 1);
+        gen = new SST::RNG::MarsagliaRNG(seeda, seedb);
+        packed.init(lines, associativity, bits, insertion, throttle, gen);
+    }
+
+    virtual ~RRIPBase() {
+        delete gen;
+    }
+
+protected:
+    SST::RNG::MarsagliaRNG* gen;
+};
+
+class SRRIP final : public RRIPBase {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(SRRIP, "memHierarchy", "replacement.srrip", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "static re-reference interval prediction replacement policy", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"rrpv_bits",   "Number of bits in each line's re-reference prediction value", "2"} )
+
+    SRRIP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPBase(id, params, lines, associativity, RRIPPackedState::Insertion::Static) { }
+    virtual ~SRRIP() { }
+};
+
+class BRRIP final : public RRIPBase {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(BRRIP, "memHierarchy", "replacement.brrip", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "bimodal re-reference interval prediction replacement policy", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"rrpv_bits",       "Number of bits in each line's re-reference prediction value", "2"},
+            {"brrip_throttle",  "Lines are inserted with a long (rather than distant) re-reference prediction once every this many insertions, on average", "32"},
+            {"seed_a",          "Seed for random number generator", "1"},
+            {"seed_b",          "Seed for random number generator", "1"} )
+
+    BRRIP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPBase(id, params, lines, associativity, RRIPPackedState::Insertion::Bimodal) { }
+    virtual ~BRRIP() { }
+};
+
+class DRRIP final : public RRIPBase {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(DRRIP, "memHierarchy", "replacement.drrip", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "dynamic re-reference interval prediction replacement policy, uses set dueling to choose between SRRIP and BRRIP", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"rrpv_bits",       "Number of bits in each line's re-reference prediction value", "2"},
+            {"brrip_throttle",  "Lines are inserted with a long (rather than distant) re-reference prediction once every this many insertions, on average", "32"},
+            {"leader_sets",     "Number of leader sets dedicated to each of SRRIP and BRRIP", "32"},
+            {"psel_bits",       "Width of the saturating policy selection counter, 1 to 32", "10"},
+            {"seed_a",          "Seed for random number generator", "1"},
+            {"seed_b",          "Seed for random number generator", "1"} )
+
+    DRRIP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPBase(id, params, lines, associativity, RRIPPackedState::Insertion::Dynamic) {
+        uint64_t leaders = params.find<uint64_t>("leader_sets", 32);
+        unsigned int pselBits = params.find<unsigned int>("psel_bits", 10);
+        if (pselBits == 0 || pselBits > 32) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "%s, Invalid param: psel_bits - must be between 1 and 32. You specified %u.\n", getName().c_str(), pselBits);
+        }
+        packed.initDueling(sets, leaders, pselBits);
+    }
+    virtual ~DRRIP() { }
+};
+
 }}
 
 
@@ -1075,7 +1075,7 @@ void Scratchpad::handleRemoteGetResponse(MemEvent * response, SST::Event::id_typ
 void Scratchpad::handleRemoteReadResponse(MemEvent * response, SST::Event::id_type requestID) {
     // Update response with payload and finish request
     MemEvent * fwdResponse = static_cast<MemEvent*>(outstandingEventList_.find(requestID)->second.response);
-    fwdResponse->setPayload(response->getPayload());
+    fwdResponse->sharePayload(response);
 
     finishRequest(requestID);
 
@@ -0,0 +1,170 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Microbenchmark for MSHR register storage: compares the ordered map used by
+ * 'mshr_type=map' against the pooled open-addressing table used by
+ * 'mshr_type=hash'. Registers are modeled with the same list-of-entries
+ * layout as MSHRRegister. Does not need sst-core:
+ *
+ *   g++ -O2 -std=c++11 -I<sst-elements>/src mshrTableBench.cc -o mshrTableBench
+ *   ./mshrTableBench [mshr_entries] [operations]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "sst/elements/memHierarchy/mshrTable.h"
+
+using namespace SST::MemHierarchy;
+
+struct BenchEntry {
+    uint64_t event;
+    uint64_t time;
+};
+
+struct MapRegister {
+    std::list<BenchEntry> entries;
+    uint32_t acksNeeded;
+    MapRegister() : acksNeeded(0) { }
+};
+
+struct PooledRegister {
+    std::list<BenchEntry, PoolAllocator<BenchEntry> > entries;
+    uint32_t acksNeeded;
+    PooledRegister(NodePool* pool) : entries(PoolAllocator<BenchEntry>(pool)), acksNeeded(0) { }
+};
+
+struct Result {
+    double seconds;
+    uint64_t checksum;
+};
+
+/*
+ * Each operation retires the oldest outstanding miss, probes the table a few
+ * times (mostly hits, as coherence managers do while handling a miss), and
+ * allocates a new miss, sometimes merging into an existing register.
+ */
+template <class Ops>
+static Result run(Ops& ops, size_t entries, size_t iterations) {
+    std::mt19937_64 rng(42);
+    std::vector<uint64_t> window(entries);
+    for (size_t i = 0; i < entries; i++) {
+        window[i] = (rng() & 0xFFFFFFFFULL) << 6;
+        ops.insert(window[i], i);
+    }
+
+    uint64_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        size_t slot = i % entries;
+        ops.remove(window[slot]);
+
+        for (int probe = 0; probe < 4; probe++)
+            checksum += ops.lookup(window[(slot + 1 + probe * 7) % entries]);
+        checksum += ops.lookup((rng() & 0xFFFFFFFFULL) << 6);   // Usually a miss
+
+        uint64_t addr = (rng() % 8 == 0) ? window[(slot + 3) % entries] : ((rng() & 0xFFFFFFFFULL) << 6);
+        window[slot] = addr;
+        ops.insert(addr, i);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    Result result;
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    result.checksum = checksum;
+    return result;
+}
+
+struct MapOps {
+    std::map<uint64_t, MapRegister> regs;
+
+    void insert(uint64_t addr, uint64_t time) {
+        std::map<uint64_t, MapRegister>::iterator it = regs.find(addr);
+        if (it == regs.end())
+            it = regs.insert(std::make_pair(addr, MapRegister())).first;
+        BenchEntry entry = { addr, time };
+        it->second.entries.push_back(entry);
+    }
+
+    uint64_t lookup(uint64_t addr) {
+        std::map<uint64_t, MapRegister>::iterator it = regs.find(addr);
+        return (it == regs.end()) ? 0 : it->second.entries.size();
+    }
+
+    void remove(uint64_t addr) {
+        std::map<uint64_t, MapRegister>::iterator it = regs.find(addr);
+        it->second.entries.pop_front();
+        if (it->second.entries.empty())
+            regs.erase(it);
+    }
+};
+
+struct HashOps {
+    NodePool pool;
+    AddrHashTable<PooledRegister> regs;
+
+    HashOps(size_t entries) : regs(entries, PooledRegister(&pool)) { }
+
+    void insert(uint64_t addr, uint64_t time) {
+        PooledRegister* reg = regs.find(addr);
+        if (reg == nullptr)
+            reg = regs.insert(addr);
+        BenchEntry entry = { addr, time };
+        reg->entries.push_back(entry);
+    }
+
+    uint64_t lookup(uint64_t addr) {
+        PooledRegister* reg = regs.find(addr);
+        return (reg == nullptr) ? 0 : reg->entries.size();
+    }
+
+    void remove(uint64_t addr) {
+        PooledRegister* reg = regs.find(addr);
+        reg->entries.pop_front();
+        if (reg->entries.empty())
+            regs.erase(addr);
+    }
+};
+
+int main(int argc, char** argv) {
+    size_t entries = (argc > 1) ? strtoul(argv[1], nullptr, 0) : 64;
+    size_t iterations = (argc > 2) ? strtoul(argv[2], nullptr, 0) : 10000000;
+
+    MapOps mapOps;
+    Result mapResult = run(mapOps, entries, iterations);
+
+    HashOps hashOps(entries);
+    Result hashResult = run(hashOps, entries, iterations);
+
+    if (mapResult.checksum != hashResult.checksum) {
+        fprintf(stderr, "Error: checksum mismatch (map %llu, hash %llu)\n",
+                (unsigned long long)mapResult.checksum, (unsigned long long)hashResult.checksum);
+        return 1;
+    }
+
+    // Each iteration is one insert, five lookups and one remove
+    double ops = 7.0 * iterations;
+    printf("MSHR entries: %zu, iterations: %zu\n", entries, iterations);
+    printf("  map:  %8.3f s  %8.2f Mops/s\n", mapResult.seconds, ops / mapResult.seconds / 1e6);
+    printf("  hash: %8.3f s  %8.2f Mops/s\n", hashResult.seconds, ops / hashResult.seconds / 1e6);
+    printf("  speedup: %.2fx\n", mapResult.seconds / hashResult.seconds);
+    return 0;
+}
@@ -0,0 +1,18 @@
+#!/bin/bash
+#
+# Runs testClockMode.py with the caches clocked (clock_mode=clock) and
+# event-driven (clock_mode=event). Both runs must produce the same
+# statistics and end at the same simulated time.
+
+cd "$(dirname "$0")"
+
+rm -f testClockMode.clock.out testClockMode.event.out
+sst --model-options="clock_mode=clock" testClockMode.py > testClockMode.clock.out 2>&1 || { echo "testClockMode.py (clock) failed."; exit 1; }
+sst --model-options="clock_mode=event" testClockMode.py > testClockMode.event.out 2>&1 || { echo "testClockMode.py (event) failed."; exit 1; }
+
+if diff testClockMode.clock.out testClockMode.event.out; then
+    rm -f testClockMode.clock.out testClockMode.event.out
+else
+    echo "testClockMode.py failed, statistics differ between clock_mode=clock and clock_mode=event."
+    exit 1
+fi
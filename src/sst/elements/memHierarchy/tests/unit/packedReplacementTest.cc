@@ -0,0 +1,220 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Checks the victim order of the packed replacement state used by the
+ * 'plru', 'srrip', 'brrip' and 'drrip' policies. The RRIP cases use a
+ * counting generator so bimodal insertion is deterministic. Replacing a
+ * line calls invalidate() then insert(), as CacheArray::replace does.
+ * Does not need sst-core:
+ *
+ *   g++ -O2 -std=c++11 -I<sst-elements>/src packedReplacementTest.cc -o packedReplacementTest
+ *   ./packedReplacementTest
+ */
+
+#include <cstdio>
+
+#include "sst/elements/memHierarchy/packedReplacement.h"
+
+using namespace SST::MemHierarchy;
+
+/* Returns 1, 2, 3, ... so BRRIP inserts long on every 'throttle'-th insertion */
+struct CountingRNG {
+    CountingRNG() : n(0) { }
+    uint64_t generateNextUInt64() { return ++n; }
+    uint64_t n;
+};
+
+typedef RRIPState<CountingRNG> TestRRIP;
+
+static int failures = 0;
+
+#define CHECK_EQ(actual, expected) do { \
+    uint64_t a_ = (actual), e_ = (expected); \
+    if (a_ != e_) { \
+        printf("FAIL %s:%d: %s is %llu, expected %llu\n", __FILE__, __LINE__, #actual, \
+                (unsigned long long)a_, (unsigned long long)e_); \
+        failures++; \
+    } } while (0)
+
+static void replaceLine(TestRRIP& r, uint64_t set, uint64_t way) {
+    r.invalidate(set, way);
+    r.insert(set, way);
+}
+
+static void testTreePLRU() {
+    TreePLRUState p;
+    p.init(8, 4);   // Two sets of four ways
+
+    CHECK_EQ(p.victim(0), 0);
+    p.touch(0, 0);
+    CHECK_EQ(p.victim(0), 2);
+    p.touch(0, 2);
+    CHECK_EQ(p.victim(0), 1);
+    p.touch(0, 1);
+    CHECK_EQ(p.victim(0), 3);
+    p.touch(0, 3);
+    CHECK_EQ(p.victim(0), 0);
+
+    // Invalidating a line makes it the next victim
+    p.invalidate(0, 2);
+    CHECK_EQ(p.victim(0), 2);
+
+    // Sets are independent
+    CHECK_EQ(p.victim(1), 0);
+
+    // Eight ways touched in order evict way 0, then the far half of the tree
+    TreePLRUState q;
+    q.init(8, 8);
+    for (uint64_t w = 0; w < 8; w++)
+        q.touch(0, w);
+    CHECK_EQ(q.victim(0), 0);
+    q.touch(0, 0);
+    CHECK_EQ(q.victim(0), 4);
+}
+
+static void testSRRIP() {
+    CountingRNG rng;
+    TestRRIP r;
+    r.init(8, 4, 2, TestRRIP::Insertion::Static, 32, &rng);   // Two sets, RRPV 0..3
+
+    // Empty lines are at distant RRPV
+    CHECK_EQ(r.victim(0), 0);
+    for (uint64_t w = 0; w < 4; w++)
+        replaceLine(r, 0, w);
+    for (uint64_t w = 0; w < 4; w++)
+        CHECK_EQ(r.getRRPV(0, w), 2);
+
+    // A hit protects a line; nothing is at max so the first oldest line is picked
+    r.touch(0, 0);
+    CHECK_EQ(r.victim(0), 1);
+
+    // Looking for a victim does not age the set
+    CHECK_EQ(r.victim(0), 1);
+    CHECK_EQ(r.getRRPV(0, 2), 2);
+
+    // Replacing the victim ages the set by one so ways 2 and 3 reach max
+    replaceLine(r, 0, 1);
+    CHECK_EQ(r.getRRPV(0, 0), 1);
+    CHECK_EQ(r.getRRPV(0, 1), 2);
+    CHECK_EQ(r.getRRPV(0, 2), 3);
+    CHECK_EQ(r.getRRPV(0, 3), 3);
+    CHECK_EQ(r.victim(0), 2);
+}
+
+/* Aging found by a victim search survives a deallocation elsewhere before the victim is replaced */
+static void testRRIPAgingAcrossInvalidate() {
+    CountingRNG rng;
+    TestRRIP r;
+    r.init(8, 4, 2, TestRRIP::Insertion::Static, 32, &rng);
+    for (uint64_t s = 0; s < 2; s++) {
+        for (uint64_t w = 0; w < 4; w++)
+            replaceLine(r, s, w);
+    }
+
+    CHECK_EQ(r.victim(0), 0);
+    r.invalidate(1, 3);     // Deallocation in another set
+    replaceLine(r, 0, 0);
+    CHECK_EQ(r.getRRPV(0, 1), 3);
+    CHECK_EQ(r.getRRPV(0, 2), 3);
+    CHECK_EQ(r.getRRPV(0, 3), 3);
+    CHECK_EQ(r.getRRPV(1, 0), 2);
+    CHECK_EQ(r.victim(0), 1);
+
+    // A hit in the aged set after the search sees the aging first
+    CountingRNG rng2;
+    TestRRIP h;
+    h.init(4, 4, 2, TestRRIP::Insertion::Static, 32, &rng2);
+    for (uint64_t w = 0; w < 4; w++)
+        replaceLine(h, 0, w);
+    CHECK_EQ(h.victim(0), 0);
+    h.touch(0, 3);
+    CHECK_EQ(h.getRRPV(0, 3), 0);
+    CHECK_EQ(h.getRRPV(0, 0), 3);
+    CHECK_EQ(h.victim(0), 0);
+}
+
+static void testBRRIP() {
+    CountingRNG rng;
+    TestRRIP r;
+    r.init(4, 4, 2, TestRRIP::Insertion::Bimodal, 4, &rng);
+
+    // Every fourth insertion is long, the rest are distant
+    for (uint64_t w = 0; w < 4; w++)
+        replaceLine(r, 0, w);
+    CHECK_EQ(r.getRRPV(0, 0), 3);
+    CHECK_EQ(r.getRRPV(0, 1), 3);
+    CHECK_EQ(r.getRRPV(0, 2), 3);
+    CHECK_EQ(r.getRRPV(0, 3), 2);
+    CHECK_EQ(r.victim(0), 0);
+
+    replaceLine(r, 0, 0);
+    CHECK_EQ(r.getRRPV(0, 0), 3);
+    CHECK_EQ(r.victim(0), 0);
+    r.touch(0, 0);
+    CHECK_EQ(r.victim(0), 1);
+}
+
+static void testDRRIPDueling() {
+    CountingRNG rng;
+    TestRRIP r;
+    // Eight sets with two leaders each: sets 0 and 4 lead SRRIP, sets 1 and 5 lead BRRIP
+    r.init(32, 4, 2, TestRRIP::Insertion::Dynamic, 1000, &rng);
+    r.initDueling(8, 2, 2);
+    CHECK_EQ(r.getPSEL(), 1);
+
+    // Followers start on SRRIP
+    replaceLine(r, 2, 0);
+    CHECK_EQ(r.getRRPV(2, 0), 2);
+
+    // Misses in SRRIP leaders move followers to BRRIP, and the selector saturates
+    replaceLine(r, 0, 0);
+    CHECK_EQ(r.getRRPV(0, 0), 2);
+    replaceLine(r, 4, 0);
+    replaceLine(r, 0, 1);
+    CHECK_EQ(r.getPSEL(), 3);
+    replaceLine(r, 2, 1);
+    CHECK_EQ(r.getRRPV(2, 1), 3);
+    CHECK_EQ(r.victim(2), 1);
+
+    // BRRIP leaders insert distant whatever the selector says
+    replaceLine(r, 1, 0);
+    CHECK_EQ(r.getRRPV(1, 0), 3);
+    CHECK_EQ(r.getPSEL(), 2);
+
+    // Misses in BRRIP leaders move followers back to SRRIP
+    replaceLine(r, 5, 0);
+    replaceLine(r, 1, 1);
+    replaceLine(r, 5, 1);
+    CHECK_EQ(r.getPSEL(), 0);
+    replaceLine(r, 3, 0);
+    CHECK_EQ(r.getRRPV(3, 0), 2);
+    CHECK_EQ(r.victim(3), 1);
+}
+
+int main() {
+    testTreePLRU();
+    testSRRIP();
+    testRRIPAgingAcrossInvalidate();
+    testBRRIP();
+    testDRRIPDueling();
+
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("All packed replacement checks passed\n");
+    return 0;
+}
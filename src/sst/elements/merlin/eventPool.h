@@ -0,0 +1,114 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_EVENTPOOL_H
+#define COMPONENTS_MERLIN_EVENTPOOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <new>
+
+namespace SST {
+namespace Merlin {
+
+// Freelists for the events created for every packet and credit
+// return (RtrEvent, internal_router_event and its topology
+// subclasses, credit_event).  The event classes route their
+// operator new/delete here.
+//
+// Blocks are binned by size, so subclasses share the bins of their
+// base class.  Each thread has its own freelists and no locking is
+// done.  An event deleted on a different thread than it was created
+// on (links between partitions) goes to the deleting thread's
+// freelist.  Each bin holds at most max_free blocks per thread, the
+// rest go back to the heap.  Blocks held at exit are not released.
+class EventPool {
+public:
+    static const size_t granularity = 16;
+    // Blocks up to num_bins * granularity bytes are pooled
+    static const size_t num_bins = 16;
+    static const uint32_t max_free = 4096;
+
+    static void* allocate(size_t size) {
+        ThreadPool& pool = local();
+        size_t bin = size == 0 ? 0 : (size - 1) / granularity;
+        if ( bin >= num_bins ) {
+            pool.misses++;
+            return ::operator new(size);
+        }
+
+        FreeBlock* block = pool.free[bin];
+        if ( block != NULL ) {
+            pool.free[bin] = block->next;
+            pool.count[bin]--;
+            pool.hits++;
+            return block;
+        }
+        pool.misses++;
+        return ::operator new((bin + 1) * granularity);
+    }
+
+    static void release(void* ptr, size_t size) {
+        if ( ptr == NULL ) return;
+        ThreadPool& pool = local();
+        size_t bin = size == 0 ? 0 : (size - 1) / granularity;
+        if ( bin >= num_bins || pool.count[bin] >= max_free ) {
+            ::operator delete(ptr);
+            return;
+        }
+
+        FreeBlock* block = static_cast<FreeBlock*>(ptr);
+        block->next = pool.free[bin];
+        pool.free[bin] = block;
+        pool.count[bin]++;
+    }
+
+    // Returns the allocations served from and missed by this thread's
+    // freelists since the last call on this thread
+    static void takeCounts(uint64_t& hits, uint64_t& misses) {
+        ThreadPool& pool = local();
+        hits = pool.hits;
+        misses = pool.misses;
+        pool.hits = 0;
+        pool.misses = 0;
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    // Trivially destructible so it is safe to use while other thread
+    // local objects are being torn down
+    struct ThreadPool {
+        FreeBlock* free[num_bins];
+        uint32_t count[num_bins];
+        uint64_t hits;
+        uint64_t misses;
+    };
+
+    static ThreadPool& local() {
+        static thread_local ThreadPool pool;
+        return pool;
+    }
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_EVENTPOOL_H
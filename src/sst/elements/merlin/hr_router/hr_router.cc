@@ -109,6 +109,7 @@ hr_router::~hr_router()
     delete [] in_port_busy;
     delete [] out_port_busy;
     delete [] progress_vcs;
+    delete [] fast_forward_count;
 
     for ( int i = 0 ; i < num_ports ; i++ ) {
         delete ports[i];
@@ -234,6 +235,9 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
     bool oql_track_port = params.find<bool>("oql_track_port","false");
     bool oql_track_remote = params.find<bool>("oql_track_remote","false");
 
+    fast_forward = params.find<bool>("fast_forward",false);
+    fast_forward_threshold = params.find<int>("fast_forward_threshold",0);
+
     params.enableVerify(false);
 
     Params pc_params = params.find_prefix_params("portcontrol:");
@@ -316,6 +320,18 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
         port_name = port_name + std::to_string(i);
         xbar_stalls[i] = registerStatistic<uint64_t>("xbar_stalls",port_name);
     }
+    event_pool_hits = registerStatistic<uint64_t>("event_pool_hits");
+    event_pool_misses = registerStatistic<uint64_t>("event_pool_misses");
+
+    fast_forward_count = NULL;
+    if ( fast_forward ) {
+        fast_forward_count = new Statistic<uint64_t>*[num_ports];
+        for ( int i = 0; i < num_ports; i++ ) {
+            std::string port_name("port");
+            port_name = port_name + std::to_string(i);
+            fast_forward_count[i] = registerStatistic<uint64_t>("fast_forward_count",port_name);
+        }
+    }
 
     init_vcs();
 }
@@ -468,6 +484,63 @@ hr_router::clock_handler(Cycle_t cycle)
     return false;
 }
 
+// Approximation for lightly loaded networks: an event that arrives
+// while (almost) nothing is queued in the router and whose output has
+// an empty queue and buffer space is handed straight to the output
+// port.  It skips waiting for the next crossbar cycle and arbitration,
+// and the router clock stays off if it was off.  The input port
+// returns the credits right away, as if recv() had been called.
+bool
+hr_router::fastForward(int port, int in_vc, internal_router_event* ev)
+{
+    if ( !fast_forward ) return false;
+
+    // Fall back to full modeling once there is contention to model
+    if ( vcs_with_data > fast_forward_threshold ) return false;
+
+    // Adaptive and non-minimal algorithms pick the output in
+    // reroute(), which clock_handler() calls for every VC head.  If
+    // the event ends up queued after all, it is rerouted again there,
+    // just as it would have been as a VC head.
+    topo->reroute(port, in_vc, ev);
+
+    int next_port = ev->getNextPort();
+    int vc = ev->getVC();
+
+    // Busy counts are only kept up to date while the clock is on
+#if VERIFY_DECLOCKING
+    bool clocked = clocking;
+#else
+    bool clocked = !getRequestNotifyOnEvent();
+#endif
+    if ( clocked && (in_port_busy[port] > 0 || out_port_busy[next_port] > 0) ) return false;
+
+    if ( output_queue_lengths[next_port * num_vcs + vc] != 0 ) return false;
+    if ( !ports[next_port]->spaceToSend(vc, ev->getFlitCount()) ) return false;
+
+    if ( clocked ) {
+        in_port_busy[port] = ev->getFlitCount();
+        out_port_busy[next_port] = ev->getFlitCount();
+    }
+    ports[next_port]->send(ev,vc);
+    fast_forward_count[port]->addData(1);
+
+    if ( ev->getTraceType() == SimpleNetwork::Request::FULL ) {
+        output.output("TRACE(%d): %" PRIu64 " ns: Fast forwarding event (src = %d, dest = %d) "
+                      "in router %d (%s) from port %d to port %d, VC %d.\n",
+                      ev->getTraceID(),
+                      getCurrentSimTimeNano(),
+                      ev->getSrc(),
+                      ev->getDest(),
+                      id,
+                      getName().c_str(),
+                      port,
+                      next_port,
+                      vc);
+    }
+    return true;
+}
+
 void hr_router::setup()
 {
     for ( int i = 0; i < num_ports; i++ ) {
@@ -481,6 +554,11 @@ void hr_router::finish()
     	ports[i]->finish();
     }
 
+    uint64_t hits, misses;
+    EventPool::takeCounts(hits, misses);
+    event_pool_hits->addData(hits);
+    event_pool_misses->addData(misses);
+
 }
 
 void
@@ -67,6 +67,8 @@ public:
         {"num_vns",            "Number of VNs.","2"},
         {"vn_remap",           "Array that specifies the vn remapping for each node in the systsm."},
         {"vn_remap_shm",       "Name of shared memory region for vn remapping.  If empty, no remapping is done", ""},
+        {"fast_forward",       "Set to true to move packets that arrive at an idle router straight to their output port, skipping input queueing and crossbar arbitration.  Approximates timing at low load.", "false"},
+        {"fast_forward_threshold", "Number of occupied input VCs in the router above which fast_forward falls back to full modeling.", "0"},
         {"debug",              "Turn on debugging for router. Set to 1 for on, 0 for off.", "0"}
     )
 
@@ -76,7 +78,10 @@ public:
         { "output_port_stalls", "Time output port is stalled (in units of core timebase)", "time in stalls", 1},
         { "xbar_stalls",        "Count number of cycles the xbar is stalled", "cycles", 1},
         { "idle_time",          "Amount of time spent idle for a given port", "units of core timebase", 1},
-        { "width_adj_count",    "Number of times that link width was increased or decreased", "width adjustment count", 1}
+        { "width_adj_count",    "Number of times that link width was increased or decreased", "width adjustment count", 1},
+        { "fast_forward_count", "Number of packets received on a port that skipped crossbar arbitration (fast_forward)", "packets", 1},
+        { "event_pool_hits",    "Network events allocated from the event freelists.  Each router reports the allocations made on its thread since the previous report, so the sum over all routers is the total", "events", 1},
+        { "event_pool_misses",  "Network events allocated from the heap because the event freelists were empty.  Summed over routers like event_pool_hits", "events", 1}
     )
 
     SST_ELI_DOCUMENT_PORTS(
@@ -116,6 +121,9 @@ private:
     int* out_port_busy;
     int* progress_vcs;
 
+    bool fast_forward;
+    int fast_forward_threshold;
+
     /* int input_buf_size; */
     /* int output_buf_size; */
     UnitAlgebra input_buf_size;
@@ -134,6 +142,9 @@ private:
 
     void init_vcs();
     Statistic<uint64_t>** xbar_stalls;
+    Statistic<uint64_t>** fast_forward_count;
+    Statistic<uint64_t>* event_pool_hits;
+    Statistic<uint64_t>* event_pool_misses;
 
     Output& output;
 
@@ -149,6 +160,7 @@ public:
     void notifyEvent();
     int const* getOutputBufferCredits() {return xbar_in_credits;}
     int const* getOutputQueueLengths() {return output_queue_lengths;}
+    bool fastForward(int port, int vc, internal_router_event* ev);
 
     void sendTopologyEvent(int port, TopologyEvent* ev);
     void recvTopologyEvent(int port, TopologyEvent* ev);
@@ -0,0 +1,260 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_HR_ROUTER_VC_ARBITER_H
+#define COMPONENTS_HR_ROUTER_VC_ARBITER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+
+namespace SST {
+namespace Merlin {
+
+/*
+ * Crossbar arbiters that make exactly the grants xbar_arb_lru and
+ * xbar_arb_rr make, but find the occupied VCs through the VC occupancy
+ * mask each port keeps instead of reading every VC head.
+ *
+ * LRU: (port, VC) pairs are visited in priority order.  Granted pairs
+ * move to the bottom of the list, the first one granted last, and the
+ * rest keep their order.  The list is kept in a ring twice its size or
+ * more: a granted pair leaves a hole and is appended at the tail, and
+ * the ring is compacted only when the tail catches up with the head.
+ * The slot of every pair is tracked, so the occupied VCs of idle ports
+ * are marked in a bitmask by distance from the head and only those are
+ * visited.
+ *
+ * RR: ports are visited starting from a pointer that advances every
+ * cycle.  Each idle port takes the first occupied VC from its own
+ * pointer that can move, and the VC pointer of every idle port advances
+ * by one.
+ *
+ * The arbiters have no dependencies on SST so they can be benchmarked
+ * stand alone.  PortT must provide getVCHeads(), getVCOccupancy() and
+ * spaceToSend(vc,flits); EventT must provide getNextPort(), getVC() and
+ * getFlitCount().
+ */
+template <class PortT, class EventT>
+class VCArbiter {
+
+public:
+    enum Policy { LRU, RR };
+
+    VCArbiter() : num_ports(0), num_vcs(0), vc_mask(0), policy(LRU), ring_mask(0), head(0), tail(0), rr_port(0) {}
+
+    // Returns false if the number of VCs is more than a mask can hold
+    bool init(int num_ports_s, int num_vcs_s, Policy policy_s) {
+        if ( num_vcs_s > 64 ) return false;
+
+        num_ports = num_ports_s;
+        num_vcs = num_vcs_s;
+        policy = policy_s;
+        vc_mask = (num_vcs == 64) ? ~(uint64_t)0 : ((uint64_t)1 << num_vcs) - 1;
+
+        int total_entries = num_ports * num_vcs;
+        uint32_t ring_size = 64;
+        while ( ring_size < 2 * (uint32_t)total_entries ) ring_size *= 2;
+        ring_mask = ring_size - 1;
+
+        order.assign(ring_size, HOLE);
+        position.resize(total_entries);
+        for ( int i = 0; i < num_ports; i++ ) {
+            for ( int j = 0; j < num_vcs; j++ ) {
+                order[i * num_vcs + j] = (i << 6) | j;
+                position[i * num_vcs + j] = i * num_vcs + j;
+            }
+        }
+        head = 0;
+        tail = total_entries;
+        candidates.assign(ring_size / 64, 0);
+        granted.resize(num_ports);
+        heads.assign(num_ports, NULL);
+
+        rr_port = 0;
+        rr_vcs.assign(num_ports, 0);
+        return true;
+    }
+
+    // Same interface and progress_vc encoding as XbarArbitration::arbitrate()
+    void arbitrate(PortT** ports, int* in_port_busy, int* out_port_busy, int* progress_vc) {
+        if ( policy == LRU ) arbitrateLRU(ports, in_port_busy, out_port_busy, progress_vc);
+        else arbitrateRR(ports, in_port_busy, out_port_busy, progress_vc);
+    }
+
+    void reportSkippedCycles(uint64_t cycles) {
+        if ( policy == RR ) rr_port = (rr_port + cycles) % num_ports;
+    }
+
+    int getNumPorts() const { return num_ports; }
+    int getRRPort() const { return rr_port; }
+    int getRRVC(int port) const { return rr_vcs[port]; }
+
+private:
+    enum { HOLE = -1 };
+
+    int num_ports;
+    int num_vcs;
+    uint64_t vc_mask;
+    Policy policy;
+
+    // LRU priority list of (port, VC) pairs, as port << 6 | vc.  Slots
+    // are counted from 0 and wrap, [head, tail) is the list.
+    std::vector<int> order;             // Ring, highest priority at head
+    uint32_t ring_mask;
+    uint32_t head;
+    uint32_t tail;
+    std::vector<uint32_t> position;     // Slot of each pair, by port * num_vcs + vc
+    std::vector<uint64_t> candidates;   // VCs to visit, by distance from head
+    std::vector<int> granted;           // Pairs granted this cycle, in grant order
+    std::vector<EventT**> heads;
+
+    int rr_port;
+    std::vector<int> rr_vcs;
+
+    // Try to move ev from port to its next port, as the list arbiters do
+    bool grant(PortT** ports, int* in_port_busy, int* out_port_busy, int port, EventT* ev) {
+        int next_port = ev->getNextPort();
+        if ( out_port_busy[next_port] > 0 ||
+             !ports[next_port]->spaceToSend(ev->getVC(), ev->getFlitCount()) ) {
+            return false;
+        }
+        in_port_busy[port] = ev->getFlitCount();
+        out_port_busy[next_port] = ev->getFlitCount();
+        return true;
+    }
+
+    uint32_t& positionOf(int entry) {
+        return position[(entry >> 6) * num_vcs + (entry & 63)];
+    }
+
+    // Squeeze the holes out of the list, keeping its order
+    void compact() {
+        uint32_t to = head;
+        for ( uint32_t from = head; from != tail; from++ ) {
+            int entry = order[from & ring_mask];
+            if ( entry == HOLE ) continue;
+            order[to & ring_mask] = entry;
+            positionOf(entry) = to;
+            to++;
+        }
+        tail = to;
+    }
+
+    void arbitrateLRU(PortT** ports, int* in_port_busy, int* out_port_busy, int* progress_vc) {
+        uint32_t words = 0;
+        for ( int port = 0; port < num_ports; port++ ) {
+            progress_vc[port] = -1;
+            if ( in_port_busy[port] > 0 ) continue;
+
+            uint64_t occupancy = ports[port]->getVCOccupancy() & vc_mask;
+            if ( !occupancy ) continue;
+
+            EventT** vc_heads = ports[port]->getVCHeads();
+            heads[port] = vc_heads;
+            const uint32_t* pos = &position[port * num_vcs];
+            while ( occupancy ) {
+                int vc = __builtin_ctzll(occupancy);
+                occupancy &= occupancy - 1;
+
+                EventT* src_event = vc_heads[vc];
+                if ( src_event == NULL ) continue;
+
+                // Stalled unless granted below.  Outputs only get busier
+                // during arbitration, so VCs whose output is busy now are
+                // left out of the walk.
+                progress_vc[port] = -2;
+                uint64_t ready = out_port_busy[src_event->getNextPort()] <= 0;
+
+                uint32_t distance = pos[vc] - head;
+                candidates[distance / 64] |= ready << (distance % 64);
+                words = std::max(words, distance / 64 + 1);
+            }
+        }
+
+        int num_granted = 0;
+        for ( uint32_t w = 0; w < words; w++ ) {
+            uint64_t bits = candidates[w];
+            candidates[w] = 0;
+            while ( bits ) {
+                uint32_t slot = (head + w * 64 + __builtin_ctzll(bits)) & ring_mask;
+                bits &= bits - 1;
+
+                int entry = order[slot];
+                int port = entry >> 6;
+                int vc = entry & 63;
+
+                // Granted earlier this cycle
+                if ( in_port_busy[port] > 0 ) continue;
+
+                if ( grant(ports, in_port_busy, out_port_busy, port, heads[port][vc]) ) {
+                    progress_vc[port] = vc;
+                    granted[num_granted++] = entry;
+                    order[slot] = HOLE;
+                }
+            }
+        }
+
+        if ( num_granted == 0 ) return;
+
+        // Granted pairs go to the bottom, the first one granted last
+        while ( order[head & ring_mask] == HOLE ) head++;
+        if ( tail - head + num_granted > ring_mask + 1 ) compact();
+        for ( int i = num_granted - 1; i >= 0; i-- ) {
+            order[tail & ring_mask] = granted[i];
+            positionOf(granted[i]) = tail;
+            tail++;
+        }
+    }
+
+    void arbitrateRR(PortT** ports, int* in_port_busy, int* out_port_busy, int* progress_vc) {
+        for ( int port = rr_port, pcount = 0; pcount < num_ports; port = ((port != num_ports-1) ? port+1 : 0), pcount++ ) {
+
+            progress_vc[port] = -1;
+            if ( in_port_busy[port] > 0 ) continue;
+
+            uint64_t occupancy = ports[port]->getVCOccupancy() & vc_mask;
+            int first = rr_vcs[port];
+            rr_vcs[port] = (first + 1 == num_vcs) ? 0 : first + 1;
+            if ( !occupancy ) continue;
+
+            // Rotate so the VC at the pointer is bit 0
+            uint64_t rotated = occupancy >> first;
+            if ( first != 0 ) rotated |= (occupancy << (num_vcs - first)) & vc_mask;
+
+            EventT** vc_heads = ports[port]->getVCHeads();
+            while ( rotated ) {
+                int vc = first + __builtin_ctzll(rotated);
+                if ( vc >= num_vcs ) vc -= num_vcs;
+                rotated &= rotated - 1;
+
+                EventT* src_event = vc_heads[vc];
+                if ( src_event == NULL ) continue;
+                if ( grant(ports, in_port_busy, out_port_busy, port, src_event) ) {
+                    progress_vc[port] = vc;
+                    break;
+                }
+            }
+        }
+        rr_port = (rr_port + 1 == num_ports) ? 0 : rr_port + 1;
+    }
+};
+
+}
+}
+
+#endif // COMPONENTS_HR_ROUTER_VC_ARBITER_H
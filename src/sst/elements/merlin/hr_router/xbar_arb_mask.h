@@ -0,0 +1,120 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_HR_ROUTER_XBAR_ARB_MASK_H
+#define COMPONENTS_HR_ROUTER_XBAR_ARB_MASK_H
+
+#include <sst/core/component.h>
+
+#include "sst/elements/merlin/merlin.h"
+#include "sst/elements/merlin/router.h"
+#include "sst/elements/merlin/hr_router/vc_arbiter.h"
+
+namespace SST {
+namespace Merlin {
+
+// Crossbar arbitration using the bitmask arbiter in vc_arbiter.h.  Grants
+// are identical to xbar_arb_lru / xbar_arb_rr.
+class xbar_arb_mask : public XbarArbitration {
+
+private:
+    typedef VCArbiter<PortInterface,internal_router_event> Arbiter;
+
+    Arbiter arbiter;
+    Arbiter::Policy policy;
+
+public:
+
+    xbar_arb_mask(ComponentId_t cid, Arbiter::Policy policy) :
+        XbarArbitration(cid),
+        policy(policy)
+    {
+    }
+
+    ~xbar_arb_mask() {
+    }
+
+    void setPorts(int num_ports, int num_vcs) {
+        if ( !arbiter.init(num_ports, num_vcs, policy) ) {
+            merlin_abort.fatal(CALL_INFO, -1, "xbar_arb_mask supports at most 64 VCs per port, %d requested\n", num_vcs);
+        }
+    }
+
+    void arbitrate(
+#if VERIFY_DECLOCKING
+                   PortInterface** ports, int* in_port_busy, int* out_port_busy, int* progress_vc, bool clocking
+#else
+                   PortInterface** ports, int* in_port_busy, int* out_port_busy, int* progress_vc
+#endif
+                   )
+    {
+        arbiter.arbitrate(ports, in_port_busy, out_port_busy, progress_vc);
+    }
+
+    void reportSkippedCycles(Cycle_t cycles) {
+        arbiter.reportSkippedCycles(cycles);
+    }
+
+    void dumpState(std::ostream& stream) {
+        if ( policy != Arbiter::RR ) return;
+        stream << "Current round robin port: " << arbiter.getRRPort() << std::endl;
+        stream << "  Current round robin VC by port:" << std::endl;
+        for ( int i = 0; i < arbiter.getNumPorts(); i++ ) {
+            stream << i << ": " << arbiter.getRRVC(i) << std::endl;
+        }
+    }
+};
+
+class xbar_arb_lru_mask : public xbar_arb_mask {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+        xbar_arb_lru_mask,
+        "merlin",
+        "xbar_arb_lru_mask",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Least recently used arbitration unit for hr_router.  Same grants as xbar_arb_lru, finds waiting VCs through bitmasks",
+        SST::Merlin::XbarArbitration)
+
+    xbar_arb_lru_mask(ComponentId_t cid, Params& params) :
+        xbar_arb_mask(cid, Arbiter::LRU)
+    {
+    }
+};
+
+class xbar_arb_rr_mask : public xbar_arb_mask {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+        xbar_arb_rr_mask,
+        "merlin",
+        "xbar_arb_rr_mask",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Round robin arbitration unit for hr_router.  Same grants as xbar_arb_rr, finds waiting VCs through bitmasks",
+        SST::Merlin::XbarArbitration)
+
+    xbar_arb_rr_mask(ComponentId_t cid, Params& params) :
+        xbar_arb_mask(cid, Arbiter::RR)
+    {
+    }
+};
+
+}
+}
+
+#endif // COMPONENTS_HR_ROUTER_XBAR_ARB_MASK_H
@@ -112,12 +112,27 @@ PortControl::recv(int vc)
 	// Need to update vc_heads
 	if ( input_buf[vc].empty() ) {
 	    vc_heads[vc] = NULL;
+	    if ( vc < 64 ) vc_occupancy &= ~((uint64_t)1 << vc);
 	    parent->dec_vcs_with_data();
 	}
 	else {
 	    vc_heads[vc] = input_buf[vc].front();
 	}
 	
+    returnCredits(event, vc);
+    
+#if TRACK
+    if ( rtr_id == TRACK_ID && port_number == TRACK_PORT ) {
+        // std::cout << "recv start:" << std::endl;
+        printStatus(Simulation::getSimulation()->getSimulationOutput(),0,0);
+    }
+#endif
+    return event;
+}
+
+void
+PortControl::returnCredits(internal_router_event* event, int vc)
+{
     int vc_return = topo->isHostPort(port_number) ? event->getCreditReturnVC() : vc;
 	// Figure out how many credits to return
 	port_ret_credits[vc_return] += event->getFlitCount();
@@ -127,14 +142,6 @@ PortControl::recv(int vc)
 	// into account.
 	port_link->send(1,new credit_event(vc_return,port_ret_credits[vc_return])); 
 	port_ret_credits[vc_return] = 0;
-    
-#if TRACK
-    if ( rtr_id == TRACK_ID && port_number == TRACK_PORT ) {
-        // std::cout << "recv start:" << std::endl;
-        printStatus(Simulation::getSimulation()->getSimulationOutput(),0,0);
-    }
-#endif
-    return event;
 }
 
 
@@ -340,6 +347,7 @@ void
 PortControl::initVCs(int vns, int* vcs_per_vn, internal_router_event** vc_heads_in, int* xbar_in_credits_in, int* output_queue_lengths_in)
 {
     vc_heads = vc_heads_in;
+    vc_occupancy = 0;
     num_vns = vns;
     
     // num_vcs = vcs;
@@ -823,12 +831,21 @@ PortControl::handle_input_n2r(Event* ev)
         rtr_event->setCreditReturnVC(vn);
         int curr_vc = rtr_event->getVC();
 	    topo->route(port_number, rtr_event->getVC(), rtr_event);
+
+        // Nothing ahead of it on this VC, see if the router will
+        // move it without queueing
+        if ( vc_heads[curr_vc] == NULL && parent->fastForward(port_number, curr_vc, rtr_event) ) {
+            returnCredits(rtr_event, curr_vc);
+            break;
+        }
+
 	    input_buf[curr_vc].push(rtr_event);
 	    input_buf_count[curr_vc]++;
 
 	    // If this becomes vc_head we need to put it into the vc_heads array
 	    if ( vc_heads[curr_vc] == NULL ) {
             vc_heads[curr_vc] = rtr_event;
+            if ( curr_vc < 64 ) vc_occupancy |= (uint64_t)1 << curr_vc;
             parent->inc_vcs_with_data();
 	    }
 	    
@@ -911,6 +928,12 @@ PortControl::handle_input_r2r(Event* ev)
 	    // Need to do the routing
 	    int curr_vc = event->getVC();
 	    topo->route(port_number, event->getVC(), event);
+
+        if ( vc_heads[curr_vc] == NULL && parent->fastForward(port_number, curr_vc, event) ) {
+            returnCredits(event, curr_vc);
+            break;
+        }
+
 	    input_buf[curr_vc].push(event);
 	    input_buf_count[curr_vc]++;
         
@@ -918,6 +941,7 @@ PortControl::handle_input_r2r(Event* ev)
 	    // in the array) we need to put it into the vc_heads array
 	    if ( vc_heads[curr_vc] == NULL ) {
             vc_heads[curr_vc] = event;
+            if ( curr_vc < 64 ) vc_occupancy |= (uint64_t)1 << curr_vc;
             parent->inc_vcs_with_data();
 	    }
         // std::cout << "Got to here 3" << std::endl; 
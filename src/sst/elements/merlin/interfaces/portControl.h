@@ -148,6 +148,8 @@ private:
     // head of each of its VC queues into a single array to speed
     // things up.  This is an array passed into the constructor.
     internal_router_event** vc_heads;
+    // Bit per VC with a non-NULL vc_heads entry, if num_vcs <= 64
+    uint64_t vc_occupancy;
 
     int* input_buf_count;
     int* output_buf_count;
@@ -253,6 +255,9 @@ public:
     internal_router_event** getVCHeads() {
     	return vc_heads;
     }
+    uint64_t getVCOccupancy() {
+        return num_vcs <= 64 ? vc_occupancy : ~(uint64_t)0;
+    }
 
     // time_base is a frequency which represents the bandwidth of the link in flits/second.
     PortControl(ComponentId_t cid, Params& params, Router* rif, int rtr_id, int port_number, Topology *topo);
@@ -289,6 +294,7 @@ private:
     void handle_input_n2r(Event* ev);
     void handle_input_r2r(Event* ev);
     void handle_output(Event* ev);
+    void returnCredits(internal_router_event* event, int vc);
 	void handleSAIWindow(Event* ev);
 	void reenablePort(Event* ev);
 
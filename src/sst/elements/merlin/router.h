@@ -29,6 +29,8 @@
 
 #include <queue>
 
+#include "sst/elements/merlin/eventPool.h"
+
 namespace SST {
 namespace Merlin {
 
@@ -37,6 +39,7 @@ namespace Merlin {
 const int INIT_BROADCAST_ADDR = -1;
 
 class TopologyEvent;
+class internal_router_event;
     
 class Router : public Component {
 private:
@@ -73,6 +76,11 @@ public:
     inline int get_vcs_with_data() { return vcs_with_data; }
 
     virtual int const* getOutputBufferCredits() = 0;
+    // Called by a port for an event that arrived on an empty input
+    // VC, after route().  If the router takes the event it moves it
+    // straight to its output port and returns true.  Otherwise the
+    // port queues it as usual.
+    virtual bool fastForward(int port, int vc, internal_router_event* ev) { return false; }
     virtual void sendTopologyEvent(int port, TopologyEvent* ev) = 0;
     virtual void recvTopologyEvent(int port, TopologyEvent* ev) = 0;
 };
@@ -130,6 +138,10 @@ public:
     {
         if (request) delete request;
     }
+
+    // Allocated from EventPool
+    static void* operator new(std::size_t size) { return EventPool::allocate(size); }
+    static void operator delete(void* ptr, std::size_t size) { EventPool::release(ptr, size); }
     
     inline void setInjectionTime(SimTime_t time) {injectionTime = time;}
     // inline void setTraceID(int id) {traceID = id;}
@@ -233,6 +245,10 @@ public:
 	credits(credits)
     {}
 
+    // Allocated from EventPool
+    static void* operator new(std::size_t size) { return EventPool::allocate(size); }
+    static void operator delete(void* ptr, std::size_t size) { EventPool::release(ptr, size); }
+
     virtual void print(const std::string& header, Output &out) const  override {
         out.output("%s credit_event to be delivered at %" PRIu64 " with priority %d\n",
                 header.c_str(), getDeliveryTime(), getPriority());
@@ -306,6 +322,10 @@ public:
         if ( encap_ev != NULL ) delete encap_ev;
     }
 
+    // Allocated from EventPool
+    static void* operator new(std::size_t size) { return EventPool::allocate(size); }
+    static void operator delete(void* ptr, std::size_t size) { EventPool::release(ptr, size); }
+
     virtual internal_router_event* clone(void) override
     {
         return new internal_router_event(*this);
@@ -427,6 +447,9 @@ public:
     // the next event.
     virtual internal_router_event* recv(int vc) = 0;
     virtual internal_router_event** getVCHeads() = 0;
+    // Bit vc is set if VC vc (for VCs below 64) may have an event at
+    // its head.  Ports that don't track this report every VC.
+    virtual uint64_t getVCOccupancy() { return ~(uint64_t)0; }
     
     // time_base is a frequency which represents the bandwidth of the link in flits/second.
     PortInterface(ComponentId_t cid) :
@@ -0,0 +1,154 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+//
+#include <sst_config.h>
+#include "sst/elements/merlin/test/route_bench/route_bench.h"
+
+#include <chrono>
+
+#include <sst/core/params.h>
+#include <sst/core/interfaces/simpleNetwork.h>
+
+#include "sst/elements/merlin/router.h"
+
+namespace SST {
+using namespace SST::Interfaces;
+
+namespace Merlin {
+
+
+route_bench::route_bench(ComponentId_t cid, Params& params) :
+    Component(cid),
+    out("", 0, 0, Output::STDOUT)
+{
+    std::string topology = params.find<std::string>("topology");
+    if ( topology == "" ) {
+        out.fatal(CALL_INFO, -1, "route_bench requires the topology parameter to be specified\n");
+    }
+
+    num_peers = params.find<int>("num_peers", -1);
+    num_ports = params.find<int>("num_ports", -1);
+    if ( num_peers <= 0 || num_ports <= 0 ) {
+        out.fatal(CALL_INFO, -1, "route_bench requires num_peers and num_ports to be specified\n");
+    }
+    id = params.find<int>("id", 0);
+    iterations = params.find<uint64_t>("iterations", 1000);
+
+    Params topo_params = params.find_prefix_params("topology.");
+
+    topo_params.insert("route_table", "false");
+    topo_arith = loadAnonymousSubComponent<Topology>(topology, "topology", 0, ComponentInfo::SHARE_NONE,
+                                                     topo_params, num_ports, id);
+
+    topo_params.insert("route_table", "true");
+    topo_table = loadAnonymousSubComponent<Topology>(topology, "topology", 1, ComponentInfo::SHARE_NONE,
+                                                     topo_params, num_ports, id);
+
+    if ( !topo_arith || !topo_table ) {
+        out.fatal(CALL_INFO, -1, "route_bench unable to load topology %s\n", topology.c_str());
+    }
+}
+
+
+route_bench::~route_bench()
+{
+    delete topo_arith;
+    delete topo_table;
+}
+
+
+void
+route_bench::makeEvents(Topology* topo, int port, std::vector<internal_router_event*>& events)
+{
+    int src = topo->getEndpointID(port);
+    for ( int dest = 0; dest < num_peers; dest++ ) {
+        SimpleNetwork::Request* req = new SimpleNetwork::Request(dest, src, 64, true, true);
+        events.push_back(topo->process_input(new RtrEvent(req, src, 0)));
+    }
+}
+
+
+double
+route_bench::timeRoutes(Topology* topo, int port, std::vector<internal_router_event*>& events)
+{
+    std::vector<int> vcs;
+    for ( size_t i = 0; i < events.size(); i++ ) {
+        vcs.push_back(events[i]->getVC());
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for ( uint64_t n = 0; n < iterations; n++ ) {
+        for ( size_t i = 0; i < events.size(); i++ ) {
+            topo->route(port, vcs[i], events[i]);
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return elapsed.count();
+}
+
+
+// Shared regions some topologies route with are only complete after
+// init, so all of the work is done here
+void route_bench::setup()
+{
+    int port = -1;
+    for ( int p = 0; p < num_ports; p++ ) {
+        if ( topo_arith->getPortState(p) == Topology::R2N ) {
+            port = p;
+            break;
+        }
+    }
+    if ( port == -1 ) {
+        out.fatal(CALL_INFO, -1, "route_bench: router %d has no host ports\n", id);
+    }
+
+    std::vector<internal_router_event*> arith_events;
+    std::vector<internal_router_event*> table_events;
+    makeEvents(topo_arith, port, arith_events);
+    makeEvents(topo_table, port, table_events);
+
+    for ( int dest = 0; dest < num_peers; dest++ ) {
+        int vc_arith = arith_events[dest]->getVC();
+        int vc_table = table_events[dest]->getVC();
+        topo_arith->route(port, vc_arith, arith_events[dest]);
+        topo_table->route(port, vc_table, table_events[dest]);
+        if ( arith_events[dest]->getNextPort() != table_events[dest]->getNextPort() ||
+             arith_events[dest]->getVC() != table_events[dest]->getVC() ) {
+            out.fatal(CALL_INFO, -1, "route_bench: route to %d differs, port %d vc %d without table, port %d vc %d with table\n",
+                      dest, arith_events[dest]->getNextPort(), arith_events[dest]->getVC(),
+                      table_events[dest]->getNextPort(), table_events[dest]->getVC());
+        }
+    }
+
+    double arith_time = timeRoutes(topo_arith, port, arith_events);
+    double table_time = timeRoutes(topo_table, port, table_events);
+    double routes = (double)iterations * num_peers;
+
+    out.output("route_bench: %d endpoints, %" PRIu64 " iterations from router %d port %d\n",
+               num_peers, iterations, id, port);
+    out.output("  computed:    %.3f s, %.3e routes/s\n", arith_time, routes / arith_time);
+    out.output("  route_table: %.3f s, %.3e routes/s\n", table_time, routes / table_time);
+
+    for ( size_t i = 0; i < arith_events.size(); i++ ) {
+        delete arith_events[i];
+        delete table_events[i];
+    }
+}
+
+
+} // namespace Merlin
+} // namespace SST
+
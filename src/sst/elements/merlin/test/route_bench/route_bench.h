@@ -0,0 +1,90 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_TEST_ROUTE_BENCH_H
+#define COMPONENTS_MERLIN_TEST_ROUTE_BENCH_H
+
+#include <sst/core/component.h>
+#include <sst/core/output.h>
+
+#include <vector>
+
+namespace SST {
+namespace Merlin {
+
+class Topology;
+class internal_router_event;
+
+/*
+ * Micro-benchmark for Topology::route().  Loads two copies of a topology
+ * for a single router, one computing routes arithmetically and one with
+ * route_table enabled, checks that both pick the same next hop and VC for
+ * every endpoint and reports how many routes per second each one does.
+ * No links are needed, so the benchmark can be run as the only component
+ * in a simulation.
+ */
+class route_bench : public Component {
+
+public:
+
+    SST_ELI_REGISTER_COMPONENT(
+        route_bench,
+        "merlin",
+        "route_bench",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Measures the host time spent in a topology's route function, with and without route tables.",
+        COMPONENT_CATEGORY_NETWORK)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"topology",   "Topology to benchmark, e.g., merlin.torus.  Parameters for the topology are given with the prefix 'topology.'"},
+        {"num_ports",  "Number of ports on the router."},
+        {"id",         "ID of the router to route from.", "0"},
+        {"num_peers",  "Total number of endpoints in network."},
+        {"iterations", "Number of times to route a packet to every endpoint.", "1000"}
+    )
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
+        {"topology", "Topology instances under test, loaded anonymously", "SST::Merlin::Topology" }
+    )
+
+private:
+
+    Output out;
+    int num_peers;
+    int num_ports;
+    int id;
+    uint64_t iterations;
+
+    Topology* topo_arith;
+    Topology* topo_table;
+
+public:
+    route_bench(ComponentId_t cid, Params& params);
+    ~route_bench();
+
+    void setup();
+
+private:
+    void makeEvents(Topology* topo, int port, std::vector<internal_router_event*>& events);
+    double timeRoutes(Topology* topo, int port, std::vector<internal_router_event*>& events);
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_TEST_ROUTE_BENCH_H
@@ -0,0 +1,367 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Stand alone benchmark for the crossbar arbiters in hr_router/vc_arbiter.h.
+ * Does not need SST to build or run:
+ *
+ *   g++ -O2 -std=c++11 -I<sst-elements>/src xbar_arb_bench.cc -o xbar_arb_bench
+ *   ./xbar_arb_bench [cycles]
+ *
+ * Each configuration drives routers of 16, 32, 64 and 128 ports with
+ * synthetic VC occupancy and compares the bitmask arbiters against copies
+ * of the xbar_arb_lru and xbar_arb_rr algorithms.  Every grant is checked
+ * for conflicts, and the bitmask arbiters must make the same grants as the
+ * copies every cycle.  Reported are host ns per arbitration and packets
+ * moved per cycle.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <chrono>
+#include <vector>
+
+#include "sst/elements/merlin/hr_router/vc_arbiter.h"
+
+using namespace SST::Merlin;
+
+namespace {
+
+class BenchEvent {
+public:
+    int next_port;
+    int next_vc;
+    int flits;
+
+    int getNextPort() const { return next_port; }
+    int getVC() const { return next_vc; }
+    int getFlitCount() const { return flits; }
+};
+
+// Calls are virtual, as they are through PortInterface in hr_router
+class BenchPortInterface {
+public:
+    virtual ~BenchPortInterface() {}
+    virtual BenchEvent** getVCHeads() = 0;
+    virtual uint64_t getVCOccupancy() = 0;
+    virtual bool spaceToSend(int vc, int flits) = 0;
+};
+
+class BenchPort : public BenchPortInterface {
+public:
+    std::vector<BenchEvent*> heads;
+    std::vector<BenchEvent> slots;
+    uint64_t occupancy;     // Kept up to date with heads, as PortControl does
+    int credit_block;   // Refuse space one call in credit_block, 0 to never refuse
+    uint32_t calls;
+
+    BenchEvent** getVCHeads() { return &heads[0]; }
+    uint64_t getVCOccupancy() { return occupancy; }
+    bool spaceToSend(int, int) {
+        calls++;
+        return credit_block == 0 || (calls % credit_block) != 0;
+    }
+};
+
+// Same algorithm as xbar_arb_lru
+class ListLRU {
+public:
+    typedef std::pair<uint16_t,uint16_t> priority_entry_t;
+    std::vector<priority_entry_t> cur_list;
+    std::vector<priority_entry_t> next_list;
+    int num_ports;
+    int num_vcs;
+
+    void init(int ports, int vcs) {
+        num_ports = ports;
+        num_vcs = vcs;
+        for ( int i = 0; i < ports; i++ ) {
+            for ( int j = 0; j < vcs; j++ ) {
+                cur_list.push_back(priority_entry_t(i,j));
+            }
+        }
+        next_list.resize(cur_list.size());
+    }
+
+    void arbitrate(BenchPortInterface** ports, int* in_port_busy, int* out_port_busy, int* progress_vc) {
+        for ( int i = 0; i < num_ports; i++ ) progress_vc[i] = -1;
+        int total_entries = cur_list.size();
+        priority_entry_t* sat_list = &next_list[total_entries-1];
+        priority_entry_t* unsat_list = &next_list[0];
+
+        for ( int i = 0; i < total_entries; i++ ) {
+            const priority_entry_t& check = cur_list[i];
+            int port = check.first;
+            int vc = check.second;
+            BenchEvent* src_event = ports[port]->getVCHeads()[vc];
+            if ( in_port_busy[port] <= 0 && src_event != NULL ) {
+                int next_port = src_event->getNextPort();
+                if ( out_port_busy[next_port] <= 0 &&
+                     ports[next_port]->spaceToSend(src_event->getVC(), src_event->getFlitCount()) ) {
+                    progress_vc[port] = vc;
+                    in_port_busy[port] = src_event->getFlitCount();
+                    out_port_busy[next_port] = src_event->getFlitCount();
+                    *sat_list-- = check;
+                }
+                else {
+                    *unsat_list++ = check;
+                    progress_vc[port] = -2;
+                }
+            }
+            else {
+                *unsat_list++ = check;
+            }
+        }
+        cur_list.swap(next_list);
+    }
+};
+
+// Same algorithm as xbar_arb_rr
+class ListRR {
+public:
+    std::vector<int> rr_vcs;
+    int rr_port;
+    int num_ports;
+    int num_vcs;
+
+    void init(int ports, int vcs) {
+        num_ports = ports;
+        num_vcs = vcs;
+        rr_vcs.assign(ports, 0);
+        rr_port = 0;
+    }
+
+    void arbitrate(BenchPortInterface** ports, int* in_port_busy, int* out_port_busy, int* progress_vc) {
+        for ( int port = rr_port, pcount = 0; pcount < num_ports; port = ((port != num_ports-1) ? port+1 : 0), pcount++ ) {
+            BenchEvent** vc_heads = ports[port]->getVCHeads();
+            progress_vc[port] = -1;
+            if ( in_port_busy[port] > 0 ) continue;
+            for ( int vc = rr_vcs[port], vcount = 0; vcount < num_vcs; vc = ((vc != num_vcs-1) ? (vc+1) : 0), vcount++ ) {
+                BenchEvent* src_event = vc_heads[vc];
+                if ( src_event == NULL ) continue;
+                int next_port = src_event->getNextPort();
+                if ( out_port_busy[next_port] > 0 ) continue;
+                if ( !ports[next_port]->spaceToSend(src_event->getVC(), src_event->getFlitCount()) ) continue;
+                progress_vc[port] = vc;
+                in_port_busy[port] = src_event->getFlitCount();
+                out_port_busy[next_port] = src_event->getFlitCount();
+                break;
+            }
+            rr_vcs[port] = (rr_vcs[port] + 1) % num_vcs;
+        }
+        rr_port = (rr_port + 1) % num_ports;
+    }
+};
+
+enum Pattern { UNIFORM, HOTSPOT, PERMUTATION, DRAGONFLY };
+const char* pattern_names[] = { "uniform", "hotspot", "permutation", "dragonfly" };
+
+struct Result {
+    double ns_per_cycle;
+    double moved_per_cycle;
+    std::vector<uint64_t> grants;   // Hash of the grants made each cycle
+};
+
+class Bench {
+public:
+    int num_ports;
+    int num_vcs;
+    Pattern pattern;
+    int load;           // Percent chance an empty VC gets a packet each cycle
+    uint64_t seed;
+
+    std::vector<BenchPort> port_store;
+    std::vector<BenchPortInterface*> ports;
+    std::vector<int> in_port_busy;
+    std::vector<int> out_port_busy;
+    std::vector<int> progress_vc;
+
+    Bench(int num_ports, int num_vcs, Pattern pattern, int load) :
+        num_ports(num_ports), num_vcs(num_vcs), pattern(pattern), load(load), seed(0)
+    {}
+
+    uint32_t rand() {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        return seed >> 32;
+    }
+
+    void reset() {
+        seed = 0x2545F4914F6CDD1DULL;
+        port_store.assign(num_ports, BenchPort());
+        ports.clear();
+        for ( int i = 0; i < num_ports; i++ ) {
+            port_store[i].heads.assign(num_vcs, NULL);
+            port_store[i].slots.resize(num_vcs);
+            port_store[i].credit_block = 7;
+            port_store[i].calls = 0;
+            port_store[i].occupancy = 0;
+            ports.push_back(&port_store[i]);
+        }
+        in_port_busy.assign(num_ports, 0);
+        out_port_busy.assign(num_ports, 0);
+        progress_vc.assign(num_ports, -1);
+    }
+
+    int pickOutput(int port) {
+        switch ( pattern ) {
+        case HOTSPOT:
+            if ( rand() % 4 == 0 ) return rand() % 4;
+            return rand() % num_ports;
+        case PERMUTATION:
+            return (port * 5 + 3) % num_ports;
+        case DRAGONFLY:
+        {
+            // A quarter host ports, half local, a quarter global.
+            // Packets leave through one of the other two kinds.
+            int hosts = num_ports / 4;
+            int locals = num_ports / 2;
+            int globals = num_ports - hosts - locals;
+            int kind = port < hosts ? 0 : (port < hosts + locals ? 1 : 2);
+            int to = (kind + 1 + rand() % 2) % 3;
+            if ( to == 0 ) return rand() % hosts;
+            if ( to == 1 ) return hosts + rand() % locals;
+            return hosts + locals + rand() % globals;
+        }
+        case UNIFORM:
+        default:
+            return rand() % num_ports;
+        }
+    }
+
+    void fill() {
+        for ( int port = 0; port < num_ports; port++ ) {
+            BenchPort& p = port_store[port];
+            for ( int vc = 0; vc < num_vcs; vc++ ) {
+                if ( p.heads[vc] != NULL || (int)(rand() % 100) >= load ) continue;
+                BenchEvent& ev = p.slots[vc];
+                ev.next_port = pickOutput(port);
+                ev.next_vc = vc;
+                ev.flits = 1 + rand() % 4;
+                p.heads[vc] = &ev;
+                p.occupancy |= (uint64_t)1 << vc;
+            }
+        }
+    }
+
+    // Check the grants and remove the events that moved
+    int retire() {
+        std::vector<bool> out_used(num_ports, false);
+        int moved = 0;
+        for ( int port = 0; port < num_ports; port++ ) {
+            int vc = progress_vc[port];
+            if ( vc < 0 ) continue;
+            BenchEvent* ev = port_store[port].heads[vc];
+            if ( ev == NULL || out_used[ev->next_port] ) {
+                fprintf(stderr, "Bad grant: port %d vc %d\n", port, vc);
+                exit(1);
+            }
+            out_used[ev->next_port] = true;
+            port_store[port].heads[vc] = NULL;
+            port_store[port].occupancy &= ~((uint64_t)1 << vc);
+            moved++;
+        }
+        for ( int port = 0; port < num_ports; port++ ) {
+            if ( in_port_busy[port] != 0 ) in_port_busy[port]--;
+            if ( out_port_busy[port] != 0 ) out_port_busy[port]--;
+        }
+        return moved;
+    }
+
+    template <class Arb>
+    Result run(Arb& arb, uint64_t cycles) {
+        reset();
+        uint64_t moved = 0;
+        double ns = 0;
+        Result r;
+        for ( uint64_t c = 0; c < cycles; c++ ) {
+            fill();
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            arb.arbitrate(&ports[0], &in_port_busy[0], &out_port_busy[0], &progress_vc[0]);
+            ns += std::chrono::duration<double,std::nano>(std::chrono::steady_clock::now() - start).count();
+
+            uint64_t hash = 0;
+            for ( int port = 0; port < num_ports; port++ ) {
+                hash = hash * 0x100000001b3ULL + (uint64_t)(progress_vc[port] + 2);
+            }
+            r.grants.push_back(hash);
+            moved += retire();
+        }
+        r.ns_per_cycle = ns / cycles;
+        r.moved_per_cycle = (double)moved / cycles;
+        return r;
+    }
+};
+
+void checkSame(const Result& ref, const Result& test, const char* name, const char* pattern, int ports)
+{
+    for ( size_t c = 0; c < ref.grants.size(); c++ ) {
+        if ( ref.grants[c] != test.grants[c] ) {
+            fprintf(stderr, "%s differs from the list arbiter: %s, %d ports, cycle %zu\n", name, pattern, ports, c);
+            exit(1);
+        }
+    }
+}
+
+typedef VCArbiter<BenchPortInterface,BenchEvent> MaskArb;
+
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t cycles = argc > 1 ? strtoull(argv[1], NULL, 0) : 20000;
+    const int port_counts[] = { 16, 32, 64, 128 };
+    const int num_vcs = 6;
+    const int loads[] = { 10, 50 };
+
+    printf("%-12s %5s %5s | %-22s | %-22s | %-22s | %-22s\n", "pattern", "load", "ports",
+           "list lru (ns, moved)", "mask lru (ns, moved)", "list rr (ns, moved)", "mask rr (ns, moved)");
+    for ( int pat = 0; pat < 4; pat++ ) {
+        for ( int l = 0; l < 2; l++ ) {
+            for ( int n = 0; n < 4; n++ ) {
+                Bench bench(port_counts[n], num_vcs, (Pattern)pat, loads[l]);
+
+                ListLRU list;
+                list.init(port_counts[n], num_vcs);
+                Result r_list = bench.run(list, cycles);
+
+                MaskArb lru;
+                lru.init(port_counts[n], num_vcs, MaskArb::LRU);
+                Result r_lru = bench.run(lru, cycles);
+
+                ListRR list_rr;
+                list_rr.init(port_counts[n], num_vcs);
+                Result r_list_rr = bench.run(list_rr, cycles);
+
+                MaskArb rr;
+                rr.init(port_counts[n], num_vcs, MaskArb::RR);
+                Result r_rr = bench.run(rr, cycles);
+
+                checkSame(r_list, r_lru, "mask lru", pattern_names[pat], port_counts[n]);
+                checkSame(r_list_rr, r_rr, "mask rr", pattern_names[pat], port_counts[n]);
+
+                printf("%-12s %4d%% %5d | %10.1f %10.2f | %10.1f %10.2f | %10.1f %10.2f | %10.1f %10.2f\n",
+                       pattern_names[pat], loads[l], port_counts[n],
+                       r_list.ns_per_cycle, r_list.moved_per_cycle,
+                       r_lru.ns_per_cycle, r_lru.moved_per_cycle,
+                       r_list_rr.ns_per_cycle, r_list_rr.moved_per_cycle,
+                       r_rr.ns_per_cycle, r_rr.moved_per_cycle);
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,50 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Valiant routing on a hyperx with router fast_forward enabled.  Valiant
+# picks the intermediate router and VC in reroute(), so this exercises
+# fast forwarded packets being rerouted.  Each NIC reports if it did not
+# receive all of its packets, and a broken VC assignment deadlocks.
+
+import sst
+from sst.merlin import *
+
+if __name__ == "__main__":
+
+    topo = topoHyperX()
+    endPoint = TestEndPoint()
+
+
+    sst.merlin._params["hyperx:shape"] = "4x4"
+    sst.merlin._params["hyperx:width"] = "1x1"
+    sst.merlin._params["hyperx:local_ports"] = "2"
+    sst.merlin._params["hyperx:algorithm"] = "valiant"
+
+
+    sst.merlin._params["link_bw"] = "4GB/s"
+    sst.merlin._params["link_lat"] = "20ns"
+    sst.merlin._params["flit_size"] = "8B"
+    sst.merlin._params["xbar_bw"] = "4GB/s"
+    sst.merlin._params["input_latency"] = "20ns"
+    sst.merlin._params["output_latency"] = "20ns"
+    sst.merlin._params["input_buf_size"] = "4kB"
+    sst.merlin._params["output_buf_size"] = "4kB"
+
+    sst.merlin._params["xbar_arb"] = "merlin.xbar_arb_lru"
+    sst.merlin._params["fast_forward"] = "true"
+    sst.merlin._params["fast_forward_threshold"] = "1"
+
+    topo.prepParams()
+    endPoint.prepParams()
+    topo.setEndPoint(endPoint)
+    topo.build()
@@ -0,0 +1,29 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2020 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2020, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Times route() for one router of a 16x16x16 torus with and without
+# route tables.  Change the topology parameters to benchmark others.
+
+import sst
+
+bench = sst.Component("route_bench", "merlin.route_bench")
+bench.addParams({
+    "topology" : "merlin.torus",
+    "topology.shape" : "16x16x16",
+    "topology.width" : "1x1x1",
+    "topology.local_ports" : "1",
+    "num_ports" : "7",
+    "num_peers" : "4096",
+    "id" : "1365",
+    "iterations" : "1000"
+})
@@ -77,6 +77,7 @@ topo_dragonfly2::topo_dragonfly2(ComponentId_t cid, Params &p, int num_ports, in
     std::string route_algo = p.find<std::string>("algorithm", "minimal");
 
     adaptive_threshold = p.find<double>("adaptive_threshold",2.0);
+    use_route_table = p.find<bool>("route_table", false);
     
     // Get the global link map
     std::vector<int64_t> global_link_map;
@@ -163,6 +164,8 @@ void topo_dragonfly2::route(int port, int vc, internal_router_event* ev)
 {
     topo_dragonfly2_event *td_ev = static_cast<topo_dragonfly2_event*>(ev);
 
+    if ( use_route_table && group_port_table.empty() ) buildRouteTable();
+
     // Break this up by port type
     uint32_t next_port = 0;
     if ( (uint32_t)port < params.p ) { 
@@ -569,6 +572,8 @@ uint32_t topo_dragonfly2::router_to_group(uint32_t group)
 /* returns local router port if group can't be reached from this router */
 uint32_t topo_dragonfly2::port_for_group(uint32_t group, uint32_t slice, int id)
 {
+    if ( !group_port_table.empty() ) return group_port_table[group * params.n + slice];
+
     // Look up global port to use
     switch ( global_route_mode ) {
     case ABSOLUTE:
@@ -605,3 +610,16 @@ uint32_t topo_dragonfly2::port_for_router(uint32_t router)
 }
 
 
+void topo_dragonfly2::buildRouteTable()
+{
+    std::vector<uint16_t> table(params.g * params.n, 0);
+    for ( uint32_t group = 0; group < params.g; group++ ) {
+        if ( group == group_id ) continue;
+        for ( uint32_t slice = 0; slice < params.n; slice++ ) {
+            table[group * params.n + slice] = port_for_group(group, slice);
+        }
+    }
+    group_port_table.swap(table);
+}
+
+
@@ -24,6 +24,8 @@
 #include <sst/core/params.h>
 #include <sst/core/rng/sstrng.h>
 
+#include <vector>
+
 #include "sst/elements/merlin/router.h"
 
 
@@ -88,6 +90,7 @@ public:
         {"dragonfly:adaptive_threshold",    "Threshold to use when make adaptive routing decisions.", "2.0"},
         {"dragonfly:global_link_map",       "Array specifying connectivity of global links in each dragonfly group."},
         {"dragonfly:global_route_mode",     "Mode for intepreting global link map [absolute (default) | relative].","absolute"},
+        {"dragonfly:route_table",           "Precompute the port toward every group and global link at the start of simulation so routing does not consult the global link map for each packet.", "false"},
 
         {"hosts_per_router",      "Number of hosts connected to each router."},
         {"routers_per_group",     "Number of links used to connect to routers in same group."},
@@ -98,6 +101,7 @@ public:
         {"adaptive_threshold",    "Threshold to use when make adaptive routing decisions.", "2.0"},
         {"global_link_map",       "Array specifying connectivity of global links in each dragonfly group."},
         {"global_route_mode",     "Mode for intepreting global link map [absolute (default) | relative].","absolute"},
+        {"route_table",           "Precompute the port toward every group and global link at the start of simulation so routing does not consult the global link map for each packet.", "false"},
     )
 
     /* Assumed connectivity of each router:
@@ -137,6 +141,11 @@ public:
     enum global_route_mode_t { ABSOLUTE, RELATIVE };
     global_route_mode_t global_route_mode;
 
+    // Port toward each (group, global slice), built on the first call
+    // to route() since group_to_global_port is not merged until then
+    bool use_route_table;
+    std::vector<uint16_t> group_port_table;
+
 public:
     struct dgnfly2Addr {
         uint32_t group;
@@ -169,6 +178,7 @@ private:
     uint32_t router_to_group(uint32_t group);
     uint32_t port_for_router(uint32_t router);
     uint32_t port_for_group(uint32_t group, uint32_t global_slice, int id = -1);
+    void buildRouteTable();
 
 };
 
@@ -118,6 +118,10 @@ topo_hyperx::topo_hyperx(ComponentId_t cid, Params& params, int num_ports, int r
         total_routers *= dim_size[i];
     }
 
+    if ( params.find<bool>("route_table", false) ) {
+        buildRouteTable();
+    }
+
     
     
 }
@@ -137,6 +141,17 @@ topo_hyperx::route(int port, int vc, internal_router_event* ev)
     topo_hyperx_event *tt_ev = static_cast<topo_hyperx_event*>(ev);
     tt_ev->rerouted = false;
 
+    if ( !route_table.empty() ) {
+        int dest_router = get_dest_router(tt_ev->getDest());
+        if ( dest_router == router_id ) {
+            tt_ev->setNextPort(get_dest_local_port(tt_ev->getDest()));
+        } else {
+            tt_ev->setNextPort(route_table[dest_router]);
+        }
+        tt_ev->setVC(vc);
+        return;
+    }
+
     routeDOR(port,vc,tt_ev);    
 }
 
@@ -314,6 +329,23 @@ topo_hyperx::parseDimString(const std::string &shape, int *output) const
 }
 
 
+// Next hop under DOR only depends on the destination router, so it
+// can be computed once per router rather than once per packet.
+void
+topo_hyperx::buildRouteTable()
+{
+    route_table.resize(total_routers, -1);
+
+    int* loc = new int[dimensions];
+    for ( int r = 0 ; r < total_routers ; r++ ) {
+        if ( r == router_id ) continue;
+        idToLocation(r, loc);
+        std::pair<int,int> next_port = routeDORBase(loc);
+        route_table[r] = choose_multipath(next_port.second,dim_width[next_port.first]);
+    }
+    delete [] loc;
+}
+
 // dest_id is a host id
 int
 topo_hyperx::get_dest_router(int dest_id) const
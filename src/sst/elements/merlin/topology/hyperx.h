@@ -159,11 +159,13 @@ public:
         {"hyperx:width",        "Number of links between routers in each dimension, specified in same manner as for shape.  For example, 2x2x1 denotes 2 links in the x and y dimensions and one in the z dimension."},
         {"hyperx:local_ports",  "Number of endpoints attached to each router."},
         {"hyperx:algorithm",    "Routing algorithm to use.", "DOR"},
+        {"hyperx:route_table",  "Precompute the dimension order next hop for every destination router at startup so route() is a table lookup. Adaptive algorithms still choose among ports in reroute().", "false"},
 
         {"shape",        "Shape of the mesh specified as the number of routers in each dimension, where each dimension is separated by a colon.  For example, 4x4x2x2.  Any number of dimensions is supported."},
         {"width",        "Number of links between routers in each dimension, specified in same manner as for shape.  For example, 2x2x1 denotes 2 links in the x and y dimensions and one in the z dimension."},
         {"local_ports",  "Number of endpoints attached to each router."},
-        {"algorithm",    "Routing algorithm to use.", "DOR"}
+        {"algorithm",    "Routing algorithm to use.", "DOR"},
+        {"route_table",  "Precompute the dimension order next hop for every destination router at startup so route() is a table lookup. Adaptive algorithms still choose among ports in reroute().", "false"}
     )
 
     enum RouteAlgo {
@@ -194,6 +196,8 @@ private:
     int num_vcs;
     int vcs_per_vn;
 
+    std::vector<int> route_table; // DOR next hop to each destination router, if route_table is set
+
     RouteAlgo algorithm;
     RNG::SSTRandom* rng;
     RNGFunc* rng_func;
@@ -224,6 +228,7 @@ private:
     void parseDimString(const std::string &shape, int *output) const;
     int get_dest_router(int dest_id) const;
     int get_dest_local_port(int dest_id) const;
+    void buildRouteTable();
 
     std::pair<int,int> routeDORBase(int* dest_loc);
     void routeDOR(int port, int vc, topo_hyperx_event* ev);
@@ -76,6 +76,10 @@ topo_mesh::topo_mesh(ComponentId_t cid, Params& params, int num_ports, int rtr_i
 
     id_loc = new int[dimensions];
     idToLocation(router_id, id_loc);
+
+    if ( params.find<bool>("route_table", false) ) {
+        buildRouteTable();
+    }
 }
 
 topo_mesh::~topo_mesh()
@@ -92,6 +96,21 @@ topo_mesh::route(int port, int vc, internal_router_event* ev)
     int dest_router = get_dest_router(ev->getDest());
     if ( dest_router == router_id ) {
         ev->setNextPort(get_dest_local_port(ev->getDest()));
+    } else if ( !route_table.empty() && ev->getDest() != INIT_BROADCAST_ADDR ) {
+        topo_mesh_event *tt_ev = static_cast<topo_mesh_event*>(ev);
+        const RouteEntry& entry = route_table[dest_router];
+
+        if ( tt_ev->routing_dim != entry.dim ) {
+            // Time to change direction
+            tt_ev->routing_dim = entry.dim;
+            tt_ev->setVC(vc & (~1)); // Reset the VC
+        }
+
+        tt_ev->setNextPort(entry.port);
+
+        if ( entry.dateline && port < local_port_start ) { // Crossing dateline
+            tt_ev->setVC(vc ^ 1); // Toggle VC
+        }
     } else {
         topo_mesh_event *tt_ev = static_cast<topo_mesh_event*>(ev);
 
@@ -232,6 +251,50 @@ topo_mesh::getPortState(int port) const
 }
 
 
+/*
+ * Dimension order routing always leaves for a given destination router on
+ * the same port, so work out the next hop to every router once and let
+ * route() look it up instead of walking the dimensions for each packet.
+ */
+void
+topo_mesh::buildRouteTable()
+{
+    int num_routers = 1;
+    for ( int i = 0 ; i < dimensions ; i++ ) {
+        num_routers *= dim_size[i];
+    }
+
+    if ( local_port_start + num_local_ports > 0xffff ) {
+        output.fatal(CALL_INFO, -1, "route_table supports at most 65535 ports per router\n");
+    }
+
+    route_table.resize(num_routers);
+
+    int* loc = new int[dimensions];
+    for ( int r = 0 ; r < num_routers ; r++ ) {
+        RouteEntry& entry = route_table[r];
+        entry.port = 0;
+        entry.dim = 0;
+        entry.dateline = 0;
+
+        idToLocation(r, loc);
+        for ( int dim = 0 ; dim < dimensions ; dim++ ) {
+            if ( loc[dim] == id_loc[dim] ) continue;
+
+            int go_pos = (id_loc[dim] < loc[dim]);
+
+            entry.port = choose_multipath(
+                    port_start[dim][(go_pos) ? 0 : 1],
+                    dim_width[dim],
+                    abs(id_loc[dim] - loc[dim]));
+            entry.dim = dim;
+            entry.dateline = (id_loc[dim] == 0);
+            break;
+        }
+    }
+    delete [] loc;
+}
+
 void
 topo_mesh::idToLocation(int run_id, int *location) const
 {
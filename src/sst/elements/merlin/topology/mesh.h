@@ -24,6 +24,7 @@
 #include <sst/core/params.h>
 
 #include <string.h>
+#include <vector>
 
 #include "sst/elements/merlin/router.h"
 
@@ -111,10 +112,12 @@ public:
         {"mesh:shape",        "Shape of the mesh specified as the number of routers in each dimension, where each dimension is separated by a colon.  For example, 4x4x2x2.  Any number of dimensions is supported."},
         {"mesh:width",        "Number of links between routers in each dimension, specified in same manner as for shape.  For example, 2x2x1 denotes 2 links in the x and y dimensions and one in the z dimension."},
         {"mesh:local_ports",  "Number of endpoints attached to each router."},
+        {"mesh:route_table",  "Precompute the output port for every destination router at startup so routing is a table lookup. Uses 4 bytes per router in the network, per router.", "false"},
 
         {"shape",        "Shape of the mesh specified as the number of routers in each dimension, where each dimension is separated by a colon.  For example, 4x4x2x2.  Any number of dimensions is supported."},
         {"width",        "Number of links between routers in each dimension, specified in same manner as for shape.  For example, 2x2x1 denotes 2 links in the x and y dimensions and one in the z dimension."},
-        {"local_ports",  "Number of endpoints attached to each router."}
+        {"local_ports",  "Number of endpoints attached to each router."},
+        {"route_table",  "Precompute the output port for every destination router at startup so routing is a table lookup. Uses 4 bytes per router in the network, per router.", "false"}
     )
 
 
@@ -131,6 +134,14 @@ private:
     int num_local_ports;
     int local_port_start;
 
+    // Next hop to each destination router, filled in when route_table is set
+    struct RouteEntry {
+        uint16_t port;
+        uint8_t dim;        // Dimension being routed
+        uint8_t dateline;   // Whether leaving on this port crosses the dateline
+    };
+    std::vector<RouteEntry> route_table;
+
 public:
     topo_mesh(ComponentId_t cid, Params& params, int num_ports, int rtr_id);
     ~topo_mesh();
@@ -153,6 +164,7 @@ private:
     void parseDimString(const std::string &shape, int *output) const;
     int get_dest_router(int dest_id) const;
     int get_dest_local_port(int dest_id) const;
+    void buildRouteTable();
 
 
 };
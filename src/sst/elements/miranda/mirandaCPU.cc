@@ -69,6 +69,7 @@ RequestGenCPU::RequestGenCPU(SST::ComponentId_t id, SST::Params& params) :
         }
 
 	maxOpLookup = params.find<uint64_t>("max_reorder_lookups", 16);
+	pendingRequests = new MirandaIssueQueue(maxOpLookup);
 
 	out->verbose(CALL_INFO, 1, 0, "Loaded memory interface successfully.\n");
 
@@ -172,6 +173,7 @@ RequestGenCPU::RequestGenCPU(SST::ComponentId_t id, SST::Params& params) :
 }
 
 RequestGenCPU::~RequestGenCPU() {
+	delete pendingRequests;
 	delete out;
 }
 
@@ -252,10 +254,8 @@ void RequestGenCPU::handleEvent( Interfaces::SimpleMem::Request* ev) {
 			out->verbose(CALL_INFO, 4, 0, "-> Entry has all parts satisfied, removing ID=%" PRIu64 ", total processing time: %" PRIu64 "ns\n",
 				cpuReq->getOriginalReqID(), (getCurrentSimTimeNano() - cpuReq->getIssueTime()));
 
-			// Notify every pending request that there may be a satisfied dependency
-			for(uint32_t i = 0; i < pendingRequests.size(); ++i) {
-				pendingRequests.at(i)->satisfyDependency(cpuReq->getOriginalReqID());
-			}
+			// Only the requests waiting on this one need to be told
+			pendingRequests->satisfyDependency(cpuReq->getOriginalReqID());
 
 			delete cpuReq;
 		}
@@ -385,7 +385,7 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
     statCycles->addData(1);
 
     if (reqGen->isFinished()) {
-        if ( (pendingRequests.size() == 0) &&
+        if ( pendingRequests->empty() &&
                 (0 == requestsPending[READ]) &&
                 (0 == requestsPending[WRITE]) &&
                 (0 == requestsPending[CUSTOM]) ) {
@@ -431,87 +431,108 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
 
     bool issued = false;
     uint32_t reqsIssuedThisCycle = 0;
-    std::vector<uint32_t> delReqs;
 
     // We need to generate at least as many requests as can be looked up in the OoO window
     // otherwise the issue will have starvation.
-    for(int i = pendingRequests.size(); i < maxOpLookup; ++i) {
+    for(int i = pendingRequests->size(); i < maxOpLookup; ++i) {
         if( reqGen->isFinished()) {
             break;
     	} else {
-            reqGen->generate(&pendingRequests);
+            reqGen->generate(&generatedRequests);
     	}
     }
 
-    for(uint32_t i = 0; i < pendingRequests.size(); ++i) {
-        if(reqsIssuedThisCycle == reqMaxPerCycle) {
-            statMaxIssuePerCycle->addData(1);
-            break;
-    	}
+    for(uint32_t i = 0; i < generatedRequests.size(); ++i) {
+        GeneratorRequest* newRq = generatedRequests.at(i);
+        const ReqOperation newOp = newRq->getOperation();
 
-	// Only a certain number of lookups are allowed, if we exceed this then we
-        // must exit the issue loop
-    	if(i == maxOpLookup) {
-            out->verbose(CALL_INFO, 2, 0, "Hit maximum reorder limit this cycle, no further operations will issue.\n");
-            statCyclesHitReorderLimit->addData(1);
-            break;
-    	}
+        if( (newOp != REQ_FENCE) && (newOp >= OPCOUNT || NULL == dynamic_cast<MemoryOpRequest*>(newRq)) ) {
+            out->fatal(CALL_INFO, -1, "Error, invalid operation \n");
+        }
 
-        MemoryOpRequest* memOpReq;
-	GeneratorRequest* nxtRq = pendingRequests.at(i);
+        pendingRequests->push_back(newRq);
+    }
 
-	if(nxtRq->getOperation() == REQ_FENCE) {
-            if(0 == requestsInFlight.size()) {
-		out->verbose(CALL_INFO, 4, 0, "Fence operation completed, no pending requests, will be retired.\n");
+    generatedRequests.clear();
+    pendingRequests->beginCycle();
 
-                // Keep record we will delete fence at i
-    		delReqs.push_back(i);
+    // Requests are considered in program order, but rather than stepping through
+    // the window one entry at a time we jump to the next request that is ready
+    // and stop at the first fence or operation whose load/store unit is full.
+    uint64_t nextPos = pendingRequests->front();
 
-                // Delete the fence
-    		delete nxtRq;
-            } else {
-                out->verbose(CALL_INFO, 4, 0, "Fence operation in flight (>0 pending requests), stall.\n");
+    while(true) {
+        if(reqsIssuedThisCycle == reqMaxPerCycle) {
+            if(pendingRequests->anyFrom(nextPos)) {
+                statMaxIssuePerCycle->addData(1);
             }
-
-            statCyclesHitFence->addData(1);
-
-            // Fence operations do now allow anything else to complete in this cycle
             break;
+        }
 
-        } else if ( ( memOpReq = dynamic_cast<MemoryOpRequest*>(nxtRq) ) ) {
+        const uint64_t readyPos = pendingRequests->nextReady(nextPos);
 
-            if( requestsPending[memOpReq->getOperation()] < maxRequestsPending[memOpReq->getOperation()] ) {
-                out->verbose(CALL_INFO, 4, 0, "Will attempt to issue as free slots in the load/store unit.\n");
+        // The oldest fence, or operation with no free slots, stops the issue
+        uint64_t stopPos = pendingRequests->nextOfType(REQ_FENCE, nextPos);
+        const ReqOperation memOps[] = { READ, WRITE, CUSTOM };
 
+        for(uint32_t j = 0; j < 3; ++j) {
+            if( requestsPending[memOps[j]] >= maxRequestsPending[memOps[j]] ) {
+                const uint64_t fullPos = pendingRequests->nextOfType(memOps[j], nextPos);
 
-		if(nxtRq->canIssue()) {
-                    issued = true;
-                    reqsIssuedThisCycle++;
+                if(fullPos < stopPos) {
+                    stopPos = fullPos;
+                }
+            }
+        }
 
-                    out->verbose(CALL_INFO, 4, 0, "Request %" PRIu64 " encountered, cleared to be issued, %" PRIu32 " issued this cycle.\n",
-                            nxtRq->getRequestID(), reqsIssuedThisCycle);
+        if(MirandaIssueQueue::NONE != stopPos && stopPos <= readyPos) {
+            GeneratorRequest* stopRq = pendingRequests->at(stopPos);
 
-    		    // Keep record we will delete at index i
-                    delReqs.push_back(i);
+            if(stopRq->getOperation() == REQ_FENCE) {
+                if(0 == requestsInFlight.size()) {
+                    out->verbose(CALL_INFO, 4, 0, "Fence operation completed, no pending requests, will be retired.\n");
 
-                    //MemoryOpRequest* memOpReq = dynamic_cast<MemoryOpRequest*>(nxtRq);
-                    issueRequest(memOpReq);
+                    pendingRequests->erase(stopPos);
 
-                    delete nxtRq;
-		} else {
-                    out->verbose(CALL_INFO, 4, 0, "Request %" PRIu64 " in queue, has dependencies which are not satisfied, wait.\n",
-                            nxtRq->getRequestID());
+                    // Delete the fence
+                    delete stopRq;
+                } else {
+                    out->verbose(CALL_INFO, 4, 0, "Fence operation in flight (>0 pending requests), stall.\n");
                 }
-    	    } else {
+
+                statCyclesHitFence->addData(1);
+            } else {
                 out->verbose(CALL_INFO, 4, 0, "All load/store/custom slots occupied, no more issues will be attempted.\n");
-    	        break;
             }
-	} else {
-            out->fatal(CALL_INFO, -1, "Error, invalid operation \n");
+
+            // Nothing after a fence or a full operation can issue in this cycle
+            break;
         }
-    }
 
-    pendingRequests.erase(delReqs);
+        // Only a certain number of lookups are allowed, if we exceed this then we
+        // must exit the issue loop
+        if(MirandaIssueQueue::NONE == readyPos) {
+            if(pendingRequests->beyondWindow()) {
+                out->verbose(CALL_INFO, 2, 0, "Hit maximum reorder limit this cycle, no further operations will issue.\n");
+                statCyclesHitReorderLimit->addData(1);
+            }
+            break;
+        }
+
+        MemoryOpRequest* memOpReq = static_cast<MemoryOpRequest*>(pendingRequests->at(readyPos));
+
+        issued = true;
+        reqsIssuedThisCycle++;
+
+        out->verbose(CALL_INFO, 4, 0, "Request %" PRIu64 " encountered, cleared to be issued, %" PRIu32 " issued this cycle.\n",
+                memOpReq->getRequestID(), reqsIssuedThisCycle);
+
+        pendingRequests->erase(readyPos);
+        issueRequest(memOpReq);
+
+        delete memOpReq;
+        nextPos = readyPos + 1;
+    }
 
     if(issued) {
 	statCyclesWithIssue->addData(1);
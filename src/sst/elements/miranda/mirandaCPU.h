@@ -21,6 +21,7 @@
 #include <sst/core/statapi/stataccumulator.h>
 
 #include "mirandaGenerator.h"
+#include "mirandaIssueQueue.h"
 #include "mirandaEvent.h"
 #include "mirandaMemMgr.h"
 
@@ -132,7 +133,8 @@ private:
 	Link* srcLink;
 	MirandaReqEvent* srcReqEvent;
 
-	MirandaRequestQueue<GeneratorRequest*> pendingRequests;
+	MirandaRequestQueue<GeneratorRequest*> generatedRequests;
+	MirandaIssueQueue* pendingRequests;
 	MirandaMemoryManager* memMgr;
 
         SharedRegion * addrMap;
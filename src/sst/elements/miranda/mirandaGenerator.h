@@ -69,6 +69,10 @@ public:
 		return dependsOn.empty();
 	}
 
+	const std::vector<uint64_t>& getDependencies() const {
+		return dependsOn;
+	}
+
 	uint64_t getIssueTime() const {
 		return issueTime;
 	}
@@ -127,41 +131,34 @@ public:
                	return theQ[index];
        	}
 
-       	void erase(const std::vector<uint32_t> eraseList) {
+       	void erase(const std::vector<uint32_t>& eraseList) {
 		if(0 == eraseList.size()) {
 			return;
 		}
 
-               	QueueType* newQ = (QueueType*) malloc(sizeof(QueueType) * maxCapacity);
-
+		// Compact in place, the erase list is in ascending index order
                	uint32_t nextSkipIndex = 0;
-               	uint32_t nextSkip = eraseList.at(nextSkipIndex);
-                uint32_t nextNewQIndex = 0;
+                uint32_t nextNewQIndex = eraseList.at(0);
 
-               	for(uint32_t i = 0; i < curSize; ++i) {
-                       	if(nextSkip == i) {
+               	for(uint32_t i = nextNewQIndex; i < curSize; ++i) {
+                       	if(nextSkipIndex < eraseList.size() && eraseList.at(nextSkipIndex) == i) {
                                 nextSkipIndex++;
-
-                                if(nextSkipIndex >= eraseList.size()) {
-                                       	nextSkip = curSize;
-                               	} else {
-                                       	nextSkip = eraseList.at(nextSkipIndex);
-                                }
                        	} else {
-                               	newQ[nextNewQIndex] = theQ[i];
+                               	theQ[nextNewQIndex] = theQ[i];
                                 nextNewQIndex++;
                        	}
                	}
 
-                free(theQ);
-
-               	theQ = newQ;
 		curSize = nextNewQIndex;
         }
 
+	void clear() {
+		curSize = 0;
+	}
+
 	void push_back(QueueType t) {
                 if(curSize == maxCapacity) {
-                        resize(maxCapacity + 16);
+                        resize(maxCapacity * 2);
                 }
 
                 theQ[curSize] = t;
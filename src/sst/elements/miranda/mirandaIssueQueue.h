@@ -0,0 +1,275 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MIRANDA_ISSUE_QUEUE
+#define _H_SST_MIRANDA_ISSUE_QUEUE
+
+#include <stdint.h>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include "mirandaGenerator.h"
+
+namespace SST {
+namespace Miranda {
+
+/*
+ * The CPU's queue of generated requests waiting to issue, kept in program
+ * order.  Requests are numbered by their position in the queue and held in
+ * a ring of slots; one bitmap per property (live, ready, operation type)
+ * lets the issue logic jump straight to the next request of interest
+ * instead of walking the queue.
+ *
+ * Dependencies are indexed in reverse: each request id maps to the
+ * positions of the requests waiting on it, and every request keeps a count
+ * of the dependencies it is still waiting for.  A completing request only
+ * touches its own dependents, and a memory operation is marked ready when
+ * its count reaches zero.
+ *
+ * The reorder window is the first windowSize live requests.  It is fixed
+ * by beginCycle() so that requests issued during a cycle still count
+ * against the window until the next cycle, as they always have.
+ */
+class MirandaIssueQueue {
+public:
+	static const uint64_t NONE = UINT64_MAX;
+
+	MirandaIssueQueue(const uint32_t lookups) :
+		windowSize(lookups), capacity(0), mask(0),
+		head(0), tail(0), windowEnd(0),
+		liveCount(0), liveInWindow(0) {
+
+		allocate(64);
+	}
+
+	~MirandaIssueQueue() {}
+
+	uint64_t size() const {
+		return liveCount;
+	}
+
+	bool empty() const {
+		return 0 == liveCount;
+	}
+
+	// Position of the oldest request still in the queue
+	uint64_t front() const {
+		return head;
+	}
+
+	GeneratorRequest* at(const uint64_t pos) const {
+		return slots[pos & mask].req;
+	}
+
+	void push_back(GeneratorRequest* req) {
+		if(tail - head == capacity) {
+			allocate(capacity * 2);
+		}
+
+		const uint64_t pos = tail++;
+		Slot& slot = slots[pos & mask];
+		const std::vector<uint64_t>& deps = req->getDependencies();
+
+		slot.req = req;
+		slot.pos = pos;
+		slot.outstanding = (uint32_t) deps.size();
+
+		for(uint32_t i = 0; i < deps.size(); ++i) {
+			dependents[deps[i]].push_back(pos);
+		}
+
+		setBit(live, pos);
+		setBit(opType[req->getOperation()], pos);
+
+		if(0 == slot.outstanding && isMemoryOp(req)) {
+			setBit(ready, pos);
+		}
+
+		liveCount++;
+	}
+
+	// Request reqID has completed, release anything waiting on it
+	void satisfyDependency(const uint64_t reqID) {
+		std::unordered_map<uint64_t, std::vector<uint64_t> >::iterator waiting = dependents.find(reqID);
+
+		if(waiting == dependents.end()) {
+			return;
+		}
+
+		for(uint32_t i = 0; i < waiting->second.size(); ++i) {
+			const uint64_t pos = waiting->second[i];
+			Slot& slot = slots[pos & mask];
+
+			if(pos >= head && slot.pos == pos && testBit(live, pos) && slot.outstanding > 0) {
+				slot.outstanding--;
+
+				if(0 == slot.outstanding && isMemoryOp(slot.req)) {
+					setBit(ready, pos);
+				}
+			}
+		}
+
+		dependents.erase(waiting);
+	}
+
+	// Drop requests already issued from the front and extend the reorder
+	// window over requests generated since the last cycle
+	void beginCycle() {
+		while(head < windowEnd && !testBit(live, head)) {
+			head++;
+		}
+
+		// Only window requests are ever removed, so everything past it is live
+		const uint64_t extend = std::min<uint64_t>(windowSize - liveInWindow, tail - windowEnd);
+		windowEnd += extend;
+		liveInWindow += extend;
+	}
+
+	// First memory operation at or after pos in the window with no
+	// outstanding dependencies
+	uint64_t nextReady(const uint64_t pos) const {
+		return findSet(ready, pos, windowEnd);
+	}
+
+	// First request of operation op at or after pos in the window
+	uint64_t nextOfType(const ReqOperation op, const uint64_t pos) const {
+		return findSet(opType[op], pos, windowEnd);
+	}
+
+	// Is any request, in the window or beyond it, at or after pos
+	bool anyFrom(const uint64_t pos) const {
+		return NONE != findSet(live, pos, tail);
+	}
+
+	// Are there requests the reorder window does not reach
+	bool beyondWindow() const {
+		return windowEnd < tail;
+	}
+
+	// Remove the request at pos, which must be in the window
+	void erase(const uint64_t pos) {
+		Slot& slot = slots[pos & mask];
+
+		clearBit(live, pos);
+		clearBit(ready, pos);
+		clearBit(opType[slot.req->getOperation()], pos);
+
+		slot.req = NULL;
+		liveCount--;
+		liveInWindow--;
+	}
+
+private:
+	struct Slot {
+		GeneratorRequest* req;
+		uint64_t pos;
+		uint32_t outstanding;
+	};
+
+	static bool isMemoryOp(const GeneratorRequest* req) {
+		return req->getOperation() != REQ_FENCE;
+	}
+
+	void setBit(std::vector<uint64_t>& bits, const uint64_t pos) {
+		bits[(pos & mask) >> 6] |= ((uint64_t) 1) << (pos & 63);
+	}
+
+	void clearBit(std::vector<uint64_t>& bits, const uint64_t pos) {
+		bits[(pos & mask) >> 6] &= ~(((uint64_t) 1) << (pos & 63));
+	}
+
+	bool testBit(const std::vector<uint64_t>& bits, const uint64_t pos) const {
+		return 0 != (bits[(pos & mask) >> 6] & (((uint64_t) 1) << (pos & 63)));
+	}
+
+	// First set bit in positions [from, to), a word at a time.  The
+	// capacity is a multiple of 64 so a word never straddles the wrap.
+	uint64_t findSet(const std::vector<uint64_t>& bits, uint64_t from, const uint64_t to) const {
+		while(from < to) {
+			const uint32_t bit = (uint32_t) (from & 63);
+			const uint64_t span = std::min<uint64_t>(64 - bit, to - from);
+			uint64_t word = bits[(from & mask) >> 6] >> bit;
+
+			if(span < 64) {
+				word &= (((uint64_t) 1) << span) - 1;
+			}
+
+			if(0 != word) {
+				return from + __builtin_ctzll(word);
+			}
+
+			from += span;
+		}
+
+		return NONE;
+	}
+
+	void allocate(const uint64_t newCapacity) {
+		std::vector<Slot> oldSlots;
+		oldSlots.swap(slots);
+		const uint64_t oldMask = mask;
+
+		capacity = newCapacity;
+		mask = newCapacity - 1;
+
+		Slot unused = { NULL, 0, 0 };
+		slots.assign(capacity, unused);
+		live.assign(capacity / 64, 0);
+		ready.assign(capacity / 64, 0);
+
+		for(int i = 0; i < OPCOUNT; ++i) {
+			opType[i].assign(capacity / 64, 0);
+		}
+
+		for(uint64_t pos = head; pos < tail; ++pos) {
+			const Slot& old = oldSlots[pos & oldMask];
+			slots[pos & mask] = old;
+
+			if(NULL != old.req) {
+				setBit(live, pos);
+				setBit(opType[old.req->getOperation()], pos);
+
+				if(0 == old.outstanding && isMemoryOp(old.req)) {
+					setBit(ready, pos);
+				}
+			}
+		}
+	}
+
+	const uint64_t windowSize;
+	uint64_t capacity;
+	uint64_t mask;
+
+	// Positions: [head, windowEnd) is the reorder window, [head, tail) the queue
+	uint64_t head;
+	uint64_t tail;
+	uint64_t windowEnd;
+	uint64_t liveCount;
+	uint64_t liveInWindow;
+
+	std::vector<Slot> slots;
+	std::vector<uint64_t> live;
+	std::vector<uint64_t> ready;
+	std::vector<uint64_t> opType[OPCOUNT];
+
+	std::unordered_map<uint64_t, std::vector<uint64_t> > dependents;
+};
+
+}
+}
+
+#endif
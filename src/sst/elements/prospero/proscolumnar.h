@@ -0,0 +1,563 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_COLUMNAR
+#define _H_SST_PROSPERO_COLUMNAR
+
+/*
+ * Columnar memory trace format, shared by the Prospero reader, the Ariel
+ * trace generator and sst-prospero-convert.  It has no dependency on
+ * SST core so the converter can use it.
+ *
+ * Records are grouped into chunks.  A chunk is decoded on its own, so a
+ * reader can start at any chunk.  Each chunk stores its fields as
+ * separate columns:
+ *   ops        one bit per record, set for a write
+ *   cycles     zigzag varint of the difference to the previous cycle
+ *   addresses  zigzag varint of the stride from the previous address
+ *   lengths    varint
+ * Columns are compressed with zlib when that makes the chunk smaller and
+ * Prospero was built with zlib.
+ *
+ * Layout, in host byte order like the binary trace format:
+ *   ColumnarFileHeader
+ *   ColumnarChunkHeader, payload            (repeated)
+ *   ColumnarIndexEntry                      (one per chunk)
+ *   ColumnarFooter
+ * The payload starts with the byte lengths of the cycle, address and
+ * length columns as three uint32_t, then the ops bits, then the columns.
+ * A trace without a footer (the writer did not finish) is indexed by
+ * walking the chunk headers, and a partly written last chunk is dropped.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+namespace SST {
+namespace Prospero {
+
+static const char     COLUMNAR_FILE_MAGIC[8]   = { 'S', 'S', 'T', 'C', 'T', 'R', 'C', '1' };
+static const char     COLUMNAR_FOOTER_MAGIC[8] = { 'S', 'S', 'T', 'C', 'I', 'D', 'X', '1' };
+static const uint32_t COLUMNAR_VERSION = 1;
+
+static const uint32_t COLUMNAR_STORED  = 0;
+static const uint32_t COLUMNAR_ZLIB    = 1;
+
+struct ColumnarFileHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t chunkRecords;		// Most records in a chunk
+};
+
+struct ColumnarChunkHeader {
+	uint32_t storedBytes;		// Payload size in the file
+	uint32_t rawBytes;		// Payload size once decompressed
+	uint32_t records;
+	uint32_t method;
+	uint64_t firstCycle;		// Bases for the first cycle and address deltas
+	uint64_t firstAddress;
+};
+
+struct ColumnarIndexEntry {
+	uint64_t offset;		// File offset of the chunk header
+	uint64_t firstRecord;
+	uint64_t firstCycle;
+};
+
+struct ColumnarFooter {
+	uint64_t indexOffset;
+	uint64_t chunkCount;
+	uint64_t recordCount;
+	char magic[8];
+};
+
+static const uint32_t COLUMNAR_COLUMN_HEADER = 3 * sizeof(uint32_t);
+static const uint32_t COLUMNAR_MAX_CHUNK_RECORDS = 1 << 24;
+
+inline void columnarPutVarint(std::vector<uint8_t>& column, uint64_t value) {
+	while(value >= 0x80) {
+		column.push_back((uint8_t) (value | 0x80));
+		value >>= 7;
+	}
+
+	column.push_back((uint8_t) value);
+}
+
+inline bool columnarGetVarint(const uint8_t*& pos, const uint8_t* end, uint64_t& value) {
+	value = 0;
+
+	for(uint32_t shift = 0; shift < 64 && pos < end; shift += 7) {
+		const uint8_t next = *pos++;
+		value |= ((uint64_t) (next & 0x7F)) << shift;
+
+		if(0 == (next & 0x80)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+inline uint64_t columnarZigzag(const uint64_t delta) {
+	return (delta << 1) ^ (uint64_t) (((int64_t) delta) >> 63);
+}
+
+inline uint64_t columnarUnzigzag(const uint64_t value) {
+	return (value >> 1) ^ (~(value & 1) + 1);
+}
+
+class ProsperoColumnarTraceWriter {
+
+public:
+	ProsperoColumnarTraceWriter() :
+		traceFile(NULL), chunkRecords(0), level(6), recordCount(0) {
+		resetChunk();
+	}
+
+	~ProsperoColumnarTraceWriter() {
+		std::string ignored;
+		close(ignored);
+	}
+
+	// level is the zlib level, 0 stores chunks uncompressed
+	bool open(const std::string& path, const uint32_t records, const int compressLevel, std::string& error) {
+		// Keeps the size of a chunk within a uint32_t
+		if(0 == records || records > COLUMNAR_MAX_CHUNK_RECORDS) {
+			error = "chunk size must be between 1 and 16777216 records";
+			return false;
+		}
+
+		traceFile = fopen(path.c_str(), "wb");
+
+		if(NULL == traceFile) {
+			error = "unable to open " + path + " for writing";
+			return false;
+		}
+
+		chunkRecords = records;
+		level = compressLevel;
+		recordCount = 0;
+		index.clear();
+		writeError.clear();
+		resetChunk();
+
+		ColumnarFileHeader header;
+		memcpy(header.magic, COLUMNAR_FILE_MAGIC, sizeof(header.magic));
+		header.version = COLUMNAR_VERSION;
+		header.chunkRecords = chunkRecords;
+
+		write(&header, sizeof(header));
+		return writeError.empty();
+	}
+
+	void append(const uint64_t cycle, const uint64_t address, const uint32_t length, const bool isWrite) {
+		if(0 == pendingRecords) {
+			firstCycle = prevCycle = cycle;
+			firstAddress = prevAddress = address;
+		}
+
+		if(0 == (pendingRecords & 7)) {
+			ops.push_back(0);
+		}
+
+		if(isWrite) {
+			ops.back() |= (uint8_t) (1 << (pendingRecords & 7));
+		}
+
+		columnarPutVarint(cycles, columnarZigzag(cycle - prevCycle));
+		columnarPutVarint(addresses, columnarZigzag(address - prevAddress));
+		columnarPutVarint(lengths, length);
+
+		prevCycle = cycle;
+		prevAddress = address;
+
+		if(++pendingRecords == chunkRecords) {
+			flushChunk();
+		}
+	}
+
+	// Writes the last chunk, the index and the footer
+	bool close(std::string& error) {
+		if(NULL == traceFile) {
+			return true;
+		}
+
+		flushChunk();
+
+		ColumnarFooter footer;
+		footer.indexOffset = (uint64_t) ftello(traceFile);
+		footer.chunkCount = index.size();
+		footer.recordCount = recordCount;
+		memcpy(footer.magic, COLUMNAR_FOOTER_MAGIC, sizeof(footer.magic));
+
+		if(!index.empty()) {
+			write(&index[0], index.size() * sizeof(ColumnarIndexEntry));
+		}
+
+		write(&footer, sizeof(footer));
+
+		if(0 != fclose(traceFile) && writeError.empty()) {
+			writeError = "unable to close trace file";
+		}
+
+		traceFile = NULL;
+		error = writeError;
+		return writeError.empty();
+	}
+
+	uint64_t getRecordCount() const { return recordCount + pendingRecords; }
+
+private:
+	void resetChunk() {
+		pendingRecords = 0;
+		ops.clear();
+		cycles.clear();
+		addresses.clear();
+		lengths.clear();
+	}
+
+	void write(const void* data, const size_t len) {
+		if(writeError.empty() && len != fwrite(data, 1, len, traceFile)) {
+			writeError = "unable to write trace file";
+		}
+	}
+
+	void flushChunk() {
+		if(0 == pendingRecords) {
+			return;
+		}
+
+		const uint32_t columnBytes[3] = {
+			(uint32_t) cycles.size(), (uint32_t) addresses.size(), (uint32_t) lengths.size() };
+
+		raw.resize(COLUMNAR_COLUMN_HEADER);
+		memcpy(&raw[0], columnBytes, COLUMNAR_COLUMN_HEADER);
+		raw.insert(raw.end(), ops.begin(), ops.end());
+		raw.insert(raw.end(), cycles.begin(), cycles.end());
+		raw.insert(raw.end(), addresses.begin(), addresses.end());
+		raw.insert(raw.end(), lengths.begin(), lengths.end());
+
+		ColumnarChunkHeader header;
+		header.rawBytes = (uint32_t) raw.size();
+		header.records = pendingRecords;
+		header.firstCycle = firstCycle;
+		header.firstAddress = firstAddress;
+		header.method = COLUMNAR_STORED;
+		header.storedBytes = header.rawBytes;
+
+		const uint8_t* payload = &raw[0];
+
+#ifdef HAVE_LIBZ
+		if(level > 0) {
+			uLongf packedBytes = compressBound(raw.size());
+			packed.resize(packedBytes);
+
+			if(Z_OK == compress2(&packed[0], &packedBytes, &raw[0], raw.size(), level) &&
+				packedBytes < raw.size()) {
+
+				header.method = COLUMNAR_ZLIB;
+				header.storedBytes = (uint32_t) packedBytes;
+				payload = &packed[0];
+			}
+		}
+#endif
+
+		ColumnarIndexEntry entry;
+		entry.offset = (uint64_t) ftello(traceFile);
+		entry.firstRecord = recordCount;
+		entry.firstCycle = firstCycle;
+		index.push_back(entry);
+
+		write(&header, sizeof(header));
+		write(payload, header.storedBytes);
+
+		recordCount += pendingRecords;
+		resetChunk();
+	}
+
+	FILE* traceFile;
+	uint32_t chunkRecords;
+	int level;
+	uint64_t recordCount;
+	std::string writeError;
+	std::vector<ColumnarIndexEntry> index;
+
+	uint32_t pendingRecords;
+	uint64_t firstCycle;
+	uint64_t firstAddress;
+	uint64_t prevCycle;
+	uint64_t prevAddress;
+	std::vector<uint8_t> ops;
+	std::vector<uint8_t> cycles;
+	std::vector<uint8_t> addresses;
+	std::vector<uint8_t> lengths;
+	std::vector<uint8_t> raw;
+	std::vector<uint8_t> packed;
+
+};
+
+class ProsperoColumnarTraceFile {
+
+public:
+	ProsperoColumnarTraceFile() : traceFile(NULL), chunkRecords(0), recordCount(0), complete(false) {}
+
+	~ProsperoColumnarTraceFile() {
+		if(NULL != traceFile) {
+			fclose(traceFile);
+		}
+	}
+
+	static bool isColumnar(const std::string& path) {
+		FILE* probe = fopen(path.c_str(), "rb");
+		char magic[8];
+
+		const bool match = (NULL != probe) && (sizeof(magic) == fread(magic, 1, sizeof(magic), probe)) &&
+			(0 == memcmp(magic, COLUMNAR_FILE_MAGIC, sizeof(magic)));
+
+		if(NULL != probe) {
+			fclose(probe);
+		}
+
+		return match;
+	}
+
+	bool open(const std::string& path, std::string& error) {
+		traceFile = fopen(path.c_str(), "rb");
+
+		if(NULL == traceFile) {
+			error = "unable to open " + path;
+			return false;
+		}
+
+		ColumnarFileHeader header;
+
+		if(1 != fread(&header, sizeof(header), 1, traceFile) ||
+			0 != memcmp(header.magic, COLUMNAR_FILE_MAGIC, sizeof(header.magic))) {
+			error = path + " is not a columnar trace";
+			return false;
+		}
+
+		if(COLUMNAR_VERSION != header.version) {
+			error = path + " has an unsupported columnar trace version";
+			return false;
+		}
+
+		chunkRecords = header.chunkRecords;
+
+		if(!readIndex()) {
+			scanChunks();
+		}
+
+		return true;
+	}
+
+	uint64_t getChunkCount() const { return index.size(); }
+	uint64_t getRecordCount() const { return recordCount; }
+	uint32_t getChunkRecords() const { return chunkRecords; }
+	bool isComplete() const { return complete; }
+	const ColumnarIndexEntry& getIndexEntry(const uint64_t chunk) const { return index[chunk]; }
+
+	// The chunk holding a record, or getChunkCount() if the trace is shorter
+	uint64_t findChunkByRecord(const uint64_t record) const {
+		if(record >= recordCount) {
+			return index.size();
+		}
+
+		std::vector<ColumnarIndexEntry>::const_iterator next = std::upper_bound(index.begin(), index.end(),
+			record, [](const uint64_t r, const ColumnarIndexEntry& e) { return r < e.firstRecord; });
+
+		return (uint64_t) (next - index.begin()) - 1;
+	}
+
+	// The first chunk that can hold records at or after a cycle, traces are in cycle order
+	uint64_t findChunkByCycle(const uint64_t cycle) const {
+		std::vector<ColumnarIndexEntry>::const_iterator next = std::lower_bound(index.begin(), index.end(),
+			cycle, [](const ColumnarIndexEntry& e, const uint64_t c) { return e.firstCycle < c; });
+
+		// The chunk before the first one starting at or after the cycle may end after it
+		return (next == index.begin()) ? 0 : (uint64_t) (next - index.begin()) - 1;
+	}
+
+	/*
+	 * Decodes a chunk, calling sink(cycle, address, length, isWrite)
+	 * for each record in order.
+	 */
+	template<typename Sink>
+	bool readChunk(const uint64_t chunk, Sink& sink, std::string& error) {
+		ColumnarChunkHeader header;
+
+		if(chunk >= index.size() || 0 != fseeko(traceFile, (off_t) index[chunk].offset, SEEK_SET) ||
+			1 != fread(&header, sizeof(header), 1, traceFile)) {
+			error = "unable to read chunk header";
+			return false;
+		}
+
+		stored.resize(header.storedBytes);
+
+		if(header.storedBytes > 0 && 1 != fread(&stored[0], header.storedBytes, 1, traceFile)) {
+			error = "unable to read chunk payload";
+			return false;
+		}
+
+		const uint8_t* payload = NULL;
+
+		if(COLUMNAR_STORED == header.method && header.storedBytes == header.rawBytes) {
+			payload = stored.empty() ? NULL : &stored[0];
+#ifdef HAVE_LIBZ
+		} else if(COLUMNAR_ZLIB == header.method) {
+			uLongf rawBytes = header.rawBytes;
+			raw.resize(rawBytes);
+
+			if(Z_OK != uncompress(&raw[0], &rawBytes, &stored[0], header.storedBytes) ||
+				rawBytes != header.rawBytes) {
+				error = "unable to decompress chunk";
+				return false;
+			}
+
+			payload = &raw[0];
+#endif
+		} else {
+			error = (COLUMNAR_ZLIB == header.method) ?
+				"chunk is zlib compressed but zlib is not available" : "chunk has an unknown encoding";
+			return false;
+		}
+
+		return decode(header, payload, sink, error);
+	}
+
+private:
+	template<typename Sink>
+	bool decode(const ColumnarChunkHeader& header, const uint8_t* payload, Sink& sink, std::string& error) {
+		const uint64_t opBytes = (header.records + 7) / 8;
+		uint32_t columnBytes[3];
+
+		if(header.rawBytes < COLUMNAR_COLUMN_HEADER + opBytes) {
+			error = "chunk is too short";
+			return false;
+		}
+
+		memcpy(columnBytes, payload, COLUMNAR_COLUMN_HEADER);
+
+		if((uint64_t) COLUMNAR_COLUMN_HEADER + opBytes + columnBytes[0] + columnBytes[1] + columnBytes[2] !=
+			header.rawBytes) {
+			error = "chunk column sizes are inconsistent";
+			return false;
+		}
+
+		const uint8_t* ops = payload + COLUMNAR_COLUMN_HEADER;
+		const uint8_t* cyclePos = ops + opBytes;
+		const uint8_t* cycleEnd = cyclePos + columnBytes[0];
+		const uint8_t* addressPos = cycleEnd;
+		const uint8_t* addressEnd = addressPos + columnBytes[1];
+		const uint8_t* lengthPos = addressEnd;
+		const uint8_t* lengthEnd = lengthPos + columnBytes[2];
+
+		uint64_t cycle = header.firstCycle;
+		uint64_t address = header.firstAddress;
+
+		for(uint32_t i = 0; i < header.records; ++i) {
+			uint64_t cycleDelta;
+			uint64_t stride;
+			uint64_t length;
+
+			if(!columnarGetVarint(cyclePos, cycleEnd, cycleDelta) ||
+				!columnarGetVarint(addressPos, addressEnd, stride) ||
+				!columnarGetVarint(lengthPos, lengthEnd, length)) {
+				error = "chunk column ended early";
+				return false;
+			}
+
+			cycle += columnarUnzigzag(cycleDelta);
+			address += columnarUnzigzag(stride);
+
+			sink(cycle, address, (uint32_t) length, 0 != (ops[i >> 3] & (1 << (i & 7))));
+		}
+
+		return true;
+	}
+
+	bool readIndex() {
+		ColumnarFooter footer;
+
+		if(0 != fseeko(traceFile, -((off_t) sizeof(footer)), SEEK_END) ||
+			1 != fread(&footer, sizeof(footer), 1, traceFile) ||
+			0 != memcmp(footer.magic, COLUMNAR_FOOTER_MAGIC, sizeof(footer.magic))) {
+			return false;
+		}
+
+		index.resize(footer.chunkCount);
+
+		if(footer.chunkCount > 0 && (0 != fseeko(traceFile, (off_t) footer.indexOffset, SEEK_SET) ||
+			1 != fread(&index[0], footer.chunkCount * sizeof(ColumnarIndexEntry), 1, traceFile))) {
+			index.clear();
+			return false;
+		}
+
+		recordCount = footer.recordCount;
+		complete = true;
+		return true;
+	}
+
+	void scanChunks() {
+		fseeko(traceFile, 0, SEEK_END);
+		const uint64_t fileBytes = (uint64_t) ftello(traceFile);
+
+		uint64_t offset = sizeof(ColumnarFileHeader);
+		ColumnarChunkHeader header;
+
+		index.clear();
+		recordCount = 0;
+
+		while(0 == fseeko(traceFile, (off_t) offset, SEEK_SET) &&
+			1 == fread(&header, sizeof(header), 1, traceFile) &&
+			header.records > 0 && header.records <= chunkRecords && header.method <= COLUMNAR_ZLIB &&
+			offset + sizeof(header) + header.storedBytes <= fileBytes) {
+
+			ColumnarIndexEntry entry;
+			entry.offset = offset;
+			entry.firstRecord = recordCount;
+			entry.firstCycle = header.firstCycle;
+			index.push_back(entry);
+
+			recordCount += header.records;
+			offset += sizeof(header) + header.storedBytes;
+		}
+	}
+
+	FILE* traceFile;
+	uint32_t chunkRecords;
+	uint64_t recordCount;
+	bool complete;
+	std::vector<ColumnarIndexEntry> index;
+	std::vector<uint8_t> stored;
+	std::vector<uint8_t> raw;
+
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,102 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "proscolumnarreader.h"
+
+using namespace SST::Prospero;
+
+
+ProsperoColumnarTraceReader::ProsperoColumnarTraceReader( ComponentId_t id, Params& params, Output* out ) :
+	ProsperoTraceReader(id, params, out),
+	nextEntry(0), nextChunk(0) {
+
+	statChunksRead = registerStatistic<uint64_t>("chunks_read");
+
+	std::string traceFile = params.find<std::string>("file", "");
+	std::string error;
+
+	if(!trace.open(traceFile, error)) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: %s in columnar reader.\n",
+			getName().c_str(), error.c_str());
+	}
+
+	output->verbose(CALL_INFO, 1, 0, "Columnar trace %s: %" PRIu64 " records in %" PRIu64 " chunks%s\n",
+		traceFile.c_str(), trace.getRecordCount(), trace.getChunkCount(),
+		trace.isComplete() ? "" : " (no index, trace was not finished)");
+
+	entries.reserve(trace.getChunkRecords());
+
+	const uint64_t startRecord = params.find<uint64_t>("start_record", 0);
+	const uint64_t startCycle = params.find<uint64_t>("start_cycle", 0);
+
+	if(startRecord > 0 || startCycle > 0) {
+		// Start from whichever chunk is later, then skip to the first record wanted in it
+		const uint64_t recordChunk = trace.findChunkByRecord(startRecord);
+		const uint64_t cycleChunk = trace.findChunkByCycle(startCycle);
+		nextChunk = std::max(recordChunk, cycleChunk);
+
+		if(loadChunk(nextChunk)) {
+			const uint64_t firstRecord = trace.getIndexEntry(nextChunk - 1).firstRecord;
+
+			while(nextEntry < entries.size() &&
+				(firstRecord + nextEntry < startRecord || entries[nextEntry].getIssueAtCycle() < startCycle)) {
+				nextEntry++;
+			}
+
+			output->verbose(CALL_INFO, 1, 0, "Starting columnar trace at record %" PRIu64 " (chunk %" PRIu64 ")\n",
+				firstRecord + nextEntry, nextChunk - 1);
+		}
+	}
+}
+
+ProsperoColumnarTraceReader::~ProsperoColumnarTraceReader() {
+
+}
+
+bool ProsperoColumnarTraceReader::loadChunk(const uint64_t chunk) {
+	entries.clear();
+	nextEntry = 0;
+
+	if(chunk >= trace.getChunkCount()) {
+		return false;
+	}
+
+	EntrySink sink;
+	sink.entries = &entries;
+	std::string error;
+
+	if(!trace.readChunk(chunk, sink, error)) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: %s (chunk %" PRIu64 ") in columnar reader.\n",
+			getName().c_str(), error.c_str(), chunk);
+	}
+
+	statChunksRead->addData(1);
+	nextChunk = chunk + 1;
+	return true;
+}
+
+ProsperoTraceEntry* ProsperoColumnarTraceReader::readNextEntry() {
+	// Chunks are never empty, but a start point can skip to the end of one
+	while(nextEntry == entries.size()) {
+		if(!loadChunk(nextChunk)) {
+			output->verbose(CALL_INFO, 2, 0, "End of trace file reached, returning empty request.\n");
+			return NULL;
+		}
+	}
+
+	return &entries[nextEntry++];
+}
@@ -0,0 +1,85 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_COLUMNAR_READER
+#define _H_SST_PROSPERO_COLUMNAR_READER
+
+#include "prosreader.h"
+#include "proscolumnar.h"
+
+#include <vector>
+
+namespace SST {
+namespace Prospero {
+
+/*
+ * Reads traces in the columnar format (see proscolumnar.h) a chunk at a
+ * time.  The chunk index lets the trace be started part way through.
+ * Entries belong to the reader and are overwritten when the next chunk
+ * is loaded, so an entry must not be used after the next call to
+ * readNextEntry.
+ */
+class ProsperoColumnarTraceReader : public ProsperoTraceReader {
+
+public:
+	ProsperoColumnarTraceReader( ComponentId_t id, Params& params, Output* out );
+	~ProsperoColumnarTraceReader();
+	ProsperoTraceEntry* readNextEntry();
+	void releaseEntry(const ProsperoTraceEntry* entry) { }
+
+	SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+		ProsperoColumnarTraceReader,
+		"prospero",
+		"ProsperoColumnarTraceReader",
+		SST_ELI_ELEMENT_VERSION(1,0,0),
+		"Columnar (delta encoded, chunked) trace reader",
+		SST::Prospero::ProsperoTraceReader
+	)
+
+	SST_ELI_DOCUMENT_PARAMS(
+		{ "file", "Sets the file for the trace reader to use", "" },
+		{ "start_record", "Skip the records before this one", "0" },
+		{ "start_cycle", "Skip the records issued before this cycle", "0" }
+	)
+
+	SST_ELI_DOCUMENT_STATISTICS(
+		{ "chunks_read", "Number of chunks of records decoded", "chunks", 1 }
+	)
+
+private:
+	struct EntrySink {
+		std::vector<ProsperoTraceEntry>* entries;
+
+		void operator()(const uint64_t cycle, const uint64_t address, const uint32_t length, const bool isWrite) {
+			entries->push_back(ProsperoTraceEntry(cycle, address, length, isWrite ? WRITE : READ));
+		}
+	};
+
+	bool loadChunk(const uint64_t chunk);
+
+	ProsperoColumnarTraceFile trace;
+	std::vector<ProsperoTraceEntry> entries;
+	size_t nextEntry;
+	uint64_t nextChunk;
+
+	Statistic<uint64_t>* statChunksRead;
+
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,497 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include <inttypes.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <string>
+#include <vector>
+
+#include "proscolumnar.h"
+
+using namespace SST::Prospero;
+
+/*
+ * Converts memory traces between the Prospero trace formats.  Text and
+ * binary records are "cycles op address length", see the Prospero
+ * readers.
+ */
+
+struct TraceRecord {
+	uint64_t cycles;
+	uint64_t address;
+	uint32_t length;
+	bool isWrite;
+};
+
+static const size_t BINARY_RECORD_LENGTH = sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t);
+
+static void fail(const std::string& message) {
+	fprintf(stderr, "sst-prospero-convert: %s\n", message.c_str());
+	exit(-1);
+}
+
+static void printUsage() {
+	printf("sst-prospero-convert [options] <input trace> <output trace>\n");
+	printf("\n");
+	printf("Options:\n");
+	printf("  -i <format>   Input <format> = {text, binary, compressed, columnar}, detected from the\n");
+	printf("                file header if not set (a trace that is not columnar or gzip is binary)\n");
+	printf("  -f <format>   Output <format> = {text, binary, compressed, columnar}, default columnar\n");
+	printf("  -c <records>  Records per chunk of columnar output, default 65536\n");
+	printf("  -l <level>    zlib level for columnar output, 0 stores chunks uncompressed, default 6\n");
+	printf("  -s <record>   First record to convert, columnar input seeks to it with the chunk index\n");
+	printf("  -n <count>    Number of records to convert, default all\n");
+	printf("  -v            Print the size of the trace and how it was chunked\n");
+	printf("\n");
+}
+
+class TraceInput {
+public:
+	virtual ~TraceInput() {}
+	virtual bool next(TraceRecord& record) = 0;
+	// Skips records, returns the number skipped
+	virtual uint64_t skip(const uint64_t count) {
+		TraceRecord ignored;
+		uint64_t skipped = 0;
+
+		while(skipped < count && next(ignored)) {
+			skipped++;
+		}
+
+		return skipped;
+	}
+};
+
+class TextInput : public TraceInput {
+public:
+	TextInput(const std::string& path) {
+		input = fopen(path.c_str(), "rt");
+
+		if(NULL == input) {
+			fail("unable to open " + path);
+		}
+	}
+
+	~TextInput() { fclose(input); }
+
+	bool next(TraceRecord& record) {
+		char type = 'R';
+
+		if(4 != fscanf(input, "%" PRIu64 " %c %" PRIu64 " %" PRIu32 "",
+			&record.cycles, &type, &record.address, &record.length)) {
+			return false;
+		}
+
+		record.isWrite = !(type == 'R' || type == 'r');
+		return true;
+	}
+
+private:
+	FILE* input;
+};
+
+class BinaryInput : public TraceInput {
+public:
+	BinaryInput(const std::string& path, const bool compressed) {
+		input = NULL;
+#ifdef HAVE_LIBZ
+		inputZ = Z_NULL;
+
+		if(compressed) {
+			inputZ = gzopen(path.c_str(), "rb");
+
+			if(Z_NULL == inputZ) {
+				fail("unable to open " + path);
+			}
+
+			return;
+		}
+#else
+		if(compressed) {
+			fail("compressed traces need zlib, which this build does not have");
+		}
+#endif
+
+		input = fopen(path.c_str(), "rb");
+
+		if(NULL == input) {
+			fail("unable to open " + path);
+		}
+	}
+
+	~BinaryInput() {
+		if(NULL != input) {
+			fclose(input);
+		}
+#ifdef HAVE_LIBZ
+		if(Z_NULL != inputZ) {
+			gzclose(inputZ);
+		}
+#endif
+	}
+
+	bool next(TraceRecord& record) {
+		char buffer[BINARY_RECORD_LENGTH];
+		size_t bytesRead;
+
+#ifdef HAVE_LIBZ
+		if(Z_NULL != inputZ) {
+			const int result = gzread(inputZ, buffer, BINARY_RECORD_LENGTH);
+			bytesRead = (result < 0) ? 0 : (size_t) result;
+		} else
+#endif
+		{
+			bytesRead = fread(buffer, 1, BINARY_RECORD_LENGTH, input);
+		}
+
+		if(BINARY_RECORD_LENGTH != bytesRead) {
+			return false;
+		}
+
+		const char type = buffer[sizeof(uint64_t)];
+
+		memcpy(&record.cycles, buffer, sizeof(uint64_t));
+		memcpy(&record.address, buffer + sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
+		memcpy(&record.length, buffer + sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
+		record.isWrite = !(type == 'R' || type == 'r');
+		return true;
+	}
+
+private:
+	FILE* input;
+#ifdef HAVE_LIBZ
+	gzFile inputZ;
+#endif
+};
+
+class ColumnarInput : public TraceInput {
+public:
+	ColumnarInput(const std::string& path) : nextChunk(0), nextRecord(0) {
+		std::string error;
+
+		if(!trace.open(path, error)) {
+			fail(error);
+		}
+	}
+
+	bool next(TraceRecord& record) {
+		while(nextRecord == records.size()) {
+			if(nextChunk == trace.getChunkCount()) {
+				return false;
+			}
+
+			load(nextChunk);
+		}
+
+		record = records[nextRecord++];
+		return true;
+	}
+
+	// Jumps straight to the chunk holding the first record wanted
+	uint64_t skip(const uint64_t count) {
+		const uint64_t chunk = trace.findChunkByRecord(count);
+
+		if(chunk == trace.getChunkCount()) {
+			records.clear();
+			nextRecord = 0;
+			nextChunk = chunk;
+			return trace.getRecordCount();
+		}
+
+		load(chunk);
+		nextRecord = (size_t) (count - trace.getIndexEntry(chunk).firstRecord);
+		return count;
+	}
+
+	void operator()(const uint64_t cycles, const uint64_t address, const uint32_t length, const bool isWrite) {
+		TraceRecord record;
+		record.cycles = cycles;
+		record.address = address;
+		record.length = length;
+		record.isWrite = isWrite;
+		records.push_back(record);
+	}
+
+	const ProsperoColumnarTraceFile& getTrace() const { return trace; }
+
+private:
+	void load(const uint64_t chunk) {
+		std::string error;
+
+		records.clear();
+		nextRecord = 0;
+
+		if(!trace.readChunk(chunk, *this, error)) {
+			fail(error);
+		}
+
+		nextChunk = chunk + 1;
+	}
+
+	ProsperoColumnarTraceFile trace;
+	std::vector<TraceRecord> records;
+	uint64_t nextChunk;
+	size_t nextRecord;
+};
+
+class TraceOutput {
+public:
+	virtual ~TraceOutput() {}
+	virtual void write(const TraceRecord& record) = 0;
+	virtual void finish() = 0;
+};
+
+class TextOutput : public TraceOutput {
+public:
+	TextOutput(const std::string& path) {
+		output = fopen(path.c_str(), "wt");
+
+		if(NULL == output) {
+			fail("unable to open " + path + " for writing");
+		}
+	}
+
+	void write(const TraceRecord& record) {
+		fprintf(output, "%" PRIu64 " %s %" PRIu64 " %" PRIu32 "\n",
+			record.cycles, record.isWrite ? "W" : "R", record.address, record.length);
+	}
+
+	void finish() {
+		if(0 != fclose(output)) {
+			fail("unable to write the output trace");
+		}
+	}
+
+private:
+	FILE* output;
+};
+
+class BinaryOutput : public TraceOutput {
+public:
+	BinaryOutput(const std::string& path, const bool compressed) {
+		output = NULL;
+#ifdef HAVE_LIBZ
+		outputZ = Z_NULL;
+
+		if(compressed) {
+			outputZ = gzopen(path.c_str(), "wb");
+
+			if(Z_NULL == outputZ) {
+				fail("unable to open " + path + " for writing");
+			}
+
+			return;
+		}
+#else
+		if(compressed) {
+			fail("compressed traces need zlib, which this build does not have");
+		}
+#endif
+
+		output = fopen(path.c_str(), "wb");
+
+		if(NULL == output) {
+			fail("unable to open " + path + " for writing");
+		}
+	}
+
+	void write(const TraceRecord& record) {
+		char buffer[BINARY_RECORD_LENGTH];
+		const char type = record.isWrite ? 'W' : 'R';
+
+		memcpy(buffer, &record.cycles, sizeof(uint64_t));
+		buffer[sizeof(uint64_t)] = type;
+		memcpy(buffer + sizeof(uint64_t) + sizeof(char), &record.address, sizeof(uint64_t));
+		memcpy(buffer + sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), &record.length, sizeof(uint32_t));
+
+#ifdef HAVE_LIBZ
+		if(Z_NULL != outputZ) {
+			gzwrite(outputZ, buffer, BINARY_RECORD_LENGTH);
+			return;
+		}
+#endif
+		fwrite(buffer, 1, BINARY_RECORD_LENGTH, output);
+	}
+
+	void finish() {
+#ifdef HAVE_LIBZ
+		if(Z_NULL != outputZ) {
+			if(Z_OK != gzclose(outputZ)) {
+				fail("unable to write the output trace");
+			}
+
+			return;
+		}
+#endif
+		if(0 != fclose(output)) {
+			fail("unable to write the output trace");
+		}
+	}
+
+private:
+	FILE* output;
+#ifdef HAVE_LIBZ
+	gzFile outputZ;
+#endif
+};
+
+class ColumnarOutput : public TraceOutput {
+public:
+	ColumnarOutput(const std::string& path, const uint32_t chunkRecords, const int level) {
+		std::string error;
+
+		if(!writer.open(path, chunkRecords, level, error)) {
+			fail(error);
+		}
+	}
+
+	void write(const TraceRecord& record) {
+		writer.append(record.cycles, record.address, record.length, record.isWrite);
+	}
+
+	void finish() {
+		std::string error;
+
+		if(!writer.close(error)) {
+			fail(error);
+		}
+	}
+
+private:
+	ProsperoColumnarTraceWriter writer;
+};
+
+static std::string detectFormat(const std::string& path) {
+	if(ProsperoColumnarTraceFile::isColumnar(path)) {
+		return "columnar";
+	}
+
+	FILE* probe = fopen(path.c_str(), "rb");
+	unsigned char magic[2] = { 0, 0 };
+
+	if(NULL == probe) {
+		fail("unable to open " + path);
+	}
+
+	const bool gzip = (2 == fread(magic, 1, 2, probe)) && magic[0] == 0x1f && magic[1] == 0x8b;
+	fclose(probe);
+
+	return gzip ? "compressed" : "binary";
+}
+
+int main(int argc, char* argv[]) {
+	std::string inputFormat = "";
+	std::string outputFormat = "columnar";
+	uint32_t chunkRecords = 65536;
+	int level = 6;
+	uint64_t startRecord = 0;
+	uint64_t recordLimit = UINT64_MAX;
+	bool verbose = false;
+
+	int option;
+
+	while(-1 != (option = getopt(argc, argv, "i:f:c:l:s:n:vh"))) {
+		switch(option) {
+		case 'i': inputFormat = optarg; break;
+		case 'f': outputFormat = optarg; break;
+		case 'c': chunkRecords = (uint32_t) strtoul(optarg, NULL, 0); break;
+		case 'l': level = atoi(optarg); break;
+		case 's': startRecord = strtoull(optarg, NULL, 0); break;
+		case 'n': recordLimit = strtoull(optarg, NULL, 0); break;
+		case 'v': verbose = true; break;
+		case 'h':
+			printUsage();
+			exit(0);
+		default:
+			printUsage();
+			exit(-1);
+		}
+	}
+
+	if(argc - optind != 2) {
+		printUsage();
+		exit(-1);
+	}
+
+	const std::string inputPath = argv[optind];
+	const std::string outputPath = argv[optind + 1];
+
+	if("" == inputFormat) {
+		inputFormat = detectFormat(inputPath);
+	}
+
+	TraceInput* input = NULL;
+	ColumnarInput* columnarInput = NULL;
+
+	if("text" == inputFormat) {
+		input = new TextInput(inputPath);
+	} else if("binary" == inputFormat || "compressed" == inputFormat) {
+		input = new BinaryInput(inputPath, "compressed" == inputFormat);
+	} else if("columnar" == inputFormat) {
+		input = columnarInput = new ColumnarInput(inputPath);
+	} else {
+		fail("unknown input format " + inputFormat);
+	}
+
+	TraceOutput* output = NULL;
+
+	if("text" == outputFormat) {
+		output = new TextOutput(outputPath);
+	} else if("binary" == outputFormat || "compressed" == outputFormat) {
+		output = new BinaryOutput(outputPath, "compressed" == outputFormat);
+	} else if("columnar" == outputFormat) {
+		output = new ColumnarOutput(outputPath, chunkRecords, level);
+	} else {
+		fail("unknown output format " + outputFormat);
+	}
+
+	if(verbose && NULL != columnarInput) {
+		const ProsperoColumnarTraceFile& trace = columnarInput->getTrace();
+		printf("%s: %" PRIu64 " records in %" PRIu64 " chunks of up to %" PRIu32 " records%s\n",
+			inputPath.c_str(), trace.getRecordCount(), trace.getChunkCount(), trace.getChunkRecords(),
+			trace.isComplete() ? "" : ", no index (the trace was not finished)");
+	}
+
+	if(startRecord > 0) {
+		input->skip(startRecord);
+	}
+
+	TraceRecord record;
+	uint64_t converted = 0;
+
+	while(converted < recordLimit && input->next(record)) {
+		output->write(record);
+		converted++;
+	}
+
+	output->finish();
+
+	if(verbose) {
+		printf("Converted %" PRIu64 " records from %s (%s) to %s (%s)\n", converted,
+			inputPath.c_str(), inputFormat.c_str(), outputPath.c_str(), outputFormat.c_str());
+	}
+
+	delete output;
+	delete input;
+
+	return 0;
+}
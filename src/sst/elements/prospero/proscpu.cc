@@ -19,6 +19,7 @@
 
 #include "proscpu.h"
 #include <algorithm>
+#include <cmath>
 
 using namespace SST;
 using namespace SST::Prospero;
@@ -67,6 +68,40 @@ ProsperoComponent::ProsperoComponent(ComponentId_t id, Params& params) :
 	maxIssuePerCycle = (uint32_t) params.find<uint32_t>("max_issue_per_cycle", 2);
 	output->verbose(CALL_INFO, 1, 0, "Configured maximum transaction issue per cycle %" PRIu32 "\n", maxIssuePerCycle);
 
+	clockTC = time;
+	issueOffset = 0;
+
+	sampling = params.find<bool>("sampling", false);
+	samplePeriod = params.find<uint64_t>("sample_period", 1000000);
+	sampleWindow = params.find<uint64_t>("sample_window", 10000);
+	sampleWarmup = params.find<uint64_t>("sample_warmup", 2000);
+	warmIssuePerCycle = params.find<uint32_t>("sample_warm_issue_per_cycle", 16);
+
+	std::string fastForwardMode = params.find<std::string>("sample_fastforward", "warm");
+
+	if(sampling) {
+		if(0 == sampleWindow || sampleWarmup + sampleWindow > samplePeriod) {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: sample_window must be at least 1 and sample_warmup + sample_window no more than sample_period\n",
+				getName().c_str());
+		}
+
+		if("warm" == fastForwardMode) {
+			sampleSkip = false;
+		} else if("skip" == fastForwardMode) {
+			sampleSkip = true;
+		} else {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: unknown sample_fastforward mode: %s, use warm or skip\n",
+				getName().c_str(), fastForwardMode.c_str());
+		}
+
+		if(0 == warmIssuePerCycle) {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: sample_warm_issue_per_cycle must be at least 1\n", getName().c_str());
+		}
+
+		output->verbose(CALL_INFO, 1, 0, "Configured sampling: period %" PRIu64 ", warmup %" PRIu64 ", window %" PRIu64 " records, fast forward by %s\n",
+			samplePeriod, sampleWarmup, sampleWindow, fastForwardMode.c_str());
+	}
+
 	// tell the simulator not to end without us
   	registerAsPrimaryComponent();
   	primaryComponentDoNotEndSim();
@@ -106,6 +141,24 @@ ProsperoComponent::ProsperoComponent(ComponentId_t id, Params& params) :
 	currentOutstanding = 0;
 	cyclesWithNoIssue = 0;
 	cyclesWithIssue = 0;
+	cyclesFastForward = 0;
+
+	windowOpen = false;
+	windowIssued = false;
+	windowStart = 0;
+	windowLatency = 0;
+	windowRequests = 0;
+	phaseRecords[SAMPLE_FASTFORWARD] = 0;
+	phaseRecords[SAMPLE_WARMUP] = 0;
+	phaseRecords[SAMPLE_MEASURE] = 0;
+
+	// Every period starts with the fast forward, the first record keeps its own trace timing
+	samplePhase = SAMPLE_WARMUP;
+	phaseRemaining = 0;
+
+	if(sampling) {
+		enterPhase(SAMPLE_FASTFORWARD);
+	}
 
 	output->verbose(CALL_INFO, 1, 0, "Prospero configuration completed successfully.\n");
 
@@ -132,6 +185,10 @@ void ProsperoComponent::finish() {
 	output->output("- Cycles with ops issued:                %" PRIu64 " cycles\n", cyclesWithIssue);
 	output->output("- Cycles with no ops issued (LS full):   %" PRIu64 " cycles\n", cyclesWithNoIssue);
 
+	if(sampling) {
+		output->output("- Cycles fast forwarding:                %" PRIu64 " cycles\n", cyclesFastForward);
+	}
+
 	output->output("------------------------------------------------------------------------\n");
 	output->output("- Reads issued:                          %" PRIu64 "\n", readsIssued);
 	output->output("- Writes issued:                         %" PRIu64 "\n", writesIssued);
@@ -178,14 +235,92 @@ void ProsperoComponent::finish() {
 	output->output("- Avr. Request size:                     %20.2f bytes\n",
 		((double) PROSPERO_MAX(totalBytesRead + totalBytesWritten, 1)) /
 		((double) PROSPERO_MAX(readsIssued + writesIssued, 1)));
+
+	if(sampling) {
+		printSampleSummary();
+	}
+
 	output->output("\n");
 }
 
+void ProsperoComponent::printSampleSummary() {
+	const uint64_t totalRecords = phaseRecords[SAMPLE_FASTFORWARD] + phaseRecords[SAMPLE_WARMUP] + phaseRecords[SAMPLE_MEASURE];
+	const size_t windows = windowCyclesPerRecord.size();
+
+	output->output("------------------------------------------------------------------------\n");
+	output->output("- Records fast forwarded:                %" PRIu64 " (%s)\n", phaseRecords[SAMPLE_FASTFORWARD], sampleSkip ? "skipped" : "warmed");
+	output->output("- Records in detailed warmup:            %" PRIu64 "\n", phaseRecords[SAMPLE_WARMUP]);
+	output->output("- Records measured:                      %" PRIu64 "\n", phaseRecords[SAMPLE_MEASURE]);
+	output->output("- Windows measured:                      %" PRIu64 "\n", (uint64_t) windows);
+
+	if(0 == windows) {
+		output->output("- No complete window, the trace is shorter than one sampling period\n");
+		return;
+	}
+
+	// Mean and 95% confidence half width of the per window samples
+	double cprMean = 0;
+	double cprHalf = 0;
+	double latMean = 0;
+	double latHalf = 0;
+	double cprStdDev = 0;
+
+	for(size_t i = 0; i < windows; ++i) {
+		cprMean += windowCyclesPerRecord[i];
+		latMean += windowAvrLatency[i];
+	}
+
+	cprMean /= (double) windows;
+	latMean /= (double) windows;
+
+	if(windows > 1) {
+		double cprVar = 0;
+		double latVar = 0;
+
+		for(size_t i = 0; i < windows; ++i) {
+			cprVar += (windowCyclesPerRecord[i] - cprMean) * (windowCyclesPerRecord[i] - cprMean);
+			latVar += (windowAvrLatency[i] - latMean) * (windowAvrLatency[i] - latMean);
+		}
+
+		cprStdDev = std::sqrt(cprVar / (double) (windows - 1));
+		cprHalf = 1.96 * cprStdDev / std::sqrt((double) windows);
+		latHalf = 1.96 * std::sqrt(latVar / (double) (windows - 1)) / std::sqrt((double) windows);
+	}
+
+	output->output("- Cycles per record (95%% confidence):    %20.4f +/- %.4f (%.2f%%)\n",
+		cprMean, cprHalf, 100.0 * cprHalf / PROSPERO_MAX(cprMean, 1e-12));
+	output->output("- Avr. request latency (95%% confidence): %20.4f +/- %.4f cycles\n",
+		latMean, latHalf);
+	output->output("- Estimated cycles for whole trace:      %20.0f +/- %.0f cycles\n",
+		cprMean * (double) totalRecords, cprHalf * (double) totalRecords);
+
+	if(windows > 1) {
+		// Windows for +/-3% at 99.7% confidence, as used by SMARTS
+		const double variation = cprStdDev / PROSPERO_MAX(cprMean, 1e-12);
+		output->output("- Windows for +/-3%% at 99.7%% confidence: %20.0f\n",
+			std::ceil((3.0 * variation / 0.03) * (3.0 * variation / 0.03)));
+	}
+}
+
 void ProsperoComponent::handleResponse(SimpleMem::Request *ev) {
 	output->verbose(CALL_INFO, 4, 0, "Handle response from memory subsystem.\n");
 
 	currentOutstanding--;
 
+	if(!windowPending.empty()) {
+		std::unordered_map<SimpleMem::Request::id_t, uint64_t>::iterator pending = windowPending.find(ev->id);
+
+		if(pending != windowPending.end()) {
+			windowLatency += getCurrentSimTime(clockTC) - pending->second;
+			windowRequests++;
+			windowPending.erase(pending);
+
+			if(windowIssued && windowPending.empty()) {
+				closeWindow();
+			}
+		}
+	}
+
 	// Our responsibility to delete incoming event
 	delete ev;
 }
@@ -211,23 +346,33 @@ bool ProsperoComponent::tick(SST::Cycle_t currentCycle) {
 		return false;
 	}
 
+	if(sampling && SAMPLE_FASTFORWARD == samplePhase) {
+		fastForward();
+		cyclesFastForward++;
+		return false;
+	}
+
 	const uint64_t outstandingBeforeIssue = currentOutstanding;
 
 	// Wait to see if the current operation can be issued, if yes then
 	// go ahead and issue it, otherwise we will stall
 	for(uint32_t i = 0; i < maxIssuePerCycle; ++i) {
-		if(currentCycle >= currentEntry->getIssueAtCycle()) {
+		if((int64_t) currentCycle >= (int64_t) currentEntry->getIssueAtCycle() + issueOffset) {
 			if(currentOutstanding < maxOutstanding) {
 				// Issue the pending request into the memory subsystem
 				issueRequest(currentEntry);
 
 				// Obtain the next newest request
-				currentEntry = reader->readNextEntry();
+				nextEntry();
 
 				// Trace reader has read all entries, time to begin draining
 				// the system, caches etc
-				if(NULL == currentEntry) {
-					traceEnded = true;
+				if(traceEnded) {
+					break;
+				}
+
+				// The rest of the sampling period is fast forwarded from the next cycle
+				if(sampling && SAMPLE_FASTFORWARD == samplePhase) {
 					break;
 				}
 			} else {
@@ -236,7 +381,7 @@ bool ProsperoComponent::tick(SST::Cycle_t currentCycle) {
 			}
 		} else {
 			output->verbose(CALL_INFO, 8, 0, "Not issuing on cycle %" PRIu64 ", waiting for cycle: %" PRIu64 "\n",
-				(uint64_t) currentCycle, currentEntry->getIssueAtCycle());
+				(uint64_t) currentCycle, (uint64_t) ((int64_t) currentEntry->getIssueAtCycle() + issueOffset));
 			// Have reached a point in the trace which is too far ahead in time
 			// so stall until we find that point
 			break;
@@ -296,8 +441,8 @@ void ProsperoComponent::issueRequest(const ProsperoTraceEntry* entry) {
 			upperAddress, upperLength);
         reqUpper->setVirtualAddress((entryAddress - (entryAddress % cacheLineSize)) + cacheLineSize);
 
-		cache_link->sendRequest(reqLower);
-		cache_link->sendRequest(reqUpper);
+		sendRequest(reqLower);
+		sendRequest(reqUpper);
 
 		if(isRead) {
 			readsIssued += 2;
@@ -315,7 +460,7 @@ void ProsperoComponent::issueRequest(const ProsperoTraceEntry* entry) {
 			isRead ? SimpleMem::Request::Read : SimpleMem::Request::Write,
 			memMgr->translate(entryAddress), entryLength);
         request->setVirtualAddress(entryAddress);
-		cache_link->sendRequest(request);
+		sendRequest(request);
 
 		if(isRead) {
 			readsIssued++;
@@ -326,6 +471,107 @@ void ProsperoComponent::issueRequest(const ProsperoTraceEntry* entry) {
 		currentOutstanding++;
 	}
 
-	// Delete this entry, we are done converting it into a request
-	delete entry;
+	// We are done converting this entry into a request
+	reader->releaseEntry(entry);
+}
+
+void ProsperoComponent::sendRequest(SimpleMem::Request* req) {
+	if(sampling && SAMPLE_MEASURE == samplePhase) {
+		windowPending[req->id] = getCurrentSimTime(clockTC);
+	}
+
+	cache_link->sendRequest(req);
+}
+
+void ProsperoComponent::nextEntry() {
+	currentEntry = reader->readNextEntry();
+	traceEnded = (NULL == currentEntry);
+
+	if(sampling) {
+		phaseRecords[samplePhase]++;
+
+		if(0 == --phaseRemaining) {
+			if(SAMPLE_MEASURE == samplePhase) {
+				windowIssued = true;
+
+				if(windowPending.empty()) {
+					closeWindow();
+				}
+			}
+
+			enterPhase((SamplePhase) ((samplePhase + 1) % 3));
+		}
+	}
+}
+
+void ProsperoComponent::fastForward() {
+	if(sampleSkip) {
+		// Records are only translated so pages are mapped in the order the trace touches them
+		while(!traceEnded && SAMPLE_FASTFORWARD == samplePhase) {
+			memMgr->translate(currentEntry->getAddress());
+			reader->releaseEntry(currentEntry);
+			nextEntry();
+		}
+	} else {
+		// Warm the caches with the records as fast as the memory system takes them
+		for(uint32_t i = 0; i < warmIssuePerCycle && currentOutstanding < maxOutstanding; ++i) {
+			issueRequest(currentEntry);
+			nextEntry();
+
+			if(traceEnded || SAMPLE_FASTFORWARD != samplePhase) {
+				break;
+			}
+		}
+	}
+}
+
+void ProsperoComponent::enterPhase(SamplePhase phase) {
+	const bool leavingFastForward = (SAMPLE_FASTFORWARD == samplePhase);
+
+	// Phases with no records are passed straight through, the window is never empty
+	while(true) {
+		const uint64_t phaseLength = (SAMPLE_FASTFORWARD == phase) ? samplePeriod - sampleWarmup - sampleWindow :
+			((SAMPLE_WARMUP == phase) ? sampleWarmup : sampleWindow);
+
+		if(phaseLength > 0) {
+			samplePhase = phase;
+			phaseRemaining = phaseLength;
+			break;
+		}
+
+		phase = (SamplePhase) ((phase + 1) % 3);
+	}
+
+	// One window is measured at a time, keep warming until the last one completes
+	if(SAMPLE_MEASURE == samplePhase && windowOpen) {
+		samplePhase = SAMPLE_WARMUP;
+		phaseRemaining = 1;
+	}
+
+	// Trace timing restarts from now, fast forwarding does not follow it
+	if(leavingFastForward && SAMPLE_FASTFORWARD != samplePhase && NULL != currentEntry) {
+		issueOffset = (int64_t) getCurrentSimTime(clockTC) - (int64_t) currentEntry->getIssueAtCycle();
+	}
+
+	if(SAMPLE_MEASURE == samplePhase) {
+		windowOpen = true;
+		windowIssued = false;
+		windowStart = getCurrentSimTime(clockTC);
+		windowLatency = 0;
+		windowRequests = 0;
+	}
+
+	output->verbose(CALL_INFO, 2, 0, "Sampling: entering phase %d for %" PRIu64 " records at cycle %" PRIu64 "\n",
+		(int) samplePhase, phaseRemaining, (uint64_t) getCurrentSimTime(clockTC));
+}
+
+void ProsperoComponent::closeWindow() {
+	const uint64_t windowCycles = getCurrentSimTime(clockTC) - windowStart;
+
+	windowCyclesPerRecord.push_back((double) windowCycles / (double) sampleWindow);
+	windowAvrLatency.push_back((0 == windowRequests) ? 0.0 : (double) windowLatency / (double) windowRequests);
+	windowOpen = false;
+
+	output->verbose(CALL_INFO, 2, 0, "Sampling: window %" PRIu64 " took %" PRIu64 " cycles, %" PRIu64 " requests\n",
+		(uint64_t) windowCyclesPerRecord.size(), windowCycles, windowRequests);
 }
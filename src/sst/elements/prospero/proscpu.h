@@ -25,6 +25,9 @@
 #include "sst/core/link.h"
 #include "sst/core/interfaces/simpleMem.h"
 
+#include <unordered_map>
+#include <vector>
+
 #include "prosreader.h"
 #include "prosmemmgr.h"
 
@@ -65,6 +68,12 @@ public:
     	{ "clock", "Sets the clock of the core", "2GHz"} ,
     	{ "max_outstanding", "Sets the maximum number of outstanding transactions that the memory system will allow", "16"},
     	{ "max_issue_per_cycle", "Sets the maximum number of new transactions that the system can issue per cycle", "2"},
+	{ "sampling", "Set to 1 to simulate sampled windows of the trace in detail and fast forward the rest of it", "0" },
+	{ "sample_period", "Trace records in each sampling period, the measured window is at the end of the period", "1000000" },
+	{ "sample_window", "Trace records measured in detail in each period", "10000" },
+	{ "sample_warmup", "Trace records simulated in detail, but not measured, before each window", "2000" },
+	{ "sample_fastforward", "Fast forward mode, 'warm' sends records to the memory system without trace timing to warm the caches, 'skip' drops them", "warm" },
+	{ "sample_warm_issue_per_cycle", "Sets the maximum number of transactions issued per cycle while warming", "16" },
    )
 
    SST_ELI_DOCUMENT_PORTS(
@@ -80,9 +89,22 @@ private:
   ProsperoComponent(const ProsperoComponent&); // Do not impl.
   void operator=(const ProsperoComponent&);    // Do not impl.
 
+  // Sampling divides each period of the trace into these phases, in order
+  enum SamplePhase {
+	SAMPLE_FASTFORWARD,
+	SAMPLE_WARMUP,
+	SAMPLE_MEASURE
+  };
+
   void handleResponse( SimpleMem::Request* ev );
   bool tick( Cycle_t );
   void issueRequest(const ProsperoTraceEntry* entry);
+  void sendRequest(SimpleMem::Request* req);
+  void nextEntry();
+  void fastForward();
+  void enterPhase(SamplePhase phase);
+  void closeWindow();
+  void printSampleSummary();
 
   Output* output;
   ProsperoTraceReader* reader;
@@ -109,6 +131,29 @@ private:
   uint64_t cyclesWithIssue;
   uint64_t cyclesWithNoIssue;
 
+  TimeConverter* clockTC;
+  int64_t issueOffset;		// Added to trace cycles, moves the trace on past fast forwarded records
+
+  bool sampling;
+  bool sampleSkip;
+  uint64_t samplePeriod;
+  uint64_t sampleWarmup;
+  uint64_t sampleWindow;
+  uint32_t warmIssuePerCycle;
+  SamplePhase samplePhase;
+  uint64_t phaseRemaining;	// Records left in the phase
+  uint64_t phaseRecords[3];
+
+  bool windowOpen;
+  bool windowIssued;		// Every record of the open window has been issued
+  uint64_t windowStart;
+  uint64_t windowLatency;
+  uint64_t windowRequests;
+  std::unordered_map<SimpleMem::Request::id_t, uint64_t> windowPending;	// Issue cycle of measured requests
+  std::vector<double> windowCyclesPerRecord;
+  std::vector<double> windowAvrLatency;
+  uint64_t cyclesFastForward;
+
 };
 
 }
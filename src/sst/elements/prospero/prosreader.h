@@ -32,6 +32,11 @@ typedef enum {
 
 class ProsperoTraceEntry {
 public:
+	ProsperoTraceEntry() :
+		cycles(0), address(0), length(0), op(READ) {
+
+		}
+
 	ProsperoTraceEntry(
 		const uint64_t eCyc,
 		const uint64_t eAddr,
@@ -48,10 +53,10 @@ public:
 	uint64_t getIssueAtCycle() const { return cycles; }
 	ProsperoTraceEntryOperation getOperationType() const { return op; }
 private:
-	const uint64_t cycles;
-	const uint64_t address;
-	const uint32_t length;
-	const ProsperoTraceEntryOperation op;
+	uint64_t cycles;
+	uint64_t address;
+	uint32_t length;
+	ProsperoTraceEntryOperation op;
 };
 
 class ProsperoTraceReader : public SubComponent {
@@ -64,7 +69,13 @@ public:
         }
 
 	~ProsperoTraceReader() { };
+	// Returns the next entry of the trace, or NULL once it has ended. Callers
+	// must release an entry before reading the next one: readers that decode
+	// into reused buffers (stream, columnar) may overwrite an entry on the
+	// next call.
 	virtual ProsperoTraceEntry* readNextEntry() { return NULL; };
+	// Called once the component is done with an entry from readNextEntry
+	virtual void releaseEntry(const ProsperoTraceEntry* entry) { delete entry; }
 	void setOutput(Output* out) { output = out; }
 
 protected:
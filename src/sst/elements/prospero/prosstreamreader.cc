@@ -0,0 +1,322 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "prosstreamreader.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace SST::Prospero;
+
+
+ProsperoStreamTraceReader::ProsperoStreamTraceReader( ComponentId_t id, Params& params, Output* out ) :
+	ProsperoTraceReader(id, params, out),
+	traceInput(NULL),
+#ifdef HAVE_LIBZ
+	traceInputZ(Z_NULL),
+#endif
+	mapBase(NULL), mapLength(0), mapOffset(0),
+	current(NULL), currentBlock(0), currentIndex(0), traceEnded(false),
+	stopping(false) {
+
+	recordLength = sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t);
+
+	blockEntries = (size_t) params.find<uint64_t>("block_entries", 65536);
+	useThread = params.find<bool>("read_ahead", true);
+	const size_t blockCount = useThread ? (size_t) params.find<uint32_t>("blocks", 4) : 1;
+
+	if(0 == blockEntries || 0 == blockCount) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: block_entries and blocks must be at least 1.\n",
+			getName().c_str());
+	}
+
+	statBlocksRead = registerStatistic<uint64_t>("blocks_read");
+	statReadWaits = registerStatistic<uint64_t>("read_waits");
+
+	std::string traceFile = params.find<std::string>("file", "");
+	const bool useMap = params.find<bool>("mmap", true);
+
+	openTrace(traceFile);
+
+	if(useMap && NULL != traceInput) {
+		struct stat traceStat;
+		const int traceFD = fileno(traceInput);
+
+		if(0 == fstat(traceFD, &traceStat) && traceStat.st_size > 0) {
+			void* map = mmap(NULL, (size_t) traceStat.st_size, PROT_READ, MAP_PRIVATE, traceFD, 0);
+
+			if(MAP_FAILED != map) {
+				madvise(map, (size_t) traceStat.st_size, MADV_SEQUENTIAL);
+				mapBase = (const char*) map;
+				mapLength = (size_t) traceStat.st_size;
+			} else {
+				output->verbose(CALL_INFO, 1, 0, "Unable to map %s (%s), reading it instead.\n",
+					traceFile.c_str(), strerror(errno));
+			}
+		}
+	}
+
+	if(NULL == mapBase) {
+		rawBuffer.resize(blockEntries * recordLength);
+	}
+
+	ring.resize(blockCount);
+	for(size_t i = 0; i < blockCount; ++i) {
+		ring[i].entries.resize(blockEntries);
+		ring[i].count = 0;
+		ring[i].ready = false;
+		ring[i].last = false;
+		ring[i].error = false;
+	}
+
+	output->verbose(CALL_INFO, 1, 0, "Stream reader: %" PRIu64 " blocks of %" PRIu64 " records, %s, %s\n",
+		(uint64_t) blockCount, (uint64_t) blockEntries,
+		useThread ? "read ahead thread" : "no read ahead thread",
+		NULL != mapBase ? "mapped" : "read");
+
+	if(useThread) {
+		worker = std::thread(&ProsperoStreamTraceReader::readAhead, this);
+	}
+}
+
+ProsperoStreamTraceReader::~ProsperoStreamTraceReader() {
+	if(worker.joinable()) {
+		{
+			std::lock_guard<std::mutex> guard(ringLock);
+			stopping = true;
+		}
+		blockFreed.notify_all();
+		worker.join();
+	}
+
+	if(NULL != mapBase) {
+		munmap((void*) mapBase, mapLength);
+	}
+
+	if(NULL != traceInput) {
+		fclose(traceInput);
+	}
+
+#ifdef HAVE_LIBZ
+	if(Z_NULL != traceInputZ) {
+		gzclose(traceInputZ);
+	}
+#endif
+}
+
+void ProsperoStreamTraceReader::openTrace(const std::string& traceFile) {
+	traceInput = fopen(traceFile.c_str(), "rb");
+
+	if(NULL == traceInput) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: Error opening trace file: %s in stream reader.\n",
+			getName().c_str(), traceFile.c_str());
+	}
+
+	unsigned char magic[2] = { 0, 0 };
+	const bool compressed = (2 == fread(magic, 1, 2, traceInput)) && magic[0] == 0x1f && magic[1] == 0x8b;
+	rewind(traceInput);
+
+	if(!compressed) {
+		return;
+	}
+
+#ifdef HAVE_LIBZ
+	fclose(traceInput);
+	traceInput = NULL;
+
+	traceInputZ = gzopen(traceFile.c_str(), "rb");
+
+	if(Z_NULL == traceInputZ) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: attempted to open: %s but zlib returns error condition.\n",
+			getName().c_str(), traceFile.c_str());
+	}
+
+	gzbuffer(traceInputZ, 1024 * 1024);
+#else
+	output->fatal(CALL_INFO, -1, "%s, Fatal: trace file: %s is compressed but Prospero was built without zlib.\n",
+		getName().c_str(), traceFile.c_str());
+#endif
+}
+
+size_t ProsperoStreamTraceReader::readRaw(char* target, const size_t len) {
+#ifdef HAVE_LIBZ
+	if(Z_NULL != traceInputZ) {
+		size_t bytesRead = 0;
+
+		while(bytesRead < len) {
+			const int chunk = gzread(traceInputZ, target + bytesRead, (unsigned int) (len - bytesRead));
+
+			if(chunk < 0) {
+				return (size_t) -1;
+			} else if(0 == chunk) {
+				break;
+			}
+
+			bytesRead += (size_t) chunk;
+		}
+
+		return bytesRead;
+	}
+#endif
+
+	const size_t bytesRead = fread(target, 1, len, traceInput);
+	return ferror(traceInput) ? (size_t) -1 : bytesRead;
+}
+
+void ProsperoStreamTraceReader::decode(const char* source, const size_t count, Block& block) {
+	for(size_t i = 0; i < count; ++i) {
+		const char* record = source + (i * recordLength);
+
+		uint64_t reqCycles;
+		uint64_t reqAddress;
+		uint32_t reqLength;
+		const char reqType = record[sizeof(uint64_t)];
+
+		memcpy(&reqCycles,  record, sizeof(uint64_t));
+		memcpy(&reqAddress, record + sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
+		memcpy(&reqLength,  record + sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
+
+		block.entries[i] = ProsperoTraceEntry(reqCycles, reqAddress, reqLength,
+			(reqType == 'R' || reqType == 'r') ? READ : WRITE);
+	}
+
+	block.count = count;
+}
+
+void ProsperoStreamTraceReader::fillBlock(Block& block) {
+	const size_t blockBytes = blockEntries * recordLength;
+
+	if(NULL != mapBase) {
+		const size_t available = (mapLength - mapOffset) / recordLength;
+		const size_t count = available < blockEntries ? available : blockEntries;
+
+		decode(mapBase + mapOffset, count, block);
+		mapOffset += count * recordLength;
+		block.last = (mapLength - mapOffset) < recordLength;
+	} else {
+		const size_t bytesRead = readRaw(&rawBuffer[0], blockBytes);
+
+		if((size_t) -1 == bytesRead) {
+			block.count = 0;
+			block.error = true;
+			block.last = true;
+			return;
+		}
+
+		// A partial record at the end of the trace is dropped
+		decode(&rawBuffer[0], bytesRead / recordLength, block);
+		block.last = bytesRead < blockBytes;
+	}
+}
+
+void ProsperoStreamTraceReader::readAhead() {
+	size_t fillIndex = 0;
+
+	while(true) {
+		Block& block = ring[fillIndex];
+
+		{
+			std::unique_lock<std::mutex> guard(ringLock);
+			blockFreed.wait(guard, [&] { return stopping || !block.ready; });
+
+			if(stopping) {
+				return;
+			}
+		}
+
+		fillBlock(block);
+
+		{
+			std::lock_guard<std::mutex> guard(ringLock);
+			block.ready = true;
+		}
+		blockFilled.notify_one();
+
+		if(block.last) {
+			return;
+		}
+
+		fillIndex = (fillIndex + 1) % ring.size();
+	}
+}
+
+ProsperoStreamTraceReader::Block* ProsperoStreamTraceReader::nextBlock() {
+	Block& block = ring[currentBlock];
+
+	if(useThread) {
+		std::unique_lock<std::mutex> guard(ringLock);
+
+		if(!block.ready) {
+			statReadWaits->addData(1);
+			output->verbose(CALL_INFO, 4, 0, "Waiting for the read ahead thread to fill block %" PRIu64 "\n",
+				(uint64_t) currentBlock);
+			blockFilled.wait(guard, [&] { return block.ready; });
+		}
+	} else {
+		fillBlock(block);
+		block.ready = true;
+	}
+
+	if(block.error) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: error reading trace file in stream reader.\n",
+			getName().c_str());
+	}
+
+	statBlocksRead->addData(1);
+	return &block;
+}
+
+ProsperoTraceEntry* ProsperoStreamTraceReader::readNextEntry() {
+	if(traceEnded) {
+		return NULL;
+	}
+
+	if(NULL == current || currentIndex == current->count) {
+		if(NULL != current) {
+			if(current->last) {
+				traceEnded = true;
+				return NULL;
+			}
+
+			// Callers release each entry before reading the next (see
+			// prosreader.h), so nothing still points into the block
+			// and it can go back to the read ahead thread
+			{
+				std::lock_guard<std::mutex> guard(ringLock);
+				current->ready = false;
+			}
+			blockFreed.notify_one();
+
+			currentBlock = (currentBlock + 1) % ring.size();
+		}
+
+		current = nextBlock();
+		currentIndex = 0;
+
+		if(0 == current->count) {
+			output->verbose(CALL_INFO, 2, 0, "End of trace file reached, returning empty request.\n");
+			traceEnded = true;
+			return NULL;
+		}
+	}
+
+	return &current->entries[currentIndex++];
+}
@@ -0,0 +1,125 @@
+// Copyright 2009-2020 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2020, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_STREAM_READER
+#define _H_SST_PROSPERO_STREAM_READER
+
+#include "prosreader.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+namespace SST {
+namespace Prospero {
+
+/*
+ * Reads the same binary traces as ProsperoBinaryTraceReader and
+ * ProsperoCompressedBinaryTraceReader (gzip files are detected from
+ * their header).  Records are decoded a block at a time into a ring of
+ * preallocated entries, by a background thread when read_ahead is set,
+ * so the simulation thread only waits if the thread falls behind.
+ * Uncompressed traces are mapped into memory rather than read.
+ *
+ * Entries belong to the reader.  Releasing them is a no-op; a block is
+ * handed back to be refilled when the entry after its last one is read,
+ * so an entry must not be used after the next call to readNextEntry.
+ */
+class ProsperoStreamTraceReader : public ProsperoTraceReader {
+
+public:
+	ProsperoStreamTraceReader( ComponentId_t id, Params& params, Output* out );
+	~ProsperoStreamTraceReader();
+	ProsperoTraceEntry* readNextEntry();
+	void releaseEntry(const ProsperoTraceEntry* entry) { }
+
+	SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+		ProsperoStreamTraceReader,
+		"prospero",
+		"ProsperoStreamTraceReader",
+		SST_ELI_ELEMENT_VERSION(1,0,0),
+		"Block based binary trace reader with read ahead, for compressed or uncompressed traces",
+		SST::Prospero::ProsperoTraceReader
+	)
+
+	SST_ELI_DOCUMENT_PARAMS(
+		{ "file", "Sets the file for the trace reader to use", "" },
+		{ "block_entries", "Number of trace records decoded at a time", "65536" },
+		{ "blocks", "Number of blocks decoded ahead of the simulation, when read_ahead is set", "4" },
+		{ "read_ahead", "Set to 1 to decode blocks on a background thread", "1" },
+		{ "mmap", "Set to 1 to map uncompressed traces into memory instead of reading them", "1" }
+	)
+
+	SST_ELI_DOCUMENT_STATISTICS(
+		{ "blocks_read", "Number of blocks of records decoded", "blocks", 1 },
+		{ "read_waits", "Number of times the simulation waited for the read ahead thread", "waits", 1 }
+	)
+
+private:
+	struct Block {
+		std::vector<ProsperoTraceEntry> entries;
+		size_t count;
+		bool ready;	// Filled and waiting to be used
+		bool last;	// No records follow this block
+		bool error;
+	};
+
+	void openTrace(const std::string& traceFile);
+	void fillBlock(Block& block);
+	size_t readRaw(char* target, const size_t len);
+	void decode(const char* source, const size_t count, Block& block);
+	void readAhead();
+	Block* nextBlock();
+
+	uint32_t recordLength;
+	size_t blockEntries;
+
+	FILE* traceInput;
+#ifdef HAVE_LIBZ
+	gzFile traceInputZ;
+#endif
+	const char* mapBase;
+	size_t mapLength;
+	size_t mapOffset;
+	std::vector<char> rawBuffer;
+
+	std::vector<Block> ring;
+	Block* current;
+	size_t currentBlock;
+	size_t currentIndex;
+	bool traceEnded;
+
+	bool useThread;
+	std::thread worker;
+	std::mutex ringLock;
+	std::condition_variable blockFilled;
+	std::condition_variable blockFreed;
+	bool stopping;
+
+	Statistic<uint64_t>* statBlocksRead;
+	Statistic<uint64_t>* statReadWaits;
+
+};
+
+}
+}
+
+#endif
@@ -34,6 +34,9 @@ def main():
                 # print "args are ", o, "and", a
                 Tracetype = "CompressedBinary"
                 traceFile = "sstprospero-0-0-gz.trace"
+            elif a == "stream":
+                Tracetype = "Stream"
+                traceFile = "sstprospero-0-0-bin.trace"
             else:
                 print("no match a= ", a)
                 print("Found nothing for o", o)